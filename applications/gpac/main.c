@@ -32,6 +32,8 @@ static GF_FilterSession *session=NULL;
 static u32 list_filters = 0;
 static Bool dump_stats = GF_FALSE;
 static Bool dump_graph = GF_FALSE;
+static Bool dump_prof = GF_FALSE;
+static const char *prof_out = NULL;
 static u32 print_filter_info = 0;
 static Bool print_meta_filters = GF_FALSE;
 static Bool load_test_filters = GF_FALSE;
@@ -579,6 +581,7 @@ static GF_GPACArg gpac_args[] =
 
 	GF_DEF_ARG("stats", NULL, "print stats after execution", NULL, NULL, GF_ARG_BOOL, 0),
 	GF_DEF_ARG("graph", NULL, "print graph after execution", NULL, NULL, GF_ARG_BOOL, 0),
+	GF_DEF_ARG("prof", NULL, "enable session profiling (see [-fs-prof](CORE)) and print profile as JSON after execution, to stderr or to the given file", NULL, NULL, GF_ARG_STRING, GF_ARG_HINT_EXPERT),
 	GF_DEF_ARG("k", NULL, "enable keyboard interaction from command line", NULL, NULL, GF_ARG_BOOL, GF_ARG_HINT_EXPERT),
 	GF_DEF_ARG("r", NULL, "enable reporting\n"
 			"- r: runtime reporting\n"
@@ -953,6 +956,7 @@ typedef enum
 	GPAC_EXIT,
 	GPAC_PRINT_STATS,
 	GPAC_PRINT_GRAPH,
+	GPAC_PRINT_PROFILE,
 	GPAC_SEND_UPDATE,
 	GPAC_LIST_FILTERS,
 	GPAC_INSERT_FILTER,
@@ -971,6 +975,7 @@ static struct _gpac_key
 	{'x', GPAC_EXIT, "exit with no flush (may break output files)", 0},
 	{'s', GPAC_PRINT_STATS, "print statistics", 0},
 	{'g', GPAC_PRINT_GRAPH, "print filter graph", 0},
+	{'p', GPAC_PRINT_PROFILE, "print session profile as JSON (requires -prof or -fs-prof)", 0},
 	{'l', GPAC_LIST_FILTERS, "list filters", 0},
 	{'u', GPAC_SEND_UPDATE, "update argument of filter", 0},
 	{'i', GPAC_INSERT_FILTER, "insert a filter in the chain", 0},
@@ -1001,6 +1006,26 @@ static void gpac_fsess_task_help()
 	}
 }
 
+static void gpac_print_profile(GF_FilterSession *fsess, const char *dst, Bool reset)
+{
+	FILE *out = stderr;
+	char *prof = gf_fs_get_profile(fsess, reset);
+	if (!prof) {
+		fprintf(stderr, "Session profiling not enabled\n");
+		return;
+	}
+	if (dst) {
+		out = gf_fopen(dst, "wb");
+		if (!out) {
+			fprintf(stderr, "Cannot open %s for writing profile\n", dst);
+			out = stderr;
+		}
+	}
+	fprintf(out, "%s\n", prof);
+	if (out != stderr) gf_fclose(out);
+	gf_free(prof);
+}
+
 static char szFilter[100];
 static char szCom[2048];
 static u64 run_start_time = 0;
@@ -1028,6 +1053,9 @@ static Bool gpac_fsess_task(GF_FilterSession *fsess, void *callback, u32 *resche
 		case GPAC_PRINT_GRAPH:
 			gf_fs_print_connections(fsess);
 			break;
+		case GPAC_PRINT_PROFILE:
+			gpac_print_profile(fsess, NULL, GF_FALSE);
+			break;
 		case GPAC_PRINT_HELP:
 			gpac_fsess_task_help();
 			break;
@@ -1883,6 +1911,10 @@ static int gpac_main(int argc, char **argv)
 			dump_stats = GF_TRUE;
 		} else if (!strcmp(arg, "-graph")) {
 			dump_graph = GF_TRUE;
+		} else if (!strcmp(arg, "-prof")) {
+			dump_prof = GF_TRUE;
+			prof_out = arg_val;
+			sflags |= GF_FS_FLAG_PROFILE;
 		} else if (strstr(arg, ":*") || strstr(arg, ":@")) {
 			if (list_filters)
 				list_filters = 3;
@@ -2308,6 +2340,8 @@ exit:
 		gf_fs_print_stats(session);
 	if (dump_graph)
 		gf_fs_print_connections(session);
+	if (dump_prof)
+		gpac_print_profile(session, prof_out, GF_FALSE);
 
 
 	tmp_sess = session;
@@ -0,0 +1,183 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: Jean Le Feuvre
+ *			Copyright (c) Telecom ParisTech 2021
+ *					All rights reserved
+ *
+ *  This file is part of GPAC / color conversion benchmark
+ *
+ *  GPAC is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  GPAC is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *
+ */
+
+#include <gpac/tools.h>
+#include <gpac/constants.h>
+#include <gpac/color.h>
+
+/*benchmarks gf_stretch_bits for each source pixel format to RGBA/RGB, reporting Mpixels/s
+SIMD output is first checked against the C code at full width and at a width not multiple of the SIMD block size
+the C reference is obtained by converting columns narrower than the SIMD block size, so this also works when the SIMD code is selected (the simd option is only read at init)
+usage: colorbench [width height [nb_iterations [src_pixfmt]]]*/
+
+static u32 src_formats[] = {
+	GF_PIXEL_YUV, GF_PIXEL_NV12, GF_PIXEL_NV21, GF_PIXEL_YUV422, GF_PIXEL_YUV444,
+	GF_PIXEL_YUV_10, GF_PIXEL_YUV422_10, GF_PIXEL_YUV444_10,
+	GF_PIXEL_YUYV, GF_PIXEL_YVYU, GF_PIXEL_UYVY, GF_PIXEL_VYUY,
+	GF_PIXEL_RGBA, GF_PIXEL_RGB
+};
+
+static u32 dst_formats[] = {
+	GF_PIXEL_RGBA, GF_PIXEL_RGB
+};
+
+/*width of the columns converted to get the C reference, below the smallest SIMD block size*/
+#define REF_COL_WIDTH	8
+
+static GF_Err check_simd(GF_VideoSurface *vs_dst, GF_VideoSurface *vs_src, u32 dst_size, u32 width)
+{
+	GF_Err e = GF_OK;
+	GF_Window wnd;
+	u8 *ref = gf_malloc(dst_size);
+	u8 *dst = vs_dst->video_buffer;
+	u32 i, line_size = width * vs_dst->pitch_x;
+
+	memset(ref, 0, dst_size);
+	memset(dst, 0, dst_size);
+	vs_dst->video_buffer = ref;
+	wnd.y = 0;
+	wnd.h = vs_src->height;
+	for (i=0; i<width; i+=REF_COL_WIDTH) {
+		wnd.x = i;
+		wnd.w = MIN(REF_COL_WIDTH, width - i);
+		e = gf_stretch_bits(vs_dst, vs_src, &wnd, &wnd, 0xFF, GF_FALSE, NULL, NULL);
+		if (e) break;
+	}
+	vs_dst->video_buffer = dst;
+
+	wnd.x = 0;
+	wnd.w = width;
+	if (!e) e = gf_stretch_bits(vs_dst, vs_src, &wnd, &wnd, 0xFF, GF_FALSE, NULL, NULL);
+
+	if (!e) {
+		for (i=0; i<vs_src->height; i++) {
+			if (memcmp(ref + i*vs_dst->pitch_y, dst + i*vs_dst->pitch_y, line_size)) {
+				fprintf(stderr, "%s -> %s: SIMD mismatch for width %u line %u\n", gf_pixel_fmt_name(vs_src->pixel_format), gf_pixel_fmt_name(vs_dst->pixel_format), width, i);
+				e = GF_CORRUPTED_DATA;
+				break;
+			}
+		}
+	}
+	gf_free(ref);
+	return e;
+}
+
+static GF_Err bench_format(u32 src_pf, u32 dst_pf, u32 width, u32 height, u32 nb_iter)
+{
+	u32 i, size, dst_size;
+	u64 start, now;
+	u8 *src, *dst;
+	GF_VideoSurface vs_src, vs_dst;
+	GF_Window wnd;
+	GF_Err e;
+
+	if (!gf_pixel_get_size_info(src_pf, width, height, &size, NULL, NULL, NULL, NULL))
+		return GF_NOT_SUPPORTED;
+	if (!gf_pixel_get_size_info(dst_pf, width, height, &dst_size, NULL, NULL, NULL, NULL))
+		return GF_NOT_SUPPORTED;
+
+	src = gf_malloc(size);
+	dst = gf_malloc(dst_size);
+	//random content, masked to 10 bits for high bit depth formats
+	for (i=0; i<size; i++) src[i] = gf_rand();
+	if (gf_pixel_is_wide_depth(src_pf) > 8) {
+		for (i=0; i<size/2; i++) ((u16 *)src)[i] &= 0x3FF;
+	}
+
+	memset(&vs_src, 0, sizeof(GF_VideoSurface));
+	vs_src.width = width;
+	vs_src.height = height;
+	vs_src.pixel_format = src_pf;
+	vs_src.video_buffer = src;
+	gf_pixel_get_size_info(src_pf, width, height, NULL, (u32 *) &vs_src.pitch_y, NULL, NULL, NULL);
+
+	memset(&vs_dst, 0, sizeof(GF_VideoSurface));
+	vs_dst.width = width;
+	vs_dst.height = height;
+	vs_dst.pixel_format = dst_pf;
+	vs_dst.video_buffer = dst;
+	vs_dst.pitch_x = gf_pixel_get_bytes_per_pixel(dst_pf);
+	vs_dst.pitch_y = vs_dst.pitch_x * width;
+
+	wnd.x = wnd.y = 0;
+	wnd.w = width;
+	wnd.h = height;
+
+	//bit-exactness against C code, also checks the conversion is supported
+	e = check_simd(&vs_dst, &vs_src, dst_size, width);
+	//odd number of chroma samples per line, forcing the C code on the line tail
+	if (!e && (width>34)) e = check_simd(&vs_dst, &vs_src, dst_size, width-2);
+	if (e) {
+		fprintf(stderr, "%s -> %s: %s\n", gf_pixel_fmt_name(src_pf), gf_pixel_fmt_name(dst_pf), gf_error_to_string(e));
+	} else {
+		start = gf_sys_clock_high_res();
+		for (i=0; i<nb_iter; i++) {
+			gf_stretch_bits(&vs_dst, &vs_src, &wnd, &wnd, 0xFF, GF_FALSE, NULL, NULL);
+		}
+		now = gf_sys_clock_high_res() - start;
+		if (!now) now = 1;
+		fprintf(stdout, "%-8s -> %-8s %8.2f Mpixels/s\n", gf_pixel_fmt_name(src_pf), gf_pixel_fmt_name(dst_pf), ((Double) width) * height * nb_iter / now);
+	}
+	gf_free(src);
+	gf_free(dst);
+	return e;
+}
+
+int main(int argc, char **argv)
+{
+	u32 i, j, width=1920, height=1080, nb_iter=50, pf=0;
+	int ret = 0;
+
+	if (argc>=3) {
+		width = atoi(argv[1]);
+		height = atoi(argv[2]);
+	}
+	if (argc>=4) nb_iter = atoi(argv[3]);
+	if (argc>=5) {
+		pf = gf_pixel_fmt_parse(argv[4]);
+		if (!pf) {
+			fprintf(stderr, "Unknown pixel format %s\n", argv[4]);
+			return 1;
+		}
+	}
+	if (!width || !height || !nb_iter) {
+		fprintf(stderr, "usage: colorbench [width height [nb_iterations [src_pixfmt]]]\n");
+		return 1;
+	}
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	gf_rand_init(GF_FALSE);
+
+	fprintf(stdout, "Color conversion benchmark %ux%u, %u iterations\n", width, height, nb_iter);
+	for (i=0; i<GF_ARRAY_LENGTH(src_formats); i++) {
+		if (pf && (src_formats[i] != pf)) continue;
+		for (j=0; j<GF_ARRAY_LENGTH(dst_formats); j++) {
+			if (bench_format(src_formats[i], dst_formats[j], width, height, nb_iter) == GF_CORRUPTED_DATA)
+				ret = 1;
+		}
+	}
+	gf_sys_close();
+	return ret;
+}
@@ -0,0 +1,114 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: Jean Le Feuvre
+ *			Copyright (c) Telecom ParisTech 2021
+ *					All rights reserved
+ *
+ *  This file is part of GPAC / CRC32 benchmark
+ *
+ *  GPAC is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  GPAC is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *
+ */
+
+#include <gpac/tools.h>
+
+/*benchmarks gf_crc_32 against a bytewise reference for several buffer sizes, reporting MBytes/s and checking results match
+usage: crcbench [total_bytes_per_size]*/
+
+static u32 crc_table[256];
+
+static void crc_ref_init()
+{
+	u32 i, j;
+	for (i=0; i<256; i++) {
+		u32 c = i << 24;
+		for (j=0; j<8; j++)
+			c = (c & 0x80000000) ? (c << 1) ^ 0x04c11db7 : (c << 1);
+		crc_table[i] = c;
+	}
+}
+
+static u32 crc_ref(const u8 *data, u32 len)
+{
+	u32 i, crc = 0xffffffff;
+	for (i=0; i<len; i++)
+		crc = (crc << 8) ^ crc_table[((crc >> 24) ^ data[i]) & 0xff];
+	return crc;
+}
+
+static u32 sizes[] = {
+	16, 64, 188, 1024, 4096, 65536, 1024*1024
+};
+
+int main(int argc, char **argv)
+{
+	u32 i, j, total = 256*1024*1024;
+	u32 max_size = sizes[GF_ARRAY_LENGTH(sizes)-1];
+	u8 *buf;
+	Bool ok = GF_TRUE;
+
+	if (argc>=2) total = atoi(argv[1]);
+	if (!total) {
+		fprintf(stderr, "usage: crcbench [total_bytes_per_size]\n");
+		return 1;
+	}
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	gf_rand_init(GF_FALSE);
+	crc_ref_init();
+
+	buf = gf_malloc(max_size + 16);
+	for (i=0; i<max_size + 16; i++) buf[i] = gf_rand();
+
+	//check all small sizes and misalignments
+	for (i=0; i<4096; i++) {
+		u32 offset = i % 16;
+		if (crc_ref(buf+offset, i) != gf_crc_32(buf+offset, i)) {
+			fprintf(stderr, "CRC mismatch for size %u offset %u\n", i, offset);
+			ok = GF_FALSE;
+			break;
+		}
+	}
+
+	fprintf(stdout, "CRC32 benchmark, %u bytes per size\n", total);
+	fprintf(stdout, "%8s %12s %12s\n", "size", "ref MB/s", "gpac MB/s");
+	for (i=0; i<GF_ARRAY_LENGTH(sizes); i++) {
+		u32 size = sizes[i];
+		u32 nb_iter = total / size;
+		u32 crc_a = 0, crc_b = 0;
+		u64 start, ref_time, crc_time;
+		if (!nb_iter) nb_iter = 1;
+
+		start = gf_sys_clock_high_res();
+		for (j=0; j<nb_iter; j++) crc_a ^= crc_ref(buf + (j%16), size);
+		ref_time = gf_sys_clock_high_res() - start;
+
+		start = gf_sys_clock_high_res();
+		for (j=0; j<nb_iter; j++) crc_b ^= gf_crc_32(buf + (j%16), size);
+		crc_time = gf_sys_clock_high_res() - start;
+
+		if (!ref_time) ref_time = 1;
+		if (!crc_time) crc_time = 1;
+		if (crc_a != crc_b) {
+			fprintf(stderr, "CRC mismatch for size %u\n", size);
+			ok = GF_FALSE;
+		}
+		fprintf(stdout, "%8u %12.2f %12.2f\n", size, ((Double) size) * nb_iter / ref_time, ((Double) size) * nb_iter / crc_time);
+	}
+	gf_free(buf);
+	gf_sys_close();
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: Jean Le Feuvre
+ *			Copyright (c) Telecom Paris 2024
+ *					All rights reserved
+ *
+ *  This file is part of GPAC / AES benchmark
+ *
+ *  GPAC is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  GPAC is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *
+ */
+
+#include <gpac/tools.h>
+#include <gpac/crypt.h>
+
+/*benchmarks AES-128 CTR, CBC and cbcs pattern (1:9) with the software, OpenSSL and AES-NI engines, reporting MBytes/s and checking all engines produce the same output
+usage: cryptbench [total_bytes_per_test]*/
+
+static const char *engine_names[] = {"default", "soft", "openssl", "aesni"};
+
+typedef struct
+{
+	const char *name;
+	GF_CRYPTO_MODE mode;
+	u32 crypt_blocks, skip_blocks;
+	Bool decrypt;
+} BenchTest;
+
+static BenchTest tests[] = {
+	{"CTR", GF_CTR, 0, 0, GF_FALSE},
+	{"CBC enc", GF_CBC, 0, 0, GF_FALSE},
+	{"CBC dec", GF_CBC, 0, 0, GF_TRUE},
+	{"CTR 1:9", GF_CTR, 1, 9, GF_FALSE},
+	{"CBC 1:9 enc", GF_CBC, 1, 9, GF_FALSE},
+	{"CBC 1:9 dec", GF_CBC, 1, 9, GF_TRUE},
+};
+
+static u32 sizes[] = {
+	188, 4096, 65536, 1024*1024
+};
+
+//process buffer by chunks of pseudo-random sizes to check state is correctly carried over calls
+static void run_check(GF_Crypt *gc, const BenchTest *t, u8 *buf, u32 size)
+{
+	u32 pos = 0, seed = size;
+	while (pos < size) {
+		u32 chunk = t->crypt_blocks ? 16 * (t->crypt_blocks + t->skip_blocks) : 16;
+		seed = seed * 1103515245 + 12345;
+		chunk *= 1 + (seed >> 16) % 7;
+		//CTR can be called on any size
+		if ((t->mode==GF_CTR) && !t->crypt_blocks) chunk = 1 + (seed >> 16) % 97;
+		if (chunk > size - pos) chunk = size - pos;
+		if (t->decrypt) gf_crypt_decrypt_pattern(gc, buf+pos, chunk, t->crypt_blocks, t->skip_blocks);
+		else gf_crypt_encrypt_pattern(gc, buf+pos, chunk, t->crypt_blocks, t->skip_blocks);
+		pos += chunk;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	u32 i, j, s, e, total = 64*1024*1024;
+	u32 max_size = sizes[GF_ARRAY_LENGTH(sizes)-1];
+	u8 key[16], iv[16], *src, *ref, *buf;
+	Bool ok = GF_TRUE;
+
+	if (argc>=2) total = atoi(argv[1]);
+	if (!total) {
+		fprintf(stderr, "usage: cryptbench [total_bytes_per_test]\n");
+		return 1;
+	}
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	gf_rand_init(GF_FALSE);
+
+	src = gf_malloc(max_size);
+	ref = gf_malloc(max_size);
+	buf = gf_malloc(max_size);
+	for (i=0; i<max_size; i++) src[i] = gf_rand();
+	for (i=0; i<16; i++) {
+		key[i] = gf_rand();
+		iv[i] = gf_rand();
+	}
+	//check counter wrapping on the lower 64 bits
+	memset(iv+8, 0xFF, 7);
+
+	fprintf(stdout, "AES-128 benchmark, %u bytes per test\n", total);
+	{
+		GF_Crypt *gc = gf_crypt_open(GF_AES_128, GF_CTR);
+		if (gc) {
+			fprintf(stdout, "AES-128 default engine: %s\n", engine_names[gf_crypt_get_engine(gc)]);
+			gf_crypt_close(gc);
+		}
+	}
+
+	//conformance: all engines must match the software one, with arbitrary call splitting
+	for (i=0; i<GF_ARRAY_LENGTH(tests); i++) {
+		u32 size = 65536 + 37;
+		if (tests[i].mode==GF_CBC) size -= 37;
+		for (e=GF_CRYPTO_ENGINE_SOFT; e<=GF_CRYPTO_ENGINE_AESNI; e++) {
+			GF_Crypt *gc = gf_crypt_open_engine(GF_AES_128, tests[i].mode, e);
+			if (!gc) continue;
+			gf_crypt_init(gc, key, iv);
+			memcpy(buf, src, size);
+			run_check(gc, &tests[i], buf, size);
+			gf_crypt_close(gc);
+			if (e==GF_CRYPTO_ENGINE_SOFT) {
+				memcpy(ref, buf, size);
+			} else if (memcmp(ref, buf, size)) {
+				fprintf(stderr, "%s mismatch for engine %s\n", tests[i].name, engine_names[e]);
+				ok = GF_FALSE;
+			}
+		}
+	}
+
+	fprintf(stdout, "%12s %8s %12s %12s %12s\n", "test", "size", "soft MB/s", "openssl MB/s", "aesni MB/s");
+	for (i=0; i<GF_ARRAY_LENGTH(tests); i++) {
+		for (s=0; s<GF_ARRAY_LENGTH(sizes); s++) {
+			u32 size = sizes[s];
+			u32 nb_iter = total / size;
+			if (tests[i].mode==GF_CBC) size -= size % 16;
+			if (!nb_iter) nb_iter = 1;
+
+			fprintf(stdout, "%12s %8u", tests[i].name, size);
+			for (e=GF_CRYPTO_ENGINE_SOFT; e<=GF_CRYPTO_ENGINE_AESNI; e++) {
+				u64 start, time;
+				u32 iter = nb_iter;
+				GF_Crypt *gc = gf_crypt_open_engine(GF_AES_128, tests[i].mode, e);
+				if (!gc) {
+					fprintf(stdout, " %12s", "n/a");
+					continue;
+				}
+				gf_crypt_init(gc, key, iv);
+				memcpy(buf, src, size);
+				//software engine is slow, limit iterations
+				if (e==GF_CRYPTO_ENGINE_SOFT) iter /= 8;
+				if (!iter) iter = 1;
+
+				start = gf_sys_clock_high_res();
+				for (j=0; j<iter; j++) {
+					if (tests[i].decrypt) gf_crypt_decrypt_pattern(gc, buf, size, tests[i].crypt_blocks, tests[i].skip_blocks);
+					else gf_crypt_encrypt_pattern(gc, buf, size, tests[i].crypt_blocks, tests[i].skip_blocks);
+				}
+				time = gf_sys_clock_high_res() - start;
+				if (!time) time = 1;
+				gf_crypt_close(gc);
+				fprintf(stdout, " %12.2f", ((Double) size) * iter / time);
+			}
+			fprintf(stdout, "\n");
+		}
+	}
+	gf_free(src);
+	gf_free(ref);
+	gf_free(buf);
+	gf_sys_close();
+	return ok ? 0 : 1;
+}
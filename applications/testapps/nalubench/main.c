@@ -0,0 +1,257 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: Jean Le Feuvre
+ *			Copyright (c) Telecom Paris 2024
+ *					All rights reserved
+ *
+ *  This file is part of GPAC / NAL unit scanning benchmark
+ *
+ *  GPAC is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  GPAC is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *
+ */
+
+#include <gpac/tools.h>
+#include <gpac/internal/media_dev.h>
+
+/*benchmarks start code scanning and emulation prevention byte removal/insertion against bytewise reference implementations, reporting MBytes/s and checking results match
+usage: nalubench [annexb_file ...]
+if no file is given, synthetic payloads are used*/
+
+static u32 ref_next_start_code(const u8 *data, u32 data_len, u32 *sc_size)
+{
+	u32 v = 0xffffffff, i;
+	for (i=0; i<data_len; i++) {
+		v = (v << 8) | data[i];
+		if ((v & 0x00FFFFFF) == 0x00000001) {
+			if ((i>=3) && (v == 0x00000001)) {
+				*sc_size = 4;
+				return i - 3;
+			}
+			*sc_size = 3;
+			return i - 2;
+		}
+	}
+	return data_len;
+}
+
+static u32 ref_remove_count(const u8 *buffer, u32 nal_size)
+{
+	u32 i = 0, count = 0;
+	u8 num_zero = 0;
+	while (i < nal_size) {
+		if ((num_zero == 2) && (buffer[i] == 0x03) && (i + 1 < nal_size) && (buffer[i + 1] < 0x04)) {
+			num_zero = 0;
+			count++;
+			i++;
+		}
+		if (!buffer[i]) num_zero++;
+		else num_zero = 0;
+		i++;
+	}
+	return count;
+}
+
+static u32 ref_remove(const u8 *src, u8 *dst, u32 nal_size)
+{
+	u32 i = 0, count = 0;
+	u8 num_zero = 0;
+	while (i < nal_size) {
+		if ((num_zero == 2) && (src[i] == 0x03) && (i + 1 < nal_size) && (src[i + 1] < 0x04)) {
+			num_zero = 0;
+			count++;
+			i++;
+		}
+		dst[i - count] = src[i];
+		if (!src[i]) num_zero++;
+		else num_zero = 0;
+		i++;
+	}
+	return nal_size - count;
+}
+
+static u32 ref_add_count(const u8 *buffer, u32 nal_size)
+{
+	u32 i, count = 0;
+	u8 num_zero = 0;
+	for (i=0; i<nal_size; i++) {
+		if ((num_zero == 2) && (buffer[i] < 0x04)) {
+			num_zero = buffer[i] ? 0 : 1;
+			count++;
+		} else if (!buffer[i]) num_zero++;
+		else num_zero = 0;
+	}
+	return count;
+}
+
+static u32 ref_add(const u8 *src, u8 *dst, u32 nal_size)
+{
+	u32 i, count = 0;
+	u8 num_zero = 0;
+	for (i=0; i<nal_size; i++) {
+		if ((num_zero == 2) && (src[i] < 0x04)) {
+			num_zero = src[i] ? 0 : 1;
+			dst[i + count] = 0x03;
+			count++;
+		} else if (!src[i]) num_zero++;
+		else num_zero = 0;
+		dst[i + count] = src[i];
+	}
+	return nal_size + count;
+}
+
+//scans all start codes of the buffer, returns a checksum of their positions and sizes
+static u32 scan_all(const u8 *data, u32 size, Bool use_ref)
+{
+	u32 pos = 0, res = 0;
+	while (pos < size) {
+		u32 sc_size = 0;
+		u32 sc = use_ref ? ref_next_start_code(data+pos, size-pos, &sc_size) : gf_media_nalu_next_start_code(data+pos, size-pos, &sc_size);
+		if (pos + sc == size) break;
+		res = res*31 + pos + sc + sc_size;
+		pos += sc + sc_size;
+	}
+	return res;
+}
+
+static Bool check_buffer(const char *name, const u8 *data, u32 size, u8 *dst_a, u8 *dst_b)
+{
+	u32 a, b;
+	Bool ok = GF_TRUE;
+	if (scan_all(data, size, GF_TRUE) != scan_all(data, size, GF_FALSE)) {
+		fprintf(stderr, "%s: start code mismatch for size %u\n", name, size);
+		ok = GF_FALSE;
+	}
+	if (ref_remove_count(data, size) != gf_media_nalu_emulation_bytes_remove_count(data, size)) {
+		fprintf(stderr, "%s: EPB remove count mismatch for size %u\n", name, size);
+		ok = GF_FALSE;
+	}
+	a = ref_remove(data, dst_a, size);
+	b = gf_media_nalu_remove_emulation_bytes(data, dst_b, size);
+	if ((a != b) || memcmp(dst_a, dst_b, a)) {
+		fprintf(stderr, "%s: EPB removal mismatch for size %u\n", name, size);
+		ok = GF_FALSE;
+	}
+	//inplace removal
+	memcpy(dst_b, data, size);
+	b = gf_media_nalu_remove_emulation_bytes(dst_b, dst_b, size);
+	if ((a != b) || memcmp(dst_a, dst_b, a)) {
+		fprintf(stderr, "%s: inplace EPB removal mismatch for size %u\n", name, size);
+		ok = GF_FALSE;
+	}
+	if (ref_add_count(data, size) != gf_media_nalu_emulation_bytes_add_count((u8 *) data, size)) {
+		fprintf(stderr, "%s: EPB add count mismatch for size %u\n", name, size);
+		ok = GF_FALSE;
+	}
+	a = ref_add(data, dst_a, size);
+	b = gf_media_nalu_add_emulation_bytes(data, dst_b, size);
+	if ((a != b) || memcmp(dst_a, dst_b, a)) {
+		fprintf(stderr, "%s: EPB insertion mismatch for size %u\n", name, size);
+		ok = GF_FALSE;
+	}
+	return ok;
+}
+
+#define BENCH(_res, _call) { \
+		u64 start = gf_sys_clock_high_res(); \
+		for (j=0; j<nb_iter; j++) { _call; } \
+		_res = gf_sys_clock_high_res() - start; \
+		if (!_res) _res = 1; \
+	}
+
+static Bool bench_buffer(const char *name, const u8 *data, u32 size, u32 total)
+{
+	u32 j, i, nb_iter = total / size;
+	u32 sink = 0;
+	u64 t_ref, t_new;
+	u8 *dst_a, *dst_b;
+	Bool ok = GF_TRUE;
+	Double mb = 0;
+	if (!nb_iter) nb_iter = 1;
+	mb = ((Double) size) * nb_iter;
+
+	dst_a = gf_malloc(size*3/2 + 16);
+	dst_b = gf_malloc(size*3/2 + 16);
+
+	//check full buffer and a range of small sizes and offsets
+	if (!check_buffer(name, data, size, dst_a, dst_b)) ok = GF_FALSE;
+	for (i=0; ok && (i<2048) && (i<size); i++) {
+		u32 offset = (i*7) % (size - i);
+		if (!check_buffer(name, data + offset, i, dst_a, dst_b)) ok = GF_FALSE;
+	}
+
+	BENCH(t_ref, sink += scan_all(data, size, GF_TRUE));
+	BENCH(t_new, sink += scan_all(data, size, GF_FALSE));
+	fprintf(stdout, "%20s %14s %10.2f %10.2f\n", name, "start codes", mb / t_ref, mb / t_new);
+
+	BENCH(t_ref, sink += ref_remove(data, dst_a, size));
+	BENCH(t_new, sink += gf_media_nalu_remove_emulation_bytes(data, dst_b, size));
+	fprintf(stdout, "%20s %14s %10.2f %10.2f\n", name, "EPB remove", mb / t_ref, mb / t_new);
+
+	BENCH(t_ref, sink += ref_add(data, dst_a, size));
+	BENCH(t_new, sink += gf_media_nalu_add_emulation_bytes(data, dst_b, size));
+	fprintf(stdout, "%20s %14s %10.2f %10.2f\n", name, "EPB insert", mb / t_ref, mb / t_new);
+
+	if (!sink) fprintf(stdout, "\n");
+	gf_free(dst_a);
+	gf_free(dst_b);
+	return ok;
+}
+
+int main(int argc, char **argv)
+{
+	u32 i, size = 8*1024*1024, total = 256*1024*1024;
+	u8 *buf;
+	Bool ok = GF_TRUE;
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	gf_rand_init(GF_FALSE);
+
+	fprintf(stdout, "NAL scanning benchmark, %u bytes per test\n", total);
+	fprintf(stdout, "%20s %14s %10s %10s\n", "source", "test", "ref MB/s", "gpac MB/s");
+
+	for (i=1; i<(u32) argc; i++) {
+		u32 fsize;
+		u8 *data;
+		if (gf_file_load_data(argv[i], &data, &fsize) != GF_OK) {
+			fprintf(stderr, "Cannot load %s\n", argv[i]);
+			ok = GF_FALSE;
+			continue;
+		}
+		if (fsize && !bench_buffer(gf_file_basename(argv[i]), data, fsize, total)) ok = GF_FALSE;
+		gf_free(data);
+	}
+
+	if (argc<2) {
+		buf = gf_malloc(size);
+		//high entropy payload, typical of CABAC slice data with sparse start codes
+		for (i=0; i<size; i++) buf[i] = gf_rand();
+		for (i=0; i + 4 < size; i += 50000 + gf_rand() % 100000) {
+			buf[i] = buf[i+1] = buf[i+2] = 0;
+			buf[i+3] = 1;
+		}
+		if (!bench_buffer("random", buf, size, total)) ok = GF_FALSE;
+
+		//zero-heavy payload, worst case with many emulation prevention sequences
+		for (i=0; i<size; i++) {
+			u32 r = gf_rand() % 8;
+			buf[i] = (r<4) ? 0 : ((r<6) ? (u8) (r-3) : (u8) gf_rand());
+		}
+		if (!bench_buffer("zero-heavy", buf, size, total)) ok = GF_FALSE;
+		gf_free(buf);
+	}
+	gf_sys_close();
+	return ok ? 0 : 1;
+}
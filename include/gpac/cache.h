@@ -274,6 +274,36 @@ Mark the entry as "headers processed"
  */
 GF_Err gf_cache_set_headers_processed(const DownloadedCacheEntry entry);
 
+/*!
+Mark the entry as accessed now, used for least recently used eviction of the cache
+\param entry The entry
+ */
+void gf_cache_entry_touch(const DownloadedCacheEntry entry);
+/*!
+Get the last access time of the entry
+\param entry The entry
+\return the last access time in UTC milliseconds
+ */
+u64 gf_cache_entry_get_last_access(const DownloadedCacheEntry entry);
+/*!
+Check if the entry is stored in memory
+\param entry The entry
+\return GF_TRUE if the entry is stored in memory, GF_FALSE if stored on disk
+ */
+Bool gf_cache_entry_is_memory(const DownloadedCacheEntry entry);
+/*!
+Get the storage used by the entry (file size or allocated memory)
+\param entry The entry
+\return size in bytes
+ */
+u32 gf_cache_entry_get_storage_size(const DownloadedCacheEntry entry);
+/*!
+Check if the entry may be removed from the cache, i.e. is not persistent, not pushed by the application, not being written and not used by any session
+\param entry The entry
+\return GF_TRUE if the entry can be evicted
+ */
+Bool gf_cache_entry_can_evict(const DownloadedCacheEntry entry);
+
 /*! @} */
 
 #ifdef __cplusplus
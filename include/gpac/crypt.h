@@ -75,12 +75,38 @@ typedef enum {
 } GF_CRYPTO_ALGO;
 
 
+/*! AES implementation to use*/
+typedef enum {
+	/*! use the fastest engine available: AES-NI if supported by the CPU, otherwise OpenSSL if available, otherwise software*/
+	GF_CRYPTO_ENGINE_DEFAULT = 0,
+	/*! built-in software implementation*/
+	GF_CRYPTO_ENGINE_SOFT,
+	/*! OpenSSL implementation, only available when GPAC is built with OpenSSL*/
+	GF_CRYPTO_ENGINE_OPENSSL,
+	/*! built-in AES-NI implementation, only available on x86 CPUs supporting AES instructions*/
+	GF_CRYPTO_ENGINE_AESNI,
+} GF_CRYPTO_ENGINE;
+
 /*! opens crypto context
 \param algorithm the algorithm to use
 \param mode the chaining mode of the algorithm
 \return a new crypto context
 */
 GF_Crypt *gf_crypt_open(GF_CRYPTO_ALGO algorithm, GF_CRYPTO_MODE mode);
+
+/*! opens crypto context using a given AES implementation
+\param algorithm the algorithm to use
+\param mode the chaining mode of the algorithm
+\param engine the AES implementation to use
+\return a new crypto context, or NULL if the engine is not available
+*/
+GF_Crypt *gf_crypt_open_engine(GF_CRYPTO_ALGO algorithm, GF_CRYPTO_MODE mode, GF_CRYPTO_ENGINE engine);
+
+/*! gets the AES implementation used by a crypto context
+\param gfc the target crytpo context
+\return the engine used, never GF_CRYPTO_ENGINE_DEFAULT
+*/
+GF_CRYPTO_ENGINE gf_crypt_get_engine(GF_Crypt *gfc);
 /*! destroys a crypto context
 \param gfc the target crytpo context
 */
@@ -141,6 +167,29 @@ GF_Err gf_crypt_encrypt(GF_Crypt *gfc, void *plaintext, u32 size);
 */
 GF_Err gf_crypt_decrypt(GF_Crypt *gfc, void *ciphertext, u32 size);
 
+/*! encrypts a payload using a pattern of encrypted and clear 16-byte blocks, as used by CENC cbcs and cens schemes. The encryption is done inplace.
+The payload is processed as a repetition of crypt_blocks encrypted blocks followed by skip_blocks clear blocks, the last encrypted run being possibly truncated. The chaining state (CBC IV or CTR counter) is carried over clear blocks.
+If skip_blocks is 0, this is equivalent to \ref gf_crypt_encrypt
+\param gfc the target crytpo context
+\param plaintext the clear buffer
+\param size the size of the clear buffer
+\param crypt_blocks number of encrypted blocks in pattern
+\param skip_blocks number of clear blocks in pattern
+\return error if any
+*/
+GF_Err gf_crypt_encrypt_pattern(GF_Crypt *gfc, void *plaintext, u32 size, u32 crypt_blocks, u32 skip_blocks);
+
+/*! decrypts a payload using a pattern of encrypted and clear 16-byte blocks, as used by CENC cbcs and cens schemes. The decryption is done inplace.
+See \ref gf_crypt_encrypt_pattern
+\param gfc the target crytpo context
+\param ciphertext the encrypted buffer
+\param size the size of the encrypted buffer
+\param crypt_blocks number of encrypted blocks in pattern
+\param skip_blocks number of clear blocks in pattern
+\return error if any
+*/
+GF_Err gf_crypt_decrypt_pattern(GF_Crypt *gfc, void *ciphertext, u32 size, u32 crypt_blocks, u32 skip_blocks);
+
 
 /*! @} */
 
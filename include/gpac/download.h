@@ -475,6 +475,18 @@ Gets the cumultated bitrate in of all active sessions.
  */
 u32 gf_dm_get_global_rate(GF_DownloadManager *dm);
 
+/*!
+\brief gets cache statistics
+
+Gets the cache statistics of the download manager since its creation. Entries are evicted in least recently used order when the disk cache exceeds `-cache-size` or the memory cache exceeds `-cache-mem-size`
+\param dm the download manager object
+\param nb_hits set to the number of resources served from cache, either directly or after revalidation with the server - may be NULL
+\param nb_misses set to the number of resources downloaded in cache - may be NULL
+\param nb_evictions set to the number of entries evicted from cache - may be NULL
+\param evicted_bytes set to the number of bytes evicted from cache - may be NULL
+ */
+void gf_dm_get_cache_stats(GF_DownloadManager *dm, u32 *nb_hits, u32 *nb_misses, u32 *nb_evictions, u64 *evicted_bytes);
+
 
 /*!
 \brief Get header sizes and times stats for the session
@@ -201,7 +201,9 @@ typedef enum
 	/*! In this mode, the scheduler uses locks for packet and property queues even if single-threaded (test mode) */
 	GF_FS_SCHEDULER_LOCK_FORCE,
 	/*! In this mode, the scheduler uses direct dispatch and no threads, trying to nest task calls within task calls */
-	GF_FS_SCHEDULER_DIRECT
+	GF_FS_SCHEDULER_DIRECT,
+	/*! In this mode, the scheduler does not use locks for packet and property queues, and each thread has its own lock-free task list. Tasks of a filter are posted to the list of the thread which last processed this filter, and idle threads steal tasks from other threads. Defaults to lock-free if no threads are used*/
+	GF_FS_SCHEDULER_WORK_STEALING
 } GF_FilterSchedulerType;
 
 /*! Flag set to indicate meta filters should be loaded. A meta filter is a filter providing various sub-filters.
@@ -228,6 +230,8 @@ When set, all sub-filters are exposed. This should only be set when inspecting f
 #define GF_FS_FLAG_NO_RESERVOIR (1<<10)
 /*! Throws an error if any PID in the filter graph cannot be linked. The default behavior is tu run the session even when some PIDs are not connected*/
 #define GF_FS_FLAG_FULL_LINK (1<<11)
+/*! Enables profiling of task latencies, output blocking and input starvation, see \ref gf_fs_get_profile*/
+#define GF_FS_FLAG_PROFILE (1<<12)
 
 /*! Creates a new filter session. This will also load all available filter registers not blacklisted.
 \param nb_threads number of extra threads to allocate. A negative value means all core used by session (eg nb_cores-1 extra threads)
@@ -239,7 +243,7 @@ When set, all sub-filters are exposed. This should only be set when inspecting f
 GF_FilterSession *gf_fs_new(s32 nb_threads, GF_FilterSchedulerType type, u32 flags, const char *blacklist);
 
 /*! Creates a new filter session, loading parameters from gpac config. This will also load all available filter registers not blacklisted.
-\param flags set of flags for the session. Only \ref GF_FS_FLAG_LOAD_META and  \ref GF_FS_FLAG_NO_MAIN_THREAD are used, other flags
+\param flags set of flags for the session. Only \ref GF_FS_FLAG_LOAD_META, \ref GF_FS_FLAG_NO_MAIN_THREAD and \ref GF_FS_FLAG_PROFILE are used, other flags
 \return the created filter session
 */
 GF_FilterSession *gf_fs_new_defaults(u32 flags);
@@ -305,6 +309,20 @@ GF_Err gf_fs_set_max_resolution_chain_length(GF_FilterSession *session, u32 max_
 */
 GF_Err gf_fs_set_max_sleep_time(GF_FilterSession *session, u32 max_sleep);
 
+/*! Sets the CPU affinity of the session threads. This must be called before running the session, and applies to all threads of the session including the thread calling \ref gf_fs_run.
+
+Using disjoint CPU sets for several sessions allows running isolated pipelines in a single process.
+
+In NUMA mode, threads are spread over the NUMA nodes of the CPU set and restricted to the CPUs of their node. In work-stealing mode (see \ref GF_FS_SCHEDULER_WORK_STEALING), threads only steal tasks from threads on the same node, so that a filter keeps running on the node of the thread which first processed it and packets it allocates stay local to that node.
+\param session filter session
+\param cpus list of CPU indexes the session threads may run on. If NULL, all CPUs are used
+\param nb_cpus number of CPUs in the list
+\param pin if GF_TRUE, each thread is pinned to a single CPU of the set, assigned in round-robin
+\param numa if GF_TRUE, enables NUMA mode
+\return error if any
+*/
+GF_Err gf_fs_set_cpu_affinity(GF_FilterSession *session, const u32 *cpus, u32 nb_cpus, Bool pin, Bool numa);
+
 /*! gets the maximum filter chain lengtG
 \param session filter session
 \return maximum chain length when resolving filter links.
@@ -438,6 +456,27 @@ void gf_fs_set_ui_callback(GF_FilterSession *session, Bool (*ui_event_proc)(void
 */
 void gf_fs_print_stats(GF_FilterSession *session);
 
+/*! Gets profiling information of the session as a JSON string. The session must have been created with \ref GF_FS_FLAG_PROFILE.
+
+The profile contains, for the session (filter-less tasks) and for each filter, one entry per task type (e.g. process, configure_pid) with latency histograms of:
+- exec: execution time of the task
+- wait: time spent in task lists once the task was ready for execution
+- sched: delay after the requested execution time, for tasks rescheduled by the filter
+
+Each filter also has the following histograms:
+- output_blocked: duration of blocking periods of its output PIDs
+- input_stall: duration of periods during which its input PIDs had no packet available
+
+Each histogram is given as count, sum, mean, max, 50/90/99/99.9 percentiles and list of [max_value, count] for non-empty buckets. All values are in microseconds, with a precision of 12.5%.
+
+This function can be called while the session is running, in which case values may be slightly inconsistent.
+\param session filter session
+\param reset if GF_TRUE, histograms are reset after being dumped
+
+\return JSON string to be freed by caller, or NULL if profiling is not enabled
+*/
+char *gf_fs_get_profile(GF_FilterSession *session, Bool reset);
+
 /*! Prints connections between loaded filters in the session to logs using \code LOG_APP@LOG_INFO \endcode
 \param session filter session
 */
@@ -598,6 +637,38 @@ typedef struct
 */
 GF_Err gf_fs_get_filter_stats(GF_FilterSession *session, u32 idx, GF_FilterStats *stats);
 
+/*! Packet payload memory statistics for a size class*/
+typedef struct
+{
+	/*!size of blocks in this class, 0 for payloads larger than the largest class*/
+	u32 block_size;
+	/*!number of blocks allocated, used or not*/
+	u32 nb_blocks;
+	/*!number of unused blocks kept for reuse*/
+	u32 nb_free;
+	/*!number of bytes allocated for this class*/
+	u64 bytes_reserved;
+	/*!number of bytes in blocks used by packets or by packet reservoirs of filters*/
+	u64 bytes_used;
+} GF_FilterPacketMemStats;
+
+/*! Gets packet payload memory statistics for a given size class. Payloads of allocated packets (see \ref gf_filter_pck_new_alloc) are rounded to a set of size classes, and unused blocks are shared between all filters of the session, up to the limit given by the `-pck-cap` option.
+
+The last class index gives statistics of payloads larger than the largest class, which are not kept once unused.
+\param session filter session
+\param idx index of size class to query
+\param stats statistics for the size class
+\return error code if any, GF_EOS if no more class, GF_NOT_SUPPORTED if size classes are disabled (`-no-reservoir` or `-pck-cap=0`)
+*/
+GF_Err gf_fs_get_packet_memory_stats(GF_FilterSession *session, u32 idx, GF_FilterPacketMemStats *stats);
+
+/*! Releases unused packet payload blocks of the session, largest blocks first. Blocks held by packet reservoirs of filters are not released.
+\param session filter session
+\param max_idle maximum number of bytes to keep in unused blocks after the call, 0 to release all unused blocks
+\return number of bytes released
+*/
+u64 gf_fs_trim_packet_memory(GF_FilterSession *session, u64 max_idle);
+
 
 /*! Enumerates filter and meta-filter arguments not matched in the session
 \param session filter session
@@ -2344,6 +2415,22 @@ immediately or after reschedule_ms.
 */
 GF_Err gf_filter_post_task(GF_Filter *filter, Bool (*task_execute) (GF_Filter *filter, void *callback, u32 *reschedule_ms), void *udta, const char *task_name);
 
+/*! Posts a task to the session scheduler which is not bound to the filter. Unlike \ref gf_filter_post_task, the task may be executed by any thread of the session, concurrently with the filter process function and with other tasks. The filter is responsible for synchronizing the task with its own state, and shall wait for all its posted tasks to complete before being destroyed.
+\param filter target filter
+\param task_execute the callback function for the task. The callback can return GF_TRUE to reschedule the task, in which case the task will be rescheduled
+immediately or after reschedule_ms.
+\param udta user data passed back to the task function
+\param task_name name of the task for logging purposes
+\return error code if failure
+*/
+GF_Err gf_filter_post_parallel_task(GF_Filter *filter, Bool (*task_execute) (GF_Filter *filter, void *callback, u32 *reschedule_ms), void *udta, const char *task_name);
+
+/*! Gets the number of extra threads used by the session of the filter
+\param filter target filter
+\return number of extra threads, 0 if the session only runs in the main thread
+*/
+u32 gf_filter_get_num_threads(GF_Filter *filter);
+
 
 /*! Sets callback function on source filter setup failure
 \param filter target filter
@@ -37,6 +37,7 @@ struct _gf_crypt_context
 {
 	GF_CRYPTO_ALGO algo; //single value for now
 	GF_CRYPTO_MODE mode; //CBC or CTR
+	GF_CRYPTO_ENGINE engine;
 
 	/* Internal context for openSSL or tiny AES*/
 	void *context;
@@ -50,12 +51,20 @@ struct _gf_crypt_context
 	GF_Err(*_decrypt) (GF_Crypt*, u8 *buffer, u32 size);
 	GF_Err(*_set_state) (GF_Crypt*, const u8 *IV, u32 IV_size);
 	GF_Err(*_get_state) (GF_Crypt*, u8 *IV, u32 *IV_size);
+	//optional pattern functions, NULL if not supported
+	GF_Err(*_crypt_pattern) (GF_Crypt *ctx, u8 *buffer, u32 size, u32 crypt_blocks, u32 skip_blocks);
+	GF_Err(*_decrypt_pattern) (GF_Crypt *ctx, u8 *buffer, u32 size, u32 crypt_blocks, u32 skip_blocks);
 };
 
 #ifdef GPAC_HAS_SSL
 GF_Err gf_crypt_open_open_openssl(GF_Crypt* td, GF_CRYPTO_MODE mode);
-#else
+#endif
 GF_Err gf_crypt_open_open_tinyaes(GF_Crypt* td, GF_CRYPTO_MODE mode);
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(GPAC_CONFIG_IOS)
+#define GPAC_HAS_AESNI
+Bool gf_crypt_aesni_supported();
+GF_Err gf_crypt_open_open_aesni(GF_Crypt* td, GF_CRYPTO_MODE mode);
 #endif
 
 
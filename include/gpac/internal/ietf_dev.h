@@ -127,6 +127,8 @@ struct __tag_rtp_channel
 	/*static buffer for RTP sending*/
 	u8 *send_buffer;
 	u32 send_buffer_size;
+	/*batched RTP sending over UDP, NULL if disabled*/
+	GF_SockBatch *send_batch;
 	u32 pck_sent_since_last_sr;
 	u32 last_pck_ts;
 	u32 last_pck_ntp_sec, last_pck_ntp_frac;
@@ -175,6 +177,10 @@ u32 gf_rtp_channel_time(GF_RTPChannel *ch);
 u32 gf_rtp_get_report_time();
 /*updates the time for the next report (SR, RR)*/
 void gf_rtp_get_next_report_time(GF_RTPChannel *ch);
+/*enables batched sending of RTP packets over UDP. Packets are sent when the batch is full or upon gf_rtp_flush_packets*/
+void gf_rtp_enable_send_batch(GF_RTPChannel *ch, u32 nb_packets);
+/*sends all RTP packets pending in the batch*/
+GF_Err gf_rtp_flush_packets(GF_RTPChannel *ch);
 
 
 /*
@@ -542,6 +542,8 @@ enum
 #define GF_ISOM_BS_COOKIE_VISUAL_TRACK	(1<<1)
 #define GF_ISOM_BS_COOKIE_QT_CONV		(1<<2)
 #define GF_ISOM_BS_COOKIE_CLONE_TRACK	(1<<3)
+/*sample tables (stts, stsz, stco, ...) are not parsed with their stbl but loaded on first track access*/
+#define GF_ISOM_BS_COOKIE_LAZY_TABLES	(1<<4)
 
 
 #ifndef GPAC_DISABLE_ISOM
@@ -642,6 +644,8 @@ GF_Err gf_isom_box_array_read(GF_Box *s, GF_BitStream *bs);
 GF_Err gf_isom_box_array_read_ex(GF_Box *parent, GF_BitStream *bs, u32 parent_type);
 
 GF_Err gf_isom_box_parse_ex(GF_Box **outBox, GF_BitStream *bs, u32 parent_type, Bool is_root_box);
+/*returns the size of the sample table box at the current bitstream position if it can be skipped for later loading, 0 otherwise*/
+u32 gf_isom_lazy_table_size(GF_BitStream *bs, u64 max_size);
 
 //writes box header - shall be called at the beginning of each xxxx_Write function
 //this function is not factorized in order to let box serializer modify box type before writing
@@ -923,6 +927,8 @@ typedef struct
 	u64 dts_at_seg_start;
 	u32 sample_count_at_seg_start;
 	Bool first_traf_merged;
+	/*decode time of the next fragment when indexing fragments without tfdt*/
+	u64 moof_index_next_dts;
 	Bool present_in_scalable_segment;
 	u32 current_traf_stsd_idx;
 
@@ -1101,6 +1107,51 @@ typedef struct
 	u32 sampleDelta;
 } GF_SttsEntry;
 
+/*sparse lookup index over run-length sample tables (stts, ctts, stsc), built on first seek for files opened in read mode*/
+typedef struct
+{
+	/*index of table entry*/
+	u32 entry_idx;
+	/*number of first sample in entry*/
+	u32 first_sample;
+	/*decode time of first sample in entry - stts only*/
+	u64 dts;
+} GF_StblIndexPoint;
+
+typedef struct
+{
+	GF_StblIndexPoint *points;
+	u32 nb_points;
+	/*number of table entries when index was built*/
+	u32 nb_entries;
+} GF_StblLookupIndex;
+
+/*default max number of index points per table, one point every N entries above this*/
+#define GF_ISOM_STBL_INDEX_MAX_POINTS	2048
+
+/*number of entries per block of a delta store, the first entry of each block is coded as an absolute value*/
+#define GF_ISOM_STBL_DELTA_BLOCK	64
+
+/*compact append-only store of sample sizes or chunk offsets, used while adding samples in write mode
+values are coded as zigzag varint deltas to the previous value, and expanded to the box table before any edit*/
+typedef struct
+{
+	u8 *data;
+	u32 size, alloc;
+	/*number of values in store*/
+	u32 nb_entries;
+	/*last appended value*/
+	u64 last_value;
+	/*byte offset in data of each block*/
+	u32 *blocks;
+	u32 nb_blocks, alloc_blocks;
+	/*read cache: index of next value to decode, its byte offset and the last decoded value*/
+	u32 rd_next, rd_pos;
+	u64 rd_value;
+} GF_StblDeltaStore;
+/*tables with less entries than this are not indexed*/
+#define GF_ISOM_STBL_INDEX_MIN_ENTRIES	64
+
 typedef struct
 {
 	GF_ISOM_FULL_BOX
@@ -1116,6 +1167,9 @@ typedef struct
 	u32 r_FirstSampleInEntry;
 	u32 r_currentEntryIndex;
 	u64 r_CurrentDTS;
+	/*lookup index for READ, and max number of index points (0 disables index)*/
+	GF_StblLookupIndex *r_index;
+	u32 r_index_max;
 
 	//stats for read
 	u32 max_ts_delta;
@@ -1143,6 +1197,9 @@ typedef struct
 	/*Cache for read*/
 	u32 r_currentEntryIndex;
 	u32 r_FirstSampleInEntry;
+	/*lookup index for read, and max number of index points (0 disables index)*/
+	GF_StblLookupIndex *r_index;
+	u32 r_index_max;
 
 	//stats for read
 	s32 max_ts_delta;
@@ -1850,6 +1907,8 @@ typedef struct
 	u32 sampleCount;
 	u32 alloc_size;
 	u32 *sizes;
+	/*sizes of last samples appended in write mode, sizes only holds the first sampleCount - w_deltas->nb_entries ones*/
+	GF_StblDeltaStore *w_deltas;
 	//stats for read
 	u32 max_size;
 	u64 total_size;
@@ -1862,6 +1921,8 @@ typedef struct
 	u32 nb_entries;
 	u32 alloc_size;
 	u32 *offsets;
+	/*offsets of last chunks appended in write mode, offsets only holds the first nb_entries - w_deltas->nb_entries ones*/
+	GF_StblDeltaStore *w_deltas;
 } GF_ChunkOffsetBox;
 
 typedef struct
@@ -1870,6 +1931,8 @@ typedef struct
 	u32 nb_entries;
 	u32 alloc_size;
 	u64 *offsets;
+	/*offsets of last chunks appended in write mode, offsets only holds the first nb_entries - w_deltas->nb_entries ones*/
+	GF_StblDeltaStore *w_deltas;
 } GF_ChunkLargeOffsetBox;
 
 typedef struct
@@ -1893,6 +1956,9 @@ typedef struct
 	u32 firstSampleInCurrentChunk;
 	u32 currentChunk;
 	u32 ghostNumber;
+	/*lookup index for READ, and max number of index points (0 disables index)*/
+	GF_StblLookupIndex *r_index;
+	u32 r_index_max;
 
 	u32 w_lastSampleNumber;
 	u32 w_lastChunkNumber;
@@ -2036,6 +2102,14 @@ typedef struct
 	GF_TrafMapEntry *frag_starts;
 } GF_TrafToSampleMap;
 
+/*position and start time of a movie fragment, used for seeking in fragment window mode*/
+typedef struct
+{
+	u64 moof_offset;
+	/*earliest decode time of the fragment in movie timescale*/
+	u64 time;
+} GF_MoofIndexEntry;
+
 typedef struct
 {
 	GF_ISOM_BOX
@@ -2075,6 +2149,13 @@ typedef struct
 
 	u32 r_last_chunk_num, r_last_sample_num, r_last_offset_in_chunk;
 	u8 patch_piff_psec;
+
+	/*payload range of the stbl in the file when sample tables are loaded on demand, lazy_size is 0 once loaded*/
+	u64 lazy_start, lazy_size;
+	/*sample count and constant sample size read from the stsz/stz2 header while tables are not loaded*/
+	u32 lazy_sample_count, lazy_sample_size;
+	/*same for stss: 0 if absent, 1 if it has entries, 2 if empty*/
+	u8 lazy_sync_state;
 } GF_SampleTableBox;
 
 GF_Err stbl_AppendTrafMap(GF_SampleTableBox *stbl, Bool is_seg_start, u64 seg_start_offset, u64 frag_start_offset, u8 *moof_template, u32 moof_template_size, u64 sidx_start, u64 sidx_end);
@@ -2088,6 +2169,8 @@ typedef struct __tag_media_info_box
 	struct __tag_data_map *scalableDataHandler;
 	struct __tag_data_map *dataHandler;
 	u32 dataEntryIndex;
+	/*last chunk for which access hints were sent to the file mapping, 0 if none*/
+	u32 mmap_hint_chunk;
 } GF_MediaInformationBox;
 
 GF_Err stbl_SetDependencyType(GF_SampleTableBox *stbl, u32 sampleNumber, u32 isLeading, u32 dependsOn, u32 dependedOn, u32 redundant);
@@ -3861,6 +3944,8 @@ typedef struct
 
 /*regular file IO*/
 #define GF_ISOM_DATA_FILE         0x01
+/*File Mapping object, read-only mode on complete files (no download)*/
+#define GF_ISOM_DATA_FILE_MAPPING 0x02
 /*External file object. Needs implementation*/
 #define GF_ISOM_DATA_FILE_EXTERN  0x03
 /*regular memory IO*/
@@ -3930,6 +4015,15 @@ GF_DataMap *gf_isom_fdm_new(const char *sPath, u8 mode);
 void gf_isom_fdm_del(GF_FileDataMap *ptr);
 u32 gf_isom_fdm_get_data(GF_FileDataMap *ptr, u8 *buffer, u32 bufferLength, u64 fileOffset);
 
+/*File mapping data map - returns NULL if file mapping is not supported on the platform*/
+GF_DataMap *gf_isom_fmo_new(const char *sPath, u8 mode);
+void gf_isom_fmo_del(GF_FileMappingDataMap *ptr);
+u32 gf_isom_fmo_get_data(GF_FileMappingDataMap *ptr, u8 *buffer, u32 bufferLength, u64 fileOffset);
+/*returns a pointer to the mapped data at the given offset, or NULL if out of range or not a file mapping*/
+const u8 *gf_isom_datamap_get_mapped_data(GF_DataMap *map, u64 offset, u32 size);
+/*hints the file mapping that the given range will be accessed soon - no-op for other data maps*/
+void gf_isom_datamap_will_need(GF_DataMap *map, u64 offset, u64 size);
+
 #ifndef GPAC_DISABLE_ISOM_WRITE
 GF_DataMap *gf_isom_fdm_new_temp(const char *sTempPath);
 #endif
@@ -3985,6 +4079,8 @@ struct __tag_isom {
 	to make easily parsable files (note there could be some data (mdat) before
 	the moov*/
 	GF_DataMap *movieFileMap;
+	/*read-only file mapping of the movie file used for sample data access, NULL if not enabled*/
+	GF_DataMap *mappedFileMap;
 
 #ifndef GPAC_DISABLE_ISOM_WRITE
 	/*the final file name*/
@@ -4076,6 +4172,19 @@ struct __tag_isom {
 	GF_SegmentIndexBox *main_sidx;
 	u64 main_sidx_end_pos;
 
+	/*max number of movie fragments merged per parsing call, 0 means no limit*/
+	u32 frag_window;
+	u32 frag_window_nb_moof;
+	/*set when parsing stopped on a full fragment window, or after a seek*/
+	Bool frag_window_pending;
+	/*fragments seen in fragment window mode, in file order*/
+	GF_MoofIndexEntry *moof_index;
+	u32 nb_moof_index, alloc_moof_index;
+	/*decode time of each track at each indexed fragment, in media timescale*/
+	u64 *moof_index_dts;
+	/*state of each track at each indexed fragment: 0 not present, 1 present, 2 present and starting with a sync sample*/
+	u8 *moof_index_track_flags;
+
 	Bool has_pssh_moof;
 #endif
 	GF_ProducerReferenceTimeBox *last_producer_ref_time;
@@ -4102,6 +4211,8 @@ struct __tag_isom {
 
 	Bool no_inplace_rewrite;
 	u32 padding;
+	//space reserved for moov before mdat in capture mode (fast start)
+	u32 moov_reserve;
 	u64 original_moov_offset, original_meta_offset, first_data_toplevel_offset, first_data_toplevel_size;
 };
 
@@ -4113,10 +4224,20 @@ GF_Err gf_isom_parse_movie_boxes(GF_ISOFile *mov, u32 *boxType, u64 *bytesMissin
 GF_ISOFile *gf_isom_new_movie();
 /*Movie and Track access functions*/
 GF_TrackBox *gf_isom_get_track_from_file(GF_ISOFile *the_file, u32 trackNumber);
+/*same as gf_isom_get_track_from_file but does not load sample tables, for track-level information (header, handler, sample descriptions, references)*/
+GF_TrackBox *gf_isom_get_track_from_file_no_tables(GF_ISOFile *the_file, u32 trackNumber);
 GF_TrackBox *gf_isom_get_track(GF_MovieBox *moov, u32 trackNumber);
 GF_TrackBox *gf_isom_get_track_from_id(GF_MovieBox *moov, GF_ISOTrackID trackID);
 GF_TrackBox *gf_isom_get_track_from_original_id(GF_MovieBox *moov, u32 originalID, u32 originalFile);
 u32 gf_isom_get_tracknum_from_id(GF_MovieBox *moov, GF_ISOTrackID trackID);
+/*loads sample tables of a track skipped at parse time, if any*/
+GF_Err gf_isom_load_track_tables(GF_TrackBox *trak);
+/*returns the sample table of the track if its tables are not loaded yet, NULL otherwise*/
+GF_SampleTableBox *gf_isom_get_lazy_stbl(GF_TrackBox *trak);
+/*loads sample tables of all tracks skipped at parse time, if any*/
+void gf_isom_load_all_track_tables(GF_ISOFile *mov);
+/*enables on-demand loading of sample tables if requested and possible for this file*/
+void gf_isom_check_lazy_tables(GF_ISOFile *mov);
 /*open a movie*/
 GF_ISOFile *gf_isom_open_file(const char *fileName, GF_ISOOpenMode OpenMode, const char *tmp_dir);
 /*close and delete a movie*/
@@ -4166,6 +4287,11 @@ useCTS specifies that we're looking for a composition time
 GF_Err stbl_findEntryForTime(GF_SampleTableBox *stbl, u64 DTS, u8 useCTS, u32 *sampleNumber, u32 *prevSampleNumber);
 /*Reading of the sample tables*/
 GF_Err stbl_GetSampleSize(GF_SampleSizeBox *stsz, u32 SampleNumber, u32 *Size);
+/*gets the offset of the given chunk in a stco or co64 box*/
+GF_Err stbl_GetChunkOffset(GF_Box *stco, u32 chunkNumber, u64 *offset);
+/*gets the value at the given 0-based index of a delta store*/
+u64 stbl_DeltaStoreGet(GF_StblDeltaStore *ds, u32 idx);
+void stbl_DeltaStoreDel(GF_StblDeltaStore *ds);
 GF_Err stbl_GetSampleCTS(GF_CompositionOffsetBox *ctts, u32 SampleNumber, s32 *CTSoffset);
 GF_Err stbl_GetSampleDTS(GF_TimeToSampleBox *stts, u32 SampleNumber, u64 *DTS);
 GF_Err stbl_GetSampleDTS_and_Duration(GF_TimeToSampleBox *stts, u32 SampleNumber, u64 *DTS, u32 *duration);
@@ -4175,6 +4301,9 @@ GF_Err stbl_GetSampleRAP(GF_SyncSampleBox *stss, u32 SampleNumber, GF_ISOSAPType
 /*same as above but only look for open-gop RAPs and GDR (roll)*/
 GF_Err stbl_SearchSAPs(GF_SampleTableBox *stbl, u32 SampleNumber, GF_ISOSAPType *IsRAP, u32 *prevRAP, u32 *nextRAP);
 GF_Err stbl_GetSampleInfos(GF_SampleTableBox *stbl, u32 sampleNumber, u64 *offset, u32 *chunkNumber, u32 *descIndex, GF_StscEntry **scsc_entry);
+/*sets max number of lookup index points for stts, ctts and stsc (0 disables indexing) and drops existing indexes*/
+void stbl_set_lookup_index(GF_SampleTableBox *stbl, u32 max_points);
+void stbl_lookup_index_del(GF_StblLookupIndex *index);
 GF_Err stbl_GetSampleShadow(GF_ShadowSyncBox *stsh, u32 *sampleNumber, u32 *syncNum);
 GF_Err stbl_GetPaddingBits(GF_PaddingBitsBox *padb, u32 SampleNumber, u8 *PadBits);
 GF_Err stbl_GetSampleDepType(GF_SampleDependencyTypeBox *stbl, u32 SampleNumber, u32 *isLeading, u32 *dependsOn, u32 *dependedOn, u32 *redundant);
@@ -4220,6 +4349,11 @@ GF_Err stbl_AddSize(GF_SampleSizeBox *stsz, u32 sampleNumber, u32 size, u32 nb_p
 GF_Err stbl_AddRAP(GF_SyncSampleBox *stss, u32 sampleNumber);
 GF_Err stbl_AddShadow(GF_ShadowSyncBox *stsh, u32 sampleNumber, u32 shadowNumber);
 GF_Err stbl_AddChunkOffset(GF_MediaBox *mdia, u32 sampleNumber, u32 StreamDescIndex, u64 offset, u32 nb_pack_samples);
+/*delta store for sizes and chunk offsets appended in write mode*/
+GF_Err stbl_DeltaStoreAppend(GF_StblDeltaStore **ds, u64 value);
+/*moves values of the delta stores back to the box tables, must be called before editing the tables*/
+GF_Err stbl_ExpandSizes(GF_SampleSizeBox *stsz);
+GF_Err stbl_ExpandChunkOffsets(GF_Box *stco);
 /*NB - no add for padding, this is done only through SetPaddingBits*/
 
 GF_Err stbl_AddSampleFragment(GF_SampleTableBox *stbl, u32 sampleNumber, u16 size);
@@ -4651,6 +4785,9 @@ GF_Box *boxstring_new_with_data(u32 type, const char *string, GF_List **parent);
 GF_Err gf_isom_read_null_terminated_string(GF_Box *s, GF_BitStream *bs, u64 size, char **out_str);
 
 GF_Err MergeTrack(GF_TrackBox *trak, GF_TrackFragmentBox *traf, GF_MovieFragmentBox *moof, u64 moof_offset, s32 compresed_diff, u64 *cumulated_offset, Bool is_first_merge);
+#ifndef GPAC_DISABLE_ISOM_FRAGMENTS
+void gf_isom_push_moof_index(GF_ISOFile *mov, GF_MovieFragmentBox *moof, u64 moof_offset);
+#endif
 
 
 #endif //GPAC_DISABLE_ISOM
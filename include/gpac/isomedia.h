@@ -762,6 +762,22 @@ If the movie is successfully loaded (isom_file non-NULL), BytesMissing is zero
 */
 GF_Err gf_isom_open_progressive_ex(const char *fileName, u64 start_range, u64 end_range, Bool enable_frag_templates, GF_ISOFile **isom_file, u64 *BytesMissing, u32 *topBoxType);
 
+/*! same as \ref gf_isom_open_progressive but limits the number of movie fragments merged in the sample tables at each parsing call
+
+Parsing stops once nb_moofs movie fragments have been merged; the next fragments are loaded by calling \ref gf_isom_refresh_fragmented. Combined with \ref gf_isom_reset_track_tables, this keeps the memory footprint bounded when reading long fragmented files.
+The window is ignored if the file is not fragmented or if some samples are described in the movie box.
+
+\param fileName the name of the local file or cache to open
+\param start_range only loads starting from indicated byte range
+\param end_range loading stops at indicated byte range
+\param enable_frag_templates loads fragment and segment boundaries in an internal table
+\param nb_moofs maximum number of movie fragments merged at each parsing call, 0 means no limit
+\param isom_file pointer set to the opened file if success
+\param BytesMissing is set to the predicted number of bytes missing for the file to be loaded
+\return error if any
+*/
+GF_Err gf_isom_open_progressive_window(const char *fileName, u64 start_range, u64 end_range, Bool enable_frag_templates, u32 nb_moofs, GF_ISOFile **isom_file, u64 *BytesMissing);
+
 /*! retrieves number of bytes missing.
 if requesting a sample fails with error GF_ISOM_INCOMPLETE_FILE, use this function
 to get the number of bytes missing to retrieve the sample
@@ -963,6 +979,12 @@ GF_Err gf_isom_get_data_reference(GF_ISOFile *isom_file, u32 trackNumber, u32 sa
 \return the number of samples, or 0 if error*/
 u32 gf_isom_get_sample_count(GF_ISOFile *isom_file, u32 trackNumber);
 
+/*! checks if the sample tables of a track are loaded. Tables may be loaded on first access when the core option `-lazy-stbl` is set; sample count, constant sample size and durations are available without loading them
+\param isom_file the target ISO file
+\param trackNumber the target track
+\return GF_TRUE if sample tables are loaded, GF_FALSE otherwise*/
+Bool gf_isom_has_sample_tables_loaded(GF_ISOFile *isom_file, u32 trackNumber);
+
 /*! gets the constant sample size for samples of a track
 \param isom_file the target ISO file
 \param trackNumber the target track
@@ -1051,6 +1073,23 @@ GF_ISOSample *gf_isom_get_sample_info(GF_ISOFile *isom_file, u32 trackNumber, u3
 */
 GF_ISOSample *gf_isom_get_sample_info_ex(GF_ISOFile *isom_file, u32 trackNumber, u32 sampleNumber, u32 *sampleDescriptionIndex, u64 *data_offset, GF_ISOSample *static_sample);
 
+/*! enables or disables read-only memory mapping of the file for sample data access. This is only supported for complete, non-fragmented local files opened in read mode, on platforms supporting file mapping
+\param isom_file the target ISO file
+\param use_mapping if GF_TRUE, sample data is read from a memory mapping of the file; otherwise regular file IO is used
+\return error if any, GF_NOT_SUPPORTED if file mapping cannot be used for this file
+*/
+GF_Err gf_isom_set_file_mapping(GF_ISOFile *isom_file, Bool use_mapping);
+
+/*! gets a read-only pointer to sample data in the file mapping, without copying it. The pointer is valid until the file is closed or file mapping is disabled
+\param isom_file the target ISO file
+\param trackNumber the target track
+\param sampleDescriptionIndex the sample description index of the sample, as returned by \ref gf_isom_get_sample_info_ex
+\param data_offset the sample start offset in file, as returned by \ref gf_isom_get_sample_info_ex
+\param data_size the size of the sample data
+\return the sample data or NULL if file mapping is not enabled, if the sample is not in the movie file or if its payload is rewritten by the library when fetched (NAL-based media, OD, streaming text conversion, padding)
+*/
+const u8 *gf_isom_get_sample_mapped_data(GF_ISOFile *isom_file, u32 trackNumber, u32 sampleDescriptionIndex, u64 data_offset, u32 data_size);
+
 /*! get sample decoding time
 \param isom_file the target ISO file
 \param trackNumber the target track
@@ -1321,6 +1360,13 @@ for the current time
 \return estimated file size in bytes*/
 u64 gf_isom_estimate_size(GF_ISOFile *isom_file);
 
+/*! gets an estimation of the moov box size once a given number of samples are added to each track, typically used with \ref gf_isom_set_moov_reserve
+The estimation assumes one chunk per sample and one entry per sample in each sample table, plus a safety margin. Per-sample auxiliary data (sample groups, encryption info, ...) is not accounted for.
+\param isom_file the target ISO file
+\param nb_samples array of expected total sample count for each track, in track order. If NULL, only the current state of the file is used
+\return estimated moov size in bytes, 0 if error*/
+u64 gf_isom_estimate_moov_size(GF_ISOFile *isom_file, const u32 *nb_samples);
+
 /*! gets next alternate group ID available
 \param isom_file the target ISO file
 \return next available ID for alternate groups
@@ -2027,6 +2073,17 @@ GF_Err gf_isom_set_final_name(GF_ISOFile *isom_file, char *filename);
 */
 GF_Err gf_isom_set_storage_mode(GF_ISOFile *isom_file, GF_ISOStorageMode storage_mode);
 
+/*! reserves space for the moov box before the media data when writing samples as they arrive (\ref GF_ISOM_STORE_FASTSTART or \ref GF_ISOM_STORE_STREAMABLE in \ref GF_ISOM_OPEN_WRITE mode)
+
+By default, the moov box is inserted before the media data when closing the file, which requires moving the entire media data. When space is reserved, a free box of the given size is written before the media data. If the final moov box fits in this space, it is written in place of the free box and the remaining space (if any) is kept as a free box. Otherwise, the moov box is inserted as usual.
+
+This must be called before adding the first sample.
+\param isom_file the target ISO file
+\param size amount of bytes to reserve, 0 disables reservation
+\return error if any
+*/
+GF_Err gf_isom_set_moov_reserve(GF_ISOFile *isom_file, u32 size);
+
 /*! sets the interleaving time of media data (INTERLEAVED mode only)
 \param isom_file the target ISO file
 \param InterleaveTime the target interleaving time in movie timescale
@@ -3328,6 +3385,21 @@ typedef enum
 \return error if any
 */
 GF_Err gf_isom_set_nalu_extract_mode(GF_ISOFile *isom_file, u32 trackNumber, GF_ISONaluExtractMode nalu_extract_mode);
+
+/*! configures the sample table lookup index of a track. The index is a sparse prefix-sum over time-to-sample, composition offset and sample-to-chunk tables, built on the first seek in the track and used for sample time and offset lookup in logarithmic time. It is enabled by default for files opened in read mode, and is not used on tables being edited.
+\param isom_file the target ISO file
+\param trackNumber the target track, or 0 for all tracks
+\param max_points maximum number of index points per table, bounding the index memory; 0 disables the index
+\return error if any
+*/
+GF_Err gf_isom_set_sample_lookup_index(GF_ISOFile *isom_file, u32 trackNumber, u32 max_points);
+
+/*! releases the sample table lookup index of a track, for example under memory pressure. The index is rebuilt on the next seek unless disabled through \ref gf_isom_set_sample_lookup_index
+\param isom_file the target ISO file
+\param trackNumber the target track, or 0 for all tracks
+\return error if any
+*/
+GF_Err gf_isom_drop_sample_lookup_index(GF_ISOFile *isom_file, u32 trackNumber);
 /*! gets the NALU extraction mode for this track
 \param isom_file the target ISO file
 \param trackNumber the target track
@@ -4024,6 +4096,27 @@ Bool gf_isom_sample_is_fragment_start(GF_ISOFile *isom_file, u32 trackNumber, u3
 */
 GF_Err gf_isom_reset_tables(GF_ISOFile *isom_file, Bool reset_sample_count);
 
+/*! resets sample information of a track while keeping sample numbering and timing of the next samples unchanged. This is typically used once all samples of a track loaded so far have been consumed
+\param isom_file the target ISO file
+\param trackNumber the target track
+\return error if any
+*/
+GF_Err gf_isom_reset_track_tables(GF_ISOFile *isom_file, u32 trackNumber);
+
+/*! checks if parsing stopped because the fragment window of a file opened with \ref gf_isom_open_progressive_window is full. Next fragments are loaded by calling \ref gf_isom_refresh_fragmented
+\param isom_file the target ISO file
+\return GF_TRUE if more fragments can be loaded, GF_FALSE otherwise
+*/
+Bool gf_isom_fragment_window_pending(GF_ISOFile *isom_file);
+
+/*! moves parsing of a file opened with \ref gf_isom_open_progressive_window to the last movie fragment from which all tracks start with a sync sample at or before the given time. Sample tables of all tracks are reset, and fragments are loaded from this position at the next call to \ref gf_isom_refresh_fragmented.
+The fragment is located using the segment index of the file if any, or using the fragments parsed so far completed by a scan of the top-level boxes.
+\param isom_file the target ISO file
+\param start_time the target time in seconds
+\return error if any
+*/
+GF_Err gf_isom_seek_fragment_window(GF_ISOFile *isom_file, Double start_time);
+
 /*! sets the offset for parsing from the input buffer to 0 (used to reclaim input buffer)
 \param isom_file the target ISO file
 \param top_box_start set to the byte offset in the source buffer of the first top level box
@@ -146,6 +146,12 @@ typedef struct
 {
 	/*! list of entries*/
 	GF_List *entries;
+	/*! internal, serialization cache of entries for live manifest updates*/
+	void *serialize_cache;
+	/*! if set, the owner of the timeline sets modified whenever entries are added, removed or changed, so that unchanged entries are serialized without being checked*/
+	Bool track_changes;
+	/*! entries were modified since the timeline was last serialized, only used if track_changes is set*/
+	Bool modified;
 } GF_MPD_SegmentTimeline;
 
 /*! Byte range info*/
@@ -637,6 +643,8 @@ typedef struct {
 	char *m3u8_var_name;
 	/*! temp file for m3u8 generation*/
 	FILE *m3u8_var_file;
+	/*! internal, serialization cache of segment entries for m3u8 generation*/
+	void *m3u8_var_cache;
 
 	/*! for m3u8: 0: not encrypted, 1: full segment, 2: CENC*/
 	u8 crypto_type;
@@ -873,6 +881,9 @@ typedef struct {
 	Bool m3u8_time;
 	/*! indicates  LL-HLS forced generation. 0: regular write, 1: write as byterange, 2: write as independent files*/
 	u32 force_llhls_mode;
+
+	/*! segment timelines decoded while streaming the manifest, pending attachment to their SegmentTemplate or SegmentList - GPAC internal*/
+	GF_List *sax_timelines;
 } GF_MPD;
 
 /*! parses an MPD Element (and subtree) from DOM
@@ -889,6 +900,13 @@ GF_Err gf_mpd_init_from_dom(GF_XMLNode *root, GF_MPD *mpd, const char *base_url)
 \return error if any
 */
 GF_Err gf_mpd_complete_from_dom(GF_XMLNode *root, GF_MPD *mpd, const char *base_url);
+/*! parses an MPD file using a SAX parser, without loading the complete document tree. Each Period is converted as soon as it is closed and its XML tree is discarded, and SegmentTimeline entries are decoded without creating XML nodes. This is the preferred way to load large (live) manifests
+\param file the MPD file to parse
+\param mpd MPD structure to fill
+\param base_url base URL of the document
+\return error if any
+*/
+GF_Err gf_mpd_init_from_file(const char *file, GF_MPD *mpd, const char *base_url);
 /*! MPD constructor
 \return a new MPD*/
 GF_MPD *gf_mpd_new();
@@ -874,6 +874,15 @@ typedef struct tag_m2ts_pes
 	Bool temi_pending;
 	/*! flag set to indicate the last PES packet was not flushed (HLS) to avoid warning on same PTS/DTS used*/
 	Bool is_resume;
+
+	/*! number of the last TS packet processed by the PES reassembler*/
+	u32 pck_number;
+	/*! TS packets pending for PES reassembly in deferred mode*/
+	struct __m2ts_pes_batch_item *batch;
+	/*! number of TS packets pending for PES reassembly in deferred mode*/
+	u32 batch_count;
+	/*! number of allocated pending TS packets*/
+	u32 batch_alloc;
 } GF_M2TS_PES;
 
 /*! reserved streamID for PES headers*/
@@ -1131,6 +1140,11 @@ struct tag_m2ts_demux
 	if set, on_event shall be non-null
 	*/
 	Bool split_mode;
+
+	/*! if set, PES reassembly and reframing is deferred until \ref gf_m2ts_process_deferred_pes is called, except for MPEG-4 SL streams*/
+	Bool deferred_pes;
+	/*! list of streams with pending TS packets in deferred mode*/
+	GF_List *deferred;
 };
 
 //! @endcond
@@ -1198,6 +1212,19 @@ void gf_m2ts_flush_pes(GF_M2TS_Demuxer *demux, GF_M2TS_PES *pes, Bool force_flus
 */
 void gf_m2ts_flush_all(GF_M2TS_Demuxer *demux, Bool no_force_flush);
 
+/*! gets the next stream with TS packets pending for PES reassembly in deferred mode
+\param demux the target MPEG-2 demultiplexer
+\return the next stream to process, or NULL if no more pending streams
+*/
+GF_M2TS_PES *gf_m2ts_pop_deferred_pes(GF_M2TS_Demuxer *demux);
+
+/*! processes all TS packets pending for PES reassembly in deferred mode, sending the resulting PES events to the user callback.
+This function may be called from any thread, but shall not be called concurrently for the same stream, nor while the demultiplexer is processing data (\ref gf_m2ts_process_data) or being flushed
+\param demux the target MPEG-2 demultiplexer
+\param pes the target stream
+*/
+void gf_m2ts_process_deferred_pes(GF_M2TS_Demuxer *demux, GF_M2TS_PES *pes);
+
 
 /*! MPEG-2 TS packet header*/
 typedef struct
@@ -1292,6 +1319,8 @@ enum
 	GF_ESI_INPUT_DATA_PULL,
 	/*! releases the currently pulled AU from the stream - AU cannot be pulled after that, unless seek happens
 		corresponding parameter: unused
+		For streams not in pull mode, releases the payload of an AU dispatched with GF_ESI_DATA_NO_COPY flag, in dispatch order
+		corresponding parameter: payload of the AU
 	*/
 	GF_ESI_INPUT_DATA_RELEASE,
 
@@ -1321,6 +1350,8 @@ enum
 	GF_ESI_DATA_HAS_DTS		=	1<<3,
 	/*! packet contains a carousel repeated AU*/
 	GF_ESI_DATA_REPEAT		=	1<<4,
+	/*! packet payload is not copied by the muxer and shall remain valid until released through GF_ESI_INPUT_DATA_RELEASE*/
+	GF_ESI_DATA_NO_COPY		=	1<<5,
 };
 
 /*! stream interface for MPEG-2 TS muxer*/
@@ -1589,6 +1620,8 @@ typedef struct __m2ts_mux_stream {
 	Bool force_new;
 	/*! flag set to indicate packet data shall be freed (rewrite of source packet)*/
 	Bool discard_data;
+	/*! payload of current packet dispatched without copy, released once the packet is sent*/
+	u8 *ref_data;
 	/*! flags of next packet*/
 	u16 next_pck_flags;
 	/*! SAP type of next packet*/
@@ -414,6 +414,8 @@ GF_Err gf_sk_bind(GF_Socket *sock, const char *local_ip, u16 port, const char *p
 \brief connects a socket
 
 Connects a socket to a remote peer on a given port
+
+For TCP sockets in non-blocking mode (see \ref gf_sk_set_block_mode), GF_IP_SOCK_WOULD_BLOCK is returned while the connection is being established. The function shall then be called again with the same parameters once the socket can be written to (see \ref gf_sk_group_sock_set_mode), until it returns GF_OK or an error.
 \param sock the socket object
 \param peer_name the remote server address (IP or DNS)
 \param port remote port number to connect the socket to
@@ -432,6 +434,18 @@ Sends a buffer on the socket. The socket must be in a bound or connected mode
  */
 GF_Err gf_sk_send(GF_Socket *sock, const u8 *buffer, u32 length);
 /*!
+\brief file data emission
+
+Sends a portion of a file on a connected TCP socket without copying the data in user space (sendfile). This is only supported on Linux for native files (not for memory or custom IO files)
+\param sock the socket object
+\param file the file to send data from. The file position is not modified
+\param offset the offset in the file of the first byte to send
+\param length the number of bytes to send
+\param written set to the number of bytes actually sent, may be less than length
+\return error if any, GF_NOT_SUPPORTED if zero-copy transfer is not available for this socket or file
+ */
+GF_Err gf_sk_send_file(GF_Socket *sock, FILE *file, u64 offset, u32 length, u32 *written);
+/*!
 \brief data reception
 
 Fetches data on a socket. The socket must be in a bound or connected state
@@ -623,6 +637,90 @@ Checks if socket can is ready for read or write
  */
 GF_Err gf_sk_select(GF_Socket *sock, GF_SockSelectMode mode);
 
+/*! batch of datagrams, used to receive or send several datagrams in a single system call*/
+typedef struct __tag_sock_batch GF_SockBatch;
+
+/*!
+Creates a new datagram batch. The batch owns a ring of fixed-size datagram slots reused for each receive or send call
+\param nb_slots maximum number of datagrams per system call
+\param slot_size maximum size of a datagram. Received datagrams larger than this size are truncated and counted as drops
+\return new batch object, or NULL if error
+ */
+GF_SockBatch *gf_sk_batch_new(u32 nb_slots, u32 slot_size);
+/*!
+Deletes a datagram batch
+\param batch the batch object
+ */
+void gf_sk_batch_del(GF_SockBatch *batch);
+
+/*!
+Fetches as many pending datagrams as possible on a UDP socket without performing any select (wait). This uses recvmmsg when available, and falls back otherwise to \ref gf_sk_receive_no_select for the first datagram, followed by reads of datagrams already queued on the socket, if any. Previous content of the batch is discarded
+\param sock the socket object
+\param batch the batch object receiving the datagrams
+\param nb_datagrams set to the number of datagrams received
+\return error if any, GF_IP_NETWORK_EMPTY if nothing to read
+ */
+GF_Err gf_sk_receive_batch(GF_Socket *sock, GF_SockBatch *batch, u32 *nb_datagrams);
+/*!
+Gets a datagram received in a batch
+\param batch the batch object
+\param idx 0-based index of the datagram
+\param size set to the size of the datagram
+\return datagram data, or NULL if no such datagram
+ */
+u8 *gf_sk_batch_get(GF_SockBatch *batch, u32 idx, u32 *size);
+
+/*!
+Gets the next free slot of a batch for emission. The datagram is queued by calling \ref gf_sk_batch_commit once written
+\param batch the batch object
+\param max_size set to the maximum size of the datagram
+\return slot data to write to, or NULL if the batch is full
+ */
+u8 *gf_sk_batch_reserve(GF_SockBatch *batch, u32 *max_size);
+/*!
+Queues the datagram written in the slot returned by the last call to \ref gf_sk_batch_reserve
+\param batch the batch object
+\param size size of the datagram
+\return error if any
+ */
+GF_Err gf_sk_batch_commit(GF_SockBatch *batch, u32 size);
+/*!
+Copies and queues a datagram in a batch for emission
+\param batch the batch object
+\param data the datagram data
+\param size the datagram size
+\return error if any, GF_BUFFER_TOO_SMALL if the batch is full or the datagram larger than the slot size
+ */
+GF_Err gf_sk_batch_add(GF_SockBatch *batch, const u8 *data, u32 size);
+/*!
+Gets the number of datagrams queued for emission in a batch
+\param batch the batch object
+\return number of queued datagrams
+ */
+u32 gf_sk_batch_pending(GF_SockBatch *batch);
+/*!
+Discards all datagrams of a batch
+\param batch the batch object
+ */
+void gf_sk_batch_reset(GF_SockBatch *batch);
+/*!
+Sends all datagrams queued in a batch on a UDP socket. This uses sendmmsg when available, and falls back to one \ref gf_sk_send per datagram otherwise. Datagrams not sent because the socket would block are kept in the batch for the next call; datagrams failing with any other error are discarded and counted as drops
+\param sock the socket object
+\param batch the batch object
+\return error if any, GF_IP_SOCK_WOULD_BLOCK or GF_BUFFER_TOO_SMALL if some datagrams are still pending
+ */
+GF_Err gf_sk_send_batch(GF_Socket *sock, GF_SockBatch *batch);
+
+/*!
+Gets batched datagram I/O statistics of a socket. The average batch fill ratio is nb_datagrams / nb_slots
+\param sock the socket object
+\param nb_calls set to the number of batched receive or send calls having moved at least one datagram - may be NULL
+\param nb_datagrams set to the number of datagrams moved by these calls - may be NULL
+\param nb_slots set to the number of datagram slots offered to these calls - may be NULL
+\param nb_drops set to the number of datagrams dropped: kernel receive queue overflows and truncated datagrams in reception, discarded datagrams in emission - may be NULL
+ */
+void gf_sk_get_batch_stats(GF_Socket *sock, u64 *nb_calls, u64 *nb_datagrams, u64 *nb_slots, u64 *nb_drops);
+
 /*! @} */
 
 /*!
@@ -642,7 +740,7 @@ Deletes a socket group
  */
 void gf_sk_group_del(GF_SockGroup *sg);
 /*!
-Registers a socket to a socket group
+Registers a socket to a socket group. Sockets may be registered and unregistered while another thread is blocked in \ref gf_sk_group_select
 \param sg socket group object
 \param sk socket object to register
  */
@@ -663,6 +761,24 @@ Performs a select (wait) on the socket group
  */
 GF_Err gf_sk_group_select(GF_SockGroup *sg, u32 wait_usec, GF_SockSelectMode mode);
 
+/*!
+Pauses or resumes monitoring of a socket registered in a socket group. A paused socket stays registered but is not reported by \ref gf_sk_group_select until resumed.
+The monitoring state is stored in the socket, so a socket using this function shall only be registered in a single group.
+This may be called while another thread is blocked in \ref gf_sk_group_select, the change then applies to that wait
+\param sg socket group object
+\param sk socket object
+\param paused if GF_TRUE, the socket is no longer monitored
+\param mode the operation mode to monitor for this socket, overriding the mode passed to \ref gf_sk_group_select - ignored if paused
+ */
+void gf_sk_group_sock_set_mode(GF_SockGroup *sg, GF_Socket *sk, Bool paused, GF_SockSelectMode mode);
+
+/*!
+Wakes up a thread blocked in \ref gf_sk_group_select on this group, or the next call to \ref gf_sk_group_select if no thread is currently waiting. This may be called from any thread
+\param sg socket group object
+\return error if any, GF_NOT_SUPPORTED if the platform has no wake-up mechanism for socket groups
+ */
+GF_Err gf_sk_group_notify(GF_SockGroup *sg);
+
 /*!
 Checks if given socket is selected and can be read. This shall be called after gf_sk_group_select
 \param sg socket group object
@@ -222,6 +222,36 @@ Sets the thread execution priority level.
 \note this should be used with caution, especially use of real-time priorities.
  */
 void gf_th_set_priority(GF_Thread *th, s32 priority);
+
+/*!
+\brief thread CPU affinity
+
+Restricts execution of the calling thread to a set of CPUs. This is only supported on Linux and Windows (64 first CPUs).
+\param cpus list of CPU indexes (0-based) the thread may run on
+\param nb_cpus number of CPUs in the list
+\return error if any, GF_NOT_SUPPORTED if the platform does not support thread affinity
+ */
+GF_Err gf_th_set_cpu_affinity(const u32 *cpus, u32 nb_cpus);
+
+/*!
+\brief thread CPU affinity query
+
+Gets the CPUs the calling thread may run on. This is only supported on Linux and Windows (64 first CPUs).
+\param cpus list of CPU indexes (0-based) to fill, may be NULL
+\param max_cpus number of entries in the cpus list
+\param nb_cpus set to the number of CPUs the thread may run on, which may be larger than max_cpus
+\return error if any, GF_NOT_SUPPORTED if the platform does not support thread affinity
+ */
+GF_Err gf_th_get_cpu_affinity(u32 *cpus, u32 max_cpus, u32 *nb_cpus);
+
+/*!
+\brief CPU NUMA node
+
+Gets the NUMA node of a CPU. This is only supported on Linux and Windows.
+\param cpu the CPU index (0-based)
+\return the NUMA node of the CPU, or -1 if unknown
+ */
+s32 gf_th_get_cpu_node(u32 cpu);
 /*!
 \brief current thread ID
 
@@ -1035,6 +1035,14 @@ Locks calling thread/process execution for a given time.
  */
 void gf_sleep(u32 ms);
 
+/*!
+\brief Sleeps thread/process with microsecond precision
+
+Locks calling thread/process execution for a given time. The actual precision depends on the OS scheduler, and is rounded to milliseconds on Windows.
+\param us Amount of time to sleep in microseconds.
+ */
+void gf_usleep(u32 us);
+
 #ifdef WIN32
 /*!
 \brief WINCE time constant
@@ -1546,6 +1554,32 @@ Creates a new temporary file in binary mode
  */
 FILE *gf_file_temp(char ** const fileName);
 
+/*!
+\brief Memory File Creation
+
+Creates a new growable memory-backed stream, usable with all gf_f* functions (write, printf, seek, read, tell). The stream is destroyed by \ref gf_fclose
+\return stream handle to the new memory file, or NULL if error
+ */
+FILE *gf_file_mem_new(void);
+
+/*!
+\brief Memory File Data
+
+Gets the content of a memory file created with \ref gf_file_mem_new. The returned buffer is owned by the stream and is only valid until the next write, reset or close on the stream
+\param fp the memory file
+\param size set to the size of the file content in bytes - may be NULL
+\return the file content, or NULL if empty or not a memory file
+ */
+const u8 *gf_file_mem_get_data(FILE *fp, u32 *size);
+
+/*!
+\brief Memory File Reset
+
+Truncates a memory file created with \ref gf_file_mem_new to 0 bytes, keeping its allocated memory for further writes
+\param fp the memory file
+ */
+void gf_file_mem_reset(FILE *fp);
+
 
 /*!
 \brief File Modification Time
@@ -26,7 +26,7 @@
 #include <gpac/internal/crypt_dev.h>
 
 GF_EXPORT
-GF_Crypt *gf_crypt_open(GF_CRYPTO_ALGO algorithm, GF_CRYPTO_MODE mode)
+GF_Crypt *gf_crypt_open_engine(GF_CRYPTO_ALGO algorithm, GF_CRYPTO_MODE mode, GF_CRYPTO_ENGINE engine)
 {
 	GF_Crypt *td;
 	GF_Err e;
@@ -34,11 +34,40 @@ GF_Crypt *gf_crypt_open(GF_CRYPTO_ALGO algorithm, GF_CRYPTO_MODE mode)
 	GF_SAFEALLOC(td, GF_Crypt);
 	if (td == NULL) return NULL;
 
+	switch (engine) {
+	case GF_CRYPTO_ENGINE_DEFAULT:
+		e = GF_NOT_SUPPORTED;
+#ifdef GPAC_HAS_AESNI
+		e = gf_crypt_open_open_aesni(td, mode);
+#endif
 #ifdef GPAC_HAS_SSL
-	e = gf_crypt_open_open_openssl(td, mode);
+		if (e == GF_NOT_SUPPORTED)
+			e = gf_crypt_open_open_openssl(td, mode);
+#endif
+		if (e == GF_NOT_SUPPORTED)
+			e = gf_crypt_open_open_tinyaes(td, mode);
+		break;
+	case GF_CRYPTO_ENGINE_SOFT:
+		e = gf_crypt_open_open_tinyaes(td, mode);
+		break;
+	case GF_CRYPTO_ENGINE_OPENSSL:
+#ifdef GPAC_HAS_SSL
+		e = gf_crypt_open_open_openssl(td, mode);
 #else
-	e = gf_crypt_open_open_tinyaes(td, mode);
+		e = GF_NOT_SUPPORTED;
 #endif
+		break;
+	case GF_CRYPTO_ENGINE_AESNI:
+#ifdef GPAC_HAS_AESNI
+		e = gf_crypt_open_open_aesni(td, mode);
+#else
+		e = GF_NOT_SUPPORTED;
+#endif
+		break;
+	default:
+		e = GF_BAD_PARAM;
+		break;
+	}
 
 	if (e != GF_OK) {
 		gf_free(td);
@@ -47,6 +76,18 @@ GF_Crypt *gf_crypt_open(GF_CRYPTO_ALGO algorithm, GF_CRYPTO_MODE mode)
 	return td;
 }
 
+GF_EXPORT
+GF_Crypt *gf_crypt_open(GF_CRYPTO_ALGO algorithm, GF_CRYPTO_MODE mode)
+{
+	return gf_crypt_open_engine(algorithm, mode, GF_CRYPTO_ENGINE_DEFAULT);
+}
+
+GF_EXPORT
+GF_CRYPTO_ENGINE gf_crypt_get_engine(GF_Crypt *td)
+{
+	return td ? td->engine : GF_CRYPTO_ENGINE_DEFAULT;
+}
+
 GF_EXPORT
 void gf_crypt_close(GF_Crypt *td)
 {
@@ -103,3 +144,40 @@ GF_Err gf_crypt_decrypt(GF_Crypt *td, void *ciphertext, u32 len)
 	if (!len) return GF_OK;
 	return td->_decrypt(td, ciphertext, len);
 }
+
+GF_EXPORT
+GF_Err gf_crypt_encrypt_pattern(GF_Crypt *td, void *plaintext, u32 len, u32 crypt_blocks, u32 skip_blocks)
+{
+	u32 pos = 0;
+	if (!td) return GF_BAD_PARAM;
+	if (!crypt_blocks || !skip_blocks)
+		return td->_crypt(td, plaintext, len);
+	if (td->_crypt_pattern)
+		return td->_crypt_pattern(td, plaintext, len, crypt_blocks, skip_blocks);
+
+	while (pos < len) {
+		GF_Err e = td->_crypt(td, (u8 *)plaintext + pos, MIN(16*crypt_blocks, len - pos));
+		if (e) return e;
+		pos += 16 * (crypt_blocks + skip_blocks);
+	}
+	return GF_OK;
+}
+
+GF_EXPORT
+GF_Err gf_crypt_decrypt_pattern(GF_Crypt *td, void *ciphertext, u32 len, u32 crypt_blocks, u32 skip_blocks)
+{
+	u32 pos = 0;
+	if (!td) return GF_BAD_PARAM;
+	if (!len) return GF_OK;
+	if (!crypt_blocks || !skip_blocks)
+		return td->_decrypt(td, ciphertext, len);
+	if (td->_decrypt_pattern)
+		return td->_decrypt_pattern(td, ciphertext, len, crypt_blocks, skip_blocks);
+
+	while (pos < len) {
+		GF_Err e = td->_decrypt(td, (u8 *)ciphertext + pos, MIN(16*crypt_blocks, len - pos));
+		if (e) return e;
+		pos += 16 * (crypt_blocks + skip_blocks);
+	}
+	return GF_OK;
+}
@@ -0,0 +1,479 @@
+/*
+*			GPAC - Multimedia Framework C SDK
+*
+*			Authors: Jean Le Feuvre
+*			Copyright (c) Telecom Paris 2024
+*					All rights reserved
+*
+*  This file is part of GPAC / crypto lib sub-project
+*
+*  GPAC is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation; either version 2, or (at your option)
+*  any later version.
+*
+*  GPAC is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; see the file COPYING.  If not, write to
+*  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+*
+*/
+
+#include <gpac/internal/crypt_dev.h>
+
+#ifdef GPAC_HAS_AESNI
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+#define AESNI_TARGET	__attribute__((target("aes,sse2")))
+
+//number of blocks processed in parallel - AESENC has a latency of 4 to 7 cycles for a throughput of 1 or 2 per cycle
+#define AESNI_PIPE	8
+
+typedef struct
+{
+	u8 enc_keys[11*16];
+	u8 dec_keys[11*16];
+	//CBC: last ciphertext block - CTR: next counter block
+	u8 iv[16];
+	//CTR only: keystream of the last counter and number of bytes consumed in it
+	u8 keystream[16];
+	u32 num;
+} AESNI_ctx;
+
+Bool gf_crypt_aesni_supported()
+{
+	static s32 aesni_checked = -1;
+	if (aesni_checked<0) {
+		unsigned int eax, ebx, ecx, edx;
+		aesni_checked = 0;
+		if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_AES) && (edx & bit_SSE2))
+			aesni_checked = 1;
+	}
+	return aesni_checked ? GF_TRUE : GF_FALSE;
+}
+
+AESNI_TARGET
+static GFINLINE __m128i aesni_key_step(__m128i key, __m128i kg)
+{
+	kg = _mm_shuffle_epi32(kg, 0xFF);
+	key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+	key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+	key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+	return _mm_xor_si128(key, kg);
+}
+
+//rcon must be an immediate
+#define AESNI_KEY_STEP(_k, _rcon) aesni_key_step(_k, _mm_aeskeygenassist_si128(_k, _rcon))
+
+AESNI_TARGET
+static void gf_set_key_aesni(GF_Crypt* td, void *key)
+{
+	__m128i k[11];
+	u32 i;
+	AESNI_ctx *ctx = (AESNI_ctx *)td->context;
+
+	k[0] = _mm_loadu_si128((const __m128i *) key);
+	k[1] = AESNI_KEY_STEP(k[0], 0x01);
+	k[2] = AESNI_KEY_STEP(k[1], 0x02);
+	k[3] = AESNI_KEY_STEP(k[2], 0x04);
+	k[4] = AESNI_KEY_STEP(k[3], 0x08);
+	k[5] = AESNI_KEY_STEP(k[4], 0x10);
+	k[6] = AESNI_KEY_STEP(k[5], 0x20);
+	k[7] = AESNI_KEY_STEP(k[6], 0x40);
+	k[8] = AESNI_KEY_STEP(k[7], 0x80);
+	k[9] = AESNI_KEY_STEP(k[8], 0x1B);
+	k[10] = AESNI_KEY_STEP(k[9], 0x36);
+
+	for (i=0; i<11; i++) {
+		_mm_storeu_si128((__m128i *) (ctx->enc_keys + 16*i), k[i]);
+	}
+	//equivalent inverse cipher keys
+	_mm_storeu_si128((__m128i *) ctx->dec_keys, k[10]);
+	for (i=1; i<10; i++) {
+		_mm_storeu_si128((__m128i *) (ctx->dec_keys + 16*i), _mm_aesimc_si128(k[10-i]));
+	}
+	_mm_storeu_si128((__m128i *) (ctx->dec_keys + 160), k[0]);
+}
+
+AESNI_TARGET
+static GFINLINE void aesni_load_keys(__m128i *k, const u8 *keys)
+{
+	u32 i;
+	for (i=0; i<11; i++)
+		k[i] = _mm_loadu_si128((const __m128i *) (keys + 16*i));
+}
+
+static GF_Err gf_crypt_init_aesni(GF_Crypt* td, void *key, const void *iv)
+{
+	AESNI_ctx *ctx = (AESNI_ctx *)td->context;
+	if (!ctx) {
+		GF_SAFEALLOC(ctx, AESNI_ctx);
+		if (!ctx) return GF_OUT_OF_MEM;
+		td->context = ctx;
+	}
+	ctx->num = 0;
+	if (iv) memcpy(ctx->iv, iv, 16);
+	return GF_OK;
+}
+
+static void gf_crypt_deinit_aesni(GF_Crypt* td)
+{
+}
+
+
+/** CTR mode **/
+
+static GFINLINE void aesni_ctr_get(AESNI_ctx *ctx, u64 *hi, u64 *lo)
+{
+	memcpy(hi, ctx->iv, 8);
+	memcpy(lo, ctx->iv+8, 8);
+	*hi = __builtin_bswap64(*hi);
+	*lo = __builtin_bswap64(*lo);
+}
+
+static GFINLINE void aesni_ctr_set(AESNI_ctx *ctx, u64 hi, u64 lo)
+{
+	hi = __builtin_bswap64(hi);
+	lo = __builtin_bswap64(lo);
+	memcpy(ctx->iv, &hi, 8);
+	memcpy(ctx->iv+8, &lo, 8);
+}
+
+//xors nb_blocks (at most AESNI_PIPE) 16-byte blocks with the keystream of consecutive counters
+AESNI_TARGET
+static GFINLINE void aesni_ctr_blocks(const __m128i *k, u64 *hi, u64 *lo, u8 **blocks, u32 nb_blocks)
+{
+	__m128i b[AESNI_PIPE];
+	u32 i, r;
+
+	for (i=0; i<nb_blocks; i++) {
+		b[i] = _mm_set_epi64x((long long) __builtin_bswap64(*lo), (long long) __builtin_bswap64(*hi));
+		b[i] = _mm_xor_si128(b[i], k[0]);
+		(*lo)++;
+		if (! *lo) (*hi)++;
+	}
+	for (r=1; r<10; r++) {
+		for (i=0; i<nb_blocks; i++)
+			b[i] = _mm_aesenc_si128(b[i], k[r]);
+	}
+	for (i=0; i<nb_blocks; i++) {
+		b[i] = _mm_aesenclast_si128(b[i], k[10]);
+		_mm_storeu_si128((__m128i *) blocks[i], _mm_xor_si128(b[i], _mm_loadu_si128((const __m128i *) blocks[i])));
+	}
+}
+
+AESNI_TARGET
+static GF_Err gf_crypt_crypt_aesni_ctr(GF_Crypt* td, u8 *buffer, u32 len)
+{
+	__m128i k[11];
+	u8 *blocks[AESNI_PIPE];
+	u64 hi, lo;
+	u32 i;
+	AESNI_ctx *ctx = (AESNI_ctx *)td->context;
+
+	//remaining bytes of previous keystream block
+	while (ctx->num && len) {
+		*buffer++ ^= ctx->keystream[ctx->num];
+		ctx->num = (ctx->num + 1) % 16;
+		len--;
+	}
+	if (!len) return GF_OK;
+
+	aesni_load_keys(k, ctx->enc_keys);
+	aesni_ctr_get(ctx, &hi, &lo);
+
+	while (len >= 16*AESNI_PIPE) {
+		for (i=0; i<AESNI_PIPE; i++)
+			blocks[i] = buffer + 16*i;
+		aesni_ctr_blocks(k, &hi, &lo, blocks, AESNI_PIPE);
+		buffer += 16*AESNI_PIPE;
+		len -= 16*AESNI_PIPE;
+	}
+	if (len >= 16) {
+		u32 nb_blocks = len / 16;
+		for (i=0; i<nb_blocks; i++)
+			blocks[i] = buffer + 16*i;
+		aesni_ctr_blocks(k, &hi, &lo, blocks, nb_blocks);
+		buffer += 16*nb_blocks;
+		len -= 16*nb_blocks;
+	}
+	//partial block, keep keystream for next call
+	if (len) {
+		memset(ctx->keystream, 0, 16);
+		blocks[0] = ctx->keystream;
+		aesni_ctr_blocks(k, &hi, &lo, blocks, 1);
+		for (i=0; i<len; i++)
+			buffer[i] ^= ctx->keystream[i];
+		ctx->num = len;
+	}
+	aesni_ctr_set(ctx, hi, lo);
+	return GF_OK;
+}
+
+//encrypted blocks of the pattern are gathered so that short runs (typically 1 block in 1:9 patterns) still fill the pipeline
+AESNI_TARGET
+static GF_Err gf_crypt_crypt_aesni_ctr_pattern(GF_Crypt* td, u8 *buffer, u32 len, u32 crypt_blocks, u32 skip_blocks)
+{
+	__m128i k[11];
+	u8 *blocks[AESNI_PIPE];
+	u64 hi, lo;
+	u32 pos=0, nb_blocks=0;
+	AESNI_ctx *ctx = (AESNI_ctx *)td->context;
+
+	//state not on a block boundary, process runs one by one
+	if (ctx->num) {
+		while (pos < len) {
+			u32 run = MIN(16*crypt_blocks, len - pos);
+			gf_crypt_crypt_aesni_ctr(td, buffer + pos, run);
+			pos += 16 * (crypt_blocks + skip_blocks);
+		}
+		return GF_OK;
+	}
+
+	aesni_load_keys(k, ctx->enc_keys);
+	aesni_ctr_get(ctx, &hi, &lo);
+	while (pos < len) {
+		u32 run = MIN(16*crypt_blocks, len - pos);
+		u8 *data = buffer + pos;
+		while (run >= 16) {
+			blocks[nb_blocks++] = data;
+			if (nb_blocks==AESNI_PIPE) {
+				aesni_ctr_blocks(k, &hi, &lo, blocks, AESNI_PIPE);
+				nb_blocks = 0;
+			}
+			data += 16;
+			run -= 16;
+		}
+		//partial block, can only happen in last run
+		if (run) {
+			if (nb_blocks) aesni_ctr_blocks(k, &hi, &lo, blocks, nb_blocks);
+			nb_blocks = 0;
+			aesni_ctr_set(ctx, hi, lo);
+			return gf_crypt_crypt_aesni_ctr(td, data, run);
+		}
+		pos += 16 * (crypt_blocks + skip_blocks);
+	}
+	if (nb_blocks) aesni_ctr_blocks(k, &hi, &lo, blocks, nb_blocks);
+	aesni_ctr_set(ctx, hi, lo);
+	return GF_OK;
+}
+
+static GF_Err gf_crypt_set_IV_aesni_ctr(GF_Crypt* td, const u8 *iv, u32 iv_size)
+{
+	AESNI_ctx *ctx = (AESNI_ctx *)td->context;
+	ctx->num = 0;
+	if (iv_size>16) {
+		memcpy(ctx->iv, iv+1, 16);
+		//restore keystream of the previous counter
+		if (iv[0] % 16) {
+			u64 hi, lo;
+			aesni_ctr_get(ctx, &hi, &lo);
+			if (!lo) hi--;
+			lo--;
+			aesni_ctr_set(ctx, hi, lo);
+			memset(ctx->keystream, 0, 16);
+			gf_crypt_crypt_aesni_ctr(td, ctx->keystream, 16);
+			ctx->num = iv[0] % 16;
+		}
+	} else {
+		memcpy(ctx->iv, iv, iv_size);
+	}
+	return GF_OK;
+}
+
+static GF_Err gf_crypt_get_IV_aesni_ctr(GF_Crypt* td, u8 *iv, u32 *iv_size)
+{
+	AESNI_ctx *ctx = (AESNI_ctx *)td->context;
+	*iv_size = 17;
+	iv[0] = ctx->num;
+	memcpy(iv+1, ctx->iv, 16);
+	return GF_OK;
+}
+
+
+/** CBC mode - only full blocks are processed **/
+
+AESNI_TARGET
+static GFINLINE __m128i aesni_cbc_enc_blocks(const __m128i *k, __m128i iv, u8 *data, u32 nb_blocks)
+{
+	u32 r;
+	while (nb_blocks) {
+		iv = _mm_xor_si128(iv, _mm_loadu_si128((const __m128i *) data));
+		iv = _mm_xor_si128(iv, k[0]);
+		for (r=1; r<10; r++)
+			iv = _mm_aesenc_si128(iv, k[r]);
+		iv = _mm_aesenclast_si128(iv, k[10]);
+		_mm_storeu_si128((__m128i *) data, iv);
+		data += 16;
+		nb_blocks--;
+	}
+	return iv;
+}
+
+AESNI_TARGET
+static GF_Err gf_crypt_encrypt_aesni_cbc(GF_Crypt* td, u8 *buffer, u32 len)
+{
+	__m128i k[11], iv;
+	AESNI_ctx *ctx = (AESNI_ctx *)td->context;
+	if (len<16) return GF_OK;
+
+	aesni_load_keys(k, ctx->enc_keys);
+	iv = _mm_loadu_si128((const __m128i *) ctx->iv);
+	iv = aesni_cbc_enc_blocks(k, iv, buffer, len/16);
+	_mm_storeu_si128((__m128i *) ctx->iv, iv);
+	return GF_OK;
+}
+
+AESNI_TARGET
+static GF_Err gf_crypt_encrypt_aesni_cbc_pattern(GF_Crypt* td, u8 *buffer, u32 len, u32 crypt_blocks, u32 skip_blocks)
+{
+	__m128i k[11], iv;
+	u32 pos = 0;
+	AESNI_ctx *ctx = (AESNI_ctx *)td->context;
+
+	aesni_load_keys(k, ctx->enc_keys);
+	iv = _mm_loadu_si128((const __m128i *) ctx->iv);
+	while (pos < len) {
+		u32 run = MIN(16*crypt_blocks, len - pos);
+		iv = aesni_cbc_enc_blocks(k, iv, buffer + pos, run/16);
+		pos += 16 * (crypt_blocks + skip_blocks);
+	}
+	_mm_storeu_si128((__m128i *) ctx->iv, iv);
+	return GF_OK;
+}
+
+//decrypts nb_blocks (at most AESNI_PIPE) chained blocks, blocks need not be contiguous
+AESNI_TARGET
+static GFINLINE __m128i aesni_cbc_dec_blocks(const __m128i *k, __m128i iv, u8 **blocks, u32 nb_blocks)
+{
+	__m128i c[AESNI_PIPE], b[AESNI_PIPE];
+	u32 i, r;
+
+	for (i=0; i<nb_blocks; i++) {
+		c[i] = _mm_loadu_si128((const __m128i *) blocks[i]);
+		b[i] = _mm_xor_si128(c[i], k[0]);
+	}
+	for (r=1; r<10; r++) {
+		for (i=0; i<nb_blocks; i++)
+			b[i] = _mm_aesdec_si128(b[i], k[r]);
+	}
+	for (i=0; i<nb_blocks; i++) {
+		b[i] = _mm_aesdeclast_si128(b[i], k[10]);
+		_mm_storeu_si128((__m128i *) blocks[i], _mm_xor_si128(b[i], i ? c[i-1] : iv));
+	}
+	return c[nb_blocks-1];
+}
+
+AESNI_TARGET
+static GF_Err gf_crypt_decrypt_aesni_cbc(GF_Crypt* td, u8 *buffer, u32 len)
+{
+	__m128i k[11], iv;
+	u8 *blocks[AESNI_PIPE];
+	u32 i, nb_blocks = len/16;
+	AESNI_ctx *ctx = (AESNI_ctx *)td->context;
+	if (!nb_blocks) return GF_OK;
+
+	aesni_load_keys(k, ctx->dec_keys);
+	iv = _mm_loadu_si128((const __m128i *) ctx->iv);
+	while (nb_blocks) {
+		u32 nb = MIN(nb_blocks, AESNI_PIPE);
+		for (i=0; i<nb; i++)
+			blocks[i] = buffer + 16*i;
+		iv = aesni_cbc_dec_blocks(k, iv, blocks, nb);
+		buffer += 16*nb;
+		nb_blocks -= nb;
+	}
+	_mm_storeu_si128((__m128i *) ctx->iv, iv);
+	return GF_OK;
+}
+
+//chaining skips clear blocks, so all encrypted blocks of the pattern can be decrypted in parallel
+AESNI_TARGET
+static GF_Err gf_crypt_decrypt_aesni_cbc_pattern(GF_Crypt* td, u8 *buffer, u32 len, u32 crypt_blocks, u32 skip_blocks)
+{
+	__m128i k[11], iv;
+	u8 *blocks[AESNI_PIPE];
+	u32 pos=0, nb_blocks=0;
+	AESNI_ctx *ctx = (AESNI_ctx *)td->context;
+
+	aesni_load_keys(k, ctx->dec_keys);
+	iv = _mm_loadu_si128((const __m128i *) ctx->iv);
+	while (pos < len) {
+		u32 run = MIN(16*crypt_blocks, len - pos) / 16;
+		u8 *data = buffer + pos;
+		while (run) {
+			blocks[nb_blocks++] = data;
+			if (nb_blocks==AESNI_PIPE) {
+				iv = aesni_cbc_dec_blocks(k, iv, blocks, AESNI_PIPE);
+				nb_blocks = 0;
+			}
+			data += 16;
+			run--;
+		}
+		pos += 16 * (crypt_blocks + skip_blocks);
+	}
+	if (nb_blocks) iv = aesni_cbc_dec_blocks(k, iv, blocks, nb_blocks);
+	_mm_storeu_si128((__m128i *) ctx->iv, iv);
+	return GF_OK;
+}
+
+static GF_Err gf_crypt_set_IV_aesni_cbc(GF_Crypt* td, const u8 *iv, u32 iv_size)
+{
+	AESNI_ctx *ctx = (AESNI_ctx *)td->context;
+	if (iv_size>16) return GF_BAD_PARAM;
+	memcpy(ctx->iv, iv, iv_size);
+	return GF_OK;
+}
+
+static GF_Err gf_crypt_get_IV_aesni_cbc(GF_Crypt* td, u8 *iv, u32 *iv_size)
+{
+	AESNI_ctx *ctx = (AESNI_ctx *)td->context;
+	*iv_size = 16;
+	memcpy(iv, ctx->iv, 16);
+	return GF_OK;
+}
+
+
+GF_Err gf_crypt_open_open_aesni(GF_Crypt* td, GF_CRYPTO_MODE mode)
+{
+	if (!gf_crypt_aesni_supported()) return GF_NOT_SUPPORTED;
+
+	td->mode = mode;
+	switch (td->mode) {
+	case GF_CBC:
+		td->_init_crypt = gf_crypt_init_aesni;
+		td->_deinit_crypt = gf_crypt_deinit_aesni;
+		td->_set_key = gf_set_key_aesni;
+		td->_crypt = gf_crypt_encrypt_aesni_cbc;
+		td->_decrypt = gf_crypt_decrypt_aesni_cbc;
+		td->_crypt_pattern = gf_crypt_encrypt_aesni_cbc_pattern;
+		td->_decrypt_pattern = gf_crypt_decrypt_aesni_cbc_pattern;
+		td->_get_state = gf_crypt_get_IV_aesni_cbc;
+		td->_set_state = gf_crypt_set_IV_aesni_cbc;
+		break;
+	case GF_CTR:
+		td->_init_crypt = gf_crypt_init_aesni;
+		td->_deinit_crypt = gf_crypt_deinit_aesni;
+		td->_set_key = gf_set_key_aesni;
+		td->_crypt = gf_crypt_crypt_aesni_ctr;
+		td->_decrypt = gf_crypt_crypt_aesni_ctr;
+		td->_crypt_pattern = gf_crypt_crypt_aesni_ctr_pattern;
+		td->_decrypt_pattern = gf_crypt_crypt_aesni_ctr_pattern;
+		td->_get_state = gf_crypt_get_IV_aesni_ctr;
+		td->_set_state = gf_crypt_set_IV_aesni_ctr;
+		break;
+	default:
+		return GF_BAD_PARAM;
+	}
+	td->algo = GF_AES_128;
+	td->engine = GF_CRYPTO_ENGINE_AESNI;
+	return GF_OK;
+}
+
+#endif //GPAC_HAS_AESNI
@@ -219,6 +219,7 @@ GF_Err gf_crypt_open_open_openssl(GF_Crypt* td, GF_CRYPTO_MODE mode)
 	}
 
 	td->algo = GF_AES_128;
+	td->engine = GF_CRYPTO_ENGINE_OPENSSL;
 	return GF_OK;
 }
 
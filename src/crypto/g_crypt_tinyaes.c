@@ -25,7 +25,6 @@
 
 #include <gpac/internal/crypt_dev.h>
 
-#ifndef GPAC_HAS_SSL
 #include "tiny_aes.h"
 
 #include <math.h>
@@ -194,8 +193,6 @@ GF_Err gf_crypt_open_open_tinyaes(GF_Crypt* td, GF_CRYPTO_MODE mode)
 
 	}
 	td->algo = GF_AES_128;
+	td->engine = GF_CRYPTO_ENGINE_SOFT;
 	return GF_OK;
 }
-
-#endif
-
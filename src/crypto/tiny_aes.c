@@ -38,8 +38,6 @@ NOTE:   String length must be evenly divisible by 16byte (str_len % 16 == 0)
 
 #include "tiny_aes.h"
 
-#ifndef GPAC_HAS_SSL
-
 /*****************************************************************************/
 /* Defines:                                                                  */
 /*****************************************************************************/
@@ -581,7 +579,3 @@ void AES_CTR_xcrypt_buffer(struct AES_ctx* ctx, u8* buf, u32 length)
 }
 
 #endif // #if defined(CTR) && (CTR == 1)
-
-#endif //GPAC_HAS_SSL
-
-
@@ -34,7 +34,7 @@ void gf_void_del(void *p)
 void gf_filterpacket_del(void *p)
 {
 	GF_FilterPacket *pck=(GF_FilterPacket *)p;
-	if (pck->data) gf_free(pck->data);
+	if (pck->data) gf_fs_pck_data_free(pck->session, pck->data, pck->alloc_size);
 	gf_free(p);
 }
 
@@ -597,6 +597,10 @@ void gf_filter_del(GF_Filter *filter)
 		gf_free(filter->iname);
 #endif
 
+	if (filter->prof_tasks) gf_fs_prof_del_tasks(filter->prof_tasks);
+	if (filter->prof_block) gf_free(filter->prof_block);
+	if (filter->prof_stall) gf_free(filter->prof_stall);
+
 	if (filter->freg && (filter->freg->flags & GF_FS_REG_CUSTOM)) {
 		if (! (filter->freg->flags & GF_FS_REG_SCRIPT))
 			if (filter->forced_caps) gf_free( (void *) filter->forced_caps);
@@ -71,6 +71,8 @@ GF_Err gf_filter_pck_merge_properties(GF_FilterPacket *pck_src, GF_FilterPacket
 typedef struct
 {
 	u32 data_size;
+	//block size when payloads use size classes
+	u32 block_size;
 	GF_FilterPacket *pck;
 	GF_FilterPacket *closest;
 } GF_PckQueueEnum;
@@ -80,6 +82,13 @@ static Bool pck_queue_enum(void *udta, void *item)
 	GF_PckQueueEnum *enum_state = (GF_PckQueueEnum *) udta;
 	GF_FilterPacket *cur = (GF_FilterPacket *) item;
 
+	//size classes, only reuse a block of the same class
+	if (enum_state->block_size) {
+		if (cur->alloc_size != enum_state->block_size) return GF_TRUE;
+		enum_state->pck = cur;
+		return GF_FALSE;
+	}
+
 	if (cur->alloc_size >= enum_state->data_size) {
 		if (!enum_state->pck || (enum_state->pck->alloc_size > cur->alloc_size)) {
 			enum_state->pck = cur;
@@ -99,6 +108,7 @@ static GF_FilterPacket *gf_filter_pck_new_alloc_internal(GF_FilterPid *pid, u32
 {
 	GF_FilterPacket *pck=NULL;
 	GF_FilterPacket *closest=NULL;
+	GF_FilterSession *fsess = pid->filter->session;
 	u32 count, max_reservoir_size;
 
 	if (PID_IS_INPUT(pid)) {
@@ -111,11 +121,33 @@ static GF_FilterPacket *gf_filter_pck_new_alloc_internal(GF_FilterPid *pid, u32
 		GF_PckQueueEnum pck_enum_state;
 		memset(&pck_enum_state, 0, sizeof(GF_PckQueueEnum));
 		pck_enum_state.data_size = data_size;
+		if (fsess->pck_slab_mx)
+			pck_enum_state.block_size = gf_fs_pck_data_block_size(fsess, data_size);
 		gf_fq_enum(pid->filter->pcks_alloc_reservoir, pck_queue_enum, &pck_enum_state);
 		pck = pck_enum_state.pck;
 		closest = pck_enum_state.closest;
 	}
 
+	//size classes: if no block of the same class, recycle the oldest packet and exchange its block for one of the desired class
+	//the previous block goes back to the session, where it can be used by any filter
+	if (fsess->pck_slab_mx) {
+		if (!pck && count) {
+			pck = gf_fq_pop(pid->filter->pcks_alloc_reservoir);
+			gf_fs_pck_data_free(fsess, pck->data, pck->alloc_size);
+			pck->data = gf_fs_pck_data_alloc(fsess, data_size, &pck->alloc_size);
+			if (!pck->data) {
+				gf_free(pck);
+				GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("Failed to allocate new packet on PID %s of filter %s\n", pid->name, pid->filter->name));
+				return NULL;
+			}
+#ifdef GPAC_MEMORY_TRACKING
+			fsess->nb_realloc_pck++;
+#endif
+			goto pck_ready;
+		}
+		closest = NULL;
+	}
+
 	//stop allocating after a while - TODO we for sur can design a better algo...
 	max_reservoir_size = pid->num_destinations ? 10 : 1;
 	//if pid is file, force 1 max
@@ -143,13 +175,12 @@ static GF_FilterPacket *gf_filter_pck_new_alloc_internal(GF_FilterPid *pid, u32
 			GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("Failed to allocate new packet on PID %s of filter %s\n", pid->name, pid->filter->name));
 			return NULL;
 		}
-		pck->data = gf_malloc(sizeof(char)*data_size);
+		pck->data = gf_fs_pck_data_alloc(fsess, data_size, &pck->alloc_size);
 		if (!pck->data) {
 			gf_free(pck);
 			GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("Failed to allocate new packet on PID %s of filter %s\n", pid->name, pid->filter->name));
 			return NULL;
 		}
-		pck->alloc_size = data_size;
 #ifdef GPAC_MEMORY_TRACKING
 		pid->filter->session->nb_alloc_pck+=2;
 #endif
@@ -169,6 +200,7 @@ static GF_FilterPacket *gf_filter_pck_new_alloc_internal(GF_FilterPid *pid, u32
 		pck = head_pck;
 	}
 
+pck_ready:
 	pck->pck = pck;
 	pck->data_length = data_size;
 	if (data) *data = pck->data;
@@ -646,7 +678,7 @@ void gf_filter_packet_destroy(GF_FilterPacket *pck)
 			gf_free(pck);
 		}
 	} else if (is_filter_destroyed) {
-		if (!pck->filter_owns_mem && pck->data) gf_free(pck->data);
+		if (!pck->filter_owns_mem && pck->data) gf_fs_pck_data_free(pck->session, pck->data, pck->alloc_size);
 		gf_free(pck);
 	} else if (pck->is_dangling) {
 		if (pck->data) gf_free(pck->data);
@@ -662,7 +694,7 @@ void gf_filter_packet_destroy(GF_FilterPacket *pck)
 		if (pid->filter && pid->filter->pcks_alloc_reservoir) {
 			gf_fq_add(pid->filter->pcks_alloc_reservoir, pck);
 		} else {
-			if (pck->data) gf_free(pck->data);
+			if (pck->data) gf_fs_pck_data_free(pck->session, pck->data, pck->alloc_size);
 			gf_free(pck);
 		}
 	}
@@ -1789,8 +1821,9 @@ GF_Err gf_filter_pck_expand(GF_FilterPacket *pck, u32 nb_bytes_to_add, u8 **data
 		return GF_BAD_PARAM;
 
 	if (pck->data_length + nb_bytes_to_add > pck->alloc_size) {
-		pck->alloc_size = pck->data_length + nb_bytes_to_add;
-		pck->data = gf_realloc(pck->data, pck->alloc_size);
+		char *data = gf_fs_pck_data_realloc(pck->session, pck->data, pck->data_length, &pck->alloc_size, pck->data_length + nb_bytes_to_add);
+		if (!data) return GF_OUT_OF_MEM;
+		pck->data = data;
 #ifdef GPAC_MEMORY_TRACKING
 		pck->pid->filter->session->nb_realloc_pck++;
 #endif
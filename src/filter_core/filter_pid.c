@@ -129,6 +129,11 @@ static void gf_filter_pid_check_unblock(GF_FilterPid *pid)
 		assert(pid->would_block);
 		safe_int_dec(&pid->would_block);
 
+		if (pid->prof_block_start) {
+			gf_fs_histo_push(&pid->filter->prof_block, gf_sys_clock_high_res() - pid->prof_block_start);
+			pid->prof_block_start = 0;
+		}
+
 		assert(pid->filter->would_block);
 		safe_int_dec(&pid->filter->would_block);
 		assert((s32)pid->filter->would_block>=0);
@@ -5413,6 +5418,9 @@ GF_FilterPacket *gf_filter_pid_get_packet(GF_FilterPid *pid)
 		}
 		if (!pidinst->is_end_of_stream && pidinst->pid->filter->would_block)
 			gf_filter_pid_check_unblock(pidinst->pid);
+		//input starvation starts
+		if (!pidinst->is_end_of_stream && !pidinst->prof_stall_start && (pidinst->filter->session->flags & GF_FS_FLAG_PROFILE))
+			pidinst->prof_stall_start = gf_sys_clock_high_res();
 		pidinst->filter->nb_pck_io++;
 		return NULL;
 	}
@@ -5422,6 +5430,10 @@ GF_FilterPacket *gf_filter_pid_get_packet(GF_FilterPid *pid)
 		return gf_filter_pid_get_packet(pid);
 	}
 	pcki->pid->is_end_of_stream = GF_FALSE;
+	if (pidinst->prof_stall_start) {
+		gf_fs_histo_push(&pidinst->filter->prof_stall, gf_sys_clock_high_res() - pidinst->prof_stall_start);
+		pidinst->prof_stall_start = 0;
+	}
 
 	if ( (pcki->pck->info.flags & GF_PCKF_PROPS_CHANGED) && !pcki->pid_props_change_done) {
 		GF_Err e;
@@ -5912,6 +5924,8 @@ Bool gf_filter_pid_would_block(GF_FilterPid *pid)
 		safe_int_inc(&pid->would_block);
 		safe_int_inc(&pid->filter->would_block);
 		assert(pid->filter->would_block + pid->filter->num_out_pids_not_connected <= pid->filter->num_output_pids);
+		if (pid->filter->session->flags & GF_FS_FLAG_PROFILE)
+			pid->prof_block_start = gf_sys_clock_high_res();
 
 #ifndef GPAC_DISABLE_LOG
 		if (gf_log_tool_level_on(GF_LOG_FILTER, GF_LOG_DEBUG)) {
@@ -7597,6 +7611,7 @@ void gf_filter_pid_discard_block(GF_FilterPid *pid)
 		assert(pid->filter->would_block);
 		safe_int_dec(&pid->filter->would_block);
 	}
+	pid->prof_block_start = 0;
 	gf_mx_v(pid->filter->tasks_mx);
 }
 
@@ -350,3 +350,92 @@ void gf_fq_enum(GF_FilterQueue *fq, Bool (*enum_func)(void *udta1, void *item),
 		}
 	}
 }
+
+
+#if defined(WIN32) && !defined(__GNUC__)
+#define atomic_load_acquire(_ptr)	(*(_ptr))
+#define atomic_store_release(_ptr, _val)	do { MemoryBarrier(); *(_ptr) = (_val); } while (0)
+#define atomic_compare_and_swap_u32(_ptr, _comparand, _replacement) (InterlockedCompareExchange((LONG *)_ptr,(LONG)_replacement,(LONG)_comparand)==(LONG)_comparand)
+#else
+#define atomic_load_acquire(_ptr)	__atomic_load_n(_ptr, __ATOMIC_ACQUIRE)
+#define atomic_store_release(_ptr, _val)	__atomic_store_n(_ptr, _val, __ATOMIC_RELEASE)
+#define atomic_compare_and_swap_u32(_ptr, _comparand, _replacement)	__sync_bool_compare_and_swap(_ptr, _comparand, _replacement)
+#endif
+
+struct __gf_filter_deque
+{
+	//index of next item to take, advanced by CAS by any thread
+	volatile u32 top;
+	//index of next free slot, only modified by the owner thread
+	volatile u32 bottom;
+	u32 mask;
+	void * volatile *items;
+};
+
+GF_FilterDeque *gf_fdq_new(u32 size)
+{
+	GF_FilterDeque *dq;
+	u32 alloc_size = 2;
+	while (alloc_size < size) alloc_size *= 2;
+
+	GF_SAFEALLOC(dq, GF_FilterDeque);
+	if (!dq) return NULL;
+	dq->items = gf_malloc(sizeof(void *) * alloc_size);
+	if (!dq->items) {
+		gf_free(dq);
+		return NULL;
+	}
+	memset((void *) dq->items, 0, sizeof(void *) * alloc_size);
+	dq->mask = alloc_size - 1;
+	return dq;
+}
+
+void gf_fdq_del(GF_FilterDeque *dq, void (*item_delete)(void *) )
+{
+	u32 i;
+	if (!dq) return;
+	for (i=dq->top; i!=dq->bottom; i++) {
+		void *data = dq->items[i & dq->mask];
+		if (data && item_delete) item_delete(data);
+	}
+	gf_free((void *) dq->items);
+	gf_free(dq);
+}
+
+Bool gf_fdq_push(GF_FilterDeque *dq, void *item)
+{
+	u32 b = dq->bottom;
+	u32 t = atomic_load_acquire(&dq->top);
+	//full, slot at bottom may still be read by a thread about to take the top item
+	if (b - t > dq->mask) return GF_FALSE;
+
+	dq->items[b & dq->mask] = item;
+	//publish the item before the new bottom
+	atomic_store_release(&dq->bottom, b+1);
+	return GF_TRUE;
+}
+
+void *gf_fdq_take(GF_FilterDeque *dq)
+{
+	if (!dq) return NULL;
+	while (1) {
+		void *item;
+		u32 t = atomic_load_acquire(&dq->top);
+		u32 b = atomic_load_acquire(&dq->bottom);
+		if ((s32) (b - t) <= 0) return NULL;
+
+		//read before claiming the slot: the owner only overwrites it once top moved past t, in which case the CAS fails
+		item = dq->items[t & dq->mask];
+		if (atomic_compare_and_swap_u32(&dq->top, t, t+1))
+			return item;
+	}
+	return NULL;
+}
+
+u32 gf_fdq_count(GF_FilterDeque *dq)
+{
+	s32 nb_items;
+	if (!dq) return 0;
+	nb_items = (s32) (dq->bottom - dq->top);
+	return (nb_items>0) ? (u32) nb_items : 0;
+}
@@ -25,6 +25,7 @@
 
 #include "filter_session.h"
 #include <gpac/network.h>
+#include <gpac/bitstream.h>
 
 #ifndef GPAC_DISABLE_3D
 #include <gpac/modules/video_out.h>
@@ -37,6 +38,79 @@ void gf_font_manager_del(struct _gf_ft_mgr *fm);
 #endif
 
 
+//get number of tasks in secondary task lists, including per-thread lists in work-stealing mode
+static u32 gf_fs_secondary_tasks_count(GF_FilterSession *fsess)
+{
+	u32 i, count, nb_tasks = gf_fq_count(fsess->tasks);
+	if (!fsess->work_stealing) return nb_tasks;
+
+	nb_tasks += gf_fq_count(fsess->main_th.tasks) + gf_fdq_count(fsess->main_th.local_tasks);
+	count = gf_list_count(fsess->threads);
+	for (i=0; i<count; i++) {
+		GF_SessionThread *sess_th = gf_list_get(fsess->threads, i);
+		nb_tasks += gf_fq_count(sess_th->tasks) + gf_fdq_count(sess_th->local_tasks);
+	}
+	return nb_tasks;
+}
+
+//post a task to the secondary task list. In work-stealing mode, tasks of a filter are posted to the list of the thread
+//which last processed the filter, in order to keep the filter state hot in this thread caches
+//blocking tasks always go to the shared list since the main thread never processes them
+static GFINLINE void gf_fs_add_secondary_task(GF_FilterSession *fsess, GF_FSTask *task)
+{
+	if (fsess->work_stealing && task->filter && task->filter->last_session_thread && !task->blocking) {
+		GF_SessionThread *sess_th = task->filter->last_session_thread;
+		//only the owner thread may push to its deque
+		if ((sess_th->th_id == gf_th_id()) && gf_fdq_push(sess_th->local_tasks, task))
+			return;
+		gf_fq_add(sess_th->tasks, task);
+	} else {
+		gf_fq_add(fsess->tasks, task);
+	}
+}
+
+static GFINLINE GF_FSTask *gf_fs_pop_thread_task(GF_SessionThread *sess_th)
+{
+	GF_FSTask *task = gf_fdq_take(sess_th->local_tasks);
+	if (task) return task;
+	return gf_fq_pop(sess_th->tasks);
+}
+
+//fetch a task from the secondary task lists. In work-stealing mode, a thread first looks in its own list, then in the
+//shared list, then tries to steal a task from other threads
+static GF_FSTask *gf_fs_pop_secondary_task(GF_FilterSession *fsess, GF_SessionThread *sess_thread)
+{
+	u32 i, count;
+	GF_FSTask *task;
+	if (!fsess->work_stealing) return gf_fq_pop(fsess->tasks);
+
+	task = gf_fs_pop_thread_task(sess_thread);
+	if (task) return task;
+	task = gf_fq_pop(fsess->tasks);
+	if (task) return task;
+
+	//index 0 is the main thread
+	count = 1 + gf_list_count(fsess->threads);
+	for (i=0; i<count; i++) {
+		GF_SessionThread *victim;
+		u32 idx = (sess_thread->steal_idx + i) % count;
+		victim = idx ? gf_list_get(fsess->threads, idx-1) : &fsess->main_th;
+		if (victim == sess_thread) continue;
+		//in NUMA mode, don't move filters to another node
+		if (fsess->nb_numa_nodes && (victim->numa_node>=0) && (sess_thread->numa_node>=0) && (victim->numa_node != sess_thread->numa_node))
+			continue;
+
+		task = gf_fs_pop_thread_task(victim);
+		if (task) {
+			//next steal will start with the same victim
+			sess_thread->steal_idx = idx;
+			GF_LOG(GF_LOG_DEBUG, GF_LOG_SCHEDULER, ("Thread %u stole task %s::%s from thread %u\n", gf_th_id(), task->filter ? task->filter->name : "none", task->log_name, victim->th_id));
+			return task;
+		}
+	}
+	return NULL;
+}
+
 static GFINLINE void gf_fs_sema_io(GF_FilterSession *fsess, Bool notify, Bool main)
 {
 	GF_Semaphore *sem = main ? fsess->semaphore_main : fsess->semaphore_other;
@@ -58,7 +132,7 @@ static GFINLINE void gf_fs_sema_io(GF_FilterSession *fsess, Bool notify, Bool ma
 			nb_tasks = 1;
 			//no active threads, count number of tasks. If no posted tasks we are likely at the end of the session, don't block, rather use a sem_wait 
 			if (!fsess->active_threads)
-			 	nb_tasks = gf_fq_count(fsess->main_thread_tasks) + gf_fq_count(fsess->tasks);
+			 	nb_tasks = gf_fq_count(fsess->main_thread_tasks) + gf_fs_secondary_tasks_count(fsess);
 
 			//if main semaphore, keep track that we are going to sleep
 			if (main) {
@@ -208,6 +282,17 @@ GF_FilterSession *gf_fs_new(s32 nb_threads, GF_FilterSchedulerType sched_type, u
 		fsess->tasks_reservoir = gf_fq_new(fsess->tasks_mx);
 	}
 
+	if (flags & GF_FS_FLAG_PROFILE) {
+		fsess->prof_tasks = gf_list_new();
+		fsess->prof_mx = gf_mx_new("FSProfile");
+	}
+
+	if (!(flags & GF_FS_FLAG_NO_RESERVOIR)) {
+		fsess->pck_slab_cap = gf_opts_get_int("core", "pck-cap");
+		if (fsess->pck_slab_cap)
+			fsess->pck_slab_mx = gf_mx_new("FSPacketSlab");
+	}
+
 	if (nb_threads || (sched_type==GF_FS_SCHEDULER_LOCK_FORCE) ) {
 		fsess->semaphore_main = fsess->semaphore_other = gf_sema_new(GF_INT_MAX, 0);
 		if (nb_threads>0)
@@ -289,8 +374,26 @@ GF_FilterSession *gf_fs_new(s32 nb_threads, GF_FilterSchedulerType sched_type, u
 			continue;
 		}
 		sess_thread->fsess = fsess;
+		sess_thread->numa_node = -1;
 		gf_list_add(fsess->threads, sess_thread);
 	}
+	fsess->main_th.numa_node = -1;
+
+	//work-stealing mode: task lists per thread, including main thread
+	//the overflow queues have several consumers (owner and stealing threads), lock-free queues are not safe for this
+	if (fsess->threads && gf_list_count(fsess->threads) && (sched_type==GF_FS_SCHEDULER_WORK_STEALING)) {
+		fsess->work_stealing = GF_TRUE;
+		fsess->main_th.local_tasks = gf_fdq_new(GF_FS_THREAD_DEQUE_SIZE);
+		fsess->main_th.tasks_mx = gf_mx_new("ThreadTasks");
+		fsess->main_th.tasks = gf_fq_new(fsess->main_th.tasks_mx);
+		for (i=0; i<gf_list_count(fsess->threads); i++) {
+			GF_SessionThread *sess_thread = gf_list_get(fsess->threads, i);
+			sess_thread->local_tasks = gf_fdq_new(GF_FS_THREAD_DEQUE_SIZE);
+			sess_thread->tasks_mx = gf_mx_new("ThreadTasks");
+			sess_thread->tasks = gf_fq_new(sess_thread->tasks_mx);
+			sess_thread->steal_idx = i+2;
+		}
+	}
 
 	gf_fs_set_separators(fsess, NULL);
 
@@ -437,12 +540,14 @@ GF_FilterSession *gf_fs_new_defaults(u32 inflags)
 	const char *blacklist = gf_opts_get_key("core", "blacklist");
 	const char *opt = gf_opts_get_key("core", "sched");
 
-	if (!opt) sched_type = GF_FS_SCHEDULER_LOCK_FREE;
+	//NUMA mode relies on per-thread task lists
+	if (!opt) sched_type = gf_opts_get_bool("core", "fs-numa") ? GF_FS_SCHEDULER_WORK_STEALING : GF_FS_SCHEDULER_LOCK_FREE;
 	else if (!strcmp(opt, "lock")) sched_type = GF_FS_SCHEDULER_LOCK;
 	else if (!strcmp(opt, "flock")) sched_type = GF_FS_SCHEDULER_LOCK_FORCE;
 	else if (!strcmp(opt, "direct")) sched_type = GF_FS_SCHEDULER_DIRECT;
 	else if (!strcmp(opt, "free")) sched_type = GF_FS_SCHEDULER_LOCK_FREE;
 	else if (!strcmp(opt, "freex")) sched_type = GF_FS_SCHEDULER_LOCK_FREE_X;
+	else if (!strcmp(opt, "steal")) sched_type = GF_FS_SCHEDULER_WORK_STEALING;
 	else {
 		GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("Unrecognized scheduler type %s\n", opt));
 		return NULL;
@@ -482,6 +587,11 @@ GF_FilterSession *gf_fs_new_defaults(u32 inflags)
 	if (gf_opts_get_bool("core", "no-reservoir"))
 		flags |= GF_FS_FLAG_NO_RESERVOIR;
 
+	if (gf_opts_get_bool("core", "fs-prof"))
+		flags |= GF_FS_FLAG_PROFILE;
+	else if (inflags & GF_FS_FLAG_PROFILE)
+		flags |= GF_FS_FLAG_PROFILE;
+
 
 	fsess = gf_fs_new(nb_threads, sched_type, flags, blacklist);
 	if (!fsess) return NULL;
@@ -490,6 +600,37 @@ GF_FilterSession *gf_fs_new_defaults(u32 inflags)
 
 	gf_fs_set_max_sleep_time(fsess, gf_opts_get_int("core", "max-sleep") );
 
+	opt = gf_opts_get_key("core", "fs-cpus");
+	if (opt || gf_opts_get_bool("core", "fs-pin") || gf_opts_get_bool("core", "fs-numa")) {
+		u32 *cpus = NULL;
+		u32 nb_cpus = 0;
+		//comma-separated list of CPU indexes or ranges
+		while (opt && opt[0]) {
+			u32 first, last;
+			const char *sep = strchr(opt, ',');
+			u32 nb_read = sscanf(opt, "%u-%u", &first, &last);
+			if (!nb_read || (nb_read==EOF)) {
+				GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("Invalid CPU list %s, ignoring\n", opt));
+				break;
+			}
+			if (nb_read==1) last = first;
+			if (last<first) last = first;
+			cpus = gf_realloc(cpus, sizeof(u32) * (nb_cpus + last - first + 1));
+			if (!cpus) {
+				nb_cpus = 0;
+				break;
+			}
+			while (first<=last) {
+				cpus[nb_cpus] = first;
+				nb_cpus++;
+				first++;
+			}
+			opt = sep ? sep+1 : NULL;
+		}
+		gf_fs_set_cpu_affinity(fsess, cpus, nb_cpus, gf_opts_get_bool("core", "fs-pin"), gf_opts_get_bool("core", "fs-numa"));
+		if (cpus) gf_free(cpus);
+	}
+
 	opt = gf_opts_get_key("core", "seps");
 	if (opt)
 		gf_fs_set_separators(fsess, opt);
@@ -536,6 +677,145 @@ GF_Err gf_fs_set_max_sleep_time(GF_FilterSession *session, u32 max_sleep)
 	return GF_OK;
 }
 
+GF_EXPORT
+GF_Err gf_fs_set_cpu_affinity(GF_FilterSession *session, const u32 *cpus, u32 nb_cpus, Bool pin, Bool numa)
+{
+	u32 i, j;
+	GF_SystemRTInfo rti;
+	if (!session) return GF_BAD_PARAM;
+	//CPU sets of session threads are recomputed when the threads next start
+	for (i=0; i<=gf_list_count(session->threads); i++) {
+		GF_SessionThread *sess_th = i ? gf_list_get(session->threads, i-1) : &session->main_th;
+		if (sess_th->cpus) gf_free(sess_th->cpus);
+		sess_th->cpus = NULL;
+		sess_th->nb_cpus = 0;
+		sess_th->affinity_done = GF_FALSE;
+	}
+	if (session->cpus) gf_free(session->cpus);
+	if (session->cpu_nodes) gf_free(session->cpu_nodes);
+	if (session->numa_nodes) gf_free(session->numa_nodes);
+	session->cpus = NULL;
+	session->cpu_nodes = session->numa_nodes = NULL;
+	session->nb_cpus = session->nb_numa_nodes = 0;
+	session->cpu_pin = pin;
+
+	if (!cpus || !nb_cpus) {
+		//nothing to restrict
+		if (!pin && !numa) return GF_OK;
+		nb_cpus = gf_sys_get_rti(0, &rti, 0) ? rti.nb_cores : 0;
+		if (!nb_cpus) return GF_NOT_SUPPORTED;
+	}
+	session->cpus = gf_malloc(sizeof(u32) * nb_cpus);
+	session->cpu_nodes = gf_malloc(sizeof(s32) * nb_cpus);
+	if (!session->cpus || !session->cpu_nodes) return GF_OUT_OF_MEM;
+	for (i=0; i<nb_cpus; i++) {
+		session->cpus[i] = cpus ? cpus[i] : i;
+		session->cpu_nodes[i] = gf_th_get_cpu_node(session->cpus[i]);
+	}
+	session->nb_cpus = nb_cpus;
+	if (!numa) return GF_OK;
+
+	session->numa_nodes = gf_malloc(sizeof(s32) * nb_cpus);
+	if (!session->numa_nodes) return GF_OUT_OF_MEM;
+	for (i=0; i<nb_cpus; i++) {
+		s32 node = session->cpu_nodes[i];
+		if (node<0) continue;
+		for (j=0; j<session->nb_numa_nodes; j++) {
+			if (session->numa_nodes[j] == node) break;
+		}
+		if (j==session->nb_numa_nodes) {
+			session->numa_nodes[j] = node;
+			session->nb_numa_nodes++;
+		}
+	}
+	if (!session->nb_numa_nodes) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_FILTER, ("NUMA topology not available, disabling NUMA mode\n"));
+	}
+	else if (!session->work_stealing && session->threads) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_FILTER, ("NUMA mode without work-stealing scheduler, filters may move between NUMA nodes\n"));
+	}
+	return GF_OK;
+}
+
+//computes the CPU set of a session thread, thid is 0 for main thread
+static void gf_fs_thread_setup_affinity(GF_FilterSession *fsess, GF_SessionThread *sess_thread, u32 thid)
+{
+	u32 i, nb_cpus=0, cpu_idx;
+	s32 node;
+	u32 *cpus;
+
+	sess_thread->affinity_done = GF_TRUE;
+	cpus = gf_malloc(sizeof(u32) * fsess->nb_cpus);
+	if (!cpus) return;
+	if (fsess->nb_numa_nodes) {
+		//spread threads over nodes, using only the CPUs of the node
+		node = fsess->numa_nodes[thid % fsess->nb_numa_nodes];
+		cpu_idx = thid / fsess->nb_numa_nodes;
+		for (i=0; i<fsess->nb_cpus; i++) {
+			if (fsess->cpu_nodes[i] == node)
+				cpus[nb_cpus++] = fsess->cpus[i];
+		}
+	} else {
+		cpu_idx = thid;
+		//node is only known if all CPUs are on the same node
+		node = fsess->cpu_nodes[0];
+		for (i=0; i<fsess->nb_cpus; i++) {
+			cpus[nb_cpus++] = fsess->cpus[i];
+			if (fsess->cpu_nodes[i] != node) node = -1;
+		}
+	}
+	if (fsess->cpu_pin) {
+		cpus[0] = cpus[cpu_idx % nb_cpus];
+		nb_cpus = 1;
+		node = gf_th_get_cpu_node(cpus[0]);
+	}
+	sess_thread->numa_node = node;
+	sess_thread->cpus = cpus;
+	sess_thread->nb_cpus = nb_cpus;
+
+	if (nb_cpus==1) {
+		GF_LOG(GF_LOG_INFO, GF_LOG_SCHEDULER, ("Thread %u pinned to CPU %u (NUMA node %d)\n", thid+1, cpus[0], node));
+	} else {
+		GF_LOG(GF_LOG_INFO, GF_LOG_SCHEDULER, ("Thread %u restricted to %u CPUs (NUMA node %d)\n", thid+1, nb_cpus, node));
+	}
+}
+
+//restrict calling session thread to its CPU set, thid is 0 for main thread
+//the main thread is the application thread calling gf_fs_run, its CPU set is saved to be restored by gf_fs_thread_restore_affinity
+static void gf_fs_thread_set_affinity(GF_FilterSession *fsess, GF_SessionThread *sess_thread, u32 thid)
+{
+	GF_Err e;
+	if (!fsess->nb_cpus) return;
+	if (!sess_thread->affinity_done) gf_fs_thread_setup_affinity(fsess, sess_thread, thid);
+	if (!sess_thread->cpus) return;
+
+	if (!thid) {
+		u32 nb_cpus = 0;
+		if (gf_th_get_cpu_affinity(NULL, 0, &nb_cpus) != GF_OK) return;
+		if (nb_cpus > sess_thread->nb_saved_cpus) {
+			sess_thread->saved_cpus = gf_realloc(sess_thread->saved_cpus, sizeof(u32) * nb_cpus);
+			if (!sess_thread->saved_cpus) {
+				sess_thread->nb_saved_cpus = 0;
+				return;
+			}
+		}
+		gf_th_get_cpu_affinity(sess_thread->saved_cpus, nb_cpus, &sess_thread->nb_saved_cpus);
+	}
+	e = gf_th_set_cpu_affinity(sess_thread->cpus, sess_thread->nb_cpus);
+	if (e) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_SCHEDULER, ("Thread %u failed to set CPU affinity: %s\n", thid+1, gf_error_to_string(e) ));
+		sess_thread->nb_saved_cpus = 0;
+	}
+}
+
+//restore CPU set of the application thread when leaving the session
+static void gf_fs_thread_restore_affinity(GF_SessionThread *sess_thread)
+{
+	if (!sess_thread->nb_saved_cpus) return;
+	gf_th_set_cpu_affinity(sess_thread->saved_cpus, sess_thread->nb_saved_cpus);
+	sess_thread->nb_saved_cpus = 0;
+}
+
 GF_EXPORT
 u32 gf_fs_get_max_resolution_chain_length(GF_FilterSession *session)
 {
@@ -686,6 +966,21 @@ void gf_fs_del(GF_FilterSession *fsess)
 	if (fsess->tasks_reservoir)
 		gf_fq_del(fsess->tasks_reservoir, gf_void_del);
 
+	if (fsess->prof_tasks) {
+		gf_fs_prof_del_tasks(fsess->prof_tasks);
+		fsess->prof_tasks = NULL;
+	}
+	if (fsess->prof_mx) gf_mx_del(fsess->prof_mx);
+
+	if (fsess->pck_slab_mx) {
+		gf_fs_trim_packet_memory(fsess, 0);
+		gf_mx_del(fsess->pck_slab_mx);
+	}
+
+	if (fsess->cpus) gf_free(fsess->cpus);
+	if (fsess->cpu_nodes) gf_free(fsess->cpu_nodes);
+	if (fsess->numa_nodes) gf_free(fsess->numa_nodes);
+
 	if (fsess->threads) {
 		if (fsess->main_thread_tasks)
 			gf_fq_del(fsess->main_thread_tasks, gf_void_del);
@@ -693,10 +988,27 @@ void gf_fs_del(GF_FilterSession *fsess)
 		while (gf_list_count(fsess->threads)) {
 			GF_SessionThread *sess_th = gf_list_pop_back(fsess->threads);
 			gf_th_del(sess_th->th);
+			if (sess_th->tasks)
+				gf_fq_del(sess_th->tasks, gf_void_del);
+			if (sess_th->local_tasks)
+				gf_fdq_del(sess_th->local_tasks, gf_void_del);
+			if (sess_th->tasks_mx)
+				gf_mx_del(sess_th->tasks_mx);
+			if (sess_th->cpus) gf_free(sess_th->cpus);
 			gf_free(sess_th);
 		}
 		gf_list_del(fsess->threads);
 	}
+	if (fsess->main_th.tasks)
+		gf_fq_del(fsess->main_th.tasks, gf_void_del);
+	if (fsess->main_th.local_tasks)
+		gf_fdq_del(fsess->main_th.local_tasks, gf_void_del);
+	if (fsess->main_th.tasks_mx)
+		gf_mx_del(fsess->main_th.tasks_mx);
+	if (fsess->main_th.cpus)
+		gf_free(fsess->main_th.cpus);
+	if (fsess->main_th.saved_cpus)
+		gf_free(fsess->main_th.saved_cpus);
 
 	if (fsess->prop_maps_reservoir)
 		gf_fq_del(fsess->prop_maps_reservoir, gf_propmap_del);
@@ -793,6 +1105,99 @@ static void check_task_list(GF_FilterQueue *fq, GF_FSTask *task)
 }
 #endif
 
+void gf_fs_histo_add(GF_FSHistogram *h, u64 val)
+{
+	u32 idx;
+	if (val < 16) {
+		idx = (u32) val;
+	} else if (val >> 40) {
+		idx = GF_FS_HISTO_SIZE-1;
+	} else {
+		u32 msb = 0;
+		u64 v = val;
+		if (v>>32) { v >>= 32; msb += 32; }
+		if (v>>16) { v >>= 16; msb += 16; }
+		if (v>>8) { v >>= 8; msb += 8; }
+		if (v>>4) { v >>= 4; msb += 4; }
+		if (v>>2) { v >>= 2; msb += 2; }
+		if (v>>1) msb += 1;
+		//8 sub-buckets given by the 3 bits following the MSB
+		idx = 16 + (msb-4)*8 + (u32) ((val >> (msb-3)) & 7);
+	}
+	h->buckets[idx]++;
+	h->count++;
+	h->sum += val;
+	if (val > h->max) h->max = val;
+}
+
+void gf_fs_histo_push(GF_FSHistogram **h, u64 val)
+{
+	if (! *h) {
+		GF_SAFEALLOC(*h, GF_FSHistogram);
+		if (! *h) return;
+	}
+	gf_fs_histo_add(*h, val);
+}
+
+void gf_fs_prof_del_tasks(GF_List *tasks)
+{
+	while (gf_list_count(tasks)) {
+		GF_FSTaskProfile *tp = gf_list_pop_back(tasks);
+		gf_free((char *) tp->name);
+		gf_free(tp);
+	}
+	gf_list_del(tasks);
+}
+
+//called right after task execution, before the task is requeued or discarded
+static void gf_fs_prof_task(GF_FilterSession *fsess, GF_FSTask *task, u64 start, u64 end, Bool requeue)
+{
+	u32 i, count;
+	GF_FSTaskProfile *tp = NULL;
+	//may be NULL if filter was destroyed by the task
+	GF_Filter *filter = task->filter;
+	GF_List *tasks = filter ? filter->prof_tasks : fsess->prof_tasks;
+	const char *name = task->log_name ? task->log_name : "unknown";
+
+	//filter-less tasks may run concurrently, filter tasks are always executed by a single thread at a time
+	if (!filter) gf_mx_p(fsess->prof_mx);
+
+	count = gf_list_count(tasks);
+	for (i=0; i<count; i++) {
+		tp = gf_list_get(tasks, i);
+		if ((tp->name==name) || !strcmp(tp->name, name))
+			break;
+		tp = NULL;
+	}
+	if (!tp) {
+		GF_SAFEALLOC(tp, GF_FSTaskProfile);
+		if (tp) tp->name = gf_strdup(name);
+		//list is browsed under tasks_mx when dumping the profile
+		if (filter) {
+			gf_mx_p(filter->tasks_mx);
+			if (!filter->prof_tasks) filter->prof_tasks = gf_list_new();
+			if (tp) gf_list_add(filter->prof_tasks, tp);
+			gf_mx_v(filter->tasks_mx);
+		} else if (tp) {
+			gf_list_add(fsess->prof_tasks, tp);
+		}
+	}
+	if (tp) {
+		gf_fs_histo_add(&tp->exec, end - start);
+		if (task->post_time) {
+			u64 ready = MAX(task->post_time, task->schedule_next_time);
+			gf_fs_histo_add(&tp->wait, (start>ready) ? start - ready : 0);
+		}
+		if (task->schedule_next_time)
+			gf_fs_histo_add(&tp->sched, (start>task->schedule_next_time) ? start - task->schedule_next_time : 0);
+	}
+	if (!filter) gf_mx_v(fsess->prof_mx);
+
+	//requeued task is waiting again from now on
+	if (requeue)
+		task->post_time = end;
+}
+
 void gf_fs_post_task_ex(GF_FilterSession *fsess, gf_fs_task_callback task_fun, GF_Filter *filter, GF_FilterPid *pid, const char *log_name, void *udta, Bool is_configure, Bool force_direct_call)
 {
 	GF_FSTask *task;
@@ -820,6 +1225,8 @@ void gf_fs_post_task_ex(GF_FilterSession *fsess, gf_fs_task_callback task_fun, G
 		if (filter)
 			filter->scheduled_for_next_task = GF_TRUE;
 		task_fun(&atask);
+		if (fsess->flags & GF_FS_FLAG_PROFILE)
+			gf_fs_prof_task(fsess, &atask, task_time, gf_sys_clock_high_res(), GF_FALSE);
 		filter = atask.filter;
 		if (filter) {
 			filter->time_process += gf_sys_clock_high_res() - task_time;
@@ -862,6 +1269,8 @@ void gf_fs_post_task_ex(GF_FilterSession *fsess, gf_fs_task_callback task_fun, G
 	task->run_task = task_fun;
 	task->log_name = log_name;
 	task->udta = udta;
+	if (fsess->flags & GF_FS_FLAG_PROFILE)
+		task->post_time = gf_sys_clock_high_res();
 
 	if (filter && is_configure) {
 		if (filter->freg->flags & GF_FS_REG_CONFIGURE_MAIN_THREAD)
@@ -916,7 +1325,7 @@ void gf_fs_post_task_ex(GF_FilterSession *fsess, gf_fs_task_callback task_fun, G
 			gf_fs_sema_io(fsess, GF_TRUE, GF_TRUE);
 		} else {
 			assert(task->run_task);
-			gf_fq_add(fsess->tasks, task);
+			gf_fs_add_secondary_task(fsess, task);
 			gf_fs_sema_io(fsess, GF_TRUE, GF_FALSE);
 		}
 	}
@@ -1275,7 +1684,7 @@ GF_Filter *gf_fs_load_filter(GF_FilterSession *fsess, const char *name, GF_Err *
 //this defines the sleep time for this case
 #define MONOTH_MIN_SLEEP	5
 
-static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
+static u32 gf_fs_thread_run(GF_SessionThread *sess_thread)
 {
 	GF_FilterSession *fsess = sess_thread->fsess;
 	u32 i, th_count = fsess->threads ? gf_list_count(fsess->threads) : 0;
@@ -1348,7 +1757,7 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 					task = gf_fq_pop(fsess->main_thread_tasks);
 				}
 				if (!task) {
-					task = gf_fq_pop(fsess->tasks);
+					task = gf_fs_pop_secondary_task(fsess, sess_thread);
 					if (task && task->blocking) {
 						gf_fq_add(fsess->tasks, task);
 						task = NULL;
@@ -1357,7 +1766,7 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 				}
 				force_secondary_tasks = GF_FALSE;
 			} else {
-				task = gf_fq_pop(fsess->tasks);
+				task = gf_fs_pop_secondary_task(fsess, sess_thread);
 			}
 			if (task) {
 				assert( task->run_task );
@@ -1405,7 +1814,7 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 
 			//no pending tasks and first time main task queue is empty, flush to detect if we
 			//are indeed done
-			if (!fsess->tasks_pending && !fsess->tasks_in_process && !sess_thread->has_seen_eot && !gf_fq_count(fsess->tasks)) {
+			if (!fsess->tasks_pending && !fsess->tasks_in_process && !sess_thread->has_seen_eot && !gf_fs_secondary_tasks_count(fsess)) {
 				//maybe last task, force a notify to check if we are truly done
 				sess_thread->has_seen_eot = GF_TRUE;
 				//not main thread and some tasks pending on main, notify only ourselves
@@ -1630,7 +2039,7 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 								gf_fs_sema_io(fsess, GF_TRUE, GF_TRUE);
 							}
 						} else {
-							gf_fq_add(fsess->tasks, task);
+							gf_fs_add_secondary_task(fsess, task);
 							//we are not the main thread and we are reposting to the secondary task list, don't notify/wait for the sema, just retry
 							//we are not sure to get a task from secondary list at next iteration, but the end of thread check will make
 							//sure we renotify secondary sema if some tasks are still pending
@@ -1662,6 +2071,7 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 			assert(!current_filter->in_process);
 			current_filter->in_process = GF_TRUE;
 			current_filter->process_th_id = gf_th_id();
+			current_filter->last_session_thread = sess_thread;
 		}
 
 		sess_thread->nb_tasks++;
@@ -1684,6 +2094,9 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 		task->run_task(task);
 		requeue = task->requeue_request;
 
+		if (fsess->flags & GF_FS_FLAG_PROFILE)
+			gf_fs_prof_task(fsess, task, task_time, gf_sys_clock_high_res(), requeue);
+
 		task_time = gf_sys_clock_high_res() - task_time;
 		safe_int_dec(& fsess->tasks_in_process );
 
@@ -1812,7 +2225,7 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 				if (task->filter && (task->filter->freg->flags & GF_FS_REG_MAIN_THREAD)) {
 					gf_fq_add(fsess->main_thread_tasks, task);
 				} else {
-					gf_fq_add(fsess->tasks, task);
+					gf_fs_add_secondary_task(fsess, task);
 				}
 				gf_fs_sema_io(fsess, GF_TRUE, use_main_sema);
 			}
@@ -1854,7 +2267,7 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 			current_filter->in_process = GF_FALSE;
 		}
 		//not requeuing and first time we have an empty task queue, flush to detect if we are indeed done
-		if (!current_filter && !fsess->tasks_pending && !sess_thread->has_seen_eot && !gf_fq_count(fsess->tasks)) {
+		if (!current_filter && !fsess->tasks_pending && !sess_thread->has_seen_eot && !gf_fs_secondary_tasks_count(fsess)) {
 			//if not the main thread, or if main thread and task list is empty, enter end of session probing mode
 			if (thid || !gf_fq_count(fsess->main_thread_tasks) ) {
 				//maybe last task, force a notify to check if we are truly done. We only tag "session done" for the non-main
@@ -1900,6 +2313,20 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 	return 0;
 }
 
+static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
+{
+	u32 ret;
+	GF_FilterSession *fsess = sess_thread->fsess;
+	u32 thid =  1 + gf_list_find(fsess->threads, sess_thread);
+
+	gf_fs_thread_set_affinity(fsess, sess_thread, thid);
+	ret = gf_fs_thread_run(sess_thread);
+	//main thread runs on the application thread, which may be used for other things once the session returns
+	if (!thid)
+		gf_fs_thread_restore_affinity(sess_thread);
+	return ret;
+}
+
 
 GF_EXPORT
 GF_Err gf_fs_run(GF_FilterSession *fsess)
@@ -2087,7 +2514,7 @@ GF_Err gf_fs_stop(GF_FilterSession *fsess)
 		if (gf_fq_count(fsess->main_thread_tasks))
 			continue;
 
-		if (count && (count == fsess->nb_threads_stopped) && gf_fq_count(fsess->tasks) ) {
+		if (count && (count == fsess->nb_threads_stopped) && gf_fs_secondary_tasks_count(fsess) ) {
 			continue;
 		}
 		break;
@@ -2140,6 +2567,165 @@ static GFINLINE void print_filter_name(GF_Filter *f, Bool skip_id, Bool skip_arg
 	GF_LOG(GF_LOG_INFO, GF_LOG_APP, (")"));
 }
 
+static void gf_fs_prof_printf(GF_BitStream *bs, const char *fmt, ...)
+{
+	char szLine[1024];
+	va_list vl;
+	va_start(vl, fmt);
+	vsnprintf(szLine, 1023, fmt, vl);
+	va_end(vl);
+	szLine[1023] = 0;
+	gf_bs_write_data(bs, szLine, (u32) strlen(szLine));
+}
+
+static void gf_fs_prof_print_str(GF_BitStream *bs, const char *name, const char *str)
+{
+	gf_fs_prof_printf(bs, "\"%s\":", name);
+	if (!str) {
+		gf_fs_prof_printf(bs, "null");
+		return;
+	}
+	gf_bs_write_u8(bs, '"');
+	while (*str) {
+		u8 c = (u8) *str;
+		if ((c=='"') || (c=='\\')) {
+			gf_bs_write_u8(bs, '\\');
+			gf_bs_write_u8(bs, c);
+		} else if (c<0x20) {
+			gf_fs_prof_printf(bs, "\\u%04x", c);
+		} else {
+			gf_bs_write_u8(bs, c);
+		}
+		str++;
+	}
+	gf_bs_write_u8(bs, '"');
+}
+
+//upper value of a histogram bucket
+static u64 gf_fs_histo_bucket_max(u32 idx)
+{
+	u32 msb, sub;
+	if (idx < 16) return idx;
+	msb = 4 + (idx-16) / 8;
+	sub = (idx-16) % 8;
+	return (((u64) (9+sub)) << (msb-3)) - 1;
+}
+
+static u64 gf_fs_histo_percentile(GF_FSHistogram *h, u32 per_thousand)
+{
+	u32 i;
+	u64 nb = 0;
+	u64 target = (h->count * per_thousand + 999) / 1000;
+	if (!target) target = 1;
+	for (i=0; i<GF_FS_HISTO_SIZE; i++) {
+		nb += h->buckets[i];
+		if (nb >= target) {
+			u64 val = gf_fs_histo_bucket_max(i);
+			return MIN(val, h->max);
+		}
+	}
+	return h->max;
+}
+
+static void gf_fs_prof_print_histo(GF_BitStream *bs, const char *name, GF_FSHistogram *h, Bool reset)
+{
+	u32 i;
+	Bool first = GF_TRUE;
+	if (!h || !h->count) {
+		gf_fs_prof_printf(bs, "\"%s\":{\"count\":0}", name);
+		return;
+	}
+	gf_fs_prof_printf(bs, "\"%s\":{\"count\":"LLU",\"sum\":"LLU",\"mean\":%g,\"max\":"LLU",\"p50\":"LLU",\"p90\":"LLU",\"p99\":"LLU",\"p999\":"LLU",\"buckets\":[",
+		name, h->count, h->sum, (Double) h->sum / h->count, h->max,
+		gf_fs_histo_percentile(h, 500), gf_fs_histo_percentile(h, 900), gf_fs_histo_percentile(h, 990), gf_fs_histo_percentile(h, 999));
+	//sparse [max_value, count] pairs
+	for (i=0; i<GF_FS_HISTO_SIZE; i++) {
+		if (!h->buckets[i]) continue;
+		gf_fs_prof_printf(bs, "%s["LLU",%u]", first ? "" : ",", gf_fs_histo_bucket_max(i), h->buckets[i]);
+		first = GF_FALSE;
+	}
+	gf_fs_prof_printf(bs, "]}");
+	if (reset) memset(h, 0, sizeof(GF_FSHistogram));
+}
+
+static void gf_fs_prof_print_tasks(GF_BitStream *bs, GF_List *tasks, Bool reset)
+{
+	u32 i, count = gf_list_count(tasks);
+	gf_fs_prof_printf(bs, "\"tasks\":[");
+	for (i=0; i<count; i++) {
+		GF_FSTaskProfile *tp = gf_list_get(tasks, i);
+		gf_fs_prof_printf(bs, "%s{", i ? "," : "");
+		gf_fs_prof_print_str(bs, "name", tp->name);
+		gf_fs_prof_printf(bs, ",");
+		gf_fs_prof_print_histo(bs, "exec", &tp->exec, reset);
+		gf_fs_prof_printf(bs, ",");
+		gf_fs_prof_print_histo(bs, "wait", &tp->wait, reset);
+		if (tp->sched.count) {
+			gf_fs_prof_printf(bs, ",");
+			gf_fs_prof_print_histo(bs, "sched", &tp->sched, reset);
+		}
+		gf_fs_prof_printf(bs, "}");
+	}
+	gf_fs_prof_printf(bs, "]");
+}
+
+GF_EXPORT
+char *gf_fs_get_profile(GF_FilterSession *fsess, Bool reset)
+{
+	u32 i, count, nb_filters=0;
+	u8 *data = NULL;
+	u32 size;
+	GF_BitStream *bs;
+	if (!fsess || !(fsess->flags & GF_FS_FLAG_PROFILE)) return NULL;
+
+	bs = gf_bs_new(NULL, 0, GF_BITSTREAM_WRITE_DYN);
+	if (!bs) return NULL;
+
+	gf_fs_prof_printf(bs, "{\"clock\":"LLU",\"threads\":[", gf_sys_clock_high_res());
+	gf_fs_prof_printf(bs, "{\"thread\":1,\"nb_tasks\":"LLU",\"active_time\":"LLU"}", fsess->main_th.nb_tasks, fsess->main_th.active_time);
+	count = gf_list_count(fsess->threads);
+	for (i=0; i<count; i++) {
+		GF_SessionThread *sth = gf_list_get(fsess->threads, i);
+		gf_fs_prof_printf(bs, ",{\"thread\":%u,\"nb_tasks\":"LLU",\"active_time\":"LLU"}", i+2, sth->nb_tasks, sth->active_time);
+	}
+	gf_fs_prof_printf(bs, "],\"session\":{");
+	gf_mx_p(fsess->prof_mx);
+	gf_fs_prof_print_tasks(bs, fsess->prof_tasks, reset);
+	gf_mx_v(fsess->prof_mx);
+	gf_fs_prof_printf(bs, "},\"filters\":[");
+
+	gf_mx_p(fsess->filters_mx);
+	count = gf_list_count(fsess->filters);
+	for (i=0; i<count; i++) {
+		GF_Filter *f = gf_list_get(fsess->filters, i);
+		if (f->multi_sink_target) continue;
+
+		gf_mx_p(f->tasks_mx);
+		gf_fs_prof_printf(bs, "%s{", nb_filters ? "," : "");
+		gf_fs_prof_print_str(bs, "name", f->name);
+		gf_fs_prof_printf(bs, ",");
+		gf_fs_prof_print_str(bs, "reg", f->freg->name);
+		gf_fs_prof_printf(bs, ",");
+		gf_fs_prof_print_str(bs, "id", f->id);
+		gf_fs_prof_printf(bs, ",\"idx\":%u,\"nb_tasks\":"LLU",\"time_process\":"LLU",\"nb_pck_processed\":"LLU",\"nb_pck_sent\":"LLU",", i, f->nb_tasks_done, f->time_process, f->nb_pck_processed, f->nb_pck_sent);
+		gf_fs_prof_print_tasks(bs, f->prof_tasks, reset);
+		gf_fs_prof_printf(bs, ",");
+		gf_fs_prof_print_histo(bs, "output_blocked", f->prof_block, reset);
+		gf_fs_prof_printf(bs, ",");
+		gf_fs_prof_print_histo(bs, "input_stall", f->prof_stall, reset);
+		gf_fs_prof_printf(bs, "}");
+		gf_mx_v(f->tasks_mx);
+		nb_filters++;
+	}
+	gf_mx_v(fsess->filters_mx);
+	gf_fs_prof_printf(bs, "]}");
+	gf_bs_write_u8(bs, 0);
+
+	gf_bs_get_content(bs, &data, &size);
+	gf_bs_del(bs);
+	return (char *) data;
+}
+
 GF_EXPORT
 void gf_fs_print_stats(GF_FilterSession *fsess)
 {
@@ -2235,6 +2821,25 @@ void gf_fs_print_stats(GF_FilterSession *fsess)
 		nb_tasks+=s->nb_tasks;
 	}
 	GF_LOG(GF_LOG_INFO, GF_LOG_APP, ("\nTotal: run_time "LLU" us active_time "LLU" us nb_tasks "LLU"\n", run_time, active_time, nb_tasks));
+
+	if (fsess->pck_slab_mx) {
+		GF_FilterPacketMemStats mstats;
+		u64 reserved=0, used=0;
+		GF_LOG(GF_LOG_INFO, GF_LOG_APP, ("Packet memory stats\n"));
+		i=0;
+		while (gf_fs_get_packet_memory_stats(fsess, i, &mstats)==GF_OK) {
+			i++;
+			if (!mstats.nb_blocks) continue;
+			reserved += mstats.bytes_reserved;
+			used += mstats.bytes_used;
+			if (mstats.block_size) {
+				GF_LOG(GF_LOG_INFO, GF_LOG_APP, ("\tBlock size %u: %u blocks %u free\n", mstats.block_size, mstats.nb_blocks, mstats.nb_free));
+			} else {
+				GF_LOG(GF_LOG_INFO, GF_LOG_APP, ("\tLarge blocks: %u blocks "LLU" bytes\n", mstats.nb_blocks, mstats.bytes_reserved));
+			}
+		}
+		GF_LOG(GF_LOG_INFO, GF_LOG_APP, ("Total: reserved "LLU" bytes used "LLU" bytes\n", reserved, used));
+	}
 }
 
 static void gf_fs_print_filter_outputs(GF_Filter *f, GF_List *filters_done, u32 indent, GF_FilterPid *pid, GF_Filter *alias_for, u32 src_num_tiled_pids, Bool skip_print)
@@ -3332,6 +3937,8 @@ typedef struct
 	void *callback;
 	Bool (*task_execute) (GF_FilterSession *fsess, void *callback, u32 *reschedule_ms);
 	Bool (*task_execute_filter) (GF_Filter *filter, void *callback, u32 *reschedule_ms);
+	//filter for parallel tasks, not bound to the filter
+	GF_Filter *filter;
 #ifndef GPAC_DISABLE_REMOTERY
 	rmtU32 rmt_hash;
 #endif
@@ -3350,6 +3957,8 @@ static void do_fs_user_task(GF_FSTask *task, Bool free_log_name)
 		task->requeue_request = utask->task_execute(utask->fsess, utask->callback, &reschedule_ms);
 	} else if (task->filter) {
 		task->requeue_request = utask->task_execute_filter(task->filter, utask->callback, &reschedule_ms);
+	} else if (utask->filter) {
+		task->requeue_request = utask->task_execute_filter(utask->filter, utask->callback, &reschedule_ms);
 	} else {
 		task->requeue_request = 0;
 	}
@@ -3407,6 +4016,33 @@ GF_Err gf_filter_post_task(GF_Filter *filter, Bool (*task_execute) (GF_Filter *f
 	return GF_OK;
 }
 
+GF_EXPORT
+GF_Err gf_filter_post_parallel_task(GF_Filter *filter, Bool (*task_execute) (GF_Filter *filter, void *callback, u32 *reschedule_ms), void *udta, const char *task_name)
+{
+	GF_UserTask *utask;
+	if (!filter || !task_execute) return GF_BAD_PARAM;
+	GF_SAFEALLOC(utask, GF_UserTask);
+	if (!utask) return GF_OUT_OF_MEM;
+	utask->callback = udta;
+	utask->task_execute_filter = task_execute;
+	utask->filter = filter;
+	utask->fsess = filter->session;
+	//not bound to the filter, posted on the secondary task list and processed by any thread
+	gf_fs_post_task(filter->session, gf_fs_user_task, NULL, NULL, task_name ? task_name : "user_task", utask);
+	//the posting filter may block its thread until the task is done: secondary threads may all be busy, and the main thread
+	//is only woken by secondary threads going idle, so wake it up to process the task
+	if (filter->session->semaphore_main != filter->session->semaphore_other)
+		gf_fs_sema_io(filter->session, GF_TRUE, GF_TRUE);
+	return GF_OK;
+}
+
+GF_EXPORT
+u32 gf_filter_get_num_threads(GF_Filter *filter)
+{
+	if (!filter) return 0;
+	return gf_list_count(filter->session->threads);
+}
+
 
 GF_EXPORT
 Bool gf_fs_is_last_task(GF_FilterSession *fsess)
@@ -3414,7 +4050,7 @@ Bool gf_fs_is_last_task(GF_FilterSession *fsess)
 	if (!fsess) return GF_TRUE;
 	if (fsess->tasks_pending>1) return GF_FALSE;
 	if (gf_fq_count(fsess->main_thread_tasks)) return GF_FALSE;
-	if (gf_fq_count(fsess->tasks)) return GF_FALSE;
+	if (gf_fs_secondary_tasks_count(fsess)) return GF_FALSE;
 	return GF_TRUE;
 }
 
@@ -3568,6 +4204,180 @@ GF_Err gf_fs_get_filter_stats(GF_FilterSession *session, u32 idx, GF_FilterStats
 	return gf_filter_get_stats(gf_list_get(session->filters, idx), stats);
 }
 
+static u32 slab_class(u32 size)
+{
+	u32 nbits;
+	if (size <= (1<<GF_FS_SLAB_MIN_SHIFT)) return 0;
+	//size is in ]2^(nbits-1), 2^nbits], split in 4 classes
+	nbits = gf_get_bit_size(size-1);
+	return 1 + (nbits - 1 - GF_FS_SLAB_MIN_SHIFT)*4 + (size - 1 - (1<<(nbits-1))) / (1<<(nbits-3));
+}
+
+static u32 slab_class_size(u32 idx)
+{
+	u32 base;
+	if (!idx) return 1<<GF_FS_SLAB_MIN_SHIFT;
+	idx--;
+	base = 1 << (GF_FS_SLAB_MIN_SHIFT + idx/4);
+	return base + (idx%4 + 1) * (base/4);
+}
+
+#define SLAB_MAX_SIZE	(1<<(GF_FS_SLAB_MIN_SHIFT + (GF_FS_SLAB_CLASSES-1)/4))
+
+u32 gf_fs_pck_data_block_size(GF_FilterSession *fsess, u32 size)
+{
+	if (!fsess->pck_slab_mx || (size > SLAB_MAX_SIZE)) return size;
+	return slab_class_size(slab_class(size));
+}
+
+char *gf_fs_pck_data_alloc(GF_FilterSession *fsess, u32 size, u32 *alloc_size)
+{
+	char *data;
+	u32 idx;
+	GF_FSSlabClass *sc;
+
+	if (!fsess->pck_slab_mx || (size > SLAB_MAX_SIZE)) {
+		data = gf_malloc(sizeof(char)*size);
+		*alloc_size = data ? size : 0;
+		if (data && fsess->pck_slab_mx) {
+			gf_mx_p(fsess->pck_slab_mx);
+			fsess->pck_slab_nb_large++;
+			fsess->pck_slab_large += size;
+			gf_mx_v(fsess->pck_slab_mx);
+		}
+		return data;
+	}
+	idx = slab_class(size);
+	sc = &fsess->pck_slab[idx];
+	size = slab_class_size(idx);
+
+	gf_mx_p(fsess->pck_slab_mx);
+	data = sc->free_blocks;
+	if (data) {
+		sc->free_blocks = *(void **)data;
+		sc->nb_free--;
+		fsess->pck_slab_idle -= size;
+	} else {
+		data = gf_malloc(sizeof(char)*size);
+		if (data) sc->nb_blocks++;
+	}
+	gf_mx_v(fsess->pck_slab_mx);
+
+	*alloc_size = data ? size : 0;
+	return data;
+}
+
+void gf_fs_pck_data_free(GF_FilterSession *fsess, char *data, u32 alloc_size)
+{
+	GF_FSSlabClass *sc;
+	if (!data) return;
+	if (!fsess->pck_slab_mx) {
+		gf_free(data);
+		return;
+	}
+	gf_mx_p(fsess->pck_slab_mx);
+	if (alloc_size > SLAB_MAX_SIZE) {
+		fsess->pck_slab_nb_large--;
+		fsess->pck_slab_large -= alloc_size;
+		gf_mx_v(fsess->pck_slab_mx);
+		gf_free(data);
+		return;
+	}
+	sc = &fsess->pck_slab[slab_class(alloc_size)];
+	assert(slab_class_size(slab_class(alloc_size)) == alloc_size);
+	//over cap, release block
+	if (fsess->pck_slab_idle + alloc_size > fsess->pck_slab_cap) {
+		sc->nb_blocks--;
+		gf_mx_v(fsess->pck_slab_mx);
+		gf_free(data);
+		return;
+	}
+	*(void **)data = sc->free_blocks;
+	sc->free_blocks = data;
+	sc->nb_free++;
+	fsess->pck_slab_idle += alloc_size;
+	gf_mx_v(fsess->pck_slab_mx);
+}
+
+char *gf_fs_pck_data_realloc(GF_FilterSession *fsess, char *data, u32 data_length, u32 *alloc_size, u32 size)
+{
+	char *new_data;
+	u32 new_size;
+	if (size <= *alloc_size) return data;
+
+	//direct allocations
+	if (!fsess->pck_slab_mx || ((*alloc_size > SLAB_MAX_SIZE) && (size > SLAB_MAX_SIZE))) {
+		new_data = gf_realloc(data, sizeof(char)*size);
+		if (!new_data) return NULL;
+		if (fsess->pck_slab_mx) {
+			gf_mx_p(fsess->pck_slab_mx);
+			fsess->pck_slab_large += size - *alloc_size;
+			gf_mx_v(fsess->pck_slab_mx);
+		}
+		*alloc_size = size;
+		return new_data;
+	}
+	new_data = gf_fs_pck_data_alloc(fsess, size, &new_size);
+	if (!new_data) return NULL;
+	if (data) {
+		memcpy(new_data, data, MIN(data_length, *alloc_size));
+		gf_fs_pck_data_free(fsess, data, *alloc_size);
+	}
+	*alloc_size = new_size;
+	return new_data;
+}
+
+GF_EXPORT
+GF_Err gf_fs_get_packet_memory_stats(GF_FilterSession *session, u32 idx, GF_FilterPacketMemStats *stats)
+{
+	if (!stats || !session) return GF_BAD_PARAM;
+	if (!session->pck_slab_mx) return GF_NOT_SUPPORTED;
+	if (idx > GF_FS_SLAB_CLASSES) return GF_EOS;
+
+	memset(stats, 0, sizeof(GF_FilterPacketMemStats));
+	gf_mx_p(session->pck_slab_mx);
+	if (idx == GF_FS_SLAB_CLASSES) {
+		stats->nb_blocks = session->pck_slab_nb_large;
+		stats->bytes_reserved = stats->bytes_used = session->pck_slab_large;
+	} else {
+		GF_FSSlabClass *sc = &session->pck_slab[idx];
+		stats->block_size = slab_class_size(idx);
+		stats->nb_blocks = sc->nb_blocks;
+		stats->nb_free = sc->nb_free;
+		stats->bytes_reserved = (u64) sc->nb_blocks * stats->block_size;
+		stats->bytes_used = (u64) (sc->nb_blocks - sc->nb_free) * stats->block_size;
+	}
+	gf_mx_v(session->pck_slab_mx);
+	return GF_OK;
+}
+
+GF_EXPORT
+u64 gf_fs_trim_packet_memory(GF_FilterSession *session, u64 max_idle)
+{
+	u32 i;
+	u64 released = 0;
+	if (!session || !session->pck_slab_mx) return 0;
+
+	gf_mx_p(session->pck_slab_mx);
+	i = GF_FS_SLAB_CLASSES;
+	while (i && (session->pck_slab_idle > max_idle)) {
+		GF_FSSlabClass *sc = &session->pck_slab[i-1];
+		u32 size = slab_class_size(i-1);
+		while (sc->free_blocks && (session->pck_slab_idle > max_idle)) {
+			void *block = sc->free_blocks;
+			sc->free_blocks = *(void **)block;
+			sc->nb_free--;
+			sc->nb_blocks--;
+			session->pck_slab_idle -= size;
+			released += size;
+			gf_free(block);
+		}
+		i--;
+	}
+	gf_mx_v(session->pck_slab_mx);
+	return released;
+}
+
 Bool gf_fs_ui_event(GF_FilterSession *session, GF_Event *uievt)
 {
 	Bool ret;
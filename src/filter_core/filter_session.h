@@ -120,6 +120,17 @@ u32 gf_fq_count(GF_FilterQueue *fq);
 void *gf_fq_get(GF_FilterQueue *fq, u32 idx);
 void gf_fq_enum(GF_FilterQueue *fq, Bool (*enum_func)(void *udta1, void *item), void *udta);
 
+typedef struct __gf_filter_deque GF_FilterDeque;
+//constructs a new bounded lock-free work-stealing deque, size is rounded up to a power of 2
+//items are only pushed by the thread owning the deque, and taken in push order by any thread including the owner
+GF_FilterDeque *gf_fdq_new(u32 size);
+void gf_fdq_del(GF_FilterDeque *dq, void (*item_delete)(void *) );
+//pushes an item at the bottom of the deque, shall only be called by the owner thread - returns GF_FALSE if the deque is full
+Bool gf_fdq_push(GF_FilterDeque *dq, void *item);
+//takes the item at the top of the deque, may be called by any thread
+void *gf_fdq_take(GF_FilterDeque *dq);
+u32 gf_fdq_count(GF_FilterDeque *dq);
+
 
 typedef void (*gf_destruct_fun)(void *cbck);
 
@@ -281,7 +292,8 @@ struct __gf_fs_task
 	Bool blocking;
 
 	u64 schedule_next_time;
-
+	//time at which the task was posted or requeued, only set when profiling
+	u64 post_time;
 
 	gf_fs_task_callback run_task;
 	GF_Filter *filter;
@@ -299,6 +311,59 @@ void gf_fs_post_task_ex(GF_FilterSession *fsess, gf_fs_task_callback task_fun, G
 void gf_filter_pid_send_event_downstream(GF_FSTask *task);
 
 
+//log-linear latency histogram in microseconds: values below 16 us are exact, larger values use 8 buckets per power of two (12.5% precision)
+#define GF_FS_HISTO_SIZE	(16 + 36*8)
+
+typedef struct
+{
+	u64 count, sum, max;
+	u32 buckets[GF_FS_HISTO_SIZE];
+} GF_FSHistogram;
+
+void gf_fs_histo_add(GF_FSHistogram *h, u64 val);
+//allocates histogram if needed
+void gf_fs_histo_push(GF_FSHistogram **h, u64 val);
+
+//profiling of a task type (identified by its log name) for a filter or for the session
+typedef struct
+{
+	const char *name;
+	//execution time
+	GF_FSHistogram exec;
+	//time spent in task lists once ready for execution
+	GF_FSHistogram wait;
+	//delay after requested execution time, for rescheduled tasks only
+	GF_FSHistogram sched;
+} GF_FSTaskProfile;
+
+void gf_fs_prof_del_tasks(GF_List *tasks);
+
+//size classes of packet payloads: one class up to 256 bytes, then 4 classes per power of two up to 8 MBytes
+//larger payloads are allocated and freed directly
+#define GF_FS_SLAB_MIN_SHIFT	8
+#define GF_FS_SLAB_CLASSES	(1 + 15*4)
+
+typedef struct
+{
+	//unused blocks, linked through their first bytes
+	void *free_blocks;
+	u32 nb_free;
+	//number of blocks allocated for this class, free or not
+	u32 nb_blocks;
+} GF_FSSlabClass;
+
+//gets allocation size of a payload of the given size
+u32 gf_fs_pck_data_block_size(GF_FilterSession *fsess, u32 size);
+//allocates a payload block, alloc_size is set to the size of the block
+char *gf_fs_pck_data_alloc(GF_FilterSession *fsess, u32 size, u32 *alloc_size);
+//releases a payload block allocated with gf_fs_pck_data_alloc
+void gf_fs_pck_data_free(GF_FilterSession *fsess, char *data, u32 alloc_size);
+//reallocates a payload block, keeping its first data_length bytes
+char *gf_fs_pck_data_realloc(GF_FilterSession *fsess, char *data, u32 data_length, u32 *alloc_size, u32 size);
+
+//number of tasks a thread can post to its own deque in work-stealing mode, further tasks go to its mutex-protected queue
+#define GF_FS_THREAD_DEQUE_SIZE	256
+
 typedef struct __gf_fs_thread
 {
 	//NULL for main thread
@@ -308,6 +373,24 @@ typedef struct __gf_fs_thread
 	
 	Bool has_seen_eot; //set when no more tasks in global queue
 
+	//own task lists in work-stealing mode, NULL otherwise
+	//tasks posted by the thread itself go to the deque, tasks posted by other threads (or when the deque is full) go to the queue
+	//both are taken by the thread itself and by other threads when stealing, the queue is protected by tasks_mx
+	GF_FilterDeque *local_tasks;
+	GF_FilterQueue *tasks;
+	GF_Mutex *tasks_mx;
+	//index of next thread to steal tasks from
+	u32 steal_idx;
+	//NUMA node the thread runs on, -1 if unknown
+	s32 numa_node;
+	Bool affinity_done;
+	//CPU set of the thread, NULL if not restricted
+	u32 *cpus;
+	u32 nb_cpus;
+	//CPU set of the calling application thread, restored when the main thread leaves the session
+	u32 *saved_cpus;
+	u32 nb_saved_cpus;
+
 	u64 nb_tasks;
 	u64 run_time;
 	u64 active_time;
@@ -344,6 +427,7 @@ struct __gf_filter_session
 	u32 flags;
 	Bool use_locks;
 	Bool direct_mode;
+	Bool work_stealing;
 	volatile u32 tasks_in_process;
 	Bool requires_solved_graph;
 	Bool no_main_thread;
@@ -468,6 +552,28 @@ struct __gf_filter_session
 	gf_fs_on_filter_creation on_filter_create_destroy;
 	void *rt_udta;
 
+	//CPU affinity of session threads, applied when threads start, with NUMA node of each CPU
+	u32 *cpus;
+	s32 *cpu_nodes;
+	u32 nb_cpus;
+	//distinct NUMA nodes of the CPU set, only set in NUMA mode
+	s32 *numa_nodes;
+	u32 nb_numa_nodes;
+	Bool cpu_pin;
+
+	//profiling of filter-less tasks, protected by prof_mx
+	GF_List *prof_tasks;
+	GF_Mutex *prof_mx;
+
+	//size-classed payloads of allocated packets, shared by all filters, protected by pck_slab_mx - disabled if pck_slab_mx is NULL
+	GF_FSSlabClass pck_slab[GF_FS_SLAB_CLASSES];
+	GF_Mutex *pck_slab_mx;
+	//max bytes kept in unused blocks, and current value
+	u64 pck_slab_cap, pck_slab_idle;
+	//payloads above the largest size class
+	u32 pck_slab_nb_large;
+	u64 pck_slab_large;
+
 #ifdef GF_FS_ENABLE_LOCALES
 	GF_List *uri_relocators;
 	GF_FSLocales locales;
@@ -551,6 +657,8 @@ struct __gf_filter
 	//set to true when the filter is being processed by a thread
 	volatile Bool in_process;
 	u32 process_th_id;
+	//session thread which last processed this filter, used to post tasks in work-stealing mode
+	GF_SessionThread *last_session_thread;
 	//user data for the filter implementation
 	void *filter_udta;
 
@@ -641,6 +749,14 @@ struct __gf_filter
 	//number of microseconds this filter was active
 	u64 time_process;
 
+	//profiling, only allocated if session has GF_FS_FLAG_PROFILE
+	//task latencies per task type, modified when executing tasks of the filter and read under tasks_mx
+	GF_List *prof_tasks;
+	//time output PIDs spent blocked, modified under tasks_mx
+	GF_FSHistogram *prof_block;
+	//time input PIDs had no packet available, modified when executing tasks of the filter
+	GF_FSHistogram *prof_stall;
+
 #ifdef GPAC_MEMORY_TRACKING
 	//various stats in mem tracking mode, mostly used to detect heavy alloc/free usage by the filter
 	u64 stats_mem_allocated;
@@ -876,6 +992,9 @@ struct __gf_filter_pid_inst
 
 	u64 last_buf_query_clock;
 	u64 last_buf_query_dur;
+
+	//profiling, time at which the consumer found the PID empty
+	u64 prof_stall_start;
 };
 
 struct __gf_filter_pid
@@ -954,6 +1073,9 @@ struct __gf_filter_pid
 	//only used in filter_check_caps
 	GF_PropertyMap *local_props;
 	volatile u32 num_pidinst_del_pending;
+
+	//profiling, time at which the PID entered the blocking state
+	u64 prof_block_start;
 };
 
 
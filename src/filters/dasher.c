@@ -163,6 +163,7 @@ typedef struct
 	char *mname;
 	char *hlsdrm;
 	u32 llhls;
+	u32 ahead;
 	//inherited from mp4mx
 	GF_Fraction cdur;
 
@@ -233,7 +234,8 @@ typedef struct
 
 	u32 forward_mode;
 	
-	u8 last_hls_signature[GF_SHA1_DIGEST_SIZE], last_mpd_signature[GF_SHA1_DIGEST_SIZE], last_hls2_signature[GF_SHA1_DIGEST_SIZE];
+	//in-memory manifests: last sent MPD, HLS master and HLS second pass master, and scratch buffer for the next one
+	FILE *last_mpd, *last_hls, *last_hls2, *manifest_buf;
 
 	GF_CryptInfo *cinfo;
 
@@ -243,6 +245,11 @@ typedef struct
 	u64 min_segment_start_time, last_min_segment_start_time;
 
 	u32 def_max_seg_dur;
+
+	//representations are segmented independently, up to ahead segments in advance
+	Bool use_ahead;
+	//set when all representations of a set are done with a given segment in ahead mode
+	Bool seg_joined;
 } GF_DasherCtx;
 
 typedef enum
@@ -301,6 +308,8 @@ typedef struct _dash_stream
 
 	u32 nb_rep, nb_rep_done;
 	Double set_seg_duration;
+	//pending segment joins for the set in ahead mode
+	GF_List *seg_joins;
 
 	//repID for this stream, generated if not found
 	char *rep_id;
@@ -442,6 +451,14 @@ typedef struct _dash_stream
 	u64 last_min_segment_start_time;
 } GF_DashStream;
 
+//segment completion state across representations of a set, in ahead mode
+typedef struct
+{
+	u32 seg_number;
+	u32 nb_done;
+	Double duration;
+} DasherSegJoin;
+
 static void dasher_flush_segment(GF_DasherCtx *ctx, GF_DashStream *ds, Bool is_last_in_period);
 static void dasher_update_rep(GF_DasherCtx *ctx, GF_DashStream *ds);
 static void dasher_reset_stream(GF_Filter *filter, GF_DashStream *ds, Bool is_destroy);
@@ -3877,6 +3894,7 @@ static void dasher_purge_segment_timeline(GF_DashStream *ds, GF_MPD_SegmentTimel
 {
 	GF_MPD_SegmentTimelineEntry *stl_e = gf_list_get(stl->entries, 0);
 	if (!stl_e) return;
+	stl->modified = GF_TRUE;
 
 	if (stl_e->repeat_count) {
 		stl_e->repeat_count--;
@@ -4134,15 +4152,20 @@ static void dasher_transfer_file(FILE *f, GF_FilterPid *opid, const char *name,
 	GF_FilterPacket *pck;
 	u32 size, nb_read;
 	u8 *output;
+	const u8 *data = gf_file_mem_get_data(f, &size);
 
-	size = (u32) gf_fsize(f);
+	if (!data) size = (u32) gf_fsize(f);
 
 	pck = gf_filter_pck_new_alloc(opid, size, &output);
 	if (!pck) return;
 
-	nb_read = (u32) gf_fread(output, size, f);
-	if (nb_read != size) {
-		GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[Dasher] Error reading temp MPD file, read %d bytes but file size is %d\n", nb_read, size ));
+	if (data) {
+		memcpy(output, data, size);
+	} else {
+		nb_read = (u32) gf_fread(output, size, f);
+		if (nb_read != size) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[Dasher] Error reading temp MPD file, read %d bytes but file size is %d\n", nb_read, size ));
+		}
 	}
 	gf_filter_pck_set_framing(pck, GF_TRUE, GF_TRUE);
 	gf_filter_pck_set_seek_flag(pck, GF_TRUE);
@@ -4344,7 +4367,11 @@ static void dasher_forward_mpd(GF_DasherCtx *ctx, const char *manifest)
 
 
 	//and send
-	tmp = gf_file_temp(NULL);
+	tmp = gf_file_mem_new();
+	if (!tmp) {
+		e = GF_OUT_OF_MEM;
+		goto err_exit;
+	}
 	mpd->xml_namespace = ctx->mpd->xml_namespace;
 	mpd->publishTime = dasher_get_utc(ctx);
 	e = gf_mpd_write(mpd, tmp, ctx->cmpd);
@@ -4366,10 +4393,18 @@ err_exit:
 
 static GF_Err dasher_write_and_send_manifest(GF_DasherCtx *ctx, u64 last_period_dur, Bool do_m3u8, Bool m3u8_second_pass, GF_FilterPid *opid, char *alt_name)
 {
-	void *last_signature;
-	u8 sig[GF_SHA1_DIGEST_SIZE];
+	FILE **last_sent;
+	const u8 *data, *last_data;
+	u32 size, last_size;
 	GF_Err e;
-	FILE *tmp = gf_file_temp(NULL);
+	FILE *tmp = ctx->manifest_buf;
+
+	if (!tmp) {
+		tmp = ctx->manifest_buf = gf_file_mem_new();
+		if (!tmp) return GF_OUT_OF_MEM;
+	} else {
+		gf_file_mem_reset(tmp);
+	}
 	if (do_m3u8) {
 		ctx->mpd->m3u8_time = ctx->hlsc;
 		if (ctx->llhls==3)
@@ -4388,7 +4423,6 @@ static GF_Err dasher_write_and_send_manifest(GF_DasherCtx *ctx, u64 last_period_
 
 	if (e) {
 		GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[Dasher] failed to write %s file: %s\n", do_m3u8 ? "M3U8" : "MPD", gf_error_to_string(e) ));
-		gf_fclose(tmp);
 		if (ctx->current_period->period)
 			ctx->current_period->period->duration = last_period_dur;
 		return e;
@@ -4399,19 +4433,19 @@ static GF_Err dasher_write_and_send_manifest(GF_DasherCtx *ctx, u64 last_period_
 			GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[Dasher] manifest MPD is too big for HbbTV 1.5. Limit is 100kB, current size is "LLU"kB\n", gf_ftell(tmp) / 1024));
 	}
 
-	gf_sha1_file_ptr(tmp, sig);
 	if (do_m3u8) {
-		last_signature = (void *) m3u8_second_pass ? ctx->last_hls2_signature : ctx->last_hls_signature;
+		last_sent = m3u8_second_pass ? &ctx->last_hls2 : &ctx->last_hls;
 	} else {
-		last_signature = (void *) ctx->last_mpd_signature;
+		last_sent = &ctx->last_mpd;
 	}
-
-	if (memcmp(sig, last_signature, GF_SHA1_DIGEST_SIZE)) {
-		memcpy(last_signature, sig, GF_SHA1_DIGEST_SIZE);
-
+	//only send if changed since last manifest, and keep the sent one for next check
+	data = gf_file_mem_get_data(tmp, &size);
+	last_data = gf_file_mem_get_data(*last_sent, &last_size);
+	if (!*last_sent || (size != last_size) || (size && memcmp(data, last_data, size))) {
 		dasher_transfer_file(tmp, opid, alt_name, NULL);
+		ctx->manifest_buf = *last_sent;
+		*last_sent = tmp;
 	}
-	gf_fclose(tmp);
 	return GF_OK;
 }
 
@@ -4649,6 +4683,15 @@ static void dasher_reset_stream(GF_Filter *filter, GF_DashStream *ds, Bool is_de
 	if (ds->pending_segment_states) gf_list_del(ds->pending_segment_states);
 	ds->pending_segment_states = NULL;
 
+	if (ds->seg_joins) {
+		while (gf_list_count(ds->seg_joins)) {
+			DasherSegJoin *sj = gf_list_pop_back(ds->seg_joins);
+			gf_free(sj);
+		}
+		gf_list_del(ds->seg_joins);
+		ds->seg_joins = NULL;
+	}
+
 	if (is_destroy) {
 		if (ds->cues) gf_free(ds->cues);
 		gf_list_del(ds->complementary_streams);
@@ -6241,6 +6284,10 @@ static void dasher_insert_timeline_entry(GF_DasherCtx *ctx, GF_DashStream *ds)
 		}
 	}
 
+	//we are the only writer of the timeline, flag changes so that unchanged entries are not checked when serializing
+	tl->track_changes = GF_TRUE;
+	tl->modified = GF_TRUE;
+
 	//append to previous entry if possible
 	s = gf_list_last(tl->entries);
 	if (s && (s->duration == duration) && (s->start_time + (s->repeat_count+1) * s->duration == ds->seg_start_time + pto)) {
@@ -6305,6 +6352,8 @@ static void dasher_copy_segment_timelines(GF_DasherCtx *ctx, GF_MPD_AdaptationSe
 			tl = rep->segment_list->segment_timeline;
 		}
 		assert(tl);
+		tl->track_changes = GF_TRUE;
+		tl->modified = GF_TRUE;
 		for (j=0; j<nb_s; j++) {
 			GF_MPD_SegmentTimelineEntry *s;
 			GF_MPD_SegmentTimelineEntry *src_s = gf_list_get(src_tl->entries, j);
@@ -6319,6 +6368,108 @@ static void dasher_copy_segment_timelines(GF_DasherCtx *ctx, GF_MPD_AdaptationSe
 	}
 }
 
+static void dasher_check_seg_alignment(GF_DasherCtx *ctx, GF_DashStream *set_ds, Double ref_duration, Double seg_duration, u32 seg_number)
+{
+	Double diff = ref_duration - seg_duration;
+
+	if (ABS(diff) > 0.001) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[Dasher] Segments are not aligned across representations: first rep segment duration %g but new segment duration %g for the same segment %d\n", ref_duration, seg_duration, seg_number));
+
+		if (ctx->profile != GF_DASH_PROFILE_FULL) {
+			set_ds->set->segment_alignment = GF_FALSE;
+			set_ds->set->subsegment_alignment = GF_FALSE;
+			ctx->profile = GF_DASH_PROFILE_FULL;
+			GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[Dasher] No segment alignment, switching to full profile\n"));
+			dasher_copy_segment_timelines(ctx, set_ds->set);
+		}
+	}
+}
+
+//in ahead mode, representations of a set complete their segments independently: record the segment as done for the
+//representation and return GF_TRUE if all active representations of the set are done with one or more segments
+static Bool dasher_join_segment(GF_DasherCtx *ctx, GF_DashStream *set_ds, GF_DashStream *base_ds, Double seg_duration)
+{
+	u32 i, count, nb_active=0;
+	Bool joined = GF_FALSE;
+	DasherSegJoin *sj = NULL;
+
+	if (!set_ds->seg_joins) {
+		set_ds->seg_joins = gf_list_new();
+		if (!set_ds->seg_joins) return GF_TRUE;
+	}
+	count = gf_list_count(set_ds->seg_joins);
+	for (i=0; i<count; i++) {
+		sj = gf_list_get(set_ds->seg_joins, i);
+		if (sj->seg_number == base_ds->seg_number) break;
+		sj = NULL;
+	}
+	if (!sj) {
+		GF_SAFEALLOC(sj, DasherSegJoin);
+		if (!sj) return GF_TRUE;
+		sj->seg_number = base_ds->seg_number;
+		sj->duration = -1;
+		gf_list_add(set_ds->seg_joins, sj);
+	}
+	if (seg_duration>=0) {
+		if (sj->duration<0) sj->duration = seg_duration;
+		else dasher_check_seg_alignment(ctx, set_ds, sj->duration, seg_duration, sj->seg_number);
+	}
+	sj->nb_done++;
+
+	//representations done before the end of the period no longer participate
+	count = gf_list_count(ctx->current_period->streams);
+	for (i=0; i<count; i++) {
+		GF_DashStream *a_ds = gf_list_get(ctx->current_period->streams, i);
+		if (a_ds->muxed_base || a_ds->merged_tile_dep || (a_ds->set != set_ds->set)) continue;
+		if (a_ds->done && (a_ds != base_ds)) continue;
+		nb_active++;
+	}
+	i=0;
+	while ((sj = gf_list_get(set_ds->seg_joins, i))) {
+		if (sj->nb_done < nb_active) {
+			i++;
+			continue;
+		}
+		gf_list_rem(set_ds->seg_joins, i);
+		gf_free(sj);
+		joined = GF_TRUE;
+	}
+	return joined;
+}
+
+//in ahead mode, time in ms a representation can be in advance of others, with half a segment of tolerance for segment boundaries adjusted to SAPs
+static u64 dasher_ahead_window_ms(GF_DasherCtx *ctx, GF_DashStream *base_ds)
+{
+	if (!ctx->use_ahead || !base_ds->dash_dur.den) return 0;
+	return (2 * ctx->ahead + 1) * (u64) base_ds->dash_dur.num * 1000 / (2 * base_ds->dash_dur.den);
+}
+
+//in ahead mode, check if the next segment of this representation would start more than ahead segments after the slowest representation
+static Bool dasher_rep_is_ahead(GF_DasherCtx *ctx, GF_DashStream *base_ds)
+{
+	u32 i, count;
+	u64 seg_end, min_seg_end = 0, ahead_ms;
+	Bool has_min = GF_FALSE;
+
+	if (!base_ds->dash_dur.den) return GF_FALSE;
+	seg_end = gf_timestamp_rescale(base_ds->adjusted_next_seg_start, base_ds->timescale, 1000);
+	count = gf_list_count(ctx->current_period->streams);
+	for (i=0; i<count; i++) {
+		u64 a_end;
+		GF_DashStream *a_ds = gf_list_get(ctx->current_period->streams, i);
+		if ((a_ds == base_ds) || a_ds->muxed_base || a_ds->done || !a_ds->timescale) continue;
+		a_end = gf_timestamp_rescale(a_ds->adjusted_next_seg_start, a_ds->timescale, 1000);
+		if (!has_min || (a_end < min_seg_end)) {
+			min_seg_end = a_end;
+			has_min = GF_TRUE;
+		}
+	}
+	if (!has_min) return GF_FALSE;
+	ahead_ms = dasher_ahead_window_ms(ctx, base_ds);
+	if (seg_end > min_seg_end + ahead_ms) return GF_TRUE;
+	return GF_FALSE;
+}
+
 static void dasher_flush_segment(GF_DasherCtx *ctx, GF_DashStream *ds, Bool is_last_in_period)
 {
 	u32 i, count;
@@ -6391,23 +6542,15 @@ static void dasher_flush_segment(GF_DasherCtx *ctx, GF_DashStream *ds, Bool is_l
 		}
 		dasher_insert_timeline_entry(ctx, base_ds);
 
-		if (ctx->align) {
+		if (ctx->use_ahead) {
+			if (!ctx->align || dasher_join_segment(ctx, set_ds, base_ds, seg_duration))
+				ctx->seg_joined = GF_TRUE;
+		}
+		else if (ctx->align) {
 			if (!set_ds->nb_rep_done || !set_ds->set_seg_duration) {
 				set_ds->set_seg_duration = seg_duration;
 			} else {
-				Double diff = set_ds->set_seg_duration - seg_duration;
-
-				if (ABS(diff) > 0.001) {
-					GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[Dasher] Segments are not aligned across representations: first rep segment duration %g but new segment duration %g for the same segment %d\n", set_ds->set_seg_duration, seg_duration, set_ds->seg_number));
-
-					if (ctx->profile != GF_DASH_PROFILE_FULL) {
-						set_ds->set->segment_alignment = GF_FALSE;
-						set_ds->set->subsegment_alignment = GF_FALSE;
-						ctx->profile = GF_DASH_PROFILE_FULL;
-						GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[Dasher] No segment alignment, switching to full profile\n"));
-						dasher_copy_segment_timelines(ctx, set_ds->set);
-					}
-				}
+				dasher_check_seg_alignment(ctx, set_ds, set_ds->set_seg_duration, seg_duration, set_ds->seg_number);
 			}
 			set_ds->nb_rep_done++;
 			if (set_ds->nb_rep_done < set_ds->nb_rep) {
@@ -6421,7 +6564,11 @@ static void dasher_flush_segment(GF_DasherCtx *ctx, GF_DashStream *ds, Bool is_l
 
 		ds_log = ds;
 	} else {
-		if (ctx->align) {
+		if (ctx->use_ahead) {
+			if (!ctx->align || dasher_join_segment(ctx, set_ds, base_ds, -1))
+				ctx->seg_joined = GF_TRUE;
+		}
+		else if (ctx->align) {
 			set_ds->nb_rep_done++;
 			if (set_ds->nb_rep_done < set_ds->nb_rep) return;
 
@@ -6462,8 +6609,8 @@ static void dasher_flush_segment(GF_DasherCtx *ctx, GF_DashStream *ds, Bool is_l
 	//reset all streams from our rep or our set
 	for (i=0; i<count; i++) {
 		ds = gf_list_get(ctx->current_period->streams, i);
-		//reset all in set if segment alignment
-		if (ctx->align) {
+		//reset all in set if segment alignment, unless representations are segmented independently
+		if (ctx->align && !ctx->use_ahead) {
 			if (ds->set != set_ds->set) continue;
 		} else {
 			//otherwise reset only media components for this rep
@@ -7694,15 +7841,22 @@ static GF_Err dasher_process(GF_Filter *filter)
 			if (ds->stream_type==GF_STREAM_AUDIO)
 				check_dur = dur;
 
+			//in ahead mode, hold representations getting too far ahead of the slowest one
+			if (ctx->use_ahead && !base_ds->segment_started && dasher_rep_is_ahead(ctx, base_ds)) {
+				nb_seg_waiting++;
+				break;
+			}
 			//perform regulation of inputs to avoid dashing one stream faster than the others
 			//this is needed when inputs are not realtime and we have text streams for which we must decide
 			//if we insert empty segments
+			//in ahead mode, streams may start segments up to the ahead window after the last started segment
 			if (!base_ds->segment_started && ctx->min_segment_start_time) {
-				orig_cts = cts;
+				//split duration is added to cts below, do not modify cts here
+				u64 seg_start_cts = cts;
 				if (ds->split_dur_next)
-					cts += ds->split_dur_next;
+					seg_start_cts += ds->split_dur_next;
 
-				if (gf_timestamp_greater(cts, ds->timescale, ctx->min_segment_start_time, 1000)) {
+				if (gf_timestamp_greater(seg_start_cts, ds->timescale, ctx->min_segment_start_time + dasher_ahead_window_ms(ctx, base_ds), 1000)) {
 					nb_seg_waiting++;
 					break;
 				}
@@ -8246,6 +8400,11 @@ static GF_Err dasher_process(GF_Filter *filter)
 
 	dasher_format_report(filter, ctx);
 
+	//in ahead mode, only update manifest once all representations of a set are done with a segment
+	if (seg_done && ctx->use_ahead) {
+		seg_done = ctx->seg_joined;
+		ctx->seg_joined = GF_FALSE;
+	}
 	if (seg_done) {
 		Bool update_period = GF_FALSE;
 		Bool update_manifest = GF_FALSE;
@@ -8849,6 +9008,14 @@ static GF_Err dasher_initialize(GF_Filter *filter)
 	if ((ctx->tsb>=0) && (ctx->dmode!=GF_DASH_STATIC))
 		ctx->purge_segments = GF_TRUE;
 
+	if (ctx->ahead) {
+		if ((ctx->dmode!=GF_DASH_STATIC) || ctx->subdur || ctx->sreg || ctx->loop || ctx->state) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[Dasher] ahead mode only supported for static manifests without context, subdur, sreg or loop, ignoring\n"));
+		} else {
+			ctx->use_ahead = GF_TRUE;
+		}
+	}
+
 	if (ctx->state && ctx->sreg) {
 		u32 diff;
 		u64 next_gen_ntp;
@@ -8894,6 +9061,10 @@ static void dasher_finalize(GF_Filter *filter)
 	if (ctx->out_path) gf_free(ctx->out_path);
 	gf_list_del(ctx->postponed_pids);
 	if (ctx->cinfo) gf_crypt_info_del(ctx->cinfo);
+	if (ctx->last_mpd) gf_fclose(ctx->last_mpd);
+	if (ctx->last_hls) gf_fclose(ctx->last_hls);
+	if (ctx->last_hls2) gf_fclose(ctx->last_hls2);
+	if (ctx->manifest_buf) gf_fclose(ctx->manifest_buf);
 }
 
 #define MPD_EXTS "mpd|m3u8|3gm|ism"
@@ -9066,6 +9237,7 @@ static const GF_FilterArgs DasherArgs[] =
 		"- br: use LL-HLS with byte-range for segment parts, pointing to full segment (DASH-LL compatible)\n"
 		"- sf: use separated files for segment parts\n"
 		"- brsf: generate two sets of manifest, one for byte-range and one for files (`_IF` added before extension of manifest)", GF_PROP_UINT, "off", "off|br|sf|brsf", GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(ahead), "maximum number of segments a representation can be produced ahead of the slowest one (static mode only). If 0, all representations are synchronized at each segment boundary, otherwise representations are segmented independently and only joined at segment boundaries for alignment checks and manifest updates, allowing muxers of all representations to run concurrently when using multiple threads", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(cdur), "chunk duration for fragmentation modes", GF_PROP_FRACTION, "-1/1", NULL, GF_FS_ARG_HINT_HIDE},
 	{ OFFS(hlsdrm), "cryp file info for HLS full segment encryption", GF_PROP_STRING, NULL, NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(cmaf), "use cmaf guidelines\n"
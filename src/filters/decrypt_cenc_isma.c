@@ -1393,26 +1393,13 @@ static GF_Err cenc_dec_process_cenc(GF_CENCDecCtx *ctx, GF_CENCDecStream *cstr,
 
 			//pattern decryption
 			if (cstr->cenc_pattern) {
-				u32 pos = cur_pos;
 				u32 res = bytes_encrypted_data;
-				u32 cryp_block = 16 * cstr->cenc_pattern->value.frac.den;
-				u32 full_block = 16 * (cstr->cenc_pattern->value.frac.den + cstr->cenc_pattern->value.frac.num);
 
 				if (cstr->is_cbc) {
 					u32 clear_trailing = res % 16;
 					res -= clear_trailing;
 				}
-
-				while (res) {
-					gf_crypt_decrypt(cstr->crypts[kidx].crypt, out_data + pos, (res >= cryp_block) ? cryp_block : res);
-					if (res >= full_block) {
-						pos += full_block;
-						assert(res>=full_block);
-						res -= full_block;
-					} else {
-						res = 0;
-					}
-				}
+				gf_crypt_decrypt_pattern(cstr->crypts[kidx].crypt, out_data + cur_pos, res, cstr->cenc_pattern->value.frac.den, cstr->cenc_pattern->value.frac.num);
 			}
 			//full subsample decryption
 			else {
@@ -231,28 +231,13 @@ static Bool gsfdmx_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 static void gsfdmx_decrypt(GSF_DemuxCtx *ctx, char *data, u32 size)
 {
 #ifndef GPAC_DISABLE_CRYPTO
-	u32 pos=0;
 	u32 clear_tail = size%16;
 	u32 bytes_crypted = size - clear_tail;
 
 	if (!bytes_crypted) return;
 
 	gf_crypt_set_IV(ctx->crypt, ctx->crypt_IV, 16);
-	if (ctx->crypt_blocks && ctx->skip_blocks) {
-		u32 pattern_length = 16 * (ctx->crypt_blocks + ctx->skip_blocks);
-		u32 cryp_len = 16 * ctx->crypt_blocks;
-		while (bytes_crypted) {
-			gf_crypt_decrypt(ctx->crypt, data+pos, bytes_crypted >= cryp_len ? cryp_len : bytes_crypted);
-			if (bytes_crypted >= pattern_length) {
-				pos += pattern_length;
-				bytes_crypted -= pattern_length;
-			} else {
-				bytes_crypted = 0;
-			}
-		}
-	} else {
-		gf_crypt_decrypt(ctx->crypt, data, bytes_crypted);
-	}
+	gf_crypt_decrypt_pattern(ctx->crypt, data, bytes_crypted, ctx->crypt_blocks, ctx->skip_blocks);
 #endif
 }
 
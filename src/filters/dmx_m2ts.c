@@ -46,6 +46,28 @@ typedef struct {
 	u8 *data;
 } GF_TEMIInfo;
 
+/*packet queued on output PID in parallel PES mode*/
+typedef struct
+{
+	//TS packet number this packet was produced at
+	u32 pck_number;
+	Bool is_pcr, discontinuity, seg_start;
+	u32 flags;
+	u64 PTS, DTS;
+	//PES payload, handed over to the output packet
+	u8 *data;
+	u32 data_len;
+	GF_List *props;
+} GF_M2TSDmxQueuedPck;
+
+/*output PID queue in parallel PES mode, PES packets are filled by the reassembly tasks and PCRs by the demux loop*/
+typedef struct
+{
+	GF_List *pcks;
+	GF_List *clocks;
+	GF_List *reservoir;
+} GF_M2TSDmxQueue;
+
 enum
 {
 	DMX_TUNE_DONE=0,
@@ -60,6 +82,7 @@ typedef struct
 	//opts
 	const char *temi_url;
 	Bool dsmcc, seeksrc, sigfrag;
+	u32 ppes;
 
 	GF_Filter *filter;
 	GF_FilterPid *ipid;
@@ -87,6 +110,13 @@ typedef struct
 	u32 wait_for_progs;
 
 	Bool is_dash;
+
+	//parallel PES mode: number of bytes parsed in current round and number of reassembly tasks running
+	u32 round_size;
+	volatile u32 nb_pes_tasks;
+	//set when a caller blocks until reassembly tasks are done, the last task then notifies the semaphore
+	volatile u32 pes_wait;
+	GF_Semaphore *pes_sema;
 } GF_M2TSDmxCtx;
 
 
@@ -383,6 +413,17 @@ static void m2tsdmx_declare_pid(GF_M2TSDmxCtx *ctx, GF_M2TS_PES *stream, GF_ESD
 	if (!opid)
 		opid = gf_filter_pid_new(ctx->filter);
 
+	if (ctx->ppes && !gf_filter_pid_get_udta(opid)) {
+		GF_M2TSDmxQueue *q;
+		GF_SAFEALLOC(q, GF_M2TSDmxQueue);
+		if (q) {
+			q->pcks = gf_list_new();
+			q->clocks = gf_list_new();
+			q->reservoir = gf_list_new();
+			gf_filter_pid_set_udta(opid, q);
+		}
+	}
+
 	stream->user = opid;
 	stream->flags |= GF_M2TS_ES_ALREADY_DECLARED;
 
@@ -486,18 +527,23 @@ static void m2tsdmx_setup_program(GF_M2TSDmxCtx *ctx, GF_M2TS_Program *prog)
 	}
 }
 
+static void m2tdmx_merge_temi_props(GF_List *props, GF_FilterPacket *pck)
+{
+	char szID[100];
+	while (gf_list_count(props)) {
+		GF_TEMIInfo *t = gf_list_pop_front(props);
+		snprintf(szID, 100, "%s:%d", t->is_loc ? "temi_l" : "temi_t", t->timeline_id);
+
+		gf_filter_pck_set_property_dyn(pck, szID, &PROP_DATA_NO_COPY(t->data, t->len));
+		gf_free(t);
+	}
+	gf_list_del(props);
+}
+
 static void m2tdmx_merge_temi(GF_FilterPid *pid, GF_M2TS_ES *stream, GF_FilterPacket *pck)
 {
 	if (stream->props) {
-		char szID[100];
-		while (gf_list_count(stream->props)) {
-			GF_TEMIInfo *t = gf_list_pop_front(stream->props);
-			snprintf(szID, 100, "%s:%d", t->is_loc ? "temi_l" : "temi_t", t->timeline_id);
-
-			gf_filter_pck_set_property_dyn(pck, szID, &PROP_DATA_NO_COPY(t->data, t->len));
-			gf_free(t);
-		}
-		gf_list_del(stream->props);
+		m2tdmx_merge_temi_props(stream->props, pck);
 		stream->props = NULL;
 
 		if (!(stream->flags & GF_M2TS_ES_TEMI_INFO)) {
@@ -508,6 +554,212 @@ static void m2tdmx_merge_temi(GF_FilterPid *pid, GF_M2TS_ES *stream, GF_FilterPa
 	}
 }
 
+static void m2tsdmx_del_temi_props(GF_List *props)
+{
+	if (!props) return;
+	while (gf_list_count(props)) {
+		GF_TEMIInfo *t = gf_list_pop_back(props);
+		gf_free(t->data);
+		gf_free(t);
+	}
+	gf_list_del(props);
+}
+
+static GF_M2TSDmxQueuedPck *m2tsdmx_queue_new_entry(GF_M2TSDmxQueue *q)
+{
+	GF_M2TSDmxQueuedPck *qp = gf_list_pop_back(q->reservoir);
+	if (!qp) {
+		GF_SAFEALLOC(qp, GF_M2TSDmxQueuedPck);
+		if (!qp) return NULL;
+	}
+	qp->is_pcr = qp->discontinuity = qp->seg_start = GF_FALSE;
+	qp->flags = 0;
+	qp->data = NULL;
+	qp->data_len = 0;
+	qp->props = NULL;
+	return qp;
+}
+
+//called by the reassembly tasks, only touches the queue and the stream being reassembled
+static void m2tsdmx_queue_packet(GF_M2TSDmxCtx *ctx, GF_FilterPid *opid, GF_M2TS_PES_PCK *pck)
+{
+	GF_M2TSDmxQueuedPck *qp;
+	GF_M2TSDmxQueue *q = gf_filter_pid_get_udta(opid);
+	if (!q) return;
+	qp = m2tsdmx_queue_new_entry(q);
+	if (!qp) return;
+
+	//allocated here and released by the output packet, so that the payload is only copied once out of the reassembler
+	qp->data = gf_malloc(pck->data_len);
+	if (!qp->data) {
+		gf_list_add(q->reservoir, qp);
+		return;
+	}
+	memcpy(qp->data, pck->data, pck->data_len);
+	qp->data_len = pck->data_len;
+	qp->pck_number = pck->stream->pck_number;
+	qp->flags = pck->flags;
+	qp->PTS = pck->PTS;
+	qp->DTS = pck->DTS;
+	//TEMI info gathered so far is for this packet
+	qp->props = pck->stream->props;
+	pck->stream->props = NULL;
+	if (pck->stream->is_seg_start) {
+		pck->stream->is_seg_start = GF_FALSE;
+		qp->seg_start = GF_TRUE;
+	}
+	gf_list_add(q->pcks, qp);
+}
+
+static void m2tsdmx_send_pcr(GF_FilterPid *opid, u64 pcr, Bool discontinuity, Bool seg_start)
+{
+	GF_FilterPacket *dst_pck = gf_filter_pck_new_shared(opid, NULL, 0, NULL);
+	if (!dst_pck) return;
+
+	gf_filter_pck_set_cts(dst_pck, pcr);
+	gf_filter_pck_set_clock_type(dst_pck, discontinuity ? GF_FILTER_CLOCK_PCR_DISC : GF_FILTER_CLOCK_PCR);
+	if (seg_start) {
+		gf_filter_pck_set_property(dst_pck, GF_PROP_PCK_CUE_START, &PROP_BOOL(GF_TRUE));
+	}
+	gf_filter_pck_send(dst_pck);
+}
+
+static void m2tsdmx_queued_packet_del(GF_Filter *filter, GF_FilterPid *pid, GF_FilterPacket *pck)
+{
+	u32 size;
+	const u8 *data = gf_filter_pck_get_data(pck, &size);
+	if (data) gf_free((u8 *) data);
+}
+
+static void m2tsdmx_send_queued_packet(GF_FilterPid *opid, GF_M2TSDmxQueuedPck *qp)
+{
+	GF_FilterPacket *dst_pck;
+
+	dst_pck = gf_filter_pck_new_shared(opid, qp->data, qp->data_len, m2tsdmx_queued_packet_del);
+	if (!dst_pck) {
+		gf_free(qp->data);
+		qp->data = NULL;
+		m2tsdmx_del_temi_props(qp->props);
+		return;
+	}
+	qp->data = NULL;
+	gf_filter_pck_set_framing(dst_pck, (qp->flags & GF_M2TS_PES_PCK_AU_START) ? GF_TRUE : GF_FALSE, GF_FALSE);
+
+	if (qp->flags & GF_M2TS_PES_PCK_AU_START) {
+		gf_filter_pck_set_cts(dst_pck, qp->PTS);
+		if (qp->DTS != qp->PTS) {
+			gf_filter_pck_set_dts(dst_pck, qp->DTS);
+		}
+		gf_filter_pck_set_sap(dst_pck, (qp->flags & GF_M2TS_PES_PCK_RAP) ? GF_FILTER_SAP_1 : GF_FILTER_SAP_NONE);
+	}
+	if (qp->props) {
+		m2tdmx_merge_temi_props(qp->props, dst_pck);
+		if (!gf_filter_pid_get_property(opid, GF_PROP_PID_HAS_TEMI))
+			gf_filter_pid_set_property(opid, GF_PROP_PID_HAS_TEMI, &PROP_BOOL(GF_TRUE) );
+	}
+	if (qp->seg_start) {
+		gf_filter_pck_set_property(dst_pck, GF_PROP_PCK_CUE_START, &PROP_BOOL(GF_TRUE));
+	}
+	gf_filter_pck_send(dst_pck);
+}
+
+//dispatch queued PES packets and PCRs in TS packet order - must not be called while reassembly tasks are running
+static void m2tsdmx_drain_queues(GF_M2TSDmxCtx *ctx)
+{
+	u32 i, nb_opids = gf_filter_get_opid_count(ctx->filter);
+	for (i=0; i<nb_opids; i++) {
+		u32 nb_pcks, nb_clocks, j=0, k=0;
+		GF_FilterPid *opid = gf_filter_get_opid(ctx->filter, i);
+		GF_M2TSDmxQueue *q = gf_filter_pid_get_udta(opid);
+		if (!q) continue;
+
+		nb_pcks = gf_list_count(q->pcks);
+		nb_clocks = gf_list_count(q->clocks);
+		while ((j<nb_pcks) || (k<nb_clocks)) {
+			GF_M2TSDmxQueuedPck *qp = (j<nb_pcks) ? gf_list_get(q->pcks, j) : NULL;
+			GF_M2TSDmxQueuedPck *qc = (k<nb_clocks) ? gf_list_get(q->clocks, k) : NULL;
+			//PCR of a TS packet is processed before its payload
+			if (qc && (!qp || (qc->pck_number <= qp->pck_number))) {
+				m2tsdmx_send_pcr(opid, qc->PTS, qc->discontinuity, qc->seg_start);
+				gf_list_add(q->reservoir, qc);
+				k++;
+			} else {
+				m2tsdmx_send_queued_packet(opid, qp);
+				gf_list_add(q->reservoir, qp);
+				j++;
+			}
+		}
+		gf_list_reset(q->pcks);
+		gf_list_reset(q->clocks);
+	}
+}
+
+static void m2tsdmx_del_queue_entries(GF_List *list)
+{
+	while (gf_list_count(list)) {
+		GF_M2TSDmxQueuedPck *qp = gf_list_pop_back(list);
+		m2tsdmx_del_temi_props(qp->props);
+		if (qp->data) gf_free(qp->data);
+		gf_free(qp);
+	}
+	gf_list_del(list);
+}
+
+static Bool m2tsdmx_pes_task(GF_Filter *filter, void *udta, u32 *reschedule_ms)
+{
+	GF_M2TSDmxCtx *ctx = gf_filter_get_udta(filter);
+	gf_m2ts_process_deferred_pes(ctx->ts, udta);
+	//last task done, wake up the waiting caller if any, otherwise the demux loop
+	if (!safe_int_dec(&ctx->nb_pes_tasks)) {
+		if (ctx->pes_wait)
+			gf_sema_notify(ctx->pes_sema, 1);
+		else
+			gf_filter_post_process_task(filter);
+	}
+	return GF_FALSE;
+}
+
+//dispatch reassembly of all pending streams
+static void m2tsdmx_dispatch_pes(GF_M2TSDmxCtx *ctx)
+{
+	GF_M2TS_PES *pes;
+	ctx->round_size = 0;
+	if (!gf_filter_get_num_threads(ctx->filter)) {
+		while ((pes = gf_m2ts_pop_deferred_pes(ctx->ts))) {
+			gf_m2ts_process_deferred_pes(ctx->ts, pes);
+		}
+		m2tsdmx_drain_queues(ctx);
+		return;
+	}
+	while ((pes = gf_m2ts_pop_deferred_pes(ctx->ts))) {
+		if (!pes->batch_count) continue;
+		safe_int_inc(&ctx->nb_pes_tasks);
+		if (gf_filter_post_parallel_task(ctx->filter, m2tsdmx_pes_task, pes, "m2tsdmx_pes") != GF_OK) {
+			safe_int_dec(&ctx->nb_pes_tasks);
+			gf_m2ts_process_deferred_pes(ctx->ts, pes);
+		}
+	}
+	if (!ctx->nb_pes_tasks)
+		m2tsdmx_drain_queues(ctx);
+}
+
+//block until all reassembly tasks are done - tasks are not bound to the filter, so other threads keep running them meanwhile
+static void m2tsdmx_wait_pes_tasks(GF_M2TSDmxCtx *ctx, Bool is_final)
+{
+	if (!ctx->nb_pes_tasks) return;
+	//discard notification left by a previous wait
+	while (gf_sema_wait_for(ctx->pes_sema, 0)) {}
+
+	safe_int_inc(&ctx->pes_wait);
+	while (ctx->nb_pes_tasks) {
+		gf_sema_wait(ctx->pes_sema);
+	}
+	safe_int_dec(&ctx->pes_wait);
+	//queues filled by the tasks are drained by the next process call
+	if (!is_final)
+		gf_filter_post_process_task(ctx->filter);
+}
+
 static void m2tsdmx_send_packet(GF_M2TSDmxCtx *ctx, GF_M2TS_PES_PCK *pck)
 {
 	GF_FilterPid *opid;
@@ -519,6 +771,11 @@ static void m2tsdmx_send_packet(GF_M2TSDmxCtx *ctx, GF_M2TS_PES_PCK *pck)
 	if (!pck->stream->user) return;
 	opid = pck->stream->user;
 
+	if (ctx->ppes) {
+		m2tsdmx_queue_packet(ctx, opid, pck);
+		return;
+	}
+
 	dst_pck = gf_filter_pck_new_alloc(opid, pck->data_len, &data);
 	if (!dst_pck) return;
 
@@ -749,20 +1006,28 @@ static void m2tsdmx_on_event(GF_M2TS_Demuxer *ts, u32 evt_type, void *param)
 		pcr /= 300;
 		count = gf_list_count(pck->stream->program->streams);
 		for (i=0; i<count; i++) {
-			GF_FilterPacket *dst_pck;
+			Bool seg_start = GF_FALSE;
 			GF_M2TS_PES *stream = gf_list_get(pck->stream->program->streams, i);
 			if (!stream->user) continue;
 
-			dst_pck = gf_filter_pck_new_shared(stream->user, NULL, 0, NULL);
-			if (!dst_pck) continue;
-
-			gf_filter_pck_set_cts(dst_pck, pcr);
-			gf_filter_pck_set_clock_type(dst_pck, discontinuity ? GF_FILTER_CLOCK_PCR_DISC : GF_FILTER_CLOCK_PCR);
 			if (pck->stream->is_seg_start) {
 				pck->stream->is_seg_start = GF_FALSE;
-				gf_filter_pck_set_property(dst_pck, GF_PROP_PCK_CUE_START, &PROP_BOOL(GF_TRUE));
+				seg_start = GF_TRUE;
+			}
+			if (ctx->ppes) {
+				GF_M2TSDmxQueue *q = gf_filter_pid_get_udta(stream->user);
+				GF_M2TSDmxQueuedPck *qc = q ? m2tsdmx_queue_new_entry(q) : NULL;
+				if (qc) {
+					qc->is_pcr = GF_TRUE;
+					qc->pck_number = ts->pck_number;
+					qc->PTS = pcr;
+					qc->discontinuity = discontinuity;
+					qc->seg_start = seg_start;
+					gf_list_add(q->clocks, qc);
+				}
+			} else {
+				m2tsdmx_send_pcr(stream->user, pcr, discontinuity, seg_start);
 			}
-			gf_filter_pck_send(dst_pck);
 
 			if (map_time) {
 				gf_filter_pid_set_info_str(stream->user, "time:timestamp", &PROP_LONGUINT(pcr) );
@@ -905,12 +1170,8 @@ static void m2tsdmx_on_event(GF_M2TS_Demuxer *ts, u32 evt_type, void *param)
 	{
 		GF_M2TS_ES *es = (GF_M2TS_ES *)param;
 		if (es && es->props) {
-			while (gf_list_count(es->props)) {
-				GF_TEMIInfo *t = gf_list_pop_back(es->props);
-				gf_free(t->data);
-				gf_free(t);
-			}
-			gf_list_del(es->props);
+			m2tsdmx_del_temi_props(es->props);
+			es->props = NULL;
 		}
 	}
 		break;
@@ -923,6 +1184,7 @@ static GF_Err m2tsdmx_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool i
 	FILE *stream = NULL;
 	GF_M2TSDmxCtx *ctx = gf_filter_get_udta(filter);
 
+	m2tsdmx_wait_pes_tasks(ctx, GF_FALSE);
 	if (is_remove) {
 		ctx->ipid = NULL;
 //		gf_filter_pid_remove(ctx->opid);
@@ -963,6 +1225,8 @@ static GF_Err m2tsdmx_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool i
 		ctx->ts = gf_m2ts_demux_new();
 		ctx->ts->on_event = m2tsdmx_on_event;
 		ctx->ts->user = filter;
+		if (ctx->ppes)
+			ctx->ts->deferred_pes = GF_TRUE;
 	} else if (!p) {
 		GF_FilterEvent evt;
 		ctx->duration.num = 1;
@@ -1036,6 +1300,9 @@ static Bool m2tsdmx_process_event(GF_Filter *filter, const GF_FilterEvent *com)
 	GF_M2TSDmxCtx *ctx = gf_filter_get_udta(filter);
 	GF_M2TS_Demuxer *ts = ctx->ts;
 
+	//framing changes must not happen while reassembly tasks are running
+	m2tsdmx_wait_pes_tasks(ctx, GF_FALSE);
+
 	if (com->base.type == GF_FEVT_QUALITY_SWITCH) {
 		u32 i, count;
 		count = gf_list_count(ts->programs);
@@ -1144,6 +1411,11 @@ static GF_Err m2tsdmx_initialize(GF_Filter *filter)
 	if (ctx->dsmcc) {
 		gf_m2ts_demux_dmscc_init(ctx->ts);
 	}
+	if (ctx->ppes) {
+		ctx->ts->deferred_pes = GF_TRUE;
+		ctx->pes_sema = gf_sema_new(1, 0);
+		if (!ctx->pes_sema) return GF_OUT_OF_MEM;
+	}
 
 	return GF_OK;
 }
@@ -1151,9 +1423,24 @@ static GF_Err m2tsdmx_initialize(GF_Filter *filter)
 
 static void m2tsdmx_finalize(GF_Filter *filter)
 {
+	u32 i, nb_opids;
 	GF_M2TSDmxCtx *ctx = gf_filter_get_udta(filter);
-	if (ctx->ts) gf_m2ts_demux_del(ctx->ts);
 
+	m2tsdmx_wait_pes_tasks(ctx, GF_TRUE);
+	if (ctx->ts) gf_m2ts_demux_del(ctx->ts);
+	if (ctx->pes_sema) gf_sema_del(ctx->pes_sema);
+
+	nb_opids = gf_filter_get_opid_count(filter);
+	for (i=0; i<nb_opids; i++) {
+		GF_FilterPid *opid = gf_filter_get_opid(filter, i);
+		GF_M2TSDmxQueue *q = gf_filter_pid_get_udta(opid);
+		if (!q) continue;
+		m2tsdmx_del_queue_entries(q->pcks);
+		m2tsdmx_del_queue_entries(q->clocks);
+		m2tsdmx_del_queue_entries(q->reservoir);
+		gf_free(q);
+		gf_filter_pid_set_udta(opid, NULL);
+	}
 }
 
 static GF_Err m2tsdmx_process(GF_Filter *filter)
@@ -1164,6 +1451,12 @@ static GF_Err m2tsdmx_process(GF_Filter *filter)
 	const char *data;
 	u32 size;
 
+	if (ctx->ppes) {
+		//reassembly tasks still running, we will be called again once done
+		if (ctx->nb_pes_tasks) return GF_OK;
+		m2tsdmx_drain_queues(ctx);
+	}
+
 restart:
 	pck = gf_filter_pid_get_packet(ctx->ipid);
 	if (!pck) {
@@ -1171,18 +1464,29 @@ restart:
 			u32 i, nb_streams = gf_filter_get_opid_count(filter);
 
 			gf_m2ts_flush_all(ctx->ts, ctx->is_dash);
+			if (ctx->ppes) {
+				ctx->round_size = 0;
+				m2tsdmx_drain_queues(ctx);
+			}
 			for (i=0; i<nb_streams; i++) {
 				GF_FilterPid *opid = gf_filter_get_opid(filter, i);
 				gf_filter_pid_set_eos(opid);
 			}
 			return GF_EOS;
 		}
+		if (ctx->ppes && ctx->round_size)
+			m2tsdmx_dispatch_pes(ctx);
 		return GF_OK;
 	}
 	if (ctx->sigfrag) {
 		Bool is_start;
 		gf_filter_pck_get_framing(pck, &is_start, NULL);
 		if (is_start) {
+			//packets of previous segment must be reassembled before marking the segment start
+			if (ctx->ppes && ctx->round_size) {
+				m2tsdmx_dispatch_pes(ctx);
+				if (ctx->nb_pes_tasks) return GF_OK;
+			}
 			gf_m2ts_mark_seg_start(ctx->ts);
 		}
 	}
@@ -1200,8 +1504,11 @@ restart:
 				would_block++;
 			}
 		}
-		if (would_block && (would_block==nb_streams))
+		if (would_block && (would_block==nb_streams)) {
+			if (ctx->ppes && ctx->round_size)
+				m2tsdmx_dispatch_pes(ctx);
 			return GF_OK;
+		}
 
 		check_block = GF_FALSE;
 	}
@@ -1216,12 +1523,21 @@ restart:
 		GF_FilterEvent fevt;
 		GF_FEVT_INIT(fevt, GF_FEVT_SOURCE_SEEK, ctx->ipid);
 		gf_filter_pid_send_event(ctx->ipid, &fevt);
-		ctx->mux_tune_state = DMX_TUNE_DONE;
+		//reset parsers before marking the mux as tuned, so that data pending in parallel PES mode is trashed
 		gf_m2ts_reset_parsers(ctx->ts);
-	} else {
-		goto restart;
+		ctx->mux_tune_state = DMX_TUNE_DONE;
+		ctx->round_size = 0;
+		return GF_OK;
 	}
-	return GF_OK;
+
+	if (ctx->ppes) {
+		ctx->round_size += size;
+		if (ctx->round_size >= ctx->ppes * 188) {
+			m2tsdmx_dispatch_pes(ctx);
+			if (ctx->nb_pes_tasks) return GF_OK;
+		}
+	}
+	goto restart;
 }
 
 static const char *m2tsdmx_probe_data(const u8 *data, u32 size, GF_FilterProbeScore *score)
@@ -1261,6 +1577,7 @@ static const GF_FilterArgs M2TSDmxArgs[] =
 	{ OFFS(dsmcc), "enable DSMCC receiver", GF_PROP_BOOL, "no", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(seeksrc), "seek local source file back to origin once all programs are setup", GF_PROP_BOOL, "true", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(sigfrag), "signal segment boundaries of source on output packets", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED},
+	{ OFFS(ppes), "reassemble and reframe PES of each stream in parallel session tasks, by batches of the given number of TS packets (0 disables parallel reassembly)", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{0}
 };
 
@@ -1268,7 +1585,10 @@ static const GF_FilterArgs M2TSDmxArgs[] =
 GF_FilterRegister M2TSDmxRegister = {
 	.name = "m2tsdmx",
 	GF_FS_SET_DESCRIPTION("MPEG-2 TS demuxer")
-	GF_FS_SET_HELP("This filter demultiplexes MPEG-2 Transport Stream files/data into a set of media PIDs and frames.")
+	GF_FS_SET_HELP("This filter demultiplexes MPEG-2 Transport Stream files/data into a set of media PIDs and frames.\n"
+	"\n"
+	"When [-ppes]() is set, the demultiplexer only performs sync, PID filtering, section and PCR processing. PES reassembly and reframing of each stream is done by batches of [-ppes]() TS packets in parallel session tasks, and the resulting packets are dispatched in TS packet order for each output PID.\n"
+	"This mode is only useful when the session uses several threads, typically for high bitrate multi-program streams.\n")
 	.private_size = sizeof(GF_M2TSDmxCtx),
 	.initialize = m2tsdmx_initialize,
 	.finalize = m2tsdmx_finalize,
@@ -1703,18 +1703,9 @@ static GF_Err cenc_encrypt_packet(GF_CENCEncCtx *ctx, GF_CENCStream *cstr, GF_Fi
 					//pattern encryption
 					if (cstr->tci->crypt_byte_block && cstr->tci->skip_byte_block) {
 						u32 res = nalu_size - clear_bytes - clear_bytes_at_end;
-						pos = cur_pos;
 						assert((res % 16) == 0);
 
-						while (res) {
-							e = gf_crypt_encrypt(cstr->keys[key_idx].crypt, output+pos, res >= (u32) (16*cstr->tci->crypt_byte_block) ? 16*cstr->tci->crypt_byte_block : res);
-							if (res >= (u32) (16 * (cstr->tci->crypt_byte_block + cstr->tci->skip_byte_block))) {
-								pos += 16 * (cstr->tci->crypt_byte_block + cstr->tci->skip_byte_block);
-								res -= 16 * (cstr->tci->crypt_byte_block + cstr->tci->skip_byte_block);
-							} else {
-								res = 0;
-							}
-						}
+						e = gf_crypt_encrypt_pattern(cstr->keys[key_idx].crypt, output+cur_pos, res, cstr->tci->crypt_byte_block, cstr->tci->skip_byte_block);
 					}
 					//full subsample encryption
 					else {
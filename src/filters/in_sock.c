@@ -60,7 +60,7 @@ typedef struct
 	const char *ext;
 	const char *mime;
 	Bool tsprobe, listen, ka, block;
-	u32 timeout;
+	u32 timeout, batch;
 #ifndef GPAC_DISABLE_STREAMING
 	u32 reorder_pck;
 	u32 reorder_delay;
@@ -72,6 +72,9 @@ typedef struct
 	Bool is_udp;
 
 	char *buffer;
+	//batched UDP reception, with index of next datagram to consume and number of datagrams received
+	GF_SockBatch *rcv_batch;
+	u32 batch_idx, batch_nb;
 
 	GF_SockGroup *active_sockets;
 	u64 last_rcv_time;
@@ -178,6 +181,11 @@ static GF_Err sockin_initialize(GF_Filter *filter)
 
 	ctx->buffer = gf_malloc(ctx->block_size + 1);
 	if (!ctx->buffer) return GF_OUT_OF_MEM;
+	if (ctx->is_udp && (ctx->batch>1)) {
+		//max UDP payload size, only the pages actually written by the kernel are used
+		ctx->rcv_batch = gf_sk_batch_new(ctx->batch, 0x10000);
+		if (!ctx->rcv_batch) return GF_OUT_OF_MEM;
+	}
 	//ext/mime given and not mpeg2, disable probe
 	if (ctx->ext && !strstr("ts|m2t|mts|dmb|trp", ctx->ext)) ctx->tsprobe = GF_FALSE;
 	if (ctx->mime && !strstr(ctx->mime, "mpeg-2") && !strstr(ctx->mime, "mp2t")) ctx->tsprobe = GF_FALSE;
@@ -209,6 +217,16 @@ static void sockin_finalize(GF_Filter *filter)
 		}
 		gf_list_del(ctx->clients);
 	}
+	if (ctx->rcv_batch) {
+#ifndef GPAC_DISABLE_LOG
+		u64 nb_calls, nb_dgrams, nb_slots, nb_drops;
+		gf_sk_get_batch_stats(ctx->sock_c.socket, &nb_calls, &nb_dgrams, &nb_slots, &nb_drops);
+		if (nb_calls) {
+			GF_LOG(nb_drops ? GF_LOG_WARNING : GF_LOG_INFO, GF_LOG_NETWORK, ("[SockIn] Received "LLU" datagrams in "LLU" calls - batch fill ratio %.02f %% - "LLU" dropped\n", nb_dgrams, nb_calls, ((Double) nb_dgrams*100)/nb_slots, nb_drops));
+		}
+#endif
+		gf_sk_batch_del(ctx->rcv_batch);
+	}
 	sockin_client_reset(&ctx->sock_c);
 	if (ctx->buffer) gf_free(ctx->buffer);
 	if (ctx->active_sockets) gf_sk_group_del(ctx->active_sockets);
@@ -275,7 +293,26 @@ static GF_Err sockin_read_client(GF_Filter *filter, GF_SockInCtx *ctx, GF_SockIn
 	nb_read=0;
 	while (pos < ctx->block_size) {
 		u32 read=0;
-		e = gf_sk_receive_no_select(sock_c->socket, ctx->buffer+pos, ctx->block_size - pos, &read);
+		if (ctx->rcv_batch) {
+			e = GF_OK;
+			//fetch a new batch once all datagrams of the previous one are consumed
+			if (ctx->batch_idx == ctx->batch_nb) {
+				ctx->batch_idx = ctx->batch_nb = 0;
+				e = gf_sk_receive_batch(sock_c->socket, ctx->rcv_batch, &ctx->batch_nb);
+			}
+			if (!e) {
+				u8 *dgram = gf_sk_batch_get(ctx->rcv_batch, ctx->batch_idx, &read);
+				//not enough space left, keep datagram for next call
+				if (read > ctx->block_size - pos) {
+					if (pos) break;
+					read = ctx->block_size;
+				}
+				memcpy(ctx->buffer+pos, dgram, read);
+				ctx->batch_idx++;
+			}
+		} else {
+			e = gf_sk_receive_no_select(sock_c->socket, ctx->buffer+pos, ctx->block_size - pos, &read);
+		}
 		if (e) {
 			if (nb_read) break;
 			switch (e) {
@@ -417,6 +454,13 @@ static GF_Err sockin_process(GF_Filter *filter)
 	u32 i, count;
 	GF_SockInCtx *ctx = (GF_SockInCtx *) gf_filter_get_udta(filter);
 
+	//datagrams left from previous batch
+	if (ctx->rcv_batch && (ctx->batch_idx < ctx->batch_nb)) {
+		e = sockin_read_client(filter, ctx, &ctx->sock_c);
+		gf_filter_ask_rt_reschedule(filter, 1);
+		return e;
+	}
+
 	e = gf_sk_group_select(ctx->active_sockets, 1, GF_SK_SELECT_READ);
 	if (e==GF_IP_NETWORK_EMPTY) {
 		if (ctx->is_udp) {
@@ -523,6 +567,7 @@ static const GF_FilterArgs SockInArgs[] =
 	{ OFFS(mime), "indicate mime type of udp data", GF_PROP_STRING, NULL, NULL, 0},
 	{ OFFS(block), "set blocking mode for socket(s)", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(timeout), "set timeout in ms for UDP socket(s), 0 to disable timeout", GF_PROP_UINT, "10000", NULL, GF_FS_ARG_HINT_ADVANCED},
+	{ OFFS(batch), "maximum number of datagrams read per system call in UDP mode, 1 disables batching", GF_PROP_UINT, "32", NULL, GF_FS_ARG_HINT_EXPERT},
 
 #ifndef GPAC_DISABLE_STREAMING
 	{ OFFS(reorder_pck), "number of packets delay for RTP reordering (M2TS over RTP) ", GF_PROP_UINT, "100", NULL, GF_FS_ARG_HINT_ADVANCED},
@@ -70,8 +70,9 @@ typedef struct
 	u32 xps_check;
 	char *catseg;
 	Bool sigfrag;
-	Bool nocrypt, strtxt, nodata;
+	Bool nocrypt, strtxt, nodata, mmap;
 	u32 mstore_purge, mstore_samples, mstore_size;
+	u32 fwin;
 
 	//internal
 
@@ -89,6 +90,8 @@ typedef struct
 	Bool input_loaded;
 	//fragmented file to be refreshed before processing it
 	Bool refresh_fragmented;
+	//fragmented file opened with a fragment window, fragments are loaded on demand
+	Bool fwin_active;
 	Bool input_is_stop;
 	u64 missing_bytes, last_size;
 
@@ -127,6 +130,13 @@ typedef struct
 	u64 last_min_offset;
 	GF_Err in_error;
 	Bool force_fetch;
+
+	//file mapping is active on the current movie
+	Bool mmap_active;
+	//number of packets referencing file mappings, plus one held by the filter until finalize
+	u32 mmap_refs;
+	//closed movies whose mapping is still referenced by packets
+	GF_List *mmap_movs;
 } ISOMReader;
 
 typedef struct
@@ -145,6 +155,10 @@ typedef struct
 	GF_ISOSample *static_sample;
 	GF_ISOSample *sample;
 	u64 sample_data_offset, last_valid_sample_data_offset;
+	//sample data is forwarded from the file mapping when possible
+	Bool mmap_ref;
+	//current sample data in file mapping, NULL if sample data is in sample
+	const u8 *sample_mapped;
 	GF_Err last_state;
 	Bool sap_3;
 	GF_ISOSampleRollType sap_4_type;
@@ -208,6 +222,8 @@ typedef struct
 	Bool needs_pid_reconfig;
 	u32 sap_only;
 	Bool check_has_rap;
+	//properties computed from sample tables not yet declared, sample tables not loaded
+	Bool stbl_props_pending;
 } ISOMChannel;
 
 void isor_reset_reader(ISOMChannel *ch);
@@ -231,6 +247,8 @@ Bool isor_declare_item_properties(ISOMReader *read, ISOMChannel *ch, u32 item_id
 
 void isor_declare_pssh(ISOMChannel *ch);
 
+void isor_declare_pending_sample_stats(ISOMChannel *ch);
+
 #endif /*GPAC_DISABLE_ISOM*/
 
 #endif /*_ISMO_IN_H_*/
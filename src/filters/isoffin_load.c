@@ -76,9 +76,67 @@ void isor_emulate_chapters(GF_ISOFile *file, GF_InitialObjectDescriptor *iod)
 }
 #endif
 
+//declare properties computed from the sample tables
+static void isor_declare_sample_stats(ISOMReader *read, ISOMChannel *ch)
+{
+	u32 val = gf_isom_get_max_sample_size(read->mov, ch->track);
+	if (val) gf_filter_pid_set_property(ch->pid, GF_PROP_PID_MAX_FRAME_SIZE, &PROP_UINT(val) );
+
+	val = gf_isom_get_avg_sample_size(read->mov, ch->track);
+	if (val) gf_filter_pid_set_property(ch->pid, GF_PROP_PID_AVG_FRAME_SIZE, &PROP_UINT(val) );
+
+	val = gf_isom_get_max_sample_delta(read->mov, ch->track);
+	if (val) gf_filter_pid_set_property(ch->pid, GF_PROP_PID_MAX_TS_DELTA, &PROP_UINT(val) );
+
+	val = gf_isom_get_max_sample_cts_offset(read->mov, ch->track);
+	if (val) gf_filter_pid_set_property(ch->pid, GF_PROP_PID_MAX_CTS_OFFSET, &PROP_UINT(val) );
+
+	val = gf_isom_get_constant_sample_duration(read->mov, ch->track);
+	if (val) gf_filter_pid_set_property(ch->pid, GF_PROP_PID_CONSTANT_DURATION, &PROP_UINT(val) );
+}
+
+static void isor_declare_samples_per_frame(ISOMReader *read, ISOMChannel *ch, u32 sr)
+{
+	u32 d1 = gf_isom_get_sample_duration(read->mov, ch->track, 1);
+	u32 d2 = gf_isom_get_sample_duration(read->mov, ch->track, 2);
+	if (d1 && d2 && (d1==d2)) {
+		d1 *= sr;
+		d1 /= ch->timescale;
+		gf_filter_pid_set_property(ch->pid, GF_PROP_PID_SAMPLES_PER_FRAME, &PROP_UINT(d1));
+	}
+}
+
+void isor_declare_pending_sample_stats(ISOMChannel *ch)
+{
+	u32 avg_rate, max_rate, buffer_size;
+	const GF_PropertyValue *p;
+	ISOMReader *read = ch->owner;
+	u64 size = gf_isom_get_media_data_size(read->mov, ch->track);
+	ch->stbl_props_pending = GF_FALSE;
+
+	if (!read->mem_load_mode) {
+		gf_filter_pid_set_property(ch->pid, GF_PROP_PID_MEDIA_DATA_SIZE, &PROP_LONGUINT(size) );
+	}
+	avg_rate = 0;
+	gf_isom_get_bitrate(read->mov, ch->track, ch->last_sample_desc_index ? ch->last_sample_desc_index : 1, &avg_rate, &max_rate, &buffer_size);
+	if (!avg_rate && ch->duration && ch->timescale) {
+		Double track_dur = (Double) (s64) ch->duration;
+		u64 avgrate = 8 * size;
+		track_dur /= ch->timescale;
+		avgrate = (u64) (avgrate / track_dur);
+		gf_filter_pid_set_property(ch->pid, GF_PROP_PID_BITRATE, &PROP_UINT((u32) avgrate));
+	}
+	p = gf_filter_pid_get_property(ch->pid, GF_PROP_PID_SAMPLE_RATE);
+	if (p)
+		isor_declare_samples_per_frame(read, ch, p->value.uint);
+
+	if (gf_isom_get_sample_count(read->mov, ch->track))
+		isor_declare_sample_stats(read, ch);
+}
+
 static void isor_declare_track(ISOMReader *read, ISOMChannel *ch, u32 track, u32 stsd_idx, u32 streamtype, Bool use_iod)
 {
-	u32 w, h, sr, nb_ch, nb_bps, codec_id, depends_on_id, esid, avg_rate, max_rate, buffer_size, sample_count, max_size, nb_refs, exp_refs, base_track, audio_fmt, pix_fmt;
+	u32 w, h, sr, nb_ch, nb_bps, codec_id, depends_on_id, esid, avg_rate, max_rate, buffer_size, sample_count, nb_refs, exp_refs, base_track, audio_fmt, pix_fmt;
 	GF_ESD *an_esd;
 	const char *mime, *encoding, *stxtcfg, *namespace, *schemaloc, *mime_cfg;
 #if !defined(GPAC_DISABLE_ISOM_WRITE)
@@ -548,6 +606,8 @@ static void isor_declare_track(ISOMReader *read, ISOMChannel *ch, u32 track, u32
 			ch->duration = gf_isom_get_duration(read->mov);
 		}
 		sample_count = gf_isom_get_sample_count(read->mov, ch->track);
+		//sample tables loaded on demand, properties computed from them are declared when the track is first played
+		ch->stbl_props_pending = gf_isom_has_sample_tables_loaded(read->mov, ch->track) ? GF_FALSE : GF_TRUE;
 
 		if (read->frag_type && !read->input_loaded) {
 			u32 ts;
@@ -597,7 +657,8 @@ static void isor_declare_track(ISOMReader *read, ISOMChannel *ch, u32 track, u32
 		gf_filter_pid_set_property(ch->pid, GF_PROP_PID_SUBTYPE, &PROP_4CC(mtype) );
 
 		if (!read->mem_load_mode) {
-			gf_filter_pid_set_property(ch->pid, GF_PROP_PID_MEDIA_DATA_SIZE, &PROP_LONGUINT(gf_isom_get_media_data_size(read->mov, track) ) );
+			if (!ch->stbl_props_pending)
+				gf_filter_pid_set_property(ch->pid, GF_PROP_PID_MEDIA_DATA_SIZE, &PROP_LONGUINT(gf_isom_get_media_data_size(read->mov, track) ) );
 		}
 		//in no cache mode, depending on fetch speed we may have fetched a fragment or not, resulting in has_rap set
 		//always for HAS_SYNC to false
@@ -625,21 +686,8 @@ static void isor_declare_track(ISOMReader *read, ISOMChannel *ch, u32 track, u32
 		gf_filter_pid_set_property(ch->pid, GF_PROP_PID_ISOM_MBRAND, &PROP_4CC(major_brand) );
 
 		//we cannot expose average size/dur in mem mode with fragmented files (sample_count=0)
-		if (sample_count) {
-			max_size = gf_isom_get_max_sample_size(read->mov, ch->track);
-			if (max_size) gf_filter_pid_set_property(pid, GF_PROP_PID_MAX_FRAME_SIZE, &PROP_UINT(max_size) );
-
-			max_size = gf_isom_get_avg_sample_size(read->mov, ch->track);
-			if (max_size) gf_filter_pid_set_property(pid, GF_PROP_PID_AVG_FRAME_SIZE, &PROP_UINT(max_size) );
-
-			max_size = gf_isom_get_max_sample_delta(read->mov, ch->track);
-			if (max_size) gf_filter_pid_set_property(pid, GF_PROP_PID_MAX_TS_DELTA, &PROP_UINT(max_size) );
-
-			max_size = gf_isom_get_max_sample_cts_offset(read->mov, ch->track);
-			if (max_size) gf_filter_pid_set_property(pid, GF_PROP_PID_MAX_CTS_OFFSET, &PROP_UINT(max_size) );
-
-			max_size = gf_isom_get_constant_sample_duration(read->mov, ch->track);
-			if (max_size) gf_filter_pid_set_property(pid, GF_PROP_PID_CONSTANT_DURATION, &PROP_UINT(max_size) );
+		if (sample_count && !ch->stbl_props_pending) {
+			isor_declare_sample_stats(read, ch);
 		}
 
 
@@ -1027,7 +1075,6 @@ static void isor_declare_track(ISOMReader *read, ISOMChannel *ch, u32 track, u32
 	}
 	//nb_ch may be set to 0 for "not applicable" (3D / object coding audio)
 	if (sr) {
-		u32 d1, d2;
 		gf_filter_pid_set_property(ch->pid, GF_PROP_PID_SAMPLE_RATE, &PROP_UINT(sr));
 		gf_filter_pid_set_property(ch->pid, GF_PROP_PID_NUM_CHANNELS, &PROP_UINT(nb_ch));
 
@@ -1046,14 +1093,8 @@ static void isor_declare_track(ISOMReader *read, ISOMChannel *ch, u32 track, u32
 
 		}
 
-		if (first_config ) {
-			d1 = gf_isom_get_sample_duration(read->mov, ch->track, 1);
-			d2 = gf_isom_get_sample_duration(read->mov, ch->track, 2);
-			if (d1 && d2 && (d1==d2)) {
-				d1 *= sr;
-				d1 /= ch->timescale;
-				gf_filter_pid_set_property(ch->pid, GF_PROP_PID_SAMPLES_PER_FRAME, &PROP_UINT(d1));
-			}
+		if (first_config && !ch->stbl_props_pending) {
+			isor_declare_samples_per_frame(read, ch, sr);
 		}
 
 		if ((codec_id==GF_CODECID_MPHA) || (codec_id==GF_CODECID_MHAS)) {
@@ -1077,7 +1118,7 @@ static void isor_declare_track(ISOMReader *read, ISOMChannel *ch, u32 track, u32
 	gf_isom_get_bitrate(read->mov, ch->track, stsd_idx, &avg_rate, &max_rate, &buffer_size);
 
 	if (!avg_rate) {
-		if (first_config && ch->duration) {
+		if (first_config && ch->duration && !ch->stbl_props_pending) {
 			u64 avgrate = 8 * gf_isom_get_media_data_size(read->mov, ch->track);
 			avgrate = (u64) (avgrate / track_dur);
 			gf_filter_pid_set_property(ch->pid, GF_PROP_PID_BITRATE, &PROP_UINT((u32) avgrate));
@@ -120,7 +120,14 @@ static GF_Err isoffin_setup(GF_Filter *filter, ISOMReader *read)
 	}
 
 	read->missing_bytes = 0;
-	e = gf_isom_open_progressive(url, read->start_range, read->end_range, read->sigfrag, &read->mov, &read->missing_bytes);
+	read->fwin_active = GF_FALSE;
+	//fragment window only used for complete files, not for segments
+	if (read->fwin && !read->start_range && !read->end_range && !read->sigfrag) {
+		e = gf_isom_open_progressive_window(url, 0, 0, GF_FALSE, read->fwin, &read->mov, &read->missing_bytes);
+		read->fwin_active = GF_TRUE;
+	} else {
+		e = gf_isom_open_progressive(url, read->start_range, read->end_range, read->sigfrag, &read->mov, &read->missing_bytes);
+	}
 
 	if (e == GF_ISOM_INCOMPLETE_FILE) {
 		gf_free(url);
@@ -144,6 +151,8 @@ static GF_Err isoffin_setup(GF_Filter *filter, ISOMReader *read)
 		return e;
 	}
 	read->frag_type = gf_isom_is_fragmented(read->mov) ? 1 : 0;
+	if (!read->frag_type)
+		read->fwin_active = GF_FALSE;
 	if (!read->frag_type && read->sigfrag) {
 		e = GF_BAD_PARAM;
 		GF_LOG(GF_LOG_ERROR, GF_LOG_CONTAINER, ("[IsoMedia] sigfrag requested but file %s is not fragmented\n", url));
@@ -159,6 +168,16 @@ static GF_Err isoffin_setup(GF_Filter *filter, ISOMReader *read)
 	if (read->strtxt)
 		gf_isom_text_set_streaming_mode(read->mov, GF_TRUE);
 
+	//file mapping only on complete local files, no byte range
+	read->mmap_active = GF_FALSE;
+	if (read->mmap && read->input_loaded && !read->frag_type && !read->start_range && !read->end_range) {
+		if (gf_isom_set_file_mapping(read->mov, GF_TRUE) == GF_OK) {
+			read->mmap_active = GF_TRUE;
+		} else {
+			GF_LOG(GF_LOG_INFO, GF_LOG_CONTAINER, ("[IsoMedia] file mapping not available for %s, using regular file IO\n", url));
+		}
+	}
+
 	gf_free(url);
 	return isor_declare_objects(read);
 }
@@ -173,6 +192,31 @@ static void isoffin_delete_channel(ISOMChannel *ch)
 	gf_free(ch);
 }
 
+static void isoffin_close_mov(ISOMReader *read)
+{
+	if (!read->mov) return;
+	//packets still reference the file mapping, close the movie once they are all released
+	if (read->mmap_refs>1) {
+		if (!read->mmap_movs) read->mmap_movs = gf_list_new();
+		gf_list_add(read->mmap_movs, read->mov);
+	} else {
+		gf_isom_close(read->mov);
+	}
+	read->mov = NULL;
+	read->mmap_active = GF_FALSE;
+}
+
+static void isoffin_purge_mmap_movs(ISOMReader *read)
+{
+	if (!read->mmap_movs) return;
+	while (gf_list_count(read->mmap_movs)) {
+		GF_ISOFile *mov = gf_list_pop_back(read->mmap_movs);
+		gf_isom_close(mov);
+	}
+	gf_list_del(read->mmap_movs);
+	read->mmap_movs = NULL;
+}
+
 static void isoffin_disconnect(ISOMReader *read)
 {
 	read->disconnected = GF_TRUE;
@@ -184,8 +228,7 @@ static void isoffin_disconnect(ISOMReader *read)
 		isoffin_delete_channel(ch);
 	}
 
-	if (read->mov) gf_isom_close(read->mov);
-	read->mov = NULL;
+	isoffin_close_mov(read);
 
 	read->pid = NULL;
 }
@@ -267,7 +310,7 @@ static GF_Err isoffin_reconfigure(GF_Filter *filter, ISOMReader *read, const cha
 			}
 		}
 
-		if (read->mov) gf_isom_close(read->mov);
+		isoffin_close_mov(read);
 		e = gf_isom_open_progressive(next_url, read->start_range, read->end_range, read->sigfrag, &read->mov, &read->missing_bytes);
 
 		//init seg not completely downloaded, retry at next packet
@@ -447,6 +490,7 @@ GF_Err isoffin_initialize(GF_Filter *filter)
 	GF_Err e = GF_OK;
 	read->filter = filter;
 	read->channels = gf_list_new();
+	read->mmap_refs = 1;
 
 	if (read->xps_check==MP4DMX_XPS_AUTO) {
 		read->xps_check = (read->smode==MP4DMX_SPLIT_EXTRACTORS) ? MP4DMX_XPS_KEEP : MP4DMX_XPS_REMOVE;
@@ -491,8 +535,11 @@ static void isoffin_finalize(GF_Filter *filter)
 	}
 	gf_list_del(read->channels);
 
-	if (!read->extern_mov && read->mov) gf_isom_close(read->mov);
+	if (!read->extern_mov) isoffin_close_mov(read);
 	read->mov = NULL;
+	//release our reference, the last mapped packet destructor purges the movies if packets are still alive
+	if (!safe_int_dec(&read->mmap_refs))
+		isoffin_purge_mmap_movs(read);
 
 	if (read->mem_blob.data) gf_free(read->mem_blob.data);
 	if (read->mem_url) gf_free(read->mem_url);
@@ -659,6 +706,7 @@ ISOMChannel *isor_create_channel(ISOMReader *read, GF_FilterPid *pid, u32 track,
 	gf_list_add(read->channels, ch);
 	ch->track = track;
 	ch->item_id = item_id;
+	if (!item_id) ch->mmap_ref = read->mmap_active;
 
 	ch->nalu_extract_mode = 0;
 	ch->track_id = gf_isom_get_track_id(read->mov, ch->track);
@@ -835,6 +883,65 @@ u32 isoffin_channel_switch_quality(ISOMChannel *ch, GF_ISOFile *the_file, Bool s
 	return next_track;
 }
 
+//fragment window mode: discard sample tables of consumed tracks and load the next fragments
+//returns GF_TRUE if new samples were loaded
+static Bool isoffin_load_fragment_window(ISOMReader *read)
+{
+	u32 i, j, nb_tracks, count = gf_list_count(read->channels);
+	u64 bytes_missing=0, nb_samples=0, nb_new_samples=0;
+
+	if (!gf_isom_fragment_window_pending(read->mov) && read->input_loaded)
+		return GF_FALSE;
+
+	nb_tracks = gf_isom_get_track_count(read->mov);
+	for (i=0; i<nb_tracks; i++) {
+		Bool consumed = GF_TRUE;
+		u32 nb_track_samples = gf_isom_get_sample_count(read->mov, i+1);
+		nb_samples += nb_track_samples;
+		for (j=0; j<count; j++) {
+			ISOMChannel *ch = gf_list_get(read->channels, j);
+			if ((ch->track != i+1) || !ch->playing) continue;
+			//channels waiting for their start time do not need the loaded samples
+			if (ch->to_init && !ch->sample_num && (ch->last_state==GF_EOS)) continue;
+			if (ch->sample || (ch->sample_num < nb_track_samples)) consumed = GF_FALSE;
+			//nothing loaded yet for this channel, restart from its start time once samples are there
+			if (!nb_track_samples && !ch->sample && (ch->sample_num<=1)) {
+				ch->to_init = GF_TRUE;
+				ch->sample_num = 0;
+			}
+		}
+		//sample numbering and timing are kept, channels can continue with the next fragments
+		if (consumed)
+			gf_isom_reset_track_tables(read->mov, i+1);
+	}
+
+	gf_isom_refresh_fragmented(read->mov, &bytes_missing, NULL);
+
+	for (i=0; i<nb_tracks; i++) {
+		nb_new_samples += gf_isom_get_sample_count(read->mov, i+1);
+	}
+	return (nb_new_samples > nb_samples) ? GF_TRUE : GF_FALSE;
+}
+
+//fragment window mode: a channel has no more samples to send, load next fragments unless other channels
+//still have samples to send and are not blocked
+static Bool isoffin_fragment_window_check(ISOMReader *read)
+{
+	u32 i, count = gf_list_count(read->channels);
+	for (i=0; i<count; i++) {
+		ISOMChannel *ch = gf_list_get(read->channels, i);
+		if (!ch->playing || ch->eos_sent) continue;
+		//channel is dry or failed to fetch its next sample
+		if (!ch->sample && (ch->last_state==GF_EOS))
+			continue;
+		if (!ch->sample && (ch->sample_num >= gf_isom_get_sample_count(read->mov, ch->track)))
+			continue;
+		if (!gf_filter_pid_would_block(ch->pid))
+			return GF_FALSE;
+	}
+	return isoffin_load_fragment_window(read);
+}
+
 static Bool isoffin_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 {
 	u32 count, i;
@@ -902,6 +1009,9 @@ static Bool isoffin_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 
 		ch->sap_only = evt->play.drop_non_ref ? GF_TRUE : GF_FALSE;
 
+		if (ch->stbl_props_pending)
+			isor_declare_pending_sample_stats(ch);
+
 		GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[IsoMedia] Starting channel playback "LLD" to "LLD" (%g to %g)\n", ch->start, ch->end, evt->play.start_range, evt->play.end_range));
 
 		if (!read->nb_playing)
@@ -909,6 +1019,12 @@ static Bool isoffin_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 
 		if (read->is_partial_download) read->input_loaded = GF_FALSE;
 
+		if (read->fwin_active && !read->nb_playing && read->input_loaded && (evt->play.speed>=0) && !evt->play.from_pck) {
+			//reload fragments from the one containing the start time
+			if (gf_isom_seek_fragment_window(read->mov, MAX(evt->play.start_range, 0)) == GF_OK)
+				isoffin_load_fragment_window(read);
+		}
+
 		if (evt->play.no_byterange_forward) {
 			//new segment will be loaded, reset
 			gf_isom_reset_tables(read->mov, GF_TRUE);
@@ -1130,6 +1246,18 @@ static void isoffin_purge_mem(ISOMReader *read, u64 min_offset)
 	}
 }
 
+static void isoffin_mmap_pck_destructor(GF_Filter *filter, GF_FilterPid *pid, GF_FilterPacket *pck)
+{
+	ISOMReader *read = (ISOMReader *) gf_filter_get_udta(filter);
+	u32 refs = safe_int_dec(&read->mmap_refs);
+	//filter is finalized, last packet referencing the mappings: close movies now
+	if (!refs)
+		isoffin_purge_mmap_movs(read);
+	//last packet referencing a closed movie, purge it in process
+	else if ((refs==1) && read->mmap_movs)
+		gf_filter_post_process_task(filter);
+}
+
 static GF_Err isoffin_process(GF_Filter *filter)
 {
 	ISOMReader *read = gf_filter_get_udta(filter);
@@ -1143,6 +1271,9 @@ static GF_Err isoffin_process(GF_Filter *filter)
 	if (read->in_error)
 		return read->in_error;
 
+	if (read->mmap_movs && (read->mmap_refs==1))
+		isoffin_purge_mmap_movs(read);
+
 	if (read->pid) {
 		Bool fetch_input = GF_TRUE;
 
@@ -1239,7 +1370,8 @@ static GF_Err isoffin_process(GF_Filter *filter)
 				read->refresh_fragmented = GF_FALSE;
 		}
 
-		if (has_new_data) {
+		//in fragment window mode, new fragments are only parsed when needed
+		if (has_new_data && !read->fwin_active) {
 			u64 bytesMissing=0;
 			GF_Err e;
 			const char *new_url = NULL;
@@ -1325,6 +1457,12 @@ static GF_Err isoffin_process(GF_Filter *filter)
 				if (read->nodata) {
 					pck = gf_filter_pck_new_shared(ch->pid, NULL, ch->sample->dataLength, NULL);
 					if (!pck) return GF_OUT_OF_MEM;
+				} else if (ch->sample_mapped) {
+					pck = gf_filter_pck_new_shared(ch->pid, ch->sample_mapped, ch->sample->dataLength, isoffin_mmap_pck_destructor);
+					if (!pck) return GF_OUT_OF_MEM;
+					//mapping is read-only, filters modifying packets in place must copy
+					gf_filter_pck_set_readonly(pck);
+					safe_int_inc(&read->mmap_refs);
 				} else {
 					pck = gf_filter_pck_new_alloc(ch->pid, ch->sample->dataLength, &data);
 					if (!pck) return GF_OUT_OF_MEM;
@@ -1432,6 +1570,11 @@ static GF_Err isoffin_process(GF_Filter *filter)
 				ch->last_valid_sample_data_offset = ch->sample_data_offset;
 				nb_pck--;
 			} else if (ch->last_state==GF_EOS) {
+				if (read->fwin_active && isoffin_fragment_window_check(read))
+					continue;
+				if (read->fwin_active && gf_isom_fragment_window_pending(read->mov))
+					break;
+
 				if (ch->playing == 2) {
 					if (in_is_eos) {
 						ch->playing = GF_FALSE;
@@ -1467,6 +1610,8 @@ static GF_Err isoffin_process(GF_Filter *filter)
 				}
 				return ch->last_state;
 			} else {
+				if (read->fwin_active && isoffin_fragment_window_check(read))
+					continue;
 				read->force_fetch = GF_TRUE;
 				break;
 			}
@@ -1536,6 +1681,7 @@ static const GF_FilterArgs ISOFFInArgs[] =
 	{ OFFS(mstore_size), "target buffer size in bytes", GF_PROP_UINT, "1000000", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(mstore_purge), "minimum size in bytes between memory purges when reading from memory stream (pipe etc...), 0 means purge as soon as possible", GF_PROP_UINT, "50000", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(mstore_samples), "minimum number of samples to be present before purging sample tables when reading from memory stream (pipe etc...), 0 means purge as soon as possible", GF_PROP_UINT, "50", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(fwin), "number of movie fragments to load at once when reading fragmented files, sample tables of consumed fragments being discarded. 0 means all fragments are loaded", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(strtxt), "load text tracks (apple/tx3g) as MPEG-4 streaming text tracks", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(xps_check), "parameter sets extraction mode from AVC/HEVC/VVC samples\n"
 	"- keep: do not inspect sample (assumes input file is compliant when generating DASH/HLS/CMAF)\n"
@@ -1543,6 +1689,7 @@ static const GF_FilterArgs ISOFFInArgs[] =
 	"- auto: resolves to `keep` for `smode=splix` (dasher mode), `rem` otherwise"
 	, GF_PROP_UINT, "auto", "auto|keep|rem", GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(nodata), "do not load sample data", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(mmap), "use memory mapping of complete local files and forward sample data without copy when not modified by the demuxer", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 	{0}
 };
 
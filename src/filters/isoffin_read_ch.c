@@ -85,6 +85,22 @@ void isor_check_producer_ref_time(ISOMReader *read)
 }
 
 
+//fragment window mode: loaded audio samples end before the start time, wait for the next fragments
+//rather than sending all samples up to the start time - not done for sparse streams which may have no more samples
+static Bool isor_fragment_window_before_start(ISOMChannel *ch)
+{
+	u32 count;
+	u64 end;
+	if (!ch->owner->fwin_active || !ch->start || !gf_isom_fragment_window_pending(ch->owner->mov)) return GF_FALSE;
+	if ((ch->streamType!=GF_STREAM_AUDIO) || gf_isom_has_sync_points(ch->owner->mov, ch->track)) return GF_FALSE;
+	count = gf_isom_get_sample_count(ch->owner->mov, ch->track);
+	if (!count) return GF_FALSE;
+	//sample table timing is relative to the first loaded fragment
+	end = gf_isom_get_current_tfdt(ch->owner->mov, ch->track);
+	end += gf_isom_get_sample_dts(ch->owner->mov, ch->track, count) + gf_isom_get_sample_duration(ch->owner->mov, ch->track, count);
+	return (end <= ch->start) ? GF_TRUE : GF_FALSE;
+}
+
 static void init_reader(ISOMChannel *ch)
 {
 	u32 sample_desc_index=0;
@@ -106,6 +122,9 @@ static void init_reader(ISOMChannel *ch)
 		ch->sample = gf_isom_get_sample_ex(ch->owner->mov, ch->track, ch->sample_num, &sample_desc_index, ch->static_sample, &ch->sample_data_offset);
 		ch->disable_seek = GF_TRUE;
 		ch->au_seq_num = ch->sample_num;
+	} else if (isor_fragment_window_before_start(ch)) {
+		ch->sample = NULL;
+		return;
 	} else {
 		//if seek is disabled, get the next closest sample for this time; otherwise, get the previous RAP sample for this time
 		u32 mode = ch->disable_seek ? GF_ISOM_SEARCH_BACKWARD : GF_ISOM_SEARCH_SYNC_BACKWARD;
@@ -443,6 +462,17 @@ void isor_reader_get_sample(ISOMChannel *ch)
 		if (do_fetch) {
 			if (ch->owner->nodata) {
 				ch->sample = gf_isom_get_sample_info_ex(ch->owner->mov, ch->track, ch->sample_num, &sample_desc_index, &ch->sample_data_offset, ch->static_sample);
+			} else if (ch->mmap_ref) {
+				ch->sample = gf_isom_get_sample_info_ex(ch->owner->mov, ch->track, ch->sample_num, &sample_desc_index, &ch->sample_data_offset, ch->static_sample);
+				if (ch->sample)
+					ch->sample_mapped = gf_isom_get_sample_mapped_data(ch->owner->mov, ch->track, sample_desc_index, ch->sample_data_offset, ch->sample->dataLength);
+
+				//payload cannot be referenced (rewritten by isomedia), use regular fetch from now on
+				if (ch->sample && !ch->sample_mapped) {
+					ch->mmap_ref = GF_FALSE;
+					ch->static_sample->dataLength = ch->static_sample->alloc_size;
+					ch->sample = gf_isom_get_sample_ex(ch->owner->mov, ch->track, ch->sample_num, &sample_desc_index, ch->static_sample, &ch->sample_data_offset);
+				}
 			} else {
 				ch->sample = gf_isom_get_sample_ex(ch->owner->mov, ch->track, ch->sample_num, &sample_desc_index, ch->static_sample, &ch->sample_data_offset);
 			}
@@ -593,6 +623,7 @@ void isor_reader_release_sample(ISOMChannel *ch)
 	if (ch->sample)
 		ch->au_seq_num++;
 	ch->sample = NULL;
+	ch->sample_mapped = NULL;
 	ch->sai_buffer_size = 0;
 }
 
@@ -804,7 +835,7 @@ void isor_reader_check_config(ISOMChannel *ch)
 		//we cannot touch the payload if encrypted !!
 		if (ch->pck_encrypted) return;
 		u64 ch_layout = 0;
-		s32 PL = gf_mpegh_get_mhas_pl(ch->sample->data, ch->sample->dataLength, &ch_layout);
+		s32 PL = gf_mpegh_get_mhas_pl(ch->sample_mapped ? (u8 *) ch->sample_mapped : ch->sample->data, ch->sample->dataLength, &ch_layout);
 		if (PL>0) {
 			gf_filter_pid_set_property(ch->pid, GF_PROP_PID_PROFILE_LEVEL, &PROP_UINT((u32) PL));
 			ch->check_mhas_pl = GF_FALSE;
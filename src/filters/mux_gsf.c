@@ -168,21 +168,7 @@ static void gsfmx_encrypt(GSFMxCtx *ctx, char *data, u32 nb_crypt_bytes)
 
 	//reset IV at each packet
 	gf_crypt_set_IV(ctx->crypt, ctx->crypt_IV, 16);
-	if (ctx->pattern.den && ctx->pattern.num) {
-		u32 bytes_per_pattern = 16 * (ctx->pattern.num + ctx->pattern.den);
-		u32 offset = 0;
-		while (nb_crypt_bytes) {
-			gf_crypt_encrypt(ctx->crypt, data + offset, nb_crypt_bytes >= (u32) (16*ctx->pattern.num) ? 16*ctx->pattern.num : nb_crypt_bytes);
-			if (nb_crypt_bytes >= bytes_per_pattern) {
-				offset += bytes_per_pattern;
-				nb_crypt_bytes -= bytes_per_pattern;
-			} else {
-				nb_crypt_bytes = 0;
-			}
-		}
-	} else {
-		gf_crypt_encrypt(ctx->crypt, data, nb_crypt_bytes);
-	}
+	gf_crypt_encrypt_pattern(ctx->crypt, data, nb_crypt_bytes, ctx->pattern.num, ctx->pattern.den);
 #endif // GPAC_DISABLE_CRYPTO
 }
 
@@ -242,6 +242,7 @@ typedef struct
 	u32 pack3gp, ctmode;
 	Bool importer, pack_nal, moof_first, abs_offset, fsap, tfdt_traf, keep_utc, pps_inband;
 	u32 xps_inband, moovpad;
+	s32 moovres;
 	u32 block_size;
 	u32 store, tktpl, mudta;
 	s32 subs_sidx;
@@ -5600,6 +5601,42 @@ check_eos:
 	return GF_OK;
 }
 
+static void mp4_mux_set_moov_reserve(GF_MP4MuxCtx *ctx)
+{
+	GF_Err e;
+	u64 size;
+
+	if (ctx->moovres>0) {
+		size = ctx->moovres;
+	} else {
+		u32 i, count = gf_list_count(ctx->tracks);
+		u32 nb_tracks = gf_isom_get_track_count(ctx->file);
+		u32 *nb_samples;
+		if (!nb_tracks) return;
+		nb_samples = gf_malloc(sizeof(u32) * nb_tracks);
+		if (!nb_samples) return;
+		memset(nb_samples, 0, sizeof(u32) * nb_tracks);
+		for (i=0; i<count; i++) {
+			TrackWriter *tkw = gf_list_get(ctx->tracks, i);
+			if (tkw->fake_track || tkw->is_item || !tkw->track_num || (tkw->track_num>nb_tracks)) continue;
+			if (!tkw->nb_frames) {
+				GF_LOG(GF_LOG_INFO, GF_LOG_CONTAINER, ("[MP4Mux] Number of frames unknown for track %d, cannot estimate moov size - no space reserved\n", tkw->track_id));
+				gf_free(nb_samples);
+				return;
+			}
+			nb_samples[tkw->track_num-1] = tkw->nb_frames;
+		}
+		size = gf_isom_estimate_moov_size(ctx->file, nb_samples);
+		gf_free(nb_samples);
+	}
+	if (!size || (size > 0xFFFFFFFFUL)) return;
+
+	e = gf_isom_set_moov_reserve(ctx->file, (u32) size);
+	if (!e) {
+		GF_LOG(GF_LOG_INFO, GF_LOG_CONTAINER, ("[MP4Mux] Reserved %u bytes for moov before media data\n", (u32) size));
+	}
+}
+
 static void mp4_mux_config_timing(GF_MP4MuxCtx *ctx)
 {
 	u32 i, count = gf_list_count(ctx->tracks);
@@ -5722,6 +5759,9 @@ retry_pck:
 		}
 	}
 
+	if ((ctx->store==MP4MX_MODE_FASTSTART) && ctx->moovres && ctx->owns_mov)
+		mp4_mux_set_moov_reserve(ctx);
+
 	ctx->config_timing = GF_FALSE;
 }
 
@@ -6051,6 +6091,8 @@ static GF_Err mp4_mux_on_data(void *cbk, u8 *data, u32 block_size)
 	}
 
 	//allocate new one
+	//sample payloads are copied here, including in fragmented mode: the fragment writer derives trun data offsets
+	//and mdat sizes from its write position, so payloads cannot be forwarded as references to the input packets
 	ctx->dst_pck = gf_filter_pck_new_alloc(ctx->opid, block_size, &output);
 	if (!ctx->dst_pck) return GF_OUT_OF_MEM;
 
@@ -6763,6 +6805,7 @@ static const GF_FilterArgs MP4MuxArgs[] =
 	{ OFFS(keep_utc), "force all new files and tracks to keep the source UTC creation and modification times", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(pps_inband), "when xps_inband is set, inject PPS in each non SAP 1/2/3 sample", GF_PROP_BOOL, "no", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(moovpad), "insert free box of given size after moov for future in-place editing", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(moovres), "in `fstart` mode, reserve given space before mdat so that moov can be written without moving media data at the end. If -1, estimate the space from the number of frames of each input (see filter help)", GF_PROP_SINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(cmaf), "use cmaf guidelines (turns on `mvex`, `truns_first`, `strun`, `straf`, `tfdt_traf`, `chain_sidx` and restricts `subs_sidx` to -1 or 0)\n"
 		"- no: CMAF not enforced\n"
 		"- cmfc: use CMAF `cmfc` guidelines\n"
@@ -6789,6 +6832,10 @@ GF_FilterRegister MP4MuxRegister = {
 	"# Storage\n"
 	"The [-store]() option allows controlling if the file is fragmented ot not, and when not fragmented, how interleaving is done. For cases where disk requirements are tight and fragmentation cannot be used, it is recommended to use either `flat` or `fstart` modes.\n"
 	"  \n"
+	"In `fstart` mode, the `moov` box is by default inserted before the media data once all samples are written, which requires the output to move all media data. The [-moovres]() option can be used to reserve space for the `moov` box before the media data instead, so that the file is written in a single pass. "
+	"If the final `moov` box fits in the reserved space, the remaining space is kept as a `free` box, otherwise the `moov` box is inserted as usual. "
+	"When set to -1, the reserved space is estimated from the `NumFrames` property of each input, and no space is reserved if this property is not known for all inputs.\n"
+	"  \n"
 	"The [-vodcache]() option allows controlling how DASH onDemand segments are generated:\n"
 	"- If set to `on`, file data is stored to a temporary file on disk and flushed upon completion, no padding is present.\n"
 	"- If set to `insert`, SIDX/SSIX will be injected upon completion of the file by shifting bytes in file. In this case, no padding is required but this might not be compatible with all output sinks and will take longer to write the file.\n"
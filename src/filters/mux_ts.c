@@ -108,7 +108,6 @@ typedef struct
 
 	Bool check_pcr;
 	Bool update_mux;
-	char *pack_buffer;
 	u64 nb_pck;
 	Bool init_buffering;
 	u32 last_log_time;
@@ -188,6 +187,8 @@ typedef struct
 	u32 last_dur;
 
 	u8 *pck_data_buf;
+	//input packets whose payload is dispatched to the muxer without copy
+	GF_List *ref_pcks;
 
 	u32 suspended;
 } M2Pid;
@@ -358,9 +359,25 @@ static GF_Err tsmux_esi_ctrl(GF_ESInterface *ifce, u32 act_type, void *param)
 	if (!tspid) return GF_BAD_PARAM;
 
 	switch (act_type) {
+	case GF_ESI_INPUT_DATA_RELEASE:
+	{
+		u32 i, count = gf_list_count(tspid->ref_pcks);
+		for (i=0; i<count; i++) {
+			u32 size;
+			GF_FilterPacket *pck = gf_list_get(tspid->ref_pcks, i);
+			if (gf_filter_pck_get_data(pck, &size) == param) {
+				gf_list_rem(tspid->ref_pcks, i);
+				gf_filter_pck_unref(pck);
+				return GF_OK;
+			}
+		}
+	}
+		return GF_BAD_PARAM;
+
 	case GF_ESI_INPUT_DATA_FLUSH:
 	{
 		u64 dts;
+		u8 *pck_data;
 		GF_ESIPacket es_pck;
 		const GF_PropertyValue *p;
 		GF_FilterPacket *pck;
@@ -583,7 +600,7 @@ static GF_Err tsmux_esi_ctrl(GF_ESInterface *ifce, u32 act_type, void *param)
 				es_pck.flags |= GF_ESI_DATA_HAS_DTS;
 			}
 		}
-		es_pck.data = (char *) gf_filter_pck_get_data(pck, &es_pck.data_len);
+		es_pck.data = pck_data = (char *) gf_filter_pck_get_data(pck, &es_pck.data_len);
 		es_pck.duration = gf_filter_pck_get_duration(pck);
 		tspid->last_dur = es_pck.duration;
 
@@ -628,11 +645,20 @@ static GF_Err tsmux_esi_ctrl(GF_ESInterface *ifce, u32 act_type, void *param)
 		}
 		//for TTML we keep the entire payload as a PES packet
 
+		//payload not rewritten, keep a reference to the packet rather than having the muxer copy it
+		//we don't do so for blocking packets, as the muxer may wait for more input on this PID before releasing them
+		if (es_pck.data_len && (es_pck.data == pck_data) && !gf_filter_pck_is_blocking_ref(pck)) {
+			if (gf_filter_pck_ref(&pck) == GF_OK) {
+				if (!tspid->ref_pcks) tspid->ref_pcks = gf_list_new();
+				gf_list_add(tspid->ref_pcks, pck);
+				es_pck.flags |= GF_ESI_DATA_NO_COPY;
+			}
+		}
+
 		tspid->nb_pck++;
 		ifce->output_ctrl(ifce, GF_ESI_OUTPUT_DATA_DISPATCH, &es_pck);
 		GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[M2TSMux] PID %d: packet %d CTS "LLU"\n", tspid->esi.stream_id, tspid->nb_pck, es_pck.cts));
 
-		//data is copied by muxer for now, should need rewrite to avoid un-needed allocations
 		gf_filter_pid_drop_packet(tspid->ipid);
 
 		if (tspid->rewrite_odf) {
@@ -896,6 +922,13 @@ static void tsmux_del_stream(M2Pid *tspid)
 
 	if (tspid->esi.sl_config) gf_free(tspid->esi.sl_config);
 	if (tspid->pck_data_buf) gf_free(tspid->pck_data_buf);
+	if (tspid->ref_pcks) {
+		while (gf_list_count(tspid->ref_pcks)) {
+			GF_FilterPacket *pck = gf_list_pop_back(tspid->ref_pcks);
+			gf_filter_pck_unref(pck);
+		}
+		gf_list_del(tspid->ref_pcks);
+	}
 	gf_free(tspid);
 }
 
@@ -1318,6 +1351,7 @@ static GF_Err tsmux_process(GF_Filter *filter)
 	GF_M2TSMuxState status;
 	u32 usec_till_next;
 	GF_FilterPacket *pck;
+	u8 *output;
 	GF_TSMuxCtx *ctx = gf_filter_get_udta(filter);
 
 	if (ctx->check_pcr) {
@@ -1388,10 +1422,10 @@ static GF_Err tsmux_process(GF_Filter *filter)
 
 	nb_pck_in_call = 0;
 	nb_pck_in_pack=0;
+	pck = NULL;
+	output = NULL;
 	while (1) {
 		u64 pck_ts;
-		u8 *output;
-		u32 osize;
 		Bool is_pack_flush = GF_FALSE;
 		const char *ts_pck;
 
@@ -1399,29 +1433,25 @@ static GF_Err tsmux_process(GF_Filter *filter)
 		if (ts_pck == NULL) {
 			if (!nb_pck_in_pack)
 				break;
-			ts_pck = (const char *) ctx->pack_buffer;
+			gf_filter_pck_truncate(pck, nb_pck_in_pack * 188);
 			is_pack_flush = GF_TRUE;
 		} else {
 
 			tsmux_insert_sidx(ctx, GF_FALSE);
 
-			if (ctx->nb_pack>1) {
-				memcpy(ctx->pack_buffer + 188 * nb_pck_in_pack, ts_pck, 188);
-				nb_pck_in_pack++;
-
-				if (nb_pck_in_pack < ctx->nb_pack)
-					continue;
-
-				ts_pck = (const char *) ctx->pack_buffer;
-			} else {
-				nb_pck_in_pack = 1;
+			//write TS packets directly in the output packet
+			//each 188-byte packet interleaves its header with at most 184 payload bytes, so output stays contiguous
+			//and sinks write it as is rather than through a gather list referencing the input packets
+			if (!pck) {
+				pck = gf_filter_pck_new_alloc(ctx->opid, 188 * MAX(ctx->nb_pack, 1), &output);
+				if (!pck) return GF_OUT_OF_MEM;
 			}
+			memcpy(output + 188 * nb_pck_in_pack, ts_pck, 188);
+			nb_pck_in_pack++;
+
+			if (nb_pck_in_pack < ctx->nb_pack)
+				continue;
 		}
-		osize = nb_pck_in_pack * 188;
-		pck = gf_filter_pck_new_alloc(ctx->opid, osize, &output);
-		if (!pck) return GF_OUT_OF_MEM;
-		
-		memcpy(output, ts_pck, osize);
 		gf_filter_pck_set_framing(pck, ctx->nb_pck ? ctx->next_is_start : GF_TRUE, (status==GF_M2TS_STATE_EOS) ? GF_TRUE : GF_FALSE);
 
 		if (ctx->next_is_start && ctx->dash_mode) {
@@ -1448,6 +1478,7 @@ static GF_Err tsmux_process(GF_Filter *filter)
 			ctx->notify_filename = GF_FALSE;
 		}
 		gf_filter_pck_send(pck);
+		pck = NULL;
 		ctx->nb_pck += nb_pck_in_pack;
 		ctx->nb_pck_in_seg += nb_pck_in_pack;
 		ctx->nb_pck_in_file += nb_pck_in_pack;
@@ -1565,7 +1596,6 @@ static GF_Err tsmux_initialize(GF_Filter *filter)
 		ctx->init_buffering = GF_TRUE;
 	}
 	ctx->pids = gf_list_new();
-	if (ctx->nb_pack>1) ctx->pack_buffer = gf_malloc(sizeof(char)*188*ctx->nb_pack);
 
 #ifdef GPAC_ENABLE_COVERAGE
 	if (gf_sys_is_cov_mode()) {
@@ -1595,7 +1625,6 @@ static void tsmux_finalize(GF_Filter *filter)
 	}
 	gf_list_del(ctx->pids);
 	gf_m2ts_mux_del(ctx->mux);
-	if (ctx->pack_buffer) gf_free(ctx->pack_buffer);
 	if (ctx->sidx_entries) gf_free(ctx->sidx_entries);
 	if (ctx->idx_bs) gf_bs_del(ctx->idx_bs);
 	if (ctx->cur_file_suffix) gf_free(ctx->cur_file_suffix);
@@ -77,7 +77,7 @@ typedef struct
 	//options
 	char *dst, *user_agent, *ifce, *cache_control, *ext, *mime, *wdir, *cert, *pkey, *reqlog;
 	GF_PropStringList rdirs;
-	Bool close, hold, quit, post, dlist, ice;
+	Bool close, hold, quit, post, dlist, ice, zcopy;
 	u32 port, block_size, maxc, maxp, timeout, hmode, sutc, cors, max_client_errors;
 
 	//internal
@@ -106,6 +106,10 @@ typedef struct
 
 	u64 req_id;
 	Bool log_record;
+
+	//file bytes sent by all sessions using zero-copy and copy, reported in filter status
+	u64 tot_bytes_zcopy, tot_bytes_copy;
+	u64 last_status_bytes;
 } GF_HTTPOutCtx;
 
 typedef struct __httpout_input
@@ -200,6 +204,13 @@ typedef struct __httpout_session
 	Bool canceled;
 
 	Bool force_destroy;
+
+	//zero-copy send disabled for this session (not supported)
+	Bool no_zcopy;
+	//bytes sent using zero-copy for current request
+	u64 nb_bytes_zcopy;
+	//bytes sent using zero-copy and copy for the session lifetime
+	u64 tot_bytes_zcopy, tot_bytes_copy;
 } GF_HTTPOutSession;
 
 static void httpout_close_session(GF_HTTPOutSession *sess)
@@ -221,6 +232,10 @@ static void httpout_close_session(GF_HTTPOutSession *sess)
 		assert(sess->ctx->nb_connections);
 		sess->ctx->nb_connections--;
 
+		if (sess->tot_bytes_zcopy || sess->tot_bytes_copy) {
+			GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTPOut] Connection to %s closed - sent "LLU" bytes zero-copy and "LLU" bytes copied\n", sess->peer_address, sess->tot_bytes_zcopy, sess->tot_bytes_copy));
+		}
+
 		gf_sk_group_unregister(sess->ctx->sg, sess->socket);
 	}
 
@@ -455,6 +470,7 @@ static Bool httpout_sess_parse_range(GF_HTTPOutSession *sess, char *range)
 	u64 known_file_size;
 	sess->nb_ranges = 0;
 	sess->nb_bytes = 0;
+	sess->nb_bytes_zcopy = 0;
 	sess->range_idx = 0;
 	if (!range) return GF_TRUE;
 
@@ -767,6 +783,7 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 		}
 		sess->file_in_progress = GF_FALSE;
 		sess->nb_bytes = 0;
+		sess->nb_bytes_zcopy = 0;
 		sess->done = GF_FALSE;
 		assert(full_path);
 		if (sess->path) gf_free(sess->path);
@@ -955,6 +972,7 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 	sess->use_chunk_transfer = GF_FALSE;
 	sess->put_in_progress = 0;
 	sess->nb_bytes = 0;
+	sess->nb_bytes_zcopy = 0;
 	sess->upload_type = 0;
 
 	if (parameter->reply==GF_HTTP_DELETE) {
@@ -2023,7 +2041,11 @@ static void log_request_done(GF_HTTPOutSession *sess)
 			assert(tot_bytes==sess->nb_bytes);
 		}
 #endif
-		GF_LOG(GF_LOG_INFO, GF_LOG_ALL, ("[HTTPOut] %sREQ#"LLU" %s done: reply %d - "LLU" bytes in %d ms at %g %s\n", sprefix, sess->req_id, get_method_name(sess->method_type), sess->reply_code, sess->nb_bytes, (u32) (diff_us/1000), bps, unit));
+		if (sess->nb_bytes_zcopy) {
+			GF_LOG(GF_LOG_INFO, GF_LOG_ALL, ("[HTTPOut] %sREQ#"LLU" %s done: reply %d - "LLU" bytes ("LLU" zero-copy) in %d ms at %g %s\n", sprefix, sess->req_id, get_method_name(sess->method_type), sess->reply_code, sess->nb_bytes, sess->nb_bytes_zcopy, (u32) (diff_us/1000), bps, unit));
+		} else {
+			GF_LOG(GF_LOG_INFO, GF_LOG_ALL, ("[HTTPOut] %sREQ#"LLU" %s done: reply %d - "LLU" bytes in %d ms at %g %s\n", sprefix, sess->req_id, get_method_name(sess->method_type), sess->reply_code, sess->nb_bytes, (u32) (diff_us/1000), bps, unit));
+		}
 	}
 }
 
@@ -2293,6 +2315,35 @@ resend:
 		if (to_read > (u64) sess->ctx->block_size)
 			to_read = (u64) sess->ctx->block_size;
 
+		//zero-copy send of local files for plain HTTP/1.1 sessions
+		if (ctx->zcopy && !sess->no_zcopy && !ctx->ssl_ctx && !sess->is_h2 && !sess->use_chunk_transfer && !sess->in_source && !sess->put_in_progress) {
+			read = 0;
+			e = gf_sk_send_file(sess->socket, sess->resource, sess->file_pos, (u32) to_read, &read);
+			if (e==GF_NOT_SUPPORTED) {
+				GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTPOut] zero-copy not supported for %s, using regular send\n", sess->path));
+				sess->no_zcopy = GF_TRUE;
+				//file position was not modified by zero-copy sends
+				gf_fseek(sess->resource, sess->file_pos, SEEK_SET);
+				goto resend;
+			}
+			sess->last_active_time = gf_sys_clock_high_res();
+			if (e==GF_IP_SOCK_WOULD_BLOCK)
+				e = GF_OK;
+			//may happen when file writing is in progress
+			if (!e && !read)
+				return;
+
+			sess->file_pos += read;
+			sess->nb_bytes += read;
+			sess->nb_bytes_zcopy += read;
+			sess->tot_bytes_zcopy += read;
+			sess->ctx->tot_bytes_zcopy += read;
+			goto send_done;
+		}
+		//switching from zero-copy to regular read, resync file position
+		if (sess->nb_bytes_zcopy && (gf_ftell(sess->resource) != sess->file_pos))
+			gf_fseek(sess->resource, sess->file_pos, SEEK_SET);
+
 		read = (u32) gf_fread(sess->buffer, (u32) to_read, sess->resource);
 		//may happen when file writing is in progress
 		if (!read) {
@@ -2316,7 +2367,10 @@ resend:
 
 		sess->file_pos += read;
 		sess->nb_bytes += read;
+		sess->tot_bytes_copy += read;
+		sess->ctx->tot_bytes_copy += read;
 
+send_done:
 		if (e) {
 			if (e==GF_IP_CONNECTION_CLOSED) {
 				GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTPOut] Connection to %s for %s closed\n", sess->peer_address, sess->path));
@@ -3063,6 +3117,13 @@ static GF_Err httpout_process(GF_Filter *filter)
 		}
 	}
 
+	if (gf_filter_reporting_enabled(filter) && (ctx->last_status_bytes != ctx->tot_bytes_zcopy + ctx->tot_bytes_copy)) {
+		char szStatus[200];
+		ctx->last_status_bytes = ctx->tot_bytes_zcopy + ctx->tot_bytes_copy;
+		sprintf(szStatus, "%d connections - "LLU" bytes sent from files ("LLU" zero-copy, "LLU" copied)", ctx->nb_connections, ctx->last_status_bytes, ctx->tot_bytes_zcopy, ctx->tot_bytes_copy);
+		gf_filter_update_status(filter, -1, szStatus);
+	}
+
 	if (e==GF_EOS) {
 		if (ctx->dst) return GF_EOS;
 		e=GF_OK;
@@ -3172,6 +3233,7 @@ static const GF_FilterArgs HTTPOutArgs[] =
 		"- auto: enable CORS when `Origin` is found in request", GF_PROP_UINT, "auto", "auto|off|on", GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(reqlog), "provide short log of the requests indicated in this option (comma separated list, `*` for all) regardless of HTTP log settings. Value `REC` logs file writing start/end", GF_PROP_STRING, NULL, NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(ice), "insert ICE meta-data in response headers in sink mode - see filter help", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(zcopy), "use zero-copy transfer of local files for HTTP/1.1 sessions without TLS when supported by the system (sendfile). Bytes sent with and without zero-copy are reported in the filter status", GF_PROP_BOOL, "true", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(max_client_errors), "force disconnection after specified number of consecutive errors from HTTTP 1.1 client (ignored in H/2 or when `close` is set)", GF_PROP_UINT, "20", NULL, GF_FS_ARG_HINT_EXPERT},
 	{0}
 };
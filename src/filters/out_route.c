@@ -41,7 +41,7 @@ enum
 typedef struct
 {
 	char *dst, *ext, *mime, *ifce, *ip;
-	u32 carousel, first_port, bsid, mtu, splitlct, ttl, brinc, runfor;
+	u32 carousel, first_port, bsid, mtu, splitlct, ttl, brinc, runfor, batch;
 	Bool korean, llmode, noreg;
 
 	GF_FilterCapability in_caps[2];
@@ -63,6 +63,9 @@ typedef struct
 
 	u64 bytes_sent;
 	u8 *lct_buffer;
+	//batched LCT emission, all datagrams in the batch are for batch_sock
+	GF_SockBatch *snd_batch;
+	GF_Socket *batch_sock;
 
 	u64 reschedule_us;
 	u32 next_raw_file_toi;
@@ -631,6 +634,8 @@ static GF_Err routeout_initialize(GF_Filter *filter)
 	}
 
 	ctx->lct_buffer = gf_malloc(sizeof(u8) * ctx->mtu);
+	if (ctx->batch>1)
+		ctx->snd_batch = gf_sk_batch_new(ctx->batch, ctx->mtu);
 	ctx->clock_init = gf_sys_clock_high_res();
 	ctx->clock_stats = ctx->clock_init;
 
@@ -658,6 +663,7 @@ static void routeout_finalize(GF_Filter *filter)
 		gf_sk_del(ctx->sock_atsc_lls);
 
 	if (ctx->lct_buffer) gf_free(ctx->lct_buffer);
+	if (ctx->snd_batch) gf_sk_batch_del(ctx->snd_batch);
 	if (ctx->lls_slt_table) gf_free(ctx->lls_slt_table);
 	if (ctx->lls_time_table) gf_free(ctx->lls_time_table);
 }
@@ -1224,6 +1230,38 @@ static GF_Err routeout_check_service_updates(GF_ROUTEOutCtx *ctx, ROUTEService *
 }
 
 
+static void routeout_flush_batch(GF_ROUTEOutCtx *ctx)
+{
+	GF_Err e;
+	if (!ctx->batch_sock) return;
+	e = gf_sk_send_batch(ctx->batch_sock, ctx->snd_batch);
+	if (gf_sk_batch_pending(ctx->snd_batch)) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_ROUTE, ("[ROUTE] Failed to send %d LCT packets: %s, discarding\n", gf_sk_batch_pending(ctx->snd_batch), gf_error_to_string(e) ));
+		gf_sk_batch_reset(ctx->snd_batch);
+	} else if (e) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_ROUTE, ("[ROUTE] Failed to send LCT packets: %s\n", gf_error_to_string(e) ));
+	}
+	ctx->batch_sock = NULL;
+}
+
+static GF_Err routeout_send_lct_packet(GF_ROUTEOutCtx *ctx, GF_Socket *sock, u8 *data, u32 size)
+{
+	GF_Err e;
+	if (!ctx->snd_batch) return gf_sk_send(sock, data, size);
+
+	//batch is sent upon destination change, when full and at the end of each process call
+	if (ctx->batch_sock != sock)
+		routeout_flush_batch(ctx);
+
+	e = gf_sk_batch_add(ctx->snd_batch, data, size);
+	if (e == GF_BUFFER_TOO_SMALL) {
+		routeout_flush_batch(ctx);
+		e = gf_sk_batch_add(ctx->snd_batch, data, size);
+	}
+	if (!e) ctx->batch_sock = sock;
+	return e;
+}
+
 u32 routeout_lct_send(GF_ROUTEOutCtx *ctx, GF_Socket *sock, u32 tsi, u32 toi, u32 codepoint, u8 *payload, u32 len, u32 offset, u32 service_id, u32 total_size, u32 offset_in_frame)
 {
 	u32 max_size = ctx->mtu;
@@ -1293,7 +1331,7 @@ u32 routeout_lct_send(GF_ROUTEOutCtx *ctx, GF_Socket *sock, u32 tsi, u32 toi, u3
 	GF_LOG(GF_LOG_DEBUG, GF_LOG_ROUTE, ("[ROUTE] LCT SID %u TSI %u TOI %u size %u (frag %u total %u) offset %u (%u in obj)\n", service_id, tsi, toi, send_payl_size, len, total_size, offset, offset_in_frame));
 
 	memcpy(ctx->lct_buffer + hpos, payload + offset, send_payl_size);
-	e = gf_sk_send(sock, ctx->lct_buffer, send_payl_size + hpos);
+	e = routeout_send_lct_packet(ctx, sock, ctx->lct_buffer, send_payl_size + hpos);
 	if (e) {
 		GF_LOG(GF_LOG_ERROR, GF_LOG_ROUTE, ("[ROUTE] Failed to send LCT object TSI %u TOI %u fragment: %s\n", tsi, toi, gf_error_to_string(e) ));
 	}
@@ -2013,6 +2051,8 @@ static GF_Err routeout_process(GF_Filter *filter)
 				all_serv_done = GF_FALSE;
 		}
 	}
+	if (ctx->snd_batch)
+		routeout_flush_batch(ctx);
 
 	if (all_serv_done) {
 		return e ? e : GF_EOS;
@@ -2091,6 +2131,7 @@ static const GF_FilterArgs ROUTEOutArgs[] =
 	{ OFFS(ttl), "time-to-live for multicast packets", GF_PROP_UINT, "0", NULL, 0},
 	{ OFFS(bsid), "ID for ATSC broadcast stream", GF_PROP_UINT, "800", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(mtu), "size of LCT MTU in bytes", GF_PROP_UINT, "1472", NULL, 0},
+	{ OFFS(batch), "maximum number of LCT packets sent per system call, 1 disables batching", GF_PROP_UINT, "32", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(splitlct), "split mode for LCT channels\n"
 		"- off: all streams are in the same LCT channel\n"
 		"- type: each new stream type results in a new LCT channel\n"
@@ -27,6 +27,7 @@
 #include <gpac/filters.h>
 #include <gpac/constants.h>
 #include <gpac/network.h>
+#include <gpac/thread.h>
 
 typedef struct
 {
@@ -36,16 +37,34 @@ typedef struct
 	Bool pck_pending;
 } GF_SockOutClient;
 
+//datagram queued for paced emission
+typedef struct
+{
+	u8 *data;
+	u32 size, alloc;
+	//position of the first byte of the datagram in the output stream
+	u64 byte_pos;
+	//target emission time in microseconds (system clock)
+	u64 send_time;
+	//datagram carries a PCR of the paced PID
+	Bool has_pcr;
+} SockOutPaceSlot;
+
+#define PCR_WRAP	(((u64)1<<33) * 300)
+
 typedef struct
 {
 	//options
 	Double start, speed;
 	char *dst, *mime, *ext, *ifce;
 	Bool listen;
-	u32 maxc, port, sockbuf, ka, kp, rate, ttl;
+	u32 maxc, port, sockbuf, ka, kp, rate, ttl, batch, pbuf, pspin;
 	GF_Fraction pckr, pckd;
+	Bool pace;
 
 	GF_Socket *socket;
+	//batched UDP emission
+	GF_SockBatch *snd_batch;
 	//only one output pid
 	GF_FilterPid *pid;
 
@@ -66,8 +85,339 @@ typedef struct
 	GF_FilterPacket *rev_pck;
 	u32 next_pckd_idx, next_pckr_idx;
 	u32 nb_pckd_wnd, nb_pckr_wnd;
+
+	//PCR pacing: ring of datagrams, slots in [rd, timed[ have a send time, slots in [timed, wr[ wait for the next PCR
+	GF_Thread *pace_th;
+	GF_Mutex *pace_mx;
+	GF_Semaphore *pace_sema;
+	SockOutPaceSlot **slots;
+	u32 nb_alloc_slots, slot_rd, nb_timed, nb_queued;
+	Bool pace_exit;
+	u64 pace_byte_pos;
+	s32 pcr_pid;
+	u64 last_pcr, last_pcr_pos, last_pcr_time, pace_rate;
+	//correction applied to send times after late emission, updated by pacing thread only
+	s64 pace_shift;
+	//stats
+	u64 nb_pace_pcr, nb_pace_late, nb_pace_resync, nb_pace_dgrams;
+	s64 pcr_err_max, pcr_err_min;
+	Double pcr_err_sum, pcr_err_sum2;
 } GF_SockOutCtx;
 
+static void sockout_pace_stats(GF_SockOutCtx *ctx, Bool is_final);
+
+
+static GF_Err sockout_flush_batch(GF_SockOutCtx *ctx)
+{
+	GF_Err e;
+	if (!ctx->snd_batch || !ctx->socket || !gf_sk_batch_pending(ctx->snd_batch)) return GF_OK;
+
+	e = gf_sk_send_batch(ctx->socket, ctx->snd_batch);
+	//datagrams still pending, retry later
+	if ((e==GF_IP_SOCK_WOULD_BLOCK) || (e==GF_BUFFER_TOO_SMALL))
+		return GF_BUFFER_TOO_SMALL;
+	if (e) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_NETWORK, ("[SockOut] Write error: %s\n", gf_error_to_string(e) ));
+	}
+	return e;
+}
+
+static void sockout_pace_stop(GF_SockOutCtx *ctx)
+{
+	if (!ctx->pace_th) return;
+	ctx->pace_exit = GF_TRUE;
+	gf_sema_notify(ctx->pace_sema, 1);
+	gf_th_stop(ctx->pace_th);
+	gf_th_del(ctx->pace_th);
+	ctx->pace_th = NULL;
+	sockout_pace_stats(ctx, GF_TRUE);
+}
+
+static void sockout_close_socket(GF_SockOutCtx *ctx)
+{
+	if (!ctx->socket) return;
+	sockout_pace_stop(ctx);
+	if (ctx->snd_batch) {
+#ifndef GPAC_DISABLE_LOG
+		u64 nb_calls, nb_dgrams, nb_slots, nb_drops;
+#endif
+		sockout_flush_batch(ctx);
+#ifndef GPAC_DISABLE_LOG
+		gf_sk_get_batch_stats(ctx->socket, &nb_calls, &nb_dgrams, &nb_slots, &nb_drops);
+		if (nb_calls) {
+			GF_LOG(nb_drops ? GF_LOG_WARNING : GF_LOG_INFO, GF_LOG_NETWORK, ("[SockOut] Sent "LLU" datagrams in "LLU" calls - batch fill ratio %.02f %% - "LLU" dropped\n", nb_dgrams, nb_calls, ((Double) nb_dgrams*100)/nb_slots, nb_drops));
+		}
+#endif
+	}
+	gf_sk_del(ctx->socket);
+	ctx->socket = NULL;
+}
+
+static void sockout_pace_stats(GF_SockOutCtx *ctx, Bool is_final)
+{
+#ifndef GPAC_DISABLE_LOG
+	Double mean, jitter;
+	if (!ctx->nb_pace_pcr) {
+		if (is_final && ctx->nb_pace_dgrams) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[SockOut] Paced "LLU" datagrams but no PCR found in stream\n", ctx->nb_pace_dgrams));
+		}
+		return;
+	}
+	mean = ctx->pcr_err_sum / ctx->nb_pace_pcr;
+	jitter = ctx->pcr_err_sum2 / ctx->nb_pace_pcr - mean*mean;
+	jitter = (jitter>0) ? sqrt(jitter) : 0;
+	GF_LOG(is_final ? GF_LOG_INFO : GF_LOG_DEBUG, GF_LOG_NETWORK, ("[SockOut] Paced "LLU" datagrams - PCR accuracy over "LLU" PCRs: mean %.02f us jitter %.02f us min "LLD" us max "LLD" us - "LLU" late datagrams - "LLU" resyncs\n",
+		ctx->nb_pace_dgrams, ctx->nb_pace_pcr, mean, jitter, ctx->pcr_err_min, ctx->pcr_err_max, ctx->nb_pace_late, ctx->nb_pace_resync));
+#endif
+}
+
+//wait until target time using sleeps, then busy-wait for the last pspin microseconds
+static u64 sockout_pace_wait(GF_SockOutCtx *ctx, u64 target)
+{
+	u64 now = gf_sys_clock_high_res();
+	while (now < target) {
+		u64 diff = target - now;
+		if (ctx->pace_exit) break;
+		if (diff > ctx->pspin) {
+			diff -= ctx->pspin;
+			//wake up regularly to check for exit
+			if (diff > 100000) diff = 100000;
+			gf_usleep((u32) diff);
+		}
+		now = gf_sys_clock_high_res();
+	}
+	return now;
+}
+
+static u32 sockout_pace_thread(void *par)
+{
+	GF_SockOutCtx *ctx = (GF_SockOutCtx *) par;
+	u64 max_delay = (u64) ctx->pbuf * 1000;
+	u64 pcr_stat_time = 0;
+
+	while (1) {
+		SockOutPaceSlot *slot;
+		u64 target, now;
+		GF_Err e;
+
+		//pace_shift is also read when queuing packets, only access it under pace mutex
+		gf_mx_p(ctx->pace_mx);
+		slot = ctx->nb_timed ? ctx->slots[ctx->slot_rd] : NULL;
+		if (!slot) {
+			gf_mx_v(ctx->pace_mx);
+			if (ctx->pace_exit) break;
+			gf_sema_wait_for(ctx->pace_sema, 10);
+			continue;
+		}
+		target = slot->send_time + ctx->pace_shift;
+		now = gf_sys_clock_high_res();
+		//too far in the future, timeline jump not detected on input, resync
+		if (target > now + 2*max_delay + 1000000) {
+			ctx->pace_shift -= (s64) (target - now);
+			ctx->nb_pace_resync++;
+			target = now;
+		}
+		gf_mx_v(ctx->pace_mx);
+
+		if (target > now) {
+			now = sockout_pace_wait(ctx, target);
+		}
+		//way too late (input stall), shift timeline rather than bursting
+		else if (now > target + max_delay) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[SockOut] Paced output late by "LLU" us, resyncing\n", now - target));
+			gf_mx_p(ctx->pace_mx);
+			ctx->pace_shift += (s64) (now - target);
+			gf_mx_v(ctx->pace_mx);
+			ctx->nb_pace_resync++;
+			target = now;
+		}
+
+		e = gf_sk_send(ctx->socket, slot->data, slot->size);
+		if (e) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_NETWORK, ("[SockOut] Write error: %s\n", gf_error_to_string(e) ));
+		}
+		ctx->nb_pace_dgrams++;
+		if (now > target + 1000) ctx->nb_pace_late++;
+
+		if (slot->has_pcr) {
+			s64 err = (s64) now - (s64) target;
+			if (!ctx->nb_pace_pcr || (err > ctx->pcr_err_max)) ctx->pcr_err_max = err;
+			if (!ctx->nb_pace_pcr || (err < ctx->pcr_err_min)) ctx->pcr_err_min = err;
+			ctx->pcr_err_sum += (Double) err;
+			ctx->pcr_err_sum2 += (Double) err * err;
+			ctx->nb_pace_pcr++;
+			if (now > pcr_stat_time + 5000000) {
+				if (pcr_stat_time) sockout_pace_stats(ctx, GF_FALSE);
+				pcr_stat_time = now;
+			}
+		}
+
+		gf_mx_p(ctx->pace_mx);
+		ctx->slot_rd = (ctx->slot_rd + 1) % ctx->nb_alloc_slots;
+		ctx->nb_timed--;
+		ctx->nb_queued--;
+		gf_mx_v(ctx->pace_mx);
+	}
+	return 0;
+}
+
+//pace mutex shall be held - assign send times to all slots waiting for a PCR, by interpolation between last PCR and the new one
+static void sockout_pace_time_slots(GF_SockOutCtx *ctx, u64 pcr_pos, u64 pcr_time, Bool interpolate)
+{
+	while (ctx->nb_timed < ctx->nb_queued) {
+		SockOutPaceSlot *slot = ctx->slots[(ctx->slot_rd + ctx->nb_timed) % ctx->nb_alloc_slots];
+		if (interpolate && (pcr_pos > ctx->last_pcr_pos) && (slot->byte_pos > ctx->last_pcr_pos)) {
+			slot->send_time = ctx->last_pcr_time + (slot->byte_pos - ctx->last_pcr_pos) * (pcr_time - ctx->last_pcr_time) / (pcr_pos - ctx->last_pcr_pos);
+		} else {
+			slot->send_time = interpolate ? ctx->last_pcr_time : pcr_time;
+		}
+		ctx->nb_timed++;
+	}
+}
+
+//pace mutex shall be held
+static void sockout_pace_on_pcr(GF_SockOutCtx *ctx, SockOutPaceSlot *slot, u64 pcr, u64 pcr_pos, Bool discontinuity)
+{
+	u64 pcr_time;
+	if (!ctx->last_pcr_time) {
+		//first PCR sent after the pacing buffer delay
+		pcr_time = gf_sys_clock_high_res() + (u64) ctx->pbuf * 1000;
+		sockout_pace_time_slots(ctx, pcr_pos, pcr_time, GF_FALSE);
+	} else {
+		u64 diff = (pcr + PCR_WRAP - ctx->last_pcr) % PCR_WRAP;
+		//discontinuity, PCR going backward or jump of more than 1s: continue at current rate
+		if (discontinuity || !diff || (diff > 27000000)) {
+			pcr_time = ctx->last_pcr_time;
+			if (ctx->pace_rate)
+				pcr_time += (pcr_pos - ctx->last_pcr_pos) * 8 * 1000000 / ctx->pace_rate;
+		} else {
+			pcr_time = ctx->last_pcr_time + diff / 27;
+			ctx->pace_rate = (pcr_pos - ctx->last_pcr_pos) * 8 * 27000000 / diff;
+		}
+		sockout_pace_time_slots(ctx, pcr_pos, pcr_time, GF_TRUE);
+	}
+	slot->has_pcr = GF_TRUE;
+	ctx->last_pcr = pcr;
+	ctx->last_pcr_pos = pcr_pos;
+	ctx->last_pcr_time = pcr_time;
+}
+
+//pace mutex shall be held - locate PCRs of the first PCR PID found in the TS packets of the datagram
+static void sockout_pace_parse(GF_SockOutCtx *ctx, SockOutPaceSlot *slot)
+{
+	u32 i;
+	for (i=0; i+188<=slot->size; i+=188) {
+		u32 pid;
+		u64 pcr;
+		const u8 *ts = slot->data + i;
+		if (ts[0] != 0x47) break;
+		//adaptation field with PCR flag
+		if (!(ts[3] & 0x20) || (ts[4] < 7) || !(ts[5] & 0x10)) continue;
+		pid = ((ts[1] & 0x1F) << 8) | ts[2];
+		if (ctx->pcr_pid < 0) {
+			ctx->pcr_pid = pid;
+			GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[SockOut] Pacing output on PCR PID %d\n", pid));
+		}
+		else if ((u32) ctx->pcr_pid != pid) continue;
+
+		pcr = ((u64) ts[6] << 25) | ((u64) ts[7] << 17) | ((u64) ts[8] << 9) | ((u64) ts[9] << 1) | (ts[10] >> 7);
+		pcr = pcr * 300 + ((((u32) ts[10] & 0x1) << 8) | ts[11]);
+		sockout_pace_on_pcr(ctx, slot, pcr, slot->byte_pos + i, (ts[5] & 0x80) ? GF_TRUE : GF_FALSE);
+	}
+}
+
+//queue datagram for paced emission, returns GF_BUFFER_TOO_SMALL if the pacing buffer is full
+static GF_Err sockout_pace_packet(GF_SockOutCtx *ctx, const u8 *data, u32 size)
+{
+	SockOutPaceSlot *slot;
+	u64 now = gf_sys_clock_high_res();
+
+	gf_mx_p(ctx->pace_mx);
+	//enough data scheduled ahead
+	if (ctx->nb_timed) {
+		SockOutPaceSlot *last = ctx->slots[(ctx->slot_rd + ctx->nb_timed - 1) % ctx->nb_alloc_slots];
+		if (last->send_time + ctx->pace_shift > now + (u64) ctx->pbuf * 1000) {
+			gf_mx_v(ctx->pace_mx);
+			return GF_BUFFER_TOO_SMALL;
+		}
+	}
+	if (ctx->nb_queued == ctx->nb_alloc_slots) {
+		u32 i, nb_alloc = ctx->nb_alloc_slots ? 2*ctx->nb_alloc_slots : 256;
+		SockOutPaceSlot **slots;
+		//no PCR found after a large amount of data, send as soon as possible
+		if (ctx->nb_timed < ctx->nb_queued/2) {
+			if (ctx->nb_alloc_slots >= 0x10000) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[SockOut] No PCR found for "LLU" bytes, sending without pacing\n", ctx->pace_byte_pos - ctx->last_pcr_pos));
+				ctx->last_pcr_pos = ctx->pace_byte_pos;
+				sockout_pace_time_slots(ctx, 0, now, GF_FALSE);
+				gf_mx_v(ctx->pace_mx);
+				gf_sema_notify(ctx->pace_sema, 1);
+				return GF_BUFFER_TOO_SMALL;
+			}
+		}
+		slots = gf_malloc(sizeof(SockOutPaceSlot *) * nb_alloc);
+		if (!slots) {
+			gf_mx_v(ctx->pace_mx);
+			return GF_OUT_OF_MEM;
+		}
+		memset(slots, 0, sizeof(SockOutPaceSlot *) * nb_alloc);
+		//linearize the ring
+		for (i=0; i<ctx->nb_alloc_slots; i++) {
+			slots[i] = ctx->slots[(ctx->slot_rd + i) % ctx->nb_alloc_slots];
+		}
+		if (ctx->slots) gf_free(ctx->slots);
+		ctx->slots = slots;
+		ctx->slot_rd = 0;
+		ctx->nb_alloc_slots = nb_alloc;
+	}
+	slot = ctx->slots[(ctx->slot_rd + ctx->nb_queued) % ctx->nb_alloc_slots];
+	if (!slot) {
+		GF_SAFEALLOC(slot, SockOutPaceSlot);
+		if (!slot) {
+			gf_mx_v(ctx->pace_mx);
+			return GF_OUT_OF_MEM;
+		}
+		ctx->slots[(ctx->slot_rd + ctx->nb_queued) % ctx->nb_alloc_slots] = slot;
+	}
+	if (slot->alloc < size) {
+		slot->data = gf_realloc(slot->data, size);
+		if (!slot->data) {
+			slot->alloc = 0;
+			gf_mx_v(ctx->pace_mx);
+			return GF_OUT_OF_MEM;
+		}
+		slot->alloc = size;
+	}
+	memcpy(slot->data, data, size);
+	slot->size = size;
+	slot->byte_pos = ctx->pace_byte_pos;
+	slot->has_pcr = GF_FALSE;
+	ctx->pace_byte_pos += size;
+	ctx->nb_queued++;
+
+	sockout_pace_parse(ctx, slot);
+	gf_mx_v(ctx->pace_mx);
+
+	gf_sema_notify(ctx->pace_sema, 1);
+	return GF_OK;
+}
+
+//end of stream, schedule datagrams after the last PCR at the last known rate and wait for the queue to be empty
+static Bool sockout_pace_flush(GF_SockOutCtx *ctx)
+{
+	Bool done;
+	gf_mx_p(ctx->pace_mx);
+	if (ctx->nb_timed < ctx->nb_queued) {
+		u64 end_time = ctx->last_pcr_time ? ctx->last_pcr_time : gf_sys_clock_high_res();
+		if (ctx->pace_rate)
+			end_time += (ctx->pace_byte_pos - ctx->last_pcr_pos) * 8 * 1000000 / ctx->pace_rate;
+		sockout_pace_time_slots(ctx, ctx->pace_byte_pos, end_time, ctx->last_pcr_time ? GF_TRUE : GF_FALSE);
+		gf_sema_notify(ctx->pace_sema, 1);
+	}
+	done = ctx->nb_queued ? GF_FALSE : GF_TRUE;
+	gf_mx_v(ctx->pace_mx);
+	return done;
+}
 
 static GF_Err sockout_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remove)
 {
@@ -75,8 +425,7 @@ static GF_Err sockout_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool i
 	GF_SockOutCtx *ctx = (GF_SockOutCtx *) gf_filter_get_udta(filter);
 	if (is_remove) {
 		ctx->pid = NULL;
-		gf_sk_del(ctx->socket);
-		ctx->socket = NULL;
+		sockout_close_socket(ctx);
 		return GF_OK;
 	}
 	gf_filter_pid_check_caps(pid);
@@ -230,6 +579,35 @@ static GF_Err sockout_initialize(GF_Filter *filter)
 
 	gf_sk_set_buffer_size(ctx->socket, 0, ctx->sockbuf);
 
+	if (ctx->pace) {
+		if (ctx->listen || (sock_type != GF_SOCK_TYPE_UDP)) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[SockOut] PCR pacing only available for UDP output, disabling\n"));
+			ctx->pace = GF_FALSE;
+		} else {
+			ctx->pcr_pid = -1;
+			ctx->pace_mx = gf_mx_new("SockOutPace");
+			ctx->pace_sema = gf_sema_new(GF_INT_MAX, 0);
+			ctx->pace_th = gf_th_new("SockOutPace");
+			if (!ctx->pace_mx || !ctx->pace_sema || !ctx->pace_th) return GF_OUT_OF_MEM;
+			//datagrams are sent one by one at their scheduled time, rate is given by the PCRs
+			ctx->batch = 0;
+			ctx->rate = 0;
+			e = gf_th_run(ctx->pace_th, sockout_pace_thread, ctx);
+			if (e) return e;
+			gf_th_set_priority(ctx->pace_th, GF_THREAD_PRIORITY_REALTIME);
+		}
+	}
+
+	if (!ctx->listen && (ctx->batch>1)
+		&& ((sock_type == GF_SOCK_TYPE_UDP)
+#ifdef GPAC_HAS_SOCK_UN
+		|| (sock_type == GF_SOCK_TYPE_UDP_UN)
+#endif
+	)) {
+		//max UDP payload size, only the pages actually written are used
+		ctx->snd_batch = gf_sk_batch_new(ctx->batch, 0x10000);
+		if (!ctx->snd_batch) return GF_OUT_OF_MEM;
+	}
 	return GF_OK;
 }
 
@@ -245,7 +623,22 @@ static void sockout_finalize(GF_Filter *filter)
 		gf_list_del(ctx->clients);
 	}
 
-	if (ctx->socket) gf_sk_del(ctx->socket);
+	sockout_close_socket(ctx);
+	if (ctx->snd_batch) gf_sk_batch_del(ctx->snd_batch);
+	//in case socket setup failed
+	sockout_pace_stop(ctx);
+	if (ctx->slots) {
+		u32 i;
+		for (i=0; i<ctx->nb_alloc_slots; i++) {
+			SockOutPaceSlot *slot = ctx->slots[i];
+			if (!slot) continue;
+			if (slot->data) gf_free(slot->data);
+			gf_free(slot);
+		}
+		gf_free(ctx->slots);
+	}
+	if (ctx->pace_mx) gf_mx_del(ctx->pace_mx);
+	if (ctx->pace_sema) gf_sema_del(ctx->pace_sema);
 }
 
 static GF_Err sockout_send_packet(GF_SockOutCtx *ctx, GF_FilterPacket *pck, GF_Socket *dst_sock)
@@ -260,6 +653,26 @@ static GF_Err sockout_send_packet(GF_SockOutCtx *ctx, GF_FilterPacket *pck, GF_S
 	if (!dst_sock) return GF_OK;
 
 	pck_data = gf_filter_pck_get_data(pck, &pck_size);
+	if (pck_data && ctx->pace_th && (dst_sock==ctx->socket)) {
+		e = sockout_pace_packet(ctx, pck_data, pck_size);
+		if (!e) ctx->nb_bytes_sent += pck_size;
+		return e;
+	}
+	if (pck_data && ctx->snd_batch && (dst_sock==ctx->socket)) {
+		e = gf_sk_batch_add(ctx->snd_batch, pck_data, pck_size);
+		if (e == GF_BUFFER_TOO_SMALL) {
+			//batch full or packet too large, send pending datagrams
+			e = sockout_flush_batch(ctx);
+			if (e == GF_BUFFER_TOO_SMALL) return e;
+			e = gf_sk_batch_add(ctx->snd_batch, pck_data, pck_size);
+			if (e == GF_BUFFER_TOO_SMALL) e = gf_sk_send(dst_sock, pck_data, pck_size);
+		}
+		if (e) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_NETWORK, ("[SockOut] Write error: %s\n", gf_error_to_string(e) ));
+		}
+		ctx->nb_bytes_sent += pck_size;
+		return e;
+	}
 	if (pck_data) {
 		e = gf_sk_send(dst_sock, pck_data, pck_size);
 		if (e) {
@@ -332,6 +745,7 @@ static GF_Err sockout_process(GF_Filter *filter)
 			u64 now = gf_sys_clock_high_res() - ctx->start_time;
 			if (ctx->nb_bytes_sent*8*1000000 > ctx->rate * now) {
 				u64 diff = ctx->nb_bytes_sent*8*1000000 / ctx->rate - now;
+				sockout_flush_batch(ctx);
 				gf_filter_ask_rt_reschedule(filter, (u32) MAX(diff, 1000) );
 				return GF_OK;
 			} else if (gf_filter_reporting_enabled(filter)) {
@@ -379,14 +793,23 @@ static GF_Err sockout_process(GF_Filter *filter)
 
 	pck = gf_filter_pid_get_packet(ctx->pid);
 	if (!pck) {
+		//input drained, send queued datagrams
+		if (sockout_flush_batch(ctx) == GF_BUFFER_TOO_SMALL) {
+			gf_filter_ask_rt_reschedule(filter, 1000);
+			return GF_OK;
+		}
 		if (gf_filter_pid_is_eos(ctx->pid)) {
 			if (ctx->rev_pck) {
 				is_pck_ref = GF_TRUE;
 				pck = ctx->rev_pck;
 			} else {
+				//wait for paced datagrams to be sent
+				if (ctx->pace_th && !sockout_pace_flush(ctx)) {
+					gf_filter_ask_rt_reschedule(filter, 10000);
+					return GF_OK;
+				}
 				if (!ctx->listen) {
-					gf_sk_del(ctx->socket);
-					ctx->socket = NULL;
+					sockout_close_socket(ctx);
 					return GF_EOS;
 				}
 				if (!ctx->ka)
@@ -479,7 +902,11 @@ static GF_Err sockout_process(GF_Filter *filter)
 
 	} else {
 		e = sockout_send_packet(ctx, pck, ctx->socket);
-		if (e == GF_BUFFER_TOO_SMALL) return GF_OK;
+		if (e == GF_BUFFER_TOO_SMALL) {
+			//pacing buffer full, wait for datagrams to be sent
+			if (ctx->pace_th) gf_filter_ask_rt_reschedule(filter, 2000);
+			return GF_OK;
+		}
 	}
 
 	ctx->nb_pck_processed++;
@@ -498,6 +925,9 @@ static GF_Err sockout_process(GF_Filter *filter)
 			ctx->nb_pckr_wnd++;
 		}
 	}
+	//input drained, send queued datagrams without waiting for the next packet
+	if (ctx->snd_batch && !ctx->rev_pck && !gf_filter_pid_get_packet(ctx->pid))
+		sockout_flush_batch(ctx);
 	return GF_OK;
 }
 
@@ -533,6 +963,10 @@ static const GF_FilterArgs SockOutArgs[] =
 	{ OFFS(pckr), "reverse packet every N - see filter help", GF_PROP_FRACTION, "0/0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(pckd), "drop packet every N - see filter help", GF_PROP_FRACTION, "0/0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(ttl), "multicast TTL", GF_PROP_UINT, "0", "0-127", GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(batch), "maximum number of datagrams sent per system call in UDP mode, 1 disables batching", GF_PROP_UINT, "32", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(pace), "pace MPEG-2 TS datagrams on their PCR values in a dedicated thread (UDP only) - see filter help", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED},
+	{ OFFS(pbuf), "pacing buffer in ms, delay between reception of a PCR and its emission", GF_PROP_UINT, "100", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(pspin), "duration in microseconds before datagram emission time for which the pacing thread busy-waits instead of sleeping", GF_PROP_UINT, "200", NULL, GF_FS_ARG_HINT_EXPERT},
 	{0}
 };
 
@@ -575,6 +1009,15 @@ GF_FilterRegister SockOutRegister = {
 		"This drops every 4th packet of each 10 packet window.\n"
 		"EX :pckr=0/100\n"\
 		"This reverts the send order of one random packet in each 100 packet window.\n"
+		"\n"
+		"# PCR pacing\n"
+		"When [-pace]() is set for UDP output of MPEG-2 TS, datagrams are not sent when received but queued and sent by a dedicated high priority thread, independently of the session scheduling.\n"
+		"The send time of each datagram is interpolated between the PCRs (of the first PCR PID found) surrounding it, the first PCR being sent [-pbuf]() ms after its reception.\n"
+		"Input is no longer consumed when more than [-pbuf]() ms of data is scheduled, so the multiplexer does not need to run in real time and can produce data in bursts.\n"
+		"The [-rate]() option is ignored in this mode.\n"
+		"The deviation between actual and PCR-based emission time of datagrams carrying a PCR is logged (`network@info` at the end, `network@debug` periodically).\n"
+		"EX gpac -i src.mp4 m2tsmx:rate=50m:nb_pack=7 @ -o udp://239.0.0.1:1234/:ext=ts:pace\n"
+		"This paces a 50 Mbps CBR multiplex, the rate being set on the multiplexer, with one datagram of 7 TS packets every 210 us.\n"
 		"\n",
 #endif //GPAC_DISABLE_DOC
 	.private_size = sizeof(GF_SockOutCtx),
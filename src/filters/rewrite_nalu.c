@@ -326,6 +326,24 @@ static Bool nalumx_is_nal_skip(GF_NALUMxCtx *ctx, u8 *data, u32 pos, Bool *has_n
 	return GF_FALSE;
 }
 
+static void nalumx_send_packet(GF_Filter *filter, GF_NALUMxCtx *ctx, GF_FilterPacket *dst_pck)
+{
+	gf_filter_pck_set_byte_offset(dst_pck, GF_FILTER_NO_BO);
+
+	gf_filter_pck_set_framing(dst_pck, GF_TRUE, GF_TRUE);
+	gf_filter_pck_send(dst_pck);
+
+	gf_filter_pid_drop_packet(ctx->ipid);
+
+	if (gf_filter_reporting_enabled(filter)) {
+		char szStatus[1024];
+
+		sprintf(szStatus, "%s Annex-B %dx%d % 10d NALU", (ctx->vtype==UFNAL_HEVC) ? "HEVC" : ((ctx->vtype==UFNAL_VVC) ? "VVC" : "AVC|H264"), ctx->width, ctx->height, ctx->nb_nalu);
+		gf_filter_update_status(filter, -1, szStatus);
+
+	}
+}
+
 GF_Err nalumx_process(GF_Filter *filter)
 {
 	GF_NALUMxCtx *ctx = gf_filter_get_udta(filter);
@@ -335,6 +353,7 @@ GF_Err nalumx_process(GF_Filter *filter)
 	u8 avc_hdr;
 	u8 *dsi_buf = NULL;
 	u32 dsi_buf_size = 0, dsi_nb_nal = 0;
+	u32 nb_skip = 0;
 
 	Bool has_nalu_delim = GF_FALSE;
 
@@ -395,6 +414,8 @@ GF_Err nalumx_process(GF_Filter *filter)
 		}
 		if (!skip_nal) {
 			size += nal_size + 4;
+		} else {
+			nb_skip++;
 		}
 		gf_bs_skip_bytes(ctx->bs_r, nal_size);
 	}
@@ -437,6 +458,23 @@ GF_Err nalumx_process(GF_Filter *filter)
 		size += dsi_buf_size;
 	}
 
+	//NAL size fields on 4 bytes and no NAL removed or inserted, replace size fields by start codes in place
+	if (!nb_skip && (size == pck_size) && (ctx->nal_hdr_size==4)) {
+		u32 pos = 0;
+		dst_pck = gf_filter_pck_new_clone(ctx->opid, pck, &output);
+		if (!dst_pck) return GF_OUT_OF_MEM;
+
+		while (pos + 4 <= size) {
+			u32 nal_size = GF_4CC(output[pos], output[pos+1], output[pos+2], output[pos+3]);
+			output[pos] = output[pos+1] = output[pos+2] = 0;
+			output[pos+3] = 1;
+			pos += 4 + nal_size;
+			ctx->nb_nalu++;
+		}
+		nalumx_send_packet(filter, ctx, dst_pck);
+		return GF_OK;
+	}
+
 	dst_pck = gf_filter_pck_new_alloc(ctx->opid, size, &output);
 	if (!dst_pck) return GF_OUT_OF_MEM;
 
@@ -530,20 +568,7 @@ GF_Err nalumx_process(GF_Filter *filter)
 		ctx->nb_nalu++;
 	}
 	gf_filter_pck_merge_properties(pck, dst_pck);
-	gf_filter_pck_set_byte_offset(dst_pck, GF_FILTER_NO_BO);
-
-	gf_filter_pck_set_framing(dst_pck, GF_TRUE, GF_TRUE);
-	gf_filter_pck_send(dst_pck);
-
-	gf_filter_pid_drop_packet(ctx->ipid);
-
-	if (gf_filter_reporting_enabled(filter)) {
-		char szStatus[1024];
-
-		sprintf(szStatus, "%s Annex-B %dx%d % 10d NALU", (ctx->vtype==UFNAL_HEVC) ? "HEVC" : ((ctx->vtype==UFNAL_VVC) ? "VVC" : "AVC|H264"), ctx->width, ctx->height, ctx->nb_nalu);
-		gf_filter_update_status(filter, -1, szStatus);
-
-	}
+	nalumx_send_packet(filter, ctx, dst_pck);
 	return GF_OK;
 }
 
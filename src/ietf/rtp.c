@@ -48,6 +48,10 @@ GF_EXPORT
 void gf_rtp_del(GF_RTPChannel *ch)
 {
 	if (!ch) return;
+	if (ch->send_batch) {
+		gf_rtp_flush_packets(ch);
+		gf_sk_batch_del(ch->send_batch);
+	}
 	if (ch->rtp) gf_sk_del(ch->rtp);
 	if (ch->rtcp) gf_sk_del(ch->rtcp);
 	if (ch->net_info.source) gf_free(ch->net_info.source);
@@ -665,11 +669,24 @@ GF_Err gf_rtp_send_packet(GF_RTPChannel *ch, GF_RTPHeader *rtp_hdr, u8 *pck, u32
 		}
 	}
 	//copy payload
-	else if (fast_send) {
-		e = gf_sk_send(ch->rtp, hdr, pck_size+12);
-	} else {
-		memcpy(ch->send_buffer + Start, pck, pck_size);
-		e = gf_sk_send(ch->rtp, ch->send_buffer, Start + pck_size);
+	else {
+		u8 *data = hdr;
+		u32 size = pck_size + 12;
+		if (!fast_send) {
+			memcpy(ch->send_buffer + Start, pck, pck_size);
+			data = ch->send_buffer;
+			size = Start + pck_size;
+		}
+		if (ch->send_batch) {
+			e = gf_sk_batch_add(ch->send_batch, data, size);
+			//batch full, send pending packets
+			if (e == GF_BUFFER_TOO_SMALL) {
+				e = gf_rtp_flush_packets(ch);
+				if (!e) e = gf_sk_batch_add(ch->send_batch, data, size);
+			}
+		} else {
+			e = gf_sk_send(ch->rtp, data, size);
+		}
 	}
 	if (e) return e;
 
@@ -693,6 +710,23 @@ GF_Err gf_rtp_send_packet(GF_RTPChannel *ch, GF_RTPHeader *rtp_hdr, u8 *pck, u32
 	return GF_OK;
 }
 
+void gf_rtp_enable_send_batch(GF_RTPChannel *ch, u32 nb_packets)
+{
+	if (!ch || !ch->rtp || !ch->send_buffer_size || ch->send_batch || (nb_packets<2)) return;
+	ch->send_batch = gf_sk_batch_new(nb_packets, ch->send_buffer_size);
+}
+
+GF_Err gf_rtp_flush_packets(GF_RTPChannel *ch)
+{
+	GF_Err e;
+	if (!ch || !ch->rtp || !ch->send_batch || !gf_sk_batch_pending(ch->send_batch)) return GF_OK;
+	e = gf_sk_send_batch(ch->rtp, ch->send_batch);
+	if (e) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_RTP, ("[RTP] Failed to send %d pending packets: %s\n", gf_sk_batch_pending(ch->send_batch), gf_error_to_string(e) ));
+	}
+	return e;
+}
+
 GF_EXPORT
 u32 gf_rtp_is_unicast(GF_RTPChannel *ch)
 {
@@ -37,6 +37,9 @@
 /*for ISOBMFF subtypes*/
 #include <gpac/isomedia.h>
 
+/*max number of RTP packets sent per system call*/
+#define GF_RTP_STREAMER_BATCH	32
+
 struct __rtp_streamer
 {
 	GP_RTPPacketizer *packetizer;
@@ -112,6 +115,8 @@ GF_Err gf_rtp_streamer_init_rtsp(GF_RTPStreamer *rtp, u32 path_mtu, GF_RTSPTrans
 		GF_LOG(GF_LOG_ERROR, GF_LOG_RTP, ("Cannot initialize RTP sockets: %s\n", gf_error_to_string(res) ));
 		return res;
 	}
+	//packets of a send call are emitted in as few system calls as possible
+	gf_rtp_enable_send_batch(rtp->channel, GF_RTP_STREAMER_BATCH);
 	return GF_OK;
 }
 static GF_Err rtp_stream_init_channel(GF_RTPStreamer *rtp, u32 path_mtu, const char * dest, int port, int ttl, const char *ifce_addr)
@@ -152,6 +157,8 @@ static GF_Err rtp_stream_init_channel(GF_RTPStreamer *rtp, u32 path_mtu, const c
 		GF_LOG(GF_LOG_ERROR, GF_LOG_RTP, ("Cannot initialize RTP sockets: %s\n", gf_error_to_string(res) ));
 		return res;
 	}
+	//packets of a send call are emitted in as few system calls as possible
+	gf_rtp_enable_send_batch(rtp->channel, GF_RTP_STREAMER_BATCH);
 	return GF_OK;
 }
 
@@ -738,6 +745,7 @@ GF_Err gf_rtp_streamer_append_sdp(GF_RTPStreamer *rtp, u16 ESID, const u8 *dsi,
 GF_EXPORT
 GF_Err gf_rtp_streamer_send_data(GF_RTPStreamer *rtp, u8 *data, u32 size, u32 fullsize, u64 cts, u64 dts, Bool is_rap, Bool au_start, Bool au_end, u32 au_sn, u32 sampleDuration, u32 sampleDescIndex)
 {
+	GF_Err e;
 	rtp->packetizer->sl_header.compositionTimeStamp = (u64) (cts*rtp->ts_scale);
 	rtp->packetizer->sl_header.decodingTimeStamp = (u64) (dts*rtp->ts_scale);
 	rtp->packetizer->sl_header.randomAccessPointFlag = is_rap;
@@ -747,7 +755,9 @@ GF_Err gf_rtp_streamer_send_data(GF_RTPStreamer *rtp, u8 *data, u32 size, u32 fu
 	sampleDuration = (u32) (sampleDuration * rtp->ts_scale);
 	if (au_start && size) rtp->packetizer->nb_aus++;
 
-	return gf_rtp_builder_process(rtp->packetizer, data, size, (u8) au_end, fullsize, sampleDuration, sampleDescIndex);
+	e = gf_rtp_builder_process(rtp->packetizer, data, size, (u8) au_end, fullsize, sampleDuration, sampleDescIndex);
+	gf_rtp_flush_packets(rtp->channel);
+	return e;
 }
 
 GF_EXPORT
@@ -777,12 +787,14 @@ GF_Err gf_rtp_streamer_send_rtcp(GF_RTPStreamer *streamer, Bool force_ts, u32 rt
 	streamer->channel->forced_ntp_frac = force_ntp_type ? ntp_frac : 0;
 	if (force_ntp_type==2)
 		streamer->channel->next_report_time = 0;
+	gf_rtp_flush_packets(streamer->channel);
 	return gf_rtp_send_rtcp_report(streamer->channel);
 }
 
 GF_EXPORT
 GF_Err gf_rtp_streamer_send_bye(GF_RTPStreamer *streamer)
 {
+	gf_rtp_flush_packets(streamer->channel);
 	return gf_rtp_send_bye(streamer->channel);
 }
 
@@ -35,6 +35,7 @@ void co64_box_del(GF_Box *s)
 	ptr = (GF_ChunkLargeOffsetBox *) s;
 	if (ptr == NULL) return;
 	if (ptr->offsets) gf_free(ptr->offsets);
+	if (ptr->w_deltas) stbl_DeltaStoreDel(ptr->w_deltas);
 	gf_free(ptr);
 }
 
@@ -72,15 +73,19 @@ GF_Box *co64_box_new()
 GF_Err co64_box_write(GF_Box *s, GF_BitStream *bs)
 {
 	GF_Err e;
-	u32 i;
+	u32 i, nb_plain;
 	GF_ChunkLargeOffsetBox *ptr = (GF_ChunkLargeOffsetBox *) s;
 
 	e = gf_isom_full_box_write(s, bs);
 	if (e) return e;
 	gf_bs_write_u32(bs, ptr->nb_entries);
-	for (i = 0; i < ptr->nb_entries; i++ ) {
+	nb_plain = ptr->nb_entries - (ptr->w_deltas ? ptr->w_deltas->nb_entries : 0);
+	for (i = 0; i < nb_plain; i++ ) {
 		gf_bs_write_u64(bs, ptr->offsets[i]);
 	}
+	for (i = nb_plain; i < ptr->nb_entries; i++ ) {
+		gf_bs_write_u64(bs, stbl_DeltaStoreGet(ptr->w_deltas, i - nb_plain));
+	}
 	return GF_OK;
 }
 
@@ -378,6 +383,7 @@ void ctts_box_del(GF_Box *s)
 {
 	GF_CompositionOffsetBox *ptr = (GF_CompositionOffsetBox *)s;
 	if (ptr->entries) gf_free(ptr->entries);
+	if (ptr->r_index) stbl_lookup_index_del(ptr->r_index);
 	gf_free(ptr);
 }
 
@@ -5041,13 +5047,21 @@ GF_Err stbl_box_read(GF_Box *s, GF_BitStream *bs)
 	//we need to parse DegPrior in a special way
 	GF_SampleTableBox *ptr = (GF_SampleTableBox *)s;
 
+	if (gf_bs_get_cookie(bs) & GF_ISOM_BS_COOKIE_LAZY_TABLES) {
+		ptr->lazy_start = gf_bs_get_position(bs);
+		ptr->lazy_size = ptr->size;
+	}
 	e = gf_isom_box_array_read(s, bs);
 	if (e) return e;
 
+	ptr->nb_sgpd_in_stbl = gf_list_count(ptr->sampleGroupsDescription);
+	//sample tables are checked once loaded
+	if (ptr->lazy_size)
+		return GF_OK;
+
 	if (!ptr->SyncSample)
 		ptr->no_sync_found = 1;
 
-	ptr->nb_sgpd_in_stbl = gf_list_count(ptr->sampleGroupsDescription);
 	ptr->nb_stbl_boxes = gf_list_count(ptr->child_boxes);
 
 	if (gf_bs_get_cookie(bs) & GF_ISOM_BS_COOKIE_CLONE_TRACK)
@@ -5127,6 +5141,7 @@ void stco_box_del(GF_Box *s)
 	GF_ChunkOffsetBox *ptr = (GF_ChunkOffsetBox *)s;
 	if (ptr == NULL) return;
 	if (ptr->offsets) gf_free(ptr->offsets);
+	if (ptr->w_deltas) stbl_DeltaStoreDel(ptr->w_deltas);
 	gf_free(ptr);
 }
 
@@ -5168,14 +5183,19 @@ GF_Box *stco_box_new()
 GF_Err stco_box_write(GF_Box *s, GF_BitStream *bs)
 {
 	GF_Err e;
-	u32 i;
+	u32 i, nb_plain;
 	GF_ChunkOffsetBox *ptr = (GF_ChunkOffsetBox *)s;
 	e = gf_isom_full_box_write(s, bs);
 	if (e) return e;
 	gf_bs_write_u32(bs, ptr->nb_entries);
-	for (i = 0; i < ptr->nb_entries; i++) {
+	nb_plain = ptr->nb_entries - (ptr->w_deltas ? ptr->w_deltas->nb_entries : 0);
+	for (i = 0; i < nb_plain; i++) {
 		gf_bs_write_u32(bs, ptr->offsets[i]);
 	}
+	//offsets appended in write mode are decoded on the fly
+	for (i = nb_plain; i < ptr->nb_entries; i++) {
+		gf_bs_write_u32(bs, (u32) stbl_DeltaStoreGet(ptr->w_deltas, i - nb_plain));
+	}
 	return GF_OK;
 }
 
@@ -5258,6 +5278,7 @@ void stsc_box_del(GF_Box *s)
 	GF_SampleToChunkBox *ptr = (GF_SampleToChunkBox *)s;
 	if (ptr == NULL) return;
 	if (ptr->entries) gf_free(ptr->entries);
+	if (ptr->r_index) stbl_lookup_index_del(ptr->r_index);
 	gf_free(ptr);
 }
 
@@ -5564,6 +5585,7 @@ void stsz_box_del(GF_Box *s)
 	GF_SampleSizeBox *ptr = (GF_SampleSizeBox *)s;
 	if (ptr == NULL) return;
 	if (ptr->sizes) gf_free(ptr->sizes);
+	if (ptr->w_deltas) stbl_DeltaStoreDel(ptr->w_deltas);
 	gf_free(ptr);
 }
 
@@ -5705,8 +5727,11 @@ GF_Err stsz_box_write(GF_Box *s, GF_BitStream *bs)
 
 	if (ptr->type == GF_ISOM_BOX_TYPE_STSZ) {
 		if (! ptr->sampleSize) {
+			//sizes appended in write mode are decoded on the fly
 			for (i = 0; i < ptr->sampleCount; i++) {
-				gf_bs_write_u32(bs, ptr->sizes ? ptr->sizes[i] : 0);
+				u32 size;
+				stbl_GetSampleSize(ptr, i+1, &size);
+				gf_bs_write_u32(bs, size);
 			}
 		}
 	} else {
@@ -5734,6 +5759,7 @@ GF_Err stsz_box_write(GF_Box *s, GF_BitStream *bs)
 
 GF_Err stsz_box_size(GF_Box *s)
 {
+	GF_Err e;
 	u32 i, fieldSize, size;
 	GF_SampleSizeBox *ptr = (GF_SampleSizeBox *)s;
 
@@ -5747,6 +5773,10 @@ GF_Err stsz_box_size(GF_Box *s)
 		return GF_OK;
 	}
 
+	//the compact table is built from the plain size table
+	e = stbl_ExpandSizes(ptr);
+	if (e) return e;
+
 	fieldSize = 4;
 	size = ptr->sizes[0];
 
@@ -5802,6 +5832,7 @@ void stts_box_del(GF_Box *s)
 {
 	GF_TimeToSampleBox *ptr = (GF_TimeToSampleBox *)s;
 	if (ptr->entries) gf_free(ptr->entries);
+	if (ptr->r_index) stbl_lookup_index_del(ptr->r_index);
 	gf_free(ptr);
 }
 
@@ -6753,7 +6784,11 @@ GF_Err trak_box_read(GF_Box *s, GF_BitStream *bs)
 		GF_LOG(GF_LOG_ERROR, GF_LOG_CONTAINER, ("[iso file] Invalid MediaBox\n"));
 		return GF_ISOM_INVALID_FILE;
 	}
-	if (!ptr->Media->information->sampleTable->SampleSize || (ptr->Media->information->sampleTable->SampleSize->sampleCount==0)) {
+	//if sample tables are not loaded yet, use the sample count found in the skipped stsz/stz2
+	if (ptr->Media->information->sampleTable->lazy_size
+		? !ptr->Media->information->sampleTable->lazy_sample_count
+		: (!ptr->Media->information->sampleTable->SampleSize || (ptr->Media->information->sampleTable->SampleSize->sampleCount==0))
+	) {
 		if (ptr->Header->initial_duration) {
 			GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[iso file] Track with no samples but duration defined, ignoring duration\n"));
 			ptr->Header->initial_duration = 0;
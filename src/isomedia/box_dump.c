@@ -121,6 +121,8 @@ GF_Err gf_isom_dump(GF_ISOFile *mov, FILE * trace, Bool skip_init, Bool skip_sam
 	gf_fprintf(trace, "<IsoMediaFile xmlns=\"urn:mpeg:isobmff:schema:file:2016\" Name=\"%s\">\n", fname);
 
 	dump_skip_samples = skip_samples;
+	//dump the complete sample tables
+	gf_isom_load_all_track_tables(mov);
 	i=0;
 	if (skip_init)
 		i = mov->nb_box_init_seg;
@@ -1119,7 +1121,9 @@ GF_Err stsz_box_dump(GF_Box *a, FILE * trace)
 			gf_fprintf(trace, "<!--WARNING: No Sample Size indications-->\n");
 		} else if (p->sizes) {
 			for (i=0; i<p->sampleCount; i++) {
-				gf_fprintf(trace, "<SampleSizeEntry Size=\"%d\"/>\n", p->sizes[i]);
+				u32 size;
+				stbl_GetSampleSize(p, i+1, &size);
+				gf_fprintf(trace, "<SampleSizeEntry Size=\"%d\"/>\n", size);
 			}
 		}
 	}
@@ -1142,11 +1146,13 @@ GF_Err stco_box_dump(GF_Box *a, FILE * trace)
 	gf_isom_box_dump_start(a, "ChunkOffsetBox", trace);
 	gf_fprintf(trace, "EntryCount=\"%d\">\n", p->nb_entries);
 
-	if (!p->offsets && p->size) {
+	if (!p->offsets && !p->w_deltas && p->size) {
 		gf_fprintf(trace, "<!--Warning: No Chunk Offsets indications-->\n");
-	} else if (p->offsets) {
+	} else if (p->offsets || p->w_deltas) {
 		for (i=0; i<p->nb_entries; i++) {
-			gf_fprintf(trace, "<ChunkEntry offset=\"%u\"/>\n", p->offsets[i]);
+			u64 offset;
+			stbl_GetChunkOffset(a, i+1, &offset);
+			gf_fprintf(trace, "<ChunkEntry offset=\"%u\"/>\n", (u32) offset);
 		}
 	}
 	if (!p->size) {
@@ -1283,11 +1289,14 @@ GF_Err co64_box_dump(GF_Box *a, FILE * trace)
 	gf_isom_box_dump_start(a, "ChunkLargeOffsetBox", trace);
 	gf_fprintf(trace, "EntryCount=\"%d\">\n", p->nb_entries);
 
-	if (!p->offsets && p->size) {
+	if (!p->offsets && !p->w_deltas && p->size) {
 		gf_fprintf(trace, "<!-- Warning: No Chunk Offsets indications/>\n");
-	} else if (p->offsets) {
-		for (i=0; i<p->nb_entries; i++)
-			gf_fprintf(trace, "<ChunkOffsetEntry offset=\""LLU"\"/>\n", p->offsets[i]);
+	} else if (p->offsets || p->w_deltas) {
+		for (i=0; i<p->nb_entries; i++) {
+			u64 offset;
+			stbl_GetChunkOffset(a, i+1, &offset);
+			gf_fprintf(trace, "<ChunkOffsetEntry offset=\""LLU"\"/>\n", offset);
+		}
 	}
 	if (!p->size) {
 		gf_fprintf(trace, "<ChunkOffsetEntry offset=\"\"/>\n");
@@ -1702,14 +1702,87 @@ GF_Box *gf_isom_box_new(u32 boxType)
 	return gf_isom_box_new_ex(boxType, 0, 0, GF_FALSE);
 }
 
+u32 gf_isom_lazy_table_size(GF_BitStream *bs, u64 max_size)
+{
+	u32 size, type;
+	if (gf_bs_available(bs) < 8) return 0;
+	size = gf_bs_peek_bits(bs, 32, 0);
+	type = gf_bs_peek_bits(bs, 32, 4);
+	//large boxes and broken sizes are parsed the regular way
+	if ((size < 8) || (size > max_size) || (size > gf_bs_available(bs)))
+		return 0;
+
+	switch (type) {
+	case GF_ISOM_BOX_TYPE_STSS:
+		//entry count is read from the header when skipping
+		if (size < 16) return 0;
+		return size;
+	case GF_ISOM_BOX_TYPE_STSZ:
+		//sample size and count are read from the header when skipping
+		if (size < 20) return 0;
+		return size;
+	case GF_ISOM_BOX_TYPE_STZ2:
+		//same as above, and invalid field sizes are fixed at parse time
+		if (size < 20) return 0;
+		switch (gf_bs_peek_bits(bs, 8, 15)) {
+		case 4:
+		case 8:
+		case 16:
+			return size;
+		default:
+			return 0;
+		}
+	case GF_ISOM_BOX_TYPE_STTS:
+	case GF_ISOM_BOX_TYPE_CTTS:
+	case GF_ISOM_BOX_TYPE_STSH:
+	case GF_ISOM_BOX_TYPE_STSC:
+	case GF_ISOM_BOX_TYPE_STCO:
+	case GF_ISOM_BOX_TYPE_CO64:
+	case GF_ISOM_BOX_TYPE_STDP:
+	case GF_ISOM_BOX_TYPE_SDTP:
+	case GF_ISOM_BOX_TYPE_PADB:
+		return size;
+	default:
+		return 0;
+	}
+}
+
 GF_Err gf_isom_box_array_read_ex(GF_Box *parent, GF_BitStream *bs, u32 parent_type)
 {
 	GF_Err e;
 	GF_Box *a = NULL;
 	Bool skip_logs = (gf_bs_get_cookie(bs) & GF_ISOM_BS_COOKIE_NO_LOGS ) ? GF_TRUE : GF_FALSE;
+	Bool lazy_tables = GF_FALSE;
+
+	if ((parent->type==GF_ISOM_BOX_TYPE_STBL) && (gf_bs_get_cookie(bs) & GF_ISOM_BS_COOKIE_LAZY_TABLES))
+		lazy_tables = GF_TRUE;
 
 	//we may have terminators in some QT files (4 bytes set to 0 ...)
 	while (parent->size>=8) {
+		//sample tables are loaded when the track is first accessed
+		if (lazy_tables) {
+			u32 skip = gf_isom_lazy_table_size(bs, parent->size);
+			if (skip) {
+				GF_SampleTableBox *stbl = (GF_SampleTableBox *)parent;
+				switch (gf_bs_peek_bits(bs, 32, 4)) {
+				case GF_ISOM_BOX_TYPE_STSZ:
+					stbl->lazy_sample_size = gf_bs_peek_bits(bs, 32, 12);
+					stbl->lazy_sample_count = gf_bs_peek_bits(bs, 32, 16);
+					break;
+				//stz2 exposes its field size as sample size, as done by stsz_box_read
+				case GF_ISOM_BOX_TYPE_STZ2:
+					stbl->lazy_sample_size = gf_bs_peek_bits(bs, 8, 15);
+					stbl->lazy_sample_count = gf_bs_peek_bits(bs, 32, 16);
+					break;
+				case GF_ISOM_BOX_TYPE_STSS:
+					stbl->lazy_sync_state = gf_bs_peek_bits(bs, 32, 12) ? 1 : 2;
+					break;
+				}
+				gf_bs_skip_bytes(bs, skip);
+				parent->size -= skip;
+				continue;
+			}
+		}
 		e = gf_isom_box_parse_ex(&a, bs, parent_type, GF_FALSE);
 		if (e) {
 			if (a) gf_isom_box_del(a);
@@ -27,9 +27,13 @@
 #include <gpac/network.h>
 #include <gpac/thread.h>
 
-
-/*File Mapping object, read-only mode on complete files (no download)*/
-//#define GF_ISOM_DATA_FILE_MAPPING 0x02
+#if defined(GPAC_CONFIG_LINUX) || defined(GPAC_CONFIG_DARWIN) || defined(GPAC_CONFIG_ANDROID)
+#define GPAC_HAS_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #ifndef GPAC_DISABLE_ISOM
 
@@ -47,11 +51,9 @@ void gf_isom_datamap_del(GF_DataMap *ptr)
 	case GF_ISOM_DATA_MEM:
 		gf_isom_fdm_del((GF_FileDataMap *)ptr);
 		break;
-#if 0
 	case GF_ISOM_DATA_FILE_MAPPING:
 		gf_isom_fmo_del((GF_FileMappingDataMap *)ptr);
 		break;
-#endif
 	default:
 		if (ptr->bs) gf_bs_del(ptr->bs);
 		gf_free(ptr);
@@ -245,10 +247,13 @@ GF_Err gf_isom_datamap_open(GF_MediaBox *mdia, u32 dataRefIndex, u8 Edit)
 
 	//if self-contained, assign the input file
 	if (SelfCont) {
-		//if no edit, open the input file
+		//if no edit, open the input file, using its file mapping if enabled
 		if (!Edit) {
 			if (mdia->mediaTrack->moov->mov->movieFileMap == NULL) return GF_ISOM_INVALID_FILE;
-			minf->dataHandler = mdia->mediaTrack->moov->mov->movieFileMap;
+			if (mdia->mediaTrack->moov->mov->mappedFileMap)
+				minf->dataHandler = mdia->mediaTrack->moov->mov->mappedFileMap;
+			else
+				minf->dataHandler = mdia->mediaTrack->moov->mov->movieFileMap;
 		} else {
 #ifndef GPAC_DISABLE_ISOM_WRITE
 			if (mdia->mediaTrack->moov->mov->editFileMap == NULL) return GF_ISOM_INVALID_FILE;
@@ -278,10 +283,8 @@ u32 gf_isom_datamap_get_data(GF_DataMap *map, u8 *buffer, u32 bufferLength, u64
 	case GF_ISOM_DATA_MEM:
 		return gf_isom_fdm_get_data((GF_FileDataMap *)map, buffer, bufferLength, Offset);
 
-#if 0
 	case GF_ISOM_DATA_FILE_MAPPING:
 		return gf_isom_fmo_get_data((GF_FileMappingDataMap *)map, buffer, bufferLength, Offset);
-#endif
 
 	default:
 		return 0;
@@ -572,84 +575,53 @@ GF_Err FDM_AddData(GF_FileDataMap *ptr, char *data, u32 dataSize)
 #endif	/*GPAC_DISABLE_ISOM_WRITE*/
 
 
-#if 0 //file mapping disabled
-
-#ifdef WIN32
+const u8 *gf_isom_datamap_get_mapped_data(GF_DataMap *map, u64 offset, u32 size)
+{
+	GF_FileMappingDataMap *fmo = (GF_FileMappingDataMap *)map;
+	if (!map || (map->type != GF_ISOM_DATA_FILE_MAPPING) || !fmo->byte_map) return NULL;
+	if ((offset >= fmo->file_size) || (size > fmo->file_size - offset)) return NULL;
+	return fmo->byte_map + offset;
+}
 
-#include <windows.h>
-#include <winerror.h>
+#ifdef GPAC_HAS_MMAP
 
 GF_DataMap *gf_isom_fmo_new(const char *sPath, u8 mode)
 {
 	GF_FileMappingDataMap *tmp;
-	HANDLE fileH, fileMapH;
-#ifdef _WIN32_WCE
-	unsigned short sWPath[MAX_PATH];
-#endif
+	struct stat st;
+	void *map;
+	int fd;
 
 	//only in read only
 	if (mode != GF_ISOM_DATA_MAP_READ) return NULL;
 
-	GF_SAFEALLOC(tmp, GF_FileMappingDataMap);
-	if (!tmp) return NULL;
-
-	tmp->type = GF_ISOM_DATA_FILE_MAPPING;
-	tmp->mode = mode;
-	tmp->name = gf_strdup(sPath);
-
-	//
-	//	Open the file
-	//
-#ifdef _WIN32_WCE
-	//convert to WIDE
-	CE_CharToWide((char *)sPath, sWPath);
-
-	fileH = CreateFileForMapping(sWPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
-	                             (FILE_ATTRIBUTE_READONLY | FILE_FLAG_RANDOM_ACCESS), NULL );
-#else
-	fileH = CreateFile(sPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
-	                   (FILE_ATTRIBUTE_READONLY | FILE_FLAG_RANDOM_ACCESS), NULL );
-#endif
-
-
-	if (fileH == INVALID_HANDLE_VALUE) {
-		gf_free(tmp->name);
-		gf_free(tmp);
+	fd = open(sPath, O_RDONLY);
+	if (fd < 0) return NULL;
+	//we cannot map files larger than the address space
+	if ((fstat(fd, &st) < 0) || (st.st_size <= 0) || ((u64) st.st_size != (u64) (size_t) st.st_size)) {
+		close(fd);
 		return NULL;
 	}
+	map = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	//the mapping remains valid once the descriptor is closed
+	close(fd);
+	if (map == MAP_FAILED) return NULL;
 
-	tmp->file_size = GetFileSize(fileH, NULL);
-	if (tmp->file_size == 0xFFFFFFFF) {
-		CloseHandle(fileH);
-		gf_free(tmp->name);
-		gf_free(tmp);
-		return NULL;
-	}
-
-	//
-	//	Create the mapping
-	//
-	fileMapH = CreateFileMapping(fileH, NULL, PAGE_READONLY, 0, 0, NULL);
-	if (fileMapH == NULL) {
-		CloseHandle(fileH);
-		gf_free(tmp->name);
-		gf_free(tmp);
-		return NULL;
-	}
-
-	tmp->byte_map = MapViewOfFile(fileMapH, FILE_MAP_READ, 0, 0, 0);
-	if (tmp->byte_map == NULL) {
-		CloseHandle(fileMapH);
-		CloseHandle(fileH);
-		gf_free(tmp->name);
-		gf_free(tmp);
+	GF_SAFEALLOC(tmp, GF_FileMappingDataMap);
+	if (!tmp) {
+		munmap(map, (size_t) st.st_size);
 		return NULL;
 	}
+	tmp->type = GF_ISOM_DATA_FILE_MAPPING;
+	tmp->mode = mode;
+	tmp->name = gf_strdup(sPath);
+	tmp->file_size = (u64) st.st_size;
+	tmp->byte_map = (u8 *) map;
 
-	CloseHandle(fileH);
-	CloseHandle(fileMapH);
+	//samples are not read in file order (multiple tracks, seeking): disable kernel readahead,
+	//pages are prefetched per chunk through gf_isom_datamap_will_need
+	madvise(map, (size_t) st.st_size, MADV_RANDOM);
 
-	//finaly open our bitstream (from buffer)
 	tmp->bs = gf_bs_new(tmp->byte_map, tmp->file_size, GF_BITSTREAM_READ);
 	return (GF_DataMap *)tmp;
 }
@@ -659,40 +631,59 @@ void gf_isom_fmo_del(GF_FileMappingDataMap *ptr)
 	if (!ptr || (ptr->type != GF_ISOM_DATA_FILE_MAPPING)) return;
 
 	if (ptr->bs) gf_bs_del(ptr->bs);
-	if (ptr->byte_map) UnmapViewOfFile(ptr->byte_map);
-	gf_free(ptr->name);
+	if (ptr->byte_map) munmap(ptr->byte_map, (size_t) ptr->file_size);
+	if (ptr->name) gf_free(ptr->name);
 	gf_free(ptr);
 }
 
-
 u32 gf_isom_fmo_get_data(GF_FileMappingDataMap *ptr, u8 *buffer, u32 bufferLength, u64 fileOffset)
 {
 	//can we seek till that point ???
-	if (fileOffset > ptr->file_size) return 0;
+	if ((fileOffset >= ptr->file_size) || (bufferLength > ptr->file_size - fileOffset)) return 0;
 
 	//we do only read operations, so trivial
 	memcpy(buffer, ptr->byte_map + fileOffset, bufferLength);
+	ptr->curPos = fileOffset + bufferLength;
 	return bufferLength;
 }
 
+void gf_isom_datamap_will_need(GF_DataMap *map, u64 offset, u64 size)
+{
+	static u64 page_mask = 0;
+	GF_FileMappingDataMap *fmo = (GF_FileMappingDataMap *)map;
+	if (!map || (map->type != GF_ISOM_DATA_FILE_MAPPING) || !size) return;
+	if (offset >= fmo->file_size) return;
+	if (size > fmo->file_size - offset) size = fmo->file_size - offset;
+
+	if (!page_mask) page_mask = (u64) sysconf(_SC_PAGESIZE) - 1;
+	//madvise requires a page-aligned start address
+	size += offset & page_mask;
+	offset &= ~page_mask;
+	madvise(fmo->byte_map + offset, (size_t) size, MADV_WILLNEED);
+}
+
 #else
 
+//no file mapping on other platforms (win32 mapping was disabled since it tricks mem usage)
+
 GF_DataMap *gf_isom_fmo_new(const char *sPath, u8 mode)
 {
-	return gf_isom_fdm_new(sPath, mode);
+	return NULL;
 }
 
 void gf_isom_fmo_del(GF_FileMappingDataMap *ptr)
 {
-	gf_isom_fdm_del((GF_FileDataMap *)ptr);
 }
 
 u32 gf_isom_fmo_get_data(GF_FileMappingDataMap *ptr, u8 *buffer, u32 bufferLength, u64 fileOffset)
 {
-	return gf_isom_fdm_get_data((GF_FileDataMap *)ptr, buffer, bufferLength, fileOffset);
+	return 0;
+}
+
+void gf_isom_datamap_will_need(GF_DataMap *map, u64 offset, u64 size)
+{
 }
 
-#endif //win32
-#endif //file mapping disabled
+#endif //GPAC_HAS_MMAP
 
 #endif /*GPAC_DISABLE_ISOM*/
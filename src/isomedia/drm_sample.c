@@ -195,7 +195,7 @@ u32 gf_isom_is_media_encrypted(GF_ISOFile *the_file, u32 trackNumber, u32 sample
 	u32 i, count;
 	GF_ProtectionSchemeInfoBox *sinf;
 
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (!trak) return 0;
 	count = gf_list_count(trak->Media->information->sampleTable->SampleDescription->child_boxes);
 	for (i=0; i<count; i++) {
@@ -634,7 +634,7 @@ GF_Err gf_isom_get_original_format_type(GF_ISOFile *the_file, u32 trackNumber, u
 	GF_ProtectionSchemeInfoBox *sinf;
 	u32 i, count;
 
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (!trak) return GF_BAD_PARAM;
 
 	count = gf_list_count(trak->Media->information->sampleTable->SampleDescription->child_boxes);
@@ -664,7 +664,7 @@ Bool gf_isom_is_cenc_media(GF_ISOFile *the_file, u32 trackNumber, u32 sampleDesc
 	GF_ProtectionSchemeInfoBox *sinf;
 	u32 i, count;
 
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (!trak) return GF_FALSE;
 
 	count = gf_list_count(trak->Media->information->sampleTable->SampleDescription->child_boxes);
@@ -211,6 +211,86 @@ void gf_isom_push_mdat_end(GF_ISOFile *mov, u64 mdat_end)
 	}
 }
 
+void gf_isom_push_moof_index(GF_ISOFile *mov, GF_MovieFragmentBox *moof, u64 moof_offset)
+{
+	u32 i=0, nb_tracks;
+	u64 time=0, *track_dts;
+	u8 *track_flags;
+	Bool has_time=GF_FALSE;
+	GF_TrackFragmentBox *traf;
+	if (!mov->moov || !mov->moov->mvhd || !mov->moov->mvhd->timeScale) return;
+	//index is kept in file order, fragments may be parsed again after a seek
+	if (mov->nb_moof_index && (mov->moof_index[mov->nb_moof_index-1].moof_offset >= moof_offset))
+		return;
+
+	nb_tracks = gf_list_count(mov->moov->trackList);
+	if (mov->nb_moof_index == mov->alloc_moof_index) {
+		mov->alloc_moof_index = mov->alloc_moof_index ? 2*mov->alloc_moof_index : 10;
+		mov->moof_index = gf_realloc(mov->moof_index, sizeof(GF_MoofIndexEntry) * mov->alloc_moof_index);
+		mov->moof_index_dts = gf_realloc(mov->moof_index_dts, sizeof(u64) * nb_tracks * mov->alloc_moof_index);
+		mov->moof_index_track_flags = gf_realloc(mov->moof_index_track_flags, sizeof(u8) * nb_tracks * mov->alloc_moof_index);
+		if (!mov->moof_index || !mov->moof_index_dts || !mov->moof_index_track_flags) {
+			mov->nb_moof_index = mov->alloc_moof_index = 0;
+			return;
+		}
+	}
+	//tracks not present in this fragment keep their next decode time
+	track_dts = mov->moof_index_dts + nb_tracks * mov->nb_moof_index;
+	track_flags = mov->moof_index_track_flags + nb_tracks * mov->nb_moof_index;
+	for (i=0; i<nb_tracks; i++) {
+		GF_TrackBox *trak = gf_list_get(mov->moov->trackList, i);
+		track_dts[i] = trak->moof_index_next_dts;
+		track_flags[i] = 0;
+	}
+
+	i=0;
+	while ((traf = (GF_TrackFragmentBox*)gf_list_enum(moof->TrackList, &i))) {
+		u32 j, def_dur, def_flags, first_flags=0, nb_samples=0;
+		u64 dts, dur=0;
+		GF_TrackFragmentRunBox *trun;
+		GF_TrackExtendsBox *trex;
+		GF_TrackBox *trak;
+		if (!traf->tfhd) continue;
+		trak = gf_isom_get_track_from_id(mov->moov, traf->tfhd->trackID);
+		if (!trak || !trak->Media->mediaHeader->timeScale) continue;
+		trex = GetTrex(mov->moov, traf->tfhd->trackID);
+
+		def_dur = (traf->tfhd->flags & GF_ISOM_TRAF_SAMPLE_DUR) ? traf->tfhd->def_sample_duration : (trex ? trex->def_sample_duration : 0);
+		def_flags = (traf->tfhd->flags & GF_ISOM_TRAF_SAMPLE_FLAGS) ? traf->tfhd->def_sample_flags : (trex ? trex->def_sample_flags : 0);
+		j=0;
+		while ((trun = (GF_TrackFragmentRunBox*)gf_list_enum(traf->TrackRuns, &j))) {
+			u32 k;
+			for (k=0; k<trun->nb_samples; k++) {
+				GF_TrunEntry *ent = &trun->samples[k];
+				if (!nb_samples) {
+					first_flags = def_flags;
+					if (trun->flags & GF_ISOM_TRUN_FLAGS) first_flags = ent->flags;
+					else if (trun->flags & GF_ISOM_TRUN_FIRST_FLAG) first_flags = trun->first_sample_flags;
+				}
+				nb_samples += ent->nb_pack ? ent->nb_pack : 1;
+				dur += (u64) ((trun->flags & GF_ISOM_TRUN_DURATION) ? ent->Duration : def_dur) * (ent->nb_pack ? ent->nb_pack : 1);
+			}
+		}
+		if (!nb_samples) continue;
+
+		//without tfdt, fragments are assumed to follow each other
+		dts = traf->tfdt ? traf->tfdt->baseMediaDecodeTime : trak->moof_index_next_dts;
+		trak->moof_index_next_dts = dts + dur;
+		j = gf_list_find(mov->moov->trackList, trak);
+		track_dts[j] = dts;
+		track_flags[j] = GF_ISOM_GET_FRAG_SYNC(first_flags) ? 2 : 1;
+
+		dts = gf_timestamp_rescale(dts, trak->Media->mediaHeader->timeScale, mov->moov->mvhd->timeScale);
+		if (!has_time || (dts < time)) time = dts;
+		has_time = GF_TRUE;
+	}
+	if (!has_time) return;
+
+	mov->moof_index[mov->nb_moof_index].moof_offset = moof_offset;
+	mov->moof_index[mov->nb_moof_index].time = time;
+	mov->nb_moof_index++;
+}
+
 #ifdef GF_ENABLE_CTRN
 static void gf_isom_setup_traf_inheritance(GF_ISOFile *mov)
 {
@@ -299,6 +379,9 @@ static GF_Err gf_isom_parse_movie_boxes_internal(GF_ISOFile *mov, u32 *boxType,
 		return e;
 	}
 
+	mov->frag_window_pending = GF_FALSE;
+	mov->frag_window_nb_moof = 0;
+
 	/*restart from where we stopped last*/
 	totSize = mov->current_top_box_start;
 	if (mov->bytes_removed) {
@@ -350,6 +433,23 @@ static GF_Err gf_isom_parse_movie_boxes_internal(GF_ISOFile *mov, u32 *boxType,
 			mov->moov->mov = mov;
 #ifndef GPAC_DISABLE_ISOM_FRAGMENTS
 			if (mov->moov->mvex) mov->moov->mvex->mov = mov;
+			//fragments are merged in the sample tables, load all of them
+			if (mov->moov->mvex) gf_isom_load_all_track_tables(mov);
+
+			/*fragment window only applies when all samples are in movie fragments*/
+			if (mov->frag_window) {
+				u32 k;
+				if (!mov->moov->mvex) mov->frag_window = 0;
+				for (k=0; k<gf_list_count(mov->moov->trackList); k++) {
+					GF_TrackBox *trak = (GF_TrackBox *)gf_list_get(mov->moov->trackList, k);
+					if (!trak->Media || !trak->Media->information || !trak->Media->information->sampleTable
+						|| !trak->Media->information->sampleTable->SampleSize
+						|| trak->Media->information->sampleTable->SampleSize->sampleCount
+					) {
+						mov->frag_window = 0;
+					}
+				}
+			}
 
 #ifdef GF_ENABLE_CTRN
 			if (! (mov->FragmentsFlags & GF_ISOM_FRAG_READ_DEBUG)) {
@@ -390,6 +490,10 @@ static GF_Err gf_isom_parse_movie_boxes_internal(GF_ISOFile *mov, u32 *boxType,
 					if (trak->Media->information->sampleTable->sampleGroups) {
 						convert_compact_sample_groups(trak->Media->information->sampleTable->child_boxes, trak->Media->information->sampleTable->sampleGroups);
 					}
+					//tables are not modified in read mode, enable sample lookup index
+					if (mov->openMode == GF_ISOM_OPEN_READ) {
+						stbl_set_lookup_index(trak->Media->information->sampleTable, GF_ISOM_STBL_INDEX_MAX_POINTS);
+					}
 				}
 			}
 
@@ -648,6 +752,12 @@ static GF_Err gf_isom_parse_movie_boxes_internal(GF_ISOFile *mov, u32 *boxType,
 				mov->moof = NULL;
 				gf_isom_box_del(a);
 			} else {
+				if (mov->frag_window) {
+					gf_isom_push_moof_index(mov, mov->moof, mov->current_top_box_start);
+					mov->frag_window_nb_moof++;
+					if (mov->frag_window_nb_moof >= mov->frag_window)
+						mov->frag_window_pending = GF_TRUE;
+				}
 				/*merge all info*/
 				e = MergeFragment((GF_MovieFragmentBox *)a, mov);
 				gf_isom_box_del(a);
@@ -710,6 +820,10 @@ static GF_Err gf_isom_parse_movie_boxes_internal(GF_ISOFile *mov, u32 *boxType,
 #ifndef	GPAC_DISABLE_ISOM_FRAGMENTS
 		/*remember where we left, in case we append an entire number of movie fragments*/
 		mov->current_top_box_start = gf_bs_get_position(mov->movieFileMap->bs) + mov->bytes_removed;
+
+		/*fragment window is full, resume parsing at next refresh*/
+		if (mov->frag_window_pending)
+			break;
 #endif
 	}
 
@@ -858,6 +972,10 @@ GF_ISOFile *gf_isom_open_file(const char *fileName, GF_ISOOpenMode OpenMode, con
 		if (OpenMode == GF_ISOM_OPEN_READ_DUMP) {
 			mov->FragmentsFlags |= GF_ISOM_FRAG_READ_DEBUG;
 		}
+		//box dumps load all tables, info dumps only load the inspected tracks
+		if (OpenMode != GF_ISOM_OPEN_READ_EDIT) {
+			gf_isom_check_lazy_tables(mov);
+		}
 	} else {
 
 #ifdef GPAC_DISABLE_ISOM_WRITE
@@ -957,6 +1075,7 @@ void gf_isom_delete_movie(GF_ISOFile *mov)
 
 	//these are our two main files
 	if (mov->movieFileMap) gf_isom_datamap_del(mov->movieFileMap);
+	if (mov->mappedFileMap) gf_isom_datamap_del(mov->mappedFileMap);
 
 #ifndef GPAC_DISABLE_ISOM_WRITE
 	if (mov->editFileMap) {
@@ -977,6 +1096,12 @@ void gf_isom_delete_movie(GF_ISOFile *mov)
 
 	if (mov->main_sidx)
 		gf_isom_box_del((GF_Box*)mov->main_sidx);
+	if (mov->moof_index)
+		gf_free(mov->moof_index);
+	if (mov->moof_index_dts)
+		gf_free(mov->moof_index_dts);
+	if (mov->moof_index_track_flags)
+		gf_free(mov->moof_index_track_flags);
 
 	if (mov->block_buffer)
 		gf_free(mov->block_buffer);
@@ -987,6 +1112,134 @@ void gf_isom_delete_movie(GF_ISOFile *mov)
 	gf_free(mov);
 }
 
+void gf_isom_check_lazy_tables(GF_ISOFile *mov)
+{
+	//only for read-only sessions: tables are never modified and data is never removed from the file map
+	if (mov->openMode != GF_ISOM_OPEN_READ) return;
+	if (!mov->movieFileMap || !mov->movieFileMap->bs) return;
+	if (mov->fileName && !strnicmp(mov->fileName, "gmem://", 7)) return;
+	if (!gf_opts_get_bool("core", "lazy-stbl")) return;
+
+	gf_bs_set_cookie(mov->movieFileMap->bs, gf_bs_get_cookie(mov->movieFileMap->bs) | GF_ISOM_BS_COOKIE_LAZY_TABLES);
+}
+
+GF_Err gf_isom_load_track_tables(GF_TrackBox *trak)
+{
+	GF_Err e = GF_OK;
+	GF_SampleTableBox *stbl;
+	GF_BitStream *bs;
+	u64 pos, cookie, end;
+	u32 idx = 0;
+
+	if (!trak->Media || !trak->Media->information) return GF_OK;
+	stbl = trak->Media->information->sampleTable;
+	if (!stbl || !stbl->lazy_size) return GF_OK;
+
+	end = stbl->lazy_start + stbl->lazy_size;
+	stbl->lazy_size = 0;
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[iso file] Loading sample tables of track ID %d\n", trak->Header ? trak->Header->trackID : 0));
+	if (!trak->moov || !trak->moov->mov || !trak->moov->mov->movieFileMap || !trak->moov->mov->movieFileMap->bs) {
+		e = GF_ISOM_INVALID_FILE;
+		goto check_tables;
+	}
+
+	bs = trak->moov->mov->movieFileMap->bs;
+	pos = gf_bs_get_position(bs);
+	cookie = gf_bs_get_cookie(bs);
+	gf_bs_set_cookie(bs, cookie & ~GF_ISOM_BS_COOKIE_LAZY_TABLES);
+	gf_bs_seek(bs, stbl->lazy_start);
+
+	//parse boxes skipped at load time, inserting them at their original position in the child list
+	while (gf_bs_get_position(bs) + 8 <= end) {
+		GF_Box *a;
+		u64 start = gf_bs_get_position(bs);
+		u64 size = gf_isom_lazy_table_size(bs, end - start);
+		if (!size) {
+			size = gf_bs_peek_bits(bs, 32, 0);
+			if (size==1) {
+				size = gf_bs_peek_bits(bs, 32, 8);
+				size <<= 32;
+				size |= gf_bs_peek_bits(bs, 32, 12);
+			}
+			if ((size < 8) || (size > end - start)) break;
+			gf_bs_skip_bytes(bs, size);
+			idx++;
+			continue;
+		}
+		e = gf_isom_box_parse_ex(&a, bs, GF_ISOM_BOX_TYPE_STBL, GF_FALSE);
+		if (e) {
+			if (a) gf_isom_box_del(a);
+			break;
+		}
+		if (!a) break;
+		if (!stbl->child_boxes) stbl->child_boxes = gf_list_new();
+		if (idx > gf_list_count(stbl->child_boxes)) idx = gf_list_count(stbl->child_boxes);
+		gf_list_insert(stbl->child_boxes, a, idx);
+		idx++;
+		e = stbl_on_child_box((GF_Box *)stbl, a, GF_FALSE);
+		if (e) {
+			if (gf_list_find(stbl->child_boxes, a) >= 0)
+				gf_isom_box_del_parent(&stbl->child_boxes, a);
+			break;
+		}
+	}
+	gf_bs_seek(bs, pos);
+	gf_bs_set_cookie(bs, cookie);
+
+check_tables:
+	if (!stbl->SyncSample)
+		stbl->no_sync_found = 1;
+	stbl->nb_stbl_boxes = gf_list_count(stbl->child_boxes);
+
+	//these boxes are mandatory !
+	if (!e && (!stbl->SampleToChunk || !stbl->SampleSize || !stbl->ChunkOffset || !stbl->TimeToSample))
+		e = GF_ISOM_INVALID_FILE;
+	//sanity check
+	if (!e && stbl->SampleSize->sampleCount && (!stbl->TimeToSample->nb_entries || !stbl->SampleToChunk->nb_entries))
+		e = GF_ISOM_INVALID_FILE;
+
+	if (e) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_CONTAINER, ("[iso file] Failed to load sample tables of track ID %d: %s - ignoring track samples\n", trak->Header->trackID, gf_error_to_string(e) ));
+		//make sure the track can be safely used
+		if (!stbl->TimeToSample) stbl->TimeToSample = (GF_TimeToSampleBox *) gf_isom_box_new_parent(&stbl->child_boxes, GF_ISOM_BOX_TYPE_STTS);
+		if (!stbl->SampleToChunk) stbl->SampleToChunk = (GF_SampleToChunkBox *) gf_isom_box_new_parent(&stbl->child_boxes, GF_ISOM_BOX_TYPE_STSC);
+		if (!stbl->SampleSize) stbl->SampleSize = (GF_SampleSizeBox *) gf_isom_box_new_parent(&stbl->child_boxes, GF_ISOM_BOX_TYPE_STSZ);
+		if (!stbl->ChunkOffset) stbl->ChunkOffset = gf_isom_box_new_parent(&stbl->child_boxes, GF_ISOM_BOX_TYPE_STCO);
+		if (!stbl->TimeToSample || !stbl->SampleToChunk || !stbl->SampleSize || !stbl->ChunkOffset)
+			return GF_OUT_OF_MEM;
+		stbl->SampleSize->sampleCount = 0;
+		stbl->nb_stbl_boxes = gf_list_count(stbl->child_boxes);
+	}
+
+	if (!stbl->SampleSize->sampleCount && trak->Header->initial_duration) {
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[iso file] Track with no samples but duration defined, ignoring duration\n"));
+		trak->Header->initial_duration = 0;
+	}
+	//tables are not modified in read mode, enable sample lookup index
+	if (trak->moov && trak->moov->mov && (trak->moov->mov->openMode == GF_ISOM_OPEN_READ))
+		stbl_set_lookup_index(stbl, GF_ISOM_STBL_INDEX_MAX_POINTS);
+
+	return e;
+}
+
+GF_SampleTableBox *gf_isom_get_lazy_stbl(GF_TrackBox *trak)
+{
+	if (!trak || !trak->Media || !trak->Media->information || !trak->Media->information->sampleTable) return NULL;
+	if (!trak->Media->information->sampleTable->lazy_size) return NULL;
+	return trak->Media->information->sampleTable;
+}
+
+void gf_isom_load_all_track_tables(GF_ISOFile *mov)
+{
+	u32 i;
+	if (!mov || !mov->moov) return;
+	for (i=0; i<gf_list_count(mov->moov->trackList); i++) {
+		GF_TrackBox *trak = (GF_TrackBox*)gf_list_get(mov->moov->trackList, i);
+		GF_Err e = gf_isom_load_track_tables(trak);
+		if (e) mov->LastError = e;
+	}
+}
+
 GF_TrackBox *gf_isom_get_track_from_id(GF_MovieBox *moov, GF_ISOTrackID trackID)
 {
 	u32 i, count;
@@ -995,7 +1248,11 @@ GF_TrackBox *gf_isom_get_track_from_id(GF_MovieBox *moov, GF_ISOTrackID trackID)
 	count = gf_list_count(moov->trackList);
 	for (i = 0; i<count; i++) {
 		GF_TrackBox *trak = (GF_TrackBox*)gf_list_get(moov->trackList, i);
-		if (trak->Header->trackID == trackID) return trak;
+		if (trak->Header->trackID == trackID) {
+			GF_Err e = gf_isom_load_track_tables(trak);
+			if (e && moov->mov) moov->mov->LastError = e;
+			return trak;
+		}
 	}
 	return NULL;
 }
@@ -1022,6 +1279,16 @@ GF_TrackBox *gf_isom_get_track_from_file(GF_ISOFile *movie, u32 trackNumber)
 	return trak;
 }
 
+GF_TrackBox *gf_isom_get_track_from_file_no_tables(GF_ISOFile *movie, u32 trackNumber)
+{
+	if (!movie) return NULL;
+	if (!movie->moov || !trackNumber || (trackNumber > gf_list_count(movie->moov->trackList))) {
+		movie->LastError = GF_BAD_PARAM;
+		return NULL;
+	}
+	return (GF_TrackBox*)gf_list_get(movie->moov->trackList, trackNumber - 1);
+}
+
 
 //WARNING: MOVIETIME IS EXPRESSED IN MEDIA TS
 GF_Err GetMediaTime(GF_TrackBox *trak, Bool force_non_empty, u64 movieTime, u64 *MediaTime, s64 *SegmentStartTime, s64 *MediaOffset, u8 *useEdit, u64 *next_edit_start_plus_one)
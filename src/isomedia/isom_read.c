@@ -423,8 +423,7 @@ static GF_Err isom_create_init_from_mem(const char *fileName, GF_ISOFile *file)
 					File Opening in streaming mode
 			the file map is regular (through FILE handles)
 **************************************************************/
-GF_EXPORT
-GF_Err gf_isom_open_progressive_ex(const char *fileName, u64 start_range, u64 end_range, Bool enable_frag_bounds, GF_ISOFile **the_file, u64 *BytesMissing, u32 *outBoxType)
+static GF_Err isom_open_progressive(const char *fileName, u64 start_range, u64 end_range, Bool enable_frag_bounds, u32 frag_window, GF_ISOFile **the_file, u64 *BytesMissing, u32 *outBoxType)
 {
 	GF_Err e;
 	GF_ISOFile *movie;
@@ -440,6 +439,9 @@ GF_Err gf_isom_open_progressive_ex(const char *fileName, u64 start_range, u64 en
 	movie->fileName = gf_strdup(fileName);
 	movie->openMode = GF_ISOM_OPEN_READ;
 	movie->signal_frag_bounds = enable_frag_bounds;
+#ifndef GPAC_DISABLE_ISOM_FRAGMENTS
+	movie->frag_window = frag_window;
+#endif
 
 #ifndef GPAC_DISABLE_ISOM_WRITE
 	movie->editFileMap = NULL;
@@ -464,6 +466,7 @@ GF_Err gf_isom_open_progressive_ex(const char *fileName, u64 start_range, u64 en
 			}
 			gf_bs_seek(movie->movieFileMap->bs, start_range);
 		}
+		gf_isom_check_lazy_tables(movie);
 		e = gf_isom_parse_movie_boxes(movie, outBoxType, BytesMissing, GF_TRUE);
 
 	}
@@ -487,10 +490,25 @@ GF_Err gf_isom_open_progressive_ex(const char *fileName, u64 start_range, u64 en
 	return GF_OK;
 }
 
+GF_EXPORT
+GF_Err gf_isom_open_progressive_ex(const char *fileName, u64 start_range, u64 end_range, Bool enable_frag_bounds, GF_ISOFile **the_file, u64 *BytesMissing, u32 *outBoxType)
+{
+	return isom_open_progressive(fileName, start_range, end_range, enable_frag_bounds, 0, the_file, BytesMissing, outBoxType);
+}
+
 GF_EXPORT
 GF_Err gf_isom_open_progressive(const char *fileName, u64 start_range, u64 end_range, Bool enable_frag_bounds, GF_ISOFile **the_file, u64 *BytesMissing)
 {
-	return gf_isom_open_progressive_ex(fileName, start_range, end_range, enable_frag_bounds, the_file, BytesMissing, NULL);
+	return isom_open_progressive(fileName, start_range, end_range, enable_frag_bounds, 0, the_file, BytesMissing, NULL);
+}
+
+GF_EXPORT
+GF_Err gf_isom_open_progressive_window(const char *fileName, u64 start_range, u64 end_range, Bool enable_frag_bounds, u32 nb_moofs, GF_ISOFile **the_file, u64 *BytesMissing)
+{
+#ifdef GPAC_DISABLE_ISOM_FRAGMENTS
+	nb_moofs = 0;
+#endif
+	return isom_open_progressive(fileName, start_range, end_range, enable_frag_bounds, nb_moofs, the_file, BytesMissing, NULL);
 }
 
 /**************************************************************
@@ -788,7 +806,7 @@ GF_ISOTrackID gf_isom_get_track_id(GF_ISOFile *movie, u32 trackNumber)
 {
 	GF_TrackBox *trak;
 	if (!movie) return 0;
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 	if (!trak || !trak->Header) return 0;
 	return trak->Header->trackID;
 }
@@ -1012,7 +1030,7 @@ GF_EXPORT
 u8 gf_isom_is_track_enabled(GF_ISOFile *the_file, u32 trackNumber)
 {
 	GF_TrackBox *trak;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 
 	if (!trak || !trak->Header) return 2;
 	return (trak->Header->flags & 1) ? 1 : 0;
@@ -1022,7 +1040,7 @@ GF_EXPORT
 u32 gf_isom_get_track_flags(GF_ISOFile *the_file, u32 trackNumber)
 {
 	GF_TrackBox *trak;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (!trak) return 0;
 	return trak->Header->flags;
 }
@@ -1034,7 +1052,8 @@ GF_EXPORT
 u64 gf_isom_get_track_duration(GF_ISOFile *movie, u32 trackNumber)
 {
 	GF_TrackBox *trak;
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	//media duration is taken from mdhd if sample tables are not loaded
+	trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 	if (!trak) return 0;
 
 #ifndef GPAC_DISABLE_ISOM_WRITE
@@ -1056,7 +1075,7 @@ GF_Err gf_isom_get_media_language(GF_ISOFile *the_file, u32 trackNumber, char **
 		return GF_BAD_PARAM;
 	}
 	*lang = NULL;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (!trak || !trak->Media) return GF_BAD_PARAM;
 	count = gf_list_count(trak->Media->child_boxes);
 	if (count>0) {
@@ -1141,7 +1160,7 @@ s32 gf_isom_get_reference_count(GF_ISOFile *movie, u32 trackNumber, u32 referenc
 {
 	GF_TrackBox *trak;
 	GF_TrackReferenceTypeBox *dpnd;
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 	if (!trak) return -1;
 	if (!trak->References) return 0;
 	if (movie->openMode == GF_ISOM_OPEN_WRITE) {
@@ -1183,7 +1202,7 @@ GF_Err gf_isom_get_reference(GF_ISOFile *movie, u32 trackNumber, u32 referenceTy
 	GF_TrackBox *trak;
 	GF_TrackReferenceTypeBox *dpnd;
 	GF_ISOTrackID refTrackNum;
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 
 	*refTrack = 0;
 	if (!trak || !trak->References) return GF_BAD_PARAM;
@@ -1215,7 +1234,7 @@ GF_Err gf_isom_get_reference_ID(GF_ISOFile *movie, u32 trackNumber, u32 referenc
 	GF_Err e;
 	GF_TrackBox *trak;
 	GF_TrackReferenceTypeBox *dpnd;
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 
 	*refTrackID = 0;
 	if (!trak || !trak->References || !referenceIndex) return GF_BAD_PARAM;
@@ -1240,7 +1259,7 @@ u32 gf_isom_has_track_reference(GF_ISOFile *movie, u32 trackNumber, u32 referenc
 	u32 i;
 	GF_TrackBox *trak;
 	GF_TrackReferenceTypeBox *dpnd;
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 	if (!trak) return 0;
 	if (!trak->References) return 0;
 
@@ -1291,7 +1310,7 @@ GF_EXPORT
 u32 gf_isom_get_sample_description_count(GF_ISOFile *the_file, u32 trackNumber)
 {
 	GF_TrackBox *trak;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (!trak) return 0;
 
 	return gf_list_count(trak->Media->information->sampleTable->SampleDescription->child_boxes);
@@ -1341,7 +1360,8 @@ GF_EXPORT
 u64 gf_isom_get_media_duration(GF_ISOFile *movie, u32 trackNumber)
 {
 	GF_TrackBox *trak;
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	//media duration is taken from mdhd if sample tables are not loaded
+	trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 	if (!trak) return 0;
 
 
@@ -1374,7 +1394,7 @@ GF_EXPORT
 u32 gf_isom_get_media_timescale(GF_ISOFile *the_file, u32 trackNumber)
 {
 	GF_TrackBox *trak;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (!trak || !trak->Media || !trak->Media->mediaHeader) return 0;
 	return trak->Media->mediaHeader->timeScale;
 }
@@ -1444,7 +1464,7 @@ u32 gf_isom_get_chapter_count(GF_ISOFile *movie, u32 trackNumber)
 
 	udta = NULL;
 	if (trackNumber) {
-		GF_TrackBox *trak = gf_isom_get_track_from_file(movie, trackNumber);
+		GF_TrackBox *trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 		if (!trak) return 0;
 		udta = trak->udta;
 	} else {
@@ -1470,7 +1490,7 @@ GF_Err gf_isom_get_chapter(GF_ISOFile *movie, u32 trackNumber, u32 Index, u64 *c
 
 	udta = NULL;
 	if (trackNumber) {
-		GF_TrackBox *trak = gf_isom_get_track_from_file(movie, trackNumber);
+		GF_TrackBox *trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 		if (!trak) return GF_BAD_PARAM;
 		udta = trak->udta;
 	} else {
@@ -1497,7 +1517,7 @@ GF_EXPORT
 u32 gf_isom_get_media_type(GF_ISOFile *movie, u32 trackNumber)
 {
 	GF_TrackBox *trak;
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 	if (!trak) return GF_BAD_PARAM;
 	return (trak->Media && trak->Media->handler) ? trak->Media->handler->handlerType : 0;
 }
@@ -1536,7 +1556,7 @@ Bool gf_isom_is_track_encrypted(GF_ISOFile *the_file, u32 trackNumber)
 {
 	GF_TrackBox *trak;
 	u32 i=0;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (!trak) return 2;
 	while (1) {
 		GF_Box *entry = (GF_Box*)gf_list_get(trak->Media->information->sampleTable->SampleDescription->child_boxes, i);
@@ -1556,7 +1576,7 @@ u32 gf_isom_get_media_subtype(GF_ISOFile *the_file, u32 trackNumber, u32 Descrip
 {
 	GF_TrackBox *trak;
 	GF_Box *entry;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (!trak || !DescriptionIndex || !trak->Media || !trak->Media->information || !trak->Media->information->sampleTable) return 0;
 	entry = (GF_Box*)gf_list_get(trak->Media->information->sampleTable->SampleDescription->child_boxes, DescriptionIndex-1);
 	if (!entry) return 0;
@@ -1583,7 +1603,7 @@ u32 gf_isom_get_mpeg4_subtype(GF_ISOFile *the_file, u32 trackNumber, u32 Descrip
 {
 	GF_TrackBox *trak;
 	GF_Box *entry=NULL;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (!trak || !DescriptionIndex) return 0;
 
 	if (trak->Media
@@ -1605,7 +1625,7 @@ GF_EXPORT
 GF_Err gf_isom_get_handler_name(GF_ISOFile *the_file, u32 trackNumber, const char **outName)
 {
 	GF_TrackBox *trak;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (!trak || !outName) return GF_BAD_PARAM;
 	*outName = trak->Media->handler->nameUTF8;
 	return GF_OK;
@@ -1678,7 +1698,10 @@ GF_EXPORT
 u32 gf_isom_get_sample_count(GF_ISOFile *the_file, u32 trackNumber)
 {
 	GF_TrackBox *trak;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	GF_SampleTableBox *lazy_stbl;
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
+	lazy_stbl = gf_isom_get_lazy_stbl(trak);
+	if (lazy_stbl) return lazy_stbl->lazy_sample_count;
 	if (!trak || !trak->Media || !trak->Media->information || !trak->Media->information->sampleTable || !trak->Media->information->sampleTable->SampleSize) return 0;
 	return trak->Media->information->sampleTable->SampleSize->sampleCount
 #ifndef GPAC_DISABLE_ISOM_FRAGMENTS
@@ -1687,11 +1710,22 @@ u32 gf_isom_get_sample_count(GF_ISOFile *the_file, u32 trackNumber)
 	       ;
 }
 
+GF_EXPORT
+Bool gf_isom_has_sample_tables_loaded(GF_ISOFile *the_file, u32 trackNumber)
+{
+	GF_TrackBox *trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
+	if (!trak) return GF_FALSE;
+	return gf_isom_get_lazy_stbl(trak) ? GF_FALSE : GF_TRUE;
+}
+
 GF_EXPORT
 u32 gf_isom_get_constant_sample_size(GF_ISOFile *the_file, u32 trackNumber)
 {
 	GF_TrackBox *trak;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	GF_SampleTableBox *lazy_stbl;
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
+	lazy_stbl = gf_isom_get_lazy_stbl(trak);
+	if (lazy_stbl) return lazy_stbl->lazy_sample_size;
 	if (!trak || !trak->Media || !trak->Media->information || !trak->Media->information->sampleTable || !trak->Media->information->sampleTable->SampleSize) return 0;
 	return trak->Media->information->sampleTable->SampleSize->sampleSize;
 }
@@ -1795,7 +1829,7 @@ GF_EXPORT
 s64 gf_isom_get_cts_to_dts_shift(GF_ISOFile *the_file, u32 trackNumber)
 {
 	GF_TrackBox *trak;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (!trak || !trak->Media->information->sampleTable->CompositionToDecode) return 0;
 	return trak->Media->information->sampleTable->CompositionToDecode->compositionToDTSShift;
 }
@@ -2023,6 +2057,79 @@ GF_ISOSample *gf_isom_get_sample_info(GF_ISOFile *the_file, u32 trackNumber, u32
 	return gf_isom_get_sample_info_ex(the_file, trackNumber, sampleNumber, sampleDescriptionIndex, data_offset, NULL);
 }
 
+GF_EXPORT
+GF_Err gf_isom_set_file_mapping(GF_ISOFile *movie, Bool use_mapping)
+{
+	u32 i;
+	if (!movie || !movie->moov || !movie->movieFileMap) return GF_BAD_PARAM;
+
+	if (use_mapping) {
+		if (movie->mappedFileMap) return GF_OK;
+		if ((movie->openMode != GF_ISOM_OPEN_READ) || !movie->fileName) return GF_NOT_SUPPORTED;
+		//only for complete local files - fragmented files may grow or be replaced by segments
+		if (movie->movieFileMap->type != GF_ISOM_DATA_FILE) return GF_NOT_SUPPORTED;
+		if (((GF_FileDataMap *)movie->movieFileMap)->blob) return GF_NOT_SUPPORTED;
+		if (!strncmp(movie->fileName, "gfio://", 7) || !strncmp(movie->fileName, "gmem://", 7)) return GF_NOT_SUPPORTED;
+		if (movie->moov->mvex || movie->moov->compressed_diff || movie->read_byte_offset || movie->bytes_removed)
+			return GF_NOT_SUPPORTED;
+
+		movie->mappedFileMap = gf_isom_fmo_new(movie->fileName, GF_ISOM_DATA_MAP_READ);
+		if (!movie->mappedFileMap) return GF_NOT_SUPPORTED;
+	} else if (!movie->mappedFileMap) {
+		return GF_OK;
+	}
+
+	//reassign the data handler of self-contained tracks already opened
+	for (i=0; i<gf_list_count(movie->moov->trackList); i++) {
+		GF_TrackBox *trak = (GF_TrackBox *)gf_list_get(movie->moov->trackList, i);
+		GF_MediaInformationBox *minf = trak->Media->information;
+		if (use_mapping && (minf->dataHandler == movie->movieFileMap)) {
+			minf->dataHandler = movie->mappedFileMap;
+		} else if (!use_mapping && (minf->dataHandler == movie->mappedFileMap)) {
+			minf->dataHandler = movie->movieFileMap;
+		}
+		minf->mmap_hint_chunk = 0;
+	}
+	if (!use_mapping) {
+		gf_isom_datamap_del(movie->mappedFileMap);
+		movie->mappedFileMap = NULL;
+	}
+	return GF_OK;
+}
+
+GF_EXPORT
+const u8 *gf_isom_get_sample_mapped_data(GF_ISOFile *the_file, u32 trackNumber, u32 sampleDescriptionIndex, u64 data_offset, u32 data_size)
+{
+	u32 dataRefIndex;
+	GF_DataEntryBox *ent;
+	GF_SampleEntryBox *entry;
+	GF_TrackBox *trak;
+	if (!the_file || !the_file->mappedFileMap) return NULL;
+	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	if (!trak || trak->padding_bytes) return NULL;
+
+	if (Media_GetSampleDesc(trak->Media, sampleDescriptionIndex, &entry, &dataRefIndex) != GF_OK) return NULL;
+
+	//data must be in the movie file
+	ent = (GF_DataEntryBox*)gf_list_get(trak->Media->information->dataInformation->dref->child_boxes, dataRefIndex - 1);
+	if (ent && !(ent->flags&1)) return NULL;
+
+	//payloads modified by Media_GetSample cannot be referenced
+	switch (trak->Media->handler->handlerType) {
+	case GF_ISOM_MEDIA_OD:
+		return NULL;
+	case GF_ISOM_MEDIA_TEXT:
+	case GF_ISOM_MEDIA_SCENE:
+	case GF_ISOM_MEDIA_SUBT:
+		if (the_file->convert_streaming_text) return NULL;
+		break;
+	}
+	if (gf_isom_is_nalu_based_entry(trak->Media, entry) && !gf_isom_is_encrypted_entry(entry->type))
+		return NULL;
+
+	return gf_isom_datamap_get_mapped_data(the_file->mappedFileMap, data_offset, data_size);
+}
+
 
 //get sample dts
 GF_EXPORT
@@ -2386,7 +2493,7 @@ Bool gf_isom_get_edit_list_type(GF_ISOFile *the_file, u32 trackNumber, s64 *medi
 	GF_EdtsEntry *ent;
 	GF_TrackBox *trak;
 	u32 count;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (!trak) return GF_FALSE;
 	*mediaOffset = 0;
 	if (!trak->editBox || !trak->editBox->editList) return GF_FALSE;
@@ -2427,7 +2534,7 @@ GF_EXPORT
 u32 gf_isom_get_edits_count(GF_ISOFile *the_file, u32 trackNumber)
 {
 	GF_TrackBox *trak;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (!trak) return 0;
 
 	if (!trak->editBox || !trak->editBox->editList) return 0;
@@ -2483,8 +2590,11 @@ GF_EXPORT
 u8 gf_isom_has_sync_points(GF_ISOFile *the_file, u32 trackNumber)
 {
 	GF_TrackBox *trak;
+	GF_SampleTableBox *lazy_stbl;
 
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
+	lazy_stbl = gf_isom_get_lazy_stbl(trak);
+	if (lazy_stbl) return lazy_stbl->lazy_sync_state;
 	if (!trak || !trak->Media || !trak->Media->information || !trak->Media->information->sampleTable) return 0;
 	if (trak->Media->information->sampleTable->SyncSample) {
 		if (!trak->Media->information->sampleTable->SyncSample->nb_entries) return 2;
@@ -2576,7 +2686,7 @@ u32 gf_isom_get_udta_count(GF_ISOFile *movie, u32 trackNumber)
 	if (!movie || !movie->moov) return 0;
 
 	if (trackNumber) {
-		trak = gf_isom_get_track_from_file(movie, trackNumber);
+		trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 		if (!trak) return 0;
 		udta = trak->udta;
 	} else {
@@ -2595,7 +2705,7 @@ GF_Err gf_isom_get_udta_type(GF_ISOFile *movie, u32 trackNumber, u32 udta_idx, u
 	if (!movie || !movie->moov || !udta_idx) return GF_BAD_PARAM;
 
 	if (trackNumber) {
-		trak = gf_isom_get_track_from_file(movie, trackNumber);
+		trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 		if (!trak) return GF_OK;
 		udta = trak->udta;
 	} else {
@@ -2624,7 +2734,7 @@ u32 gf_isom_get_user_data_count(GF_ISOFile *movie, u32 trackNumber, u32 UserData
 	memset(t, 1, 16);
 
 	if (trackNumber) {
-		trak = gf_isom_get_track_from_file(movie, trackNumber);
+		trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 		if (!trak) return 0;
 		udta = trak->udta;
 	} else {
@@ -2656,7 +2766,7 @@ GF_Err gf_isom_get_user_data(GF_ISOFile *movie, u32 trackNumber, u32 UserDataTyp
 	if (!movie || !movie->moov) return GF_BAD_PARAM;
 
 	if (trackNumber) {
-		trak = gf_isom_get_track_from_file(movie, trackNumber);
+		trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 		if (!trak) return GF_BAD_PARAM;
 		udta = trak->udta;
 	} else {
@@ -2990,7 +3100,8 @@ GF_Err gf_isom_refresh_fragmented(GF_ISOFile *movie, u64 *MissingBytes, const ch
 	}
 
 	prevsize = gf_bs_get_refreshed_size(movie->movieFileMap->bs);
-	if (prevsize==size) return GF_OK;
+	//parsing was suspended on a full fragment window, resume it even if no new data
+	if ((prevsize==size) && !movie->frag_window_pending) return GF_OK;
 
 	if (!movie->moov->mvex)
 		return GF_OK;
@@ -3108,6 +3219,9 @@ static void gf_isom_recreate_tables(GF_TrackBox *trak)
 	GF_Box *a;
 	GF_SampleTableBox *stbl = trak->Media->information->sampleTable;
 
+	//drop lookup indexes but keep their settings
+	if (stbl->TimeToSample) stbl_set_lookup_index(stbl, stbl->TimeToSample->r_index_max);
+
 	if (stbl->ChunkOffset) {
 		if (stbl->ChunkOffset->type==GF_ISOM_BOX_TYPE_CO64) {
 			GF_ChunkLargeOffsetBox *co64 = (GF_ChunkLargeOffsetBox *)stbl->ChunkOffset;
@@ -3205,6 +3319,42 @@ static void gf_isom_recreate_tables(GF_TrackBox *trak)
 }
 
 
+#ifndef	GPAC_DISABLE_ISOM_FRAGMENTS
+static void isom_reset_track_tables(GF_TrackBox *trak, Bool reset_sample_count)
+{
+	u32 dur;
+	u64 dts;
+	GF_SampleTableBox *stbl = trak->Media->information->sampleTable;
+
+	trak->sample_count_at_seg_start += stbl->SampleSize->sampleCount;
+	if (trak->sample_count_at_seg_start) {
+		GF_Err e;
+		e = stbl_GetSampleDTS_and_Duration(stbl->TimeToSample, stbl->SampleSize->sampleCount, &dts, &dur);
+		if (e == GF_OK) {
+			trak->dts_at_seg_start += dts + dur;
+		}
+	}
+
+	//recreate all boxes
+	gf_isom_recreate_tables(trak);
+
+#if 0
+	j = stbl->nb_stbl_boxes;
+	while ((a = (GF_Box *)gf_list_enum(stbl->child_boxes, &j))) {
+		gf_isom_box_del_parent(&stbl->child_boxes, a);
+		j--;
+	}
+#endif
+
+	if (reset_sample_count) {
+		trak->Media->information->sampleTable->SampleSize->sampleCount = 0;
+		trak->sample_count_at_seg_start = 0;
+		trak->dts_at_seg_start = 0;
+		trak->first_traf_merged = GF_FALSE;
+	}
+}
+#endif
+
 GF_EXPORT
 GF_Err gf_isom_reset_tables(GF_ISOFile *movie, Bool reset_sample_count)
 {
@@ -3214,47 +3364,190 @@ GF_Err gf_isom_reset_tables(GF_ISOFile *movie, Bool reset_sample_count)
 	if (!movie || !movie->moov || !movie->moov->mvex) return GF_BAD_PARAM;
 	for (i=0; i<gf_list_count(movie->moov->trackList); i++) {
 		GF_TrackBox *trak = (GF_TrackBox *)gf_list_get(movie->moov->trackList, i);
+		isom_reset_track_tables(trak, reset_sample_count);
+	}
+	if (reset_sample_count) {
+		movie->NextMoofNumber = 0;
+	}
+#endif
+	return GF_OK;
 
-		u32 dur;
-		u64 dts;
-		GF_SampleTableBox *stbl = trak->Media->information->sampleTable;
+}
 
-		trak->sample_count_at_seg_start += stbl->SampleSize->sampleCount;
-		if (trak->sample_count_at_seg_start) {
-			GF_Err e;
-			e = stbl_GetSampleDTS_and_Duration(stbl->TimeToSample, stbl->SampleSize->sampleCount, &dts, &dur);
-			if (e == GF_OK) {
-				trak->dts_at_seg_start += dts + dur;
-			}
+GF_EXPORT
+GF_Err gf_isom_reset_track_tables(GF_ISOFile *movie, u32 trackNumber)
+{
+#ifndef	GPAC_DISABLE_ISOM_FRAGMENTS
+	GF_TrackBox *trak;
+	if (!movie || !movie->moov || !movie->moov->mvex) return GF_BAD_PARAM;
+	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	if (!trak) return GF_BAD_PARAM;
+	isom_reset_track_tables(trak, GF_FALSE);
+	return GF_OK;
+#else
+	return GF_NOT_SUPPORTED;
+#endif
+}
+
+GF_EXPORT
+Bool gf_isom_fragment_window_pending(GF_ISOFile *movie)
+{
+#ifndef	GPAC_DISABLE_ISOM_FRAGMENTS
+	if (movie && movie->frag_window) return movie->frag_window_pending;
+#endif
+	return GF_FALSE;
+}
+
+#ifndef	GPAC_DISABLE_ISOM_FRAGMENTS
+//walk top-level boxes after the last indexed fragment until a fragment starting after target is found
+//only moof boxes are parsed, mdat and other boxes are skipped
+static void isom_scan_moofs(GF_ISOFile *movie, u64 target)
+{
+	u64 pos, file_size, prev_pos;
+	GF_BitStream *bs = movie->movieFileMap->bs;
+
+	prev_pos = gf_bs_get_position(bs);
+	file_size = gf_bs_get_size(bs);
+	pos = movie->nb_moof_index ? movie->moof_index[movie->nb_moof_index-1].moof_offset : movie->current_top_box_start;
+
+	while (pos + 8 <= file_size) {
+		u64 size;
+		u32 type;
+		gf_bs_seek(bs, pos);
+		size = gf_bs_read_u32(bs);
+		type = gf_bs_read_u32(bs);
+		if (size==1) {
+			if (pos + 16 > file_size) break;
+			size = gf_bs_read_u64(bs);
+		} else if (!size) {
+			size = file_size - pos;
+		}
+		if (size<8) break;
+		if (type==GF_ISOM_BOX_TYPE_MOOF) {
+			GF_Box *moof;
+			if (pos + size > file_size) break;
+			gf_bs_seek(bs, pos);
+			if (gf_isom_box_parse(&moof, bs) != GF_OK) break;
+			if (moof->type==GF_ISOM_BOX_TYPE_MOOF)
+				gf_isom_push_moof_index(movie, (GF_MovieFragmentBox *) moof, pos);
+			gf_isom_box_del(moof);
+
+			if (movie->nb_moof_index && (movie->moof_index[movie->nb_moof_index-1].time > target))
+				break;
 		}
+		pos += size;
+	}
+	gf_bs_seek(bs, prev_pos);
+}
 
-		//recreate all boxes
-		gf_isom_recreate_tables(trak);
+//walk back from fragment idx until all tracks present so far start with a sync sample at or before target
+//in the following fragments
+static u32 isom_find_seek_moof(GF_ISOFile *movie, u32 idx, u64 target)
+{
+	u32 i, j, nb_tracks = gf_list_count(movie->moov->trackList);
+	//first fragment at or after idx with the track present, -1 if none, -2 if track not present up to idx
+	u32 *first_moof = gf_malloc(sizeof(u32) * nb_tracks);
+	if (!first_moof) return 0;
 
-#if 0
-		j = stbl->nb_stbl_boxes;
-		while ((a = (GF_Box *)gf_list_enum(stbl->child_boxes, &j))) {
-			gf_isom_box_del_parent(&stbl->child_boxes, a);
-			j--;
+	for (i=0; i<nb_tracks; i++) {
+		first_moof[i] = (u32) -2;
+		for (j=0; j<=idx; j++) {
+			if (movie->moof_index_track_flags[j*nb_tracks + i]) {
+				first_moof[i] = (u32) -1;
+				break;
+			}
+		}
+	}
+	while (1) {
+		Bool is_seek_point = GF_TRUE;
+		for (i=0; i<nb_tracks; i++) {
+			GF_TrackBox *trak;
+			if (first_moof[i] == (u32) -2) continue;
+			if (movie->moof_index_track_flags[idx*nb_tracks + i]) first_moof[i] = idx;
+			if (first_moof[i] == (u32) -1) {
+				is_seek_point = GF_FALSE;
+				continue;
+			}
+			j = first_moof[i]*nb_tracks + i;
+			trak = gf_list_get(movie->moov->trackList, i);
+			if ((movie->moof_index_track_flags[j] != 2)
+				|| (gf_timestamp_rescale(movie->moof_index_dts[j], trak->Media->mediaHeader->timeScale, movie->moov->mvhd->timeScale) > target)
+			) {
+				is_seek_point = GF_FALSE;
+			}
 		}
+		if (is_seek_point || !idx) break;
+		idx--;
+	}
+	gf_free(first_moof);
+	return idx;
+}
 #endif
 
-		if (reset_sample_count) {
-			trak->Media->information->sampleTable->SampleSize->sampleCount = 0;
-#ifndef GPAC_DISABLE_ISOM_FRAGMENTS
-			trak->sample_count_at_seg_start = 0;
-			trak->dts_at_seg_start = 0;
-			trak->first_traf_merged = GF_FALSE;
-#endif
+GF_EXPORT
+GF_Err gf_isom_seek_fragment_window(GF_ISOFile *movie, Double start_time)
+{
+#ifndef	GPAC_DISABLE_ISOM_FRAGMENTS
+	u32 i, timescale;
+	u64 offset, time, target, *track_dts=NULL;
+
+	if (!movie || !movie->moov || !movie->moov->mvex || !movie->frag_window || !movie->movieFileMap) return GF_BAD_PARAM;
+	if (movie->bytes_removed) return GF_NOT_SUPPORTED;
+	if (start_time<0) start_time = 0;
+
+	if (movie->main_sidx) {
+		u64 cur_time = 0;
+		u64 cur_offset = movie->main_sidx->first_offset + movie->main_sidx_end_pos;
+		timescale = movie->main_sidx->timescale;
+		target = (u64) (start_time * timescale);
+		offset = cur_offset;
+		time = 0;
+		//last subsegment starting at or before target
+		for (i=0; i<movie->main_sidx->nb_refs; i++) {
+			if (cur_time > target) break;
+			offset = cur_offset;
+			time = cur_time;
+			cur_time += movie->main_sidx->refs[i].subsegment_duration;
+			cur_offset += movie->main_sidx->refs[i].reference_size;
 		}
-
+	} else {
+		u32 lo, hi;
+		timescale = movie->moov->mvhd->timeScale;
+		target = (u64) (start_time * timescale);
+		if (!movie->nb_moof_index || (movie->moof_index[movie->nb_moof_index-1].time <= target))
+			isom_scan_moofs(movie, target);
+		if (!movie->nb_moof_index) return GF_NOT_FOUND;
+
+		//last fragment starting at or before target
+		lo = 0;
+		hi = movie->nb_moof_index;
+		while (hi - lo > 1) {
+			u32 mid = (lo + hi) / 2;
+			if (movie->moof_index[mid].time <= target) lo = mid;
+			else hi = mid;
+		}
+		lo = isom_find_seek_moof(movie, lo, target);
+		offset = movie->moof_index[lo].moof_offset;
+		time = movie->moof_index[lo].time;
+		track_dts = movie->moof_index_dts + lo * gf_list_count(movie->moov->trackList);
 	}
-	if (reset_sample_count) {
-		movie->NextMoofNumber = 0;
+
+	for (i=0; i<gf_list_count(movie->moov->trackList); i++) {
+		GF_TrackBox *trak = (GF_TrackBox *)gf_list_get(movie->moov->trackList, i);
+		isom_reset_track_tables(trak, GF_TRUE);
+		//used if no tfdt in fragments
+		if (track_dts)
+			trak->dts_at_seg_start = track_dts[i];
+		else
+			trak->dts_at_seg_start = gf_timestamp_rescale(time, timescale, trak->Media->mediaHeader->timeScale);
 	}
-#endif
+	movie->current_top_box_start = offset;
+	//force parsing at next refresh
+	movie->frag_window_pending = GF_TRUE;
 	return GF_OK;
-
+#else
+	return GF_NOT_SUPPORTED;
+#endif
 }
 
 GF_EXPORT
@@ -3498,7 +3791,7 @@ GF_GenericSampleDescription *gf_isom_get_generic_sample_description(GF_ISOFile *
 	GF_GenericSampleEntryBox *genm;
 	GF_TrackBox *trak;
 	GF_GenericSampleDescription *udesc;
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 	if (!trak || !StreamDescriptionIndex || !trak->Media || !trak->Media->information || !trak->Media->information->sampleTable) return 0;
 
 	entry = (GF_GenericVisualSampleEntryBox *)gf_list_get(trak->Media->information->sampleTable->SampleDescription->child_boxes, StreamDescriptionIndex-1);
@@ -3598,7 +3891,7 @@ GF_Err gf_isom_get_visual_info(GF_ISOFile *movie, u32 trackNumber, u32 StreamDes
 	GF_SampleEntryBox *entry;
 	GF_SampleDescriptionBox *stsd;
 
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 	if (!trak) return GF_BAD_PARAM;
 
 	stsd = trak->Media->information->sampleTable->SampleDescription;
@@ -3657,7 +3950,7 @@ GF_Err gf_isom_get_audio_info(GF_ISOFile *movie, u32 trackNumber, u32 StreamDesc
 	GF_AudioSampleEntryBox *entry;
 	GF_SampleDescriptionBox *stsd = NULL;
 
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 	if (!trak) return GF_BAD_PARAM;
 
 	if (trak->Media && trak->Media->information && trak->Media->information->sampleTable && trak->Media->information->sampleTable->SampleDescription)
@@ -3694,7 +3987,7 @@ GF_Err gf_isom_get_audio_layout(GF_ISOFile *movie, u32 trackNumber, u32 StreamDe
 	GF_SampleDescriptionBox *stsd;
 	GF_ChannelLayoutBox *chnl;
 
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 	if (!trak || !layout) return GF_BAD_PARAM;
 	memset(layout, 0, sizeof(GF_AudioChannelLayout));
 
@@ -3720,7 +4013,7 @@ GF_Err gf_isom_get_pixel_aspect_ratio(GF_ISOFile *movie, u32 trackNumber, u32 St
 	GF_VisualSampleEntryBox *entry;
 	GF_SampleDescriptionBox *stsd;
 
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 	if (!trak || !hSpacing || !vSpacing) return GF_BAD_PARAM;
 	*hSpacing = 1;
 	*vSpacing = 1;
@@ -3821,7 +4114,7 @@ u8 gf_isom_get_pl_indication(GF_ISOFile *movie, GF_ISOProfileLevelType PL_Code)
 GF_EXPORT
 GF_Err gf_isom_get_track_matrix(GF_ISOFile *the_file, u32 trackNumber, u32 matrix[9])
 {
-	GF_TrackBox *trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	GF_TrackBox *trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (!trak || !trak->Header) return GF_BAD_PARAM;
 	memcpy(matrix, trak->Header->matrix, sizeof(trak->Header->matrix));
 	return GF_OK;
@@ -3830,7 +4123,7 @@ GF_Err gf_isom_get_track_matrix(GF_ISOFile *the_file, u32 trackNumber, u32 matri
 GF_EXPORT
 GF_Err gf_isom_get_track_layout_info(GF_ISOFile *movie, u32 trackNumber, u32 *width, u32 *height, s32 *translation_x, s32 *translation_y, s16 *layer)
 {
-	GF_TrackBox *tk = gf_isom_get_track_from_file(movie, trackNumber);
+	GF_TrackBox *tk = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 	if (!tk) return GF_BAD_PARAM;
 	if (width) *width = tk->Header->width>>16;
 	if (height) *height = tk->Header->height>>16;
@@ -3848,13 +4141,23 @@ u64 gf_isom_get_media_data_size(GF_ISOFile *movie, u32 trackNumber)
 	u32 i;
 	u64 size;
 	GF_SampleSizeBox *stsz;
-	GF_TrackBox *tk = gf_isom_get_track_from_file(movie, trackNumber);
+	GF_SampleTableBox *lazy_stbl;
+	GF_TrackBox *tk = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 	if (!tk) return 0;
+	//no need to load sample tables for constant size
+	lazy_stbl = gf_isom_get_lazy_stbl(tk);
+	if (lazy_stbl && lazy_stbl->lazy_sample_size)
+		return (u64) lazy_stbl->lazy_sample_size * lazy_stbl->lazy_sample_count;
+	if (lazy_stbl && gf_isom_load_track_tables(tk)) return 0;
 	stsz = tk->Media->information->sampleTable->SampleSize;
 	if (!stsz) return 0;
 	if (stsz->sampleSize) return stsz->sampleSize*stsz->sampleCount;
 	size = 0;
-	for (i=0; i<stsz->sampleCount; i++) size += stsz->sizes[i];
+	for (i=0; i<stsz->sampleCount; i++) {
+		u32 samp_size;
+		stbl_GetSampleSize(stsz, i+1, &samp_size);
+		size += samp_size;
+	}
 	return size;
 }
 
@@ -4349,7 +4652,7 @@ GF_Err gf_isom_get_track_switch_group_count(GF_ISOFile *movie, u32 trackNumber,
 	GF_UserDataMap *map;
 	GF_TrackBox *trak;
 
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 	if (!trak || !trak->Header) return GF_BAD_PARAM;
 	if (alternateGroupID) *alternateGroupID = trak->Header->alternate_group;
 	if (nb_groups) *nb_groups = 0;
@@ -4794,7 +5097,7 @@ GF_EXPORT
 GF_Err gf_isom_set_nalu_extract_mode(GF_ISOFile *the_file, u32 trackNumber, GF_ISONaluExtractMode nalu_extract_mode)
 {
 	GF_TrackReferenceTypeBox *dpnd;
-	GF_TrackBox *trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	GF_TrackBox *trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (!trak) return GF_BAD_PARAM;
 	trak->extractor_mode = nalu_extract_mode;
 
@@ -4808,6 +5111,54 @@ GF_Err gf_isom_set_nalu_extract_mode(GF_ISOFile *the_file, u32 trackNumber, GF_I
 	return GF_OK;
 }
 
+GF_EXPORT
+GF_Err gf_isom_set_sample_lookup_index(GF_ISOFile *the_file, u32 trackNumber, u32 max_points)
+{
+	u32 i;
+	if (!the_file || !the_file->moov) return GF_BAD_PARAM;
+	//tables may be modified in edit modes
+	if (max_points && (the_file->openMode != GF_ISOM_OPEN_READ)) return GF_NOT_SUPPORTED;
+	if (trackNumber) {
+		GF_TrackBox *trak = gf_isom_get_track_from_file(the_file, trackNumber);
+		if (!trak) return GF_BAD_PARAM;
+		stbl_set_lookup_index(trak->Media->information->sampleTable, max_points);
+		return GF_OK;
+	}
+	for (i=0; i<gf_list_count(the_file->moov->trackList); i++) {
+		GF_TrackBox *trak = gf_isom_get_track_from_file(the_file, i+1);
+		if (!trak) return GF_BAD_PARAM;
+		stbl_set_lookup_index(trak->Media->information->sampleTable, max_points);
+	}
+	return GF_OK;
+}
+
+GF_EXPORT
+GF_Err gf_isom_drop_sample_lookup_index(GF_ISOFile *the_file, u32 trackNumber)
+{
+	u32 i, count;
+	if (!the_file || !the_file->moov) return GF_BAD_PARAM;
+	count = gf_list_count(the_file->moov->trackList);
+	for (i=0; i<count; i++) {
+		GF_SampleTableBox *stbl;
+		GF_TrackBox *trak = (GF_TrackBox *)gf_list_get(the_file->moov->trackList, i);
+		if (trackNumber && (trackNumber != i+1)) continue;
+		stbl = trak->Media->information->sampleTable;
+		if (stbl->TimeToSample) {
+			stbl_lookup_index_del(stbl->TimeToSample->r_index);
+			stbl->TimeToSample->r_index = NULL;
+		}
+		if (stbl->CompositionOffset) {
+			stbl_lookup_index_del(stbl->CompositionOffset->r_index);
+			stbl->CompositionOffset->r_index = NULL;
+		}
+		if (stbl->SampleToChunk) {
+			stbl_lookup_index_del(stbl->SampleToChunk->r_index);
+			stbl->SampleToChunk->r_index = NULL;
+		}
+	}
+	return GF_OK;
+}
+
 GF_EXPORT
 GF_ISONaluExtractMode gf_isom_get_nalu_extract_mode(GF_ISOFile *the_file, u32 trackNumber)
 {
@@ -5280,7 +5631,7 @@ GF_Err gf_isom_get_bitrate(GF_ISOFile *movie, u32 trackNumber, u32 sampleDescInd
 	GF_TrackBox *trak;
 	GF_ESDBox *esd;
 
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 	if (!trak || !trak->Media) return GF_BAD_PARAM;
 
 	mrate = arate = dbsize = 0;
@@ -5387,7 +5738,7 @@ GF_Err gf_isom_get_jp2_config(GF_ISOFile *movie, u32 trackNumber, u32 sampleDesc
 	GF_MPEGVisualSampleEntryBox *entry;
 	GF_BitStream *bs;
 
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 	if (!trak || !trak->Media || !trak->Media->information || !trak->Media->information->sampleTable || !trak->Media->information->sampleTable->SampleDescription) return GF_ISOM_INVALID_FILE;
 	entry = (GF_MPEGVisualSampleEntryBox *) gf_list_get(trak->Media->information->sampleTable->SampleDescription->child_boxes, sampleDesc-1);
 	if (!entry || !entry->jp2h) return GF_BAD_PARAM;
@@ -5500,7 +5851,7 @@ const u8 *gf_isom_get_mpegh_compatible_profiles(GF_ISOFile *movie, u32 trackNumb
 	GF_MHACompatibleProfilesBox *mhap;
 	GF_TrackBox *trak;
 
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 	if (!trak || !trak->Media || !nb_compat_profiles) return NULL;
 	*nb_compat_profiles = 0;
 	ent = gf_list_get(trak->Media->information->sampleTable->SampleDescription->child_boxes, sampleDescIndex-1);
@@ -5528,7 +5879,7 @@ GF_Err gf_isom_get_y3d_info(GF_ISOFile *movie, u32 trackNumber, u32 sampleDescri
 	GF_SampleEntryBox *ent;
 	GF_TrackBox *trak;
 	Bool found = GF_FALSE;
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 	if (!trak || !trak->Media || !info) return GF_BAD_PARAM;
 
 	ent = gf_list_get(trak->Media->information->sampleTable->SampleDescription->child_boxes, sampleDescriptionIndex-1);
@@ -5675,10 +6026,8 @@ GF_Err gf_isom_get_chunk_info(GF_ISOFile *movie, u32 trackNumber, u32 chunk_num,
 	if (first_sample_num) *first_sample_num = nb_samples;
 	if (sample_desc_idx) *sample_desc_idx = sample_desc_index;
 	if (chunk_offset) {
-		if (stco)
-			*chunk_offset = stco->offsets[chunk_num-1];
-		else
-			*chunk_offset = co64->offsets[chunk_num-1];
+		GF_Err e = stbl_GetChunkOffset(trak->Media->information->sampleTable->ChunkOffset, chunk_num, chunk_offset);
+		if (e) return e;
 	}
 	return GF_OK;
 }
@@ -5690,7 +6039,7 @@ GF_Err gf_isom_get_clean_aperture(GF_ISOFile *movie, u32 trackNumber, u32 Stream
 	GF_SampleEntryBox *entry;
 	GF_SampleDescriptionBox *stsd;
 
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 	if (!trak) return GF_BAD_PARAM;
 
 	stsd = trak->Media->information->sampleTable->SampleDescription;
@@ -272,6 +272,8 @@ static GF_Err shift_chunk_offsets(GF_SampleToChunkBox *stsc, GF_MediaBox *mdia,
 {
 	u32 j, k, l, last;
 	GF_StscEntry *ent;
+	GF_Err e = stbl_ExpandChunkOffsets(_stco);
+	if (e) return e;
 
 	//we have to proceed entry by entry in case a part of the media is not self-contained...
 	for (j=0; j<stsc->nb_entries; j++) {
@@ -1008,6 +1010,23 @@ GF_Err DoWrite(MovieWriter *mw, GF_List *writers, GF_BitStream *bs, u8 Emulation
 
 
 //write the file track by track, with moov box before or after the mdat
+//checks if moov can be written in the space reserved before mdat in capture mode, either exactly or followed by a free box
+static Bool moov_fits_reserve(GF_ISOFile *movie, u64 moov_size)
+{
+	if (!movie->moov_reserve) return GF_FALSE;
+	if (moov_size == movie->moov_reserve) return GF_TRUE;
+	if (moov_size + 8 <= movie->moov_reserve) return GF_TRUE;
+	return GF_FALSE;
+}
+
+static void moov_reserve_free_header(GF_ISOFile *movie, u64 moov_size, u8 *hdr)
+{
+	GF_BitStream *bs = gf_bs_new(hdr, 8, GF_BITSTREAM_WRITE);
+	gf_bs_write_u32(bs, (u32) (movie->moov_reserve - moov_size));
+	gf_bs_write_u32(bs, GF_ISOM_BOX_TYPE_FREE);
+	gf_bs_del(bs);
+}
+
 static GF_Err WriteFlat(MovieWriter *mw, u8 moovFirst, GF_BitStream *bs, Bool non_seakable, Bool for_fragments, GF_BitStream *moov_bs)
 {
 	GF_Err e;
@@ -1083,6 +1102,8 @@ static GF_Err WriteFlat(MovieWriter *mw, u8 moovFirst, GF_BitStream *bs, Bool no
 					if (e) goto exit;
 					begin += movie->pdin->size;
 				}
+				//free box reserved for moov
+				begin += movie->moov_reserve;
 			}
 			totSize -= begin;
 		} else if (!non_seakable || for_fragments) {
@@ -1196,18 +1217,21 @@ static GF_Err WriteFlat(MovieWriter *mw, u8 moovFirst, GF_BitStream *bs, Bool no
 
 			firstSize = GetMoovAndMetaSize(movie, writers);
 
-			offset = firstSize;
-			e = ShiftOffset(movie, writers, offset);
-			if (e) goto exit;
-			//get the size and see if it has changed (eg, we moved to 64 bit offsets)
-			finalSize = GetMoovAndMetaSize(movie, writers);
-			if (firstSize != finalSize) {
-				finalOffset = finalSize;
-				//OK, now we're sure about the final size.
-				//we don't need to re-emulate, as the only thing that changed is the offset
-				//so just shift the offset
-				e = ShiftOffset(movie, writers, finalOffset - offset);
+			//moov will be written in the space reserved before mdat, media data does not move
+			if (!moov_fits_reserve(movie, firstSize)) {
+				offset = firstSize;
+				e = ShiftOffset(movie, writers, offset);
 				if (e) goto exit;
+				//get the size and see if it has changed (eg, we moved to 64 bit offsets)
+				finalSize = GetMoovAndMetaSize(movie, writers);
+				if (firstSize != finalSize) {
+					finalOffset = finalSize;
+					//OK, now we're sure about the final size.
+					//we don't need to re-emulate, as the only thing that changed is the offset
+					//so just shift the offset
+					e = ShiftOffset(movie, writers, finalOffset - offset);
+					if (e) goto exit;
+				}
 			}
 		}
 		//get real sample offsets for meta items
@@ -2423,6 +2447,10 @@ GF_Err WriteToFile(GF_ISOFile *movie, Bool for_fragments)
 	}
 	//capture mode: we don't need a new bitstream
 	if (movie->openMode == GF_ISOM_OPEN_WRITE) {
+		//nothing written, no space was reserved for moov
+		if (!gf_bs_get_position(movie->editFileMap->bs))
+			movie->moov_reserve = 0;
+
 		if (!strcmp(movie->fileName, "_gpac_isobmff_redirect")) {
 			GF_BitStream *bs, *moov_bs=NULL;
 			u64 mdat_end = gf_bs_get_position(movie->editFileMap->bs);
@@ -2477,7 +2505,20 @@ GF_Err WriteToFile(GF_ISOFile *movie, Bool for_fragments)
 				gf_bs_get_content(moov_bs, &moov_data, &moov_size);
 				gf_bs_del(moov_bs);
 
-				movie->on_block_patch(movie->on_block_out_usr_data, moov_data, moov_size, mdat_start, GF_TRUE);
+				if (moov_fits_reserve(movie, moov_size)) {
+					u64 reserve_start = mdat_start - movie->moov_reserve;
+					movie->on_block_patch(movie->on_block_out_usr_data, moov_data, moov_size, reserve_start, GF_FALSE);
+					if (moov_size < movie->moov_reserve) {
+						u8 hdr[8];
+						moov_reserve_free_header(movie, moov_size, hdr);
+						movie->on_block_patch(movie->on_block_out_usr_data, hdr, 8, reserve_start + moov_size, GF_FALSE);
+					}
+				} else {
+					if (movie->moov_reserve) {
+						GF_LOG(GF_LOG_WARNING, GF_LOG_CONTAINER, ("[ISOBMFF] moov size %u larger than reserved space %u, inserting moov before mdat\n", moov_size, movie->moov_reserve));
+					}
+					movie->on_block_patch(movie->on_block_out_usr_data, moov_data, moov_size, mdat_start, GF_TRUE);
+				}
 				gf_free(moov_data);
 			}
 		} else {
@@ -2492,9 +2533,23 @@ GF_Err WriteToFile(GF_ISOFile *movie, Bool for_fragments)
 
 				gf_bs_get_content(moov_bs, &moov_data, &moov_size);
 				gf_bs_del(moov_bs);
-				if (!e)
+				if (!e && moov_fits_reserve(movie, moov_size)) {
+					GF_BitStream *file_bs = movie->editFileMap->bs;
+					u64 pos = gf_bs_get_position(file_bs);
+					gf_bs_seek(file_bs, movie->mdat->bsOffset - movie->moov_reserve);
+					gf_bs_write_data(file_bs, moov_data, moov_size);
+					if (moov_size < movie->moov_reserve) {
+						u8 hdr[8];
+						moov_reserve_free_header(movie, moov_size, hdr);
+						gf_bs_write_data(file_bs, hdr, 8);
+					}
+					gf_bs_seek(file_bs, pos);
+				} else if (!e) {
+					if (movie->moov_reserve) {
+						GF_LOG(GF_LOG_WARNING, GF_LOG_CONTAINER, ("[ISOBMFF] moov size %u larger than reserved space %u, inserting moov before mdat\n", moov_size, movie->moov_reserve));
+					}
 					e = gf_bs_insert_data(movie->editFileMap->bs, moov_data, moov_size, movie->mdat->bsOffset);
-					
+				}
 				gf_free(moov_data);
 			}
 		}
@@ -53,6 +53,21 @@ static GF_Err unpack_track(GF_TrackBox *trak)
 	return e;
 }
 
+//checks if a sample with the given DTS can be appended without unpacking the sample tables
+static Bool track_can_append_packed(GF_TrackBox *trak, u64 DTS)
+{
+	GF_SampleTableBox *stbl = trak->Media->information->sampleTable;
+	if (trak->is_unpacked) return GF_FALSE;
+	if (!stbl->SampleSize || !stbl->SampleSize->sampleCount || !stbl->SampleToChunk || !stbl->TimeToSample)
+		return GF_FALSE;
+	//sample to chunk not built in write mode (file opened for edition)
+	if (stbl->SampleToChunk->w_lastSampleNumber != stbl->SampleSize->sampleCount)
+		return GF_FALSE;
+	//insertion
+	if (DTS < stbl->TimeToSample->w_LastDTS)
+		return GF_FALSE;
+	return GF_TRUE;
+}
 
 GF_Err FlushCaptureMode(GF_ISOFile *movie)
 {
@@ -87,6 +102,21 @@ GF_Err FlushCaptureMode(GF_ISOFile *movie)
 		e = gf_isom_box_write((GF_Box *)movie->pdin, movie->editFileMap->bs);
 		if (e) return e;
 	}
+	/*reserve space for the moov before the media data, written as a free box until the file is closed*/
+	if ((movie->storageMode!=GF_ISOM_STORE_FASTSTART) && (movie->storageMode!=GF_ISOM_STORE_STREAMABLE))
+		movie->moov_reserve = 0;
+	if (movie->moov_reserve) {
+		u8 blank[1000];
+		u32 remain = movie->moov_reserve - 8;
+		memset(blank, 0, sizeof(blank));
+		gf_bs_write_u32(movie->editFileMap->bs, movie->moov_reserve);
+		gf_bs_write_u32(movie->editFileMap->bs, GF_ISOM_BOX_TYPE_FREE);
+		while (remain) {
+			u32 to_write = MIN(remain, sizeof(blank));
+			gf_bs_write_data(movie->editFileMap->bs, blank, to_write);
+			remain -= to_write;
+		}
+	}
 	movie->mdat->bsOffset = gf_bs_get_position(movie->editFileMap->bs);
 
 	/*we have a trick here: the data will be stored on the fly, so the first
@@ -985,8 +1015,11 @@ GF_Err gf_isom_add_sample(GF_ISOFile *movie, u32 trackNumber, u32 StreamDescript
 	e = FlushCaptureMode(movie);
 	if (e) return e;
 
-	e = unpack_track(trak);
-	if (e) return e;
+	//appending in decoding order does not require one chunk per sample
+	if (!sample || !track_can_append_packed(trak, sample->DTS)) {
+		e = unpack_track(trak);
+		if (e) return e;
+	}
 
 	//OK, add the sample
 	//1- Get the streamDescriptionIndex and dataRefIndex
@@ -1178,8 +1211,10 @@ GF_Err gf_isom_add_sample_reference(GF_ISOFile *movie, u32 trackNumber, u32 Stre
 	trak = gf_isom_get_track_from_file(movie, trackNumber);
 	if (!trak) return GF_BAD_PARAM;
 
-	e = unpack_track(trak);
-	if (e) return e;
+	if (!sample || !track_can_append_packed(trak, sample->DTS)) {
+		e = unpack_track(trak);
+		if (e) return e;
+	}
 
 	//OD is not allowed as a data ref
 	if (trak->Media->handler->handlerType == GF_ISOM_MEDIA_OD) {
@@ -2439,6 +2474,20 @@ GF_Err gf_isom_set_storage_mode(GF_ISOFile *movie, GF_ISOStorageMode storageMode
 	}
 }
 
+GF_EXPORT
+GF_Err gf_isom_set_moov_reserve(GF_ISOFile *movie, u32 size)
+{
+	GF_Err e = CanAccessMovie(movie, GF_ISOM_OPEN_WRITE);
+	if (e) return e;
+	//only for capture mode, and before any data is written
+	if ((movie->openMode != GF_ISOM_OPEN_WRITE) || !movie->editFileMap || gf_bs_get_position(movie->editFileMap->bs))
+		return GF_BAD_PARAM;
+	//we need at least a free box header
+	if (size && (size<8)) size = 8;
+	movie->moov_reserve = size;
+	return GF_OK;
+}
+
 
 GF_EXPORT
 GF_Err gf_isom_enable_compression(GF_ISOFile *file, GF_ISOCompressMode compress_mode, u32 compress_flags)
@@ -3229,6 +3278,8 @@ GF_Err gf_isom_use_compact_size(GF_ISOFile *movie, u32 trackNumber, Bool Compact
 		return GF_ISOM_INVALID_FILE;
 
 	stsz = trak->Media->information->sampleTable->SampleSize;
+	e = stbl_ExpandSizes(stsz);
+	if (e) return e;
 
 	//switch to regular table
 	if (!CompactionOn) {
@@ -3867,8 +3918,8 @@ GF_Err gf_isom_get_track_template(GF_ISOFile *file, u32 track, u8 **output, u32
 
 	*output = NULL;
 	*output_size = 0;
-	/*get orig sample desc and clone it*/
-	trak = gf_isom_get_track_from_file(file, track);
+	/*get orig sample desc and clone it - sample tables are not serialized, no need to load them*/
+	trak = gf_isom_get_track_from_file_no_tables(file, track);
 	if (!trak || !trak->Media) return GF_BAD_PARAM;
 
 	//don't serialize dref
@@ -3957,7 +4008,7 @@ GF_Err gf_isom_get_trex_template(GF_ISOFile *file, u32 track, u8 **output, u32 *
 	*output = NULL;
 	*output_size = 0;
 	/*get orig sample desc and clone it*/
-	trak = gf_isom_get_track_from_file(file, track);
+	trak = gf_isom_get_track_from_file_no_tables(file, track);
 	if (!trak || !trak->Media) return GF_BAD_PARAM;
 	if (!file->moov->mvex) return GF_NOT_FOUND;
 	for (i=0; i<gf_list_count(file->moov->mvex->TrackExList); i++) {
@@ -3997,7 +4048,7 @@ GF_Err gf_isom_get_stsd_template(GF_ISOFile *file, u32 track, u32 stsd_idx, u8 *
 	*output = NULL;
 	*output_size = 0;
 	/*get orig sample desc and clone it*/
-	trak = gf_isom_get_track_from_file(file, track);
+	trak = gf_isom_get_track_from_file_no_tables(file, track);
 	if (!trak || !stsd_idx || !trak->Media || !trak->Media->information || !trak->Media->information->sampleTable || !trak->Media->information->sampleTable->SampleDescription) return GF_BAD_PARAM;
 
 	ent = gf_list_get(trak->Media->information->sampleTable->SampleDescription->child_boxes, stsd_idx-1);
@@ -5330,6 +5381,40 @@ u64 gf_isom_estimate_size(GF_ISOFile *movie)
 	return mdat_size;
 }
 
+GF_EXPORT
+u64 gf_isom_estimate_moov_size(GF_ISOFile *movie, const u32 *nb_samples)
+{
+	u32 i, count;
+	u64 size;
+	if (!movie || !movie->moov) return 0;
+	if (gf_isom_box_size((GF_Box *)movie->moov)) return 0;
+	size = movie->moov->size;
+	if (movie->meta && !gf_isom_box_size((GF_Box *)movie->meta))
+		size += movie->meta->size;
+
+	count = gf_list_count(movie->moov->trackList);
+	for (i=0; i<count; i++) {
+		u32 nb_cur=0, nb_chunks=0, nb_new=0;
+		GF_TrackBox *trak = gf_list_get(movie->moov->trackList, i);
+		GF_SampleTableBox *stbl = trak->Media->information->sampleTable;
+		if (stbl->SampleSize) nb_cur = stbl->SampleSize->sampleCount;
+		if (stbl->ChunkOffset && (stbl->ChunkOffset->type==GF_ISOM_BOX_TYPE_STCO))
+			nb_chunks = ((GF_ChunkOffsetBox *)stbl->ChunkOffset)->nb_entries;
+		if (nb_samples && (nb_samples[i] > nb_cur))
+			nb_new = nb_samples[i] - nb_cur;
+
+		//existing chunk offsets may be moved to co64
+		size += 4 * (u64) nb_chunks;
+		//headers of tables not yet created (ctts, stss, sdtp)
+		size += 3*16;
+		//one entry per sample in stts (8), ctts (8), stss (4), stsz (4), sdtp (1), one chunk per sample in stsc (12) and co64 (8)
+		size += 45 * (u64) nb_new;
+	}
+	//safety margin for boxes updated at write time
+	size += size/16 + 1024;
+	return size;
+}
+
 
 //set shadowing on/off
 #if 0 //unused
@@ -464,6 +464,32 @@ Bool Media_IsSampleSyncShadow(GF_ShadowSyncBox *stsh, u32 sampleNumber)
 	return 0;
 }
 
+//max prefetch size for chunks in mapped files
+#define MMAP_MAX_CHUNK_HINT	0x800000
+
+/*hints the file mapping to prefetch the remainder of the chunk starting at the given sample*/
+static void Media_HintMappedChunk(GF_MediaBox *mdia, u32 sampleNumber, u32 chunkNumber, u32 sdesc_idx, u64 offset)
+{
+	u32 dataRefIndex, size=0;
+	u64 next_offset = 0;
+	GF_DataEntryBox *ent;
+	GF_SampleTableBox *stbl = mdia->information->sampleTable;
+
+	mdia->information->mmap_hint_chunk = chunkNumber;
+	if (Media_GetSampleDesc(mdia, sdesc_idx, NULL, &dataRefIndex) != GF_OK) return;
+	ent = (GF_DataEntryBox*)gf_list_get(mdia->information->dataInformation->dref->child_boxes, dataRefIndex - 1);
+	if (ent && !(ent->flags&1)) return;
+
+	if (stbl_GetChunkOffset(stbl->ChunkOffset, chunkNumber+1, &next_offset) != GF_OK)
+		next_offset = 0;
+	//chunks are not necessarily stored in order, only use the next chunk if it follows this one
+	if ((next_offset <= offset) || (next_offset - offset > MMAP_MAX_CHUNK_HINT)) {
+		if (stbl_GetSampleSize(stbl->SampleSize, sampleNumber, &size) != GF_OK) return;
+		next_offset = offset + size;
+	}
+	gf_isom_datamap_will_need(mdia->mediaTrack->moov->mov->mappedFileMap, offset, next_offset - offset);
+}
+
 GF_Err Media_GetSample(GF_MediaBox *mdia, u32 sampleNumber, GF_ISOSample **samp, u32 *sIDX, Bool no_data, u64 *out_offset)
 {
 	GF_Err e;
@@ -488,6 +514,9 @@ GF_Err Media_GetSample(GF_MediaBox *mdia, u32 sampleNumber, GF_ISOSample **samp,
 	if (e) return e;
 	if (sIDX) (*sIDX) = sdesc_idx;
 
+	if (mdia->mediaTrack->moov->mov->mappedFileMap && (chunkNumber != mdia->information->mmap_hint_chunk))
+		Media_HintMappedChunk(mdia, sampleNumber, chunkNumber, sdesc_idx, offset);
+
 	if (out_offset) *out_offset = offset;
 	if (!samp ) return GF_OK;
 
@@ -841,10 +870,16 @@ GF_Err Media_SetDuration(GF_TrackBox *trak)
 	if (!trak || !trak->Media || !trak->Media->information || !trak->Media->information->sampleTable)
 		return GF_ISOM_INVALID_FILE;
 
-	if (!trak->Media->information->sampleTable->SampleSize || !trak->Media->information->sampleTable->TimeToSample)
-		return GF_ISOM_INVALID_FILE;
+	//sample tables not loaded yet, trust the media header duration unless the track is empty
+	if (trak->Media->information->sampleTable->lazy_size) {
+		nbSamp = trak->Media->information->sampleTable->lazy_sample_count;
+		if (nbSamp) return GF_OK;
+	} else {
+		if (!trak->Media->information->sampleTable->SampleSize || !trak->Media->information->sampleTable->TimeToSample)
+			return GF_ISOM_INVALID_FILE;
 
-	nbSamp = trak->Media->information->sampleTable->SampleSize->sampleCount;
+		nbSamp = trak->Media->information->sampleTable->SampleSize->sampleCount;
+	}
 
 	//we need to check how many samples we have.
 	// == 1 -> last sample duration == default duration
@@ -518,6 +518,7 @@ u32 gf_isom_find_od_id_for_track(GF_ISOFile *file, u32 track)
 	i=0;
 	while ( (od_tk = (GF_TrackBox*)gf_list_enum(file->moov->trackList, &i))) {
 		if (od_tk->Media->handler->handlerType != GF_ISOM_MEDIA_OD) continue;
+		if (gf_isom_load_track_tables(od_tk) != GF_OK) continue;
 
 		for (j=0; j<od_tk->Media->information->sampleTable->SampleSize->sampleCount; j++) {
 			GF_ISOSample *samp = gf_isom_get_sample(file, i, j+1, &di);
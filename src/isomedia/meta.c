@@ -1770,6 +1770,8 @@ void gf_isom_meta_restore_items_ref(GF_ISOFile *movie, GF_MetaBox *meta)
 			trak = gf_list_get(movie->moov->trackList, j);
 			if (! gf_isom_is_video_handler_type(trak->Media->handler->handlerType))
 				continue;
+			if (gf_isom_load_track_tables(trak) != GF_OK)
+				continue;
 
 			stsz = trak->Media->information->sampleTable->SampleSize;
 			if (!stsz->sampleCount) continue;
@@ -1777,7 +1779,8 @@ void gf_isom_meta_restore_items_ref(GF_ISOFile *movie, GF_MetaBox *meta)
 				GF_Err e;
 				u32 chunk, di, samp_size;
 				u64 samp_offset;
-				samp_size = stsz->sampleSize ? stsz->sampleSize : stsz->sizes[k];
+				if (stbl_GetSampleSize(stsz, k+1, &samp_size) != GF_OK)
+					continue;
 				if (samp_size != entry->extent_length)
 					continue;
 
@@ -340,7 +340,7 @@ GF_AC3Config *gf_isom_ac3_config_get(GF_ISOFile *the_file, u32 trackNumber, u32
 	GF_AC3Config *res;
 	GF_TrackBox *trak;
 	GF_MPEGAudioSampleEntryBox *entry;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (!trak || !StreamDescriptionIndex) return NULL;
 
 	entry = (GF_MPEGAudioSampleEntryBox *)gf_list_get(trak->Media->information->sampleTable->SampleDescription->child_boxes, StreamDescriptionIndex-1);
@@ -361,7 +361,7 @@ GF_Err gf_isom_flac_config_get(GF_ISOFile *the_file, u32 trackNumber, u32 Stream
 	u32 type;
 	GF_TrackBox *trak;
 	GF_MPEGAudioSampleEntryBox *entry;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (dsi) *dsi = NULL;
 	if (dsi_size) *dsi_size = 0;
 	if (!trak || !StreamDescriptionIndex) return GF_BAD_PARAM;
@@ -390,7 +390,7 @@ GF_Err gf_isom_truehd_config_get(GF_ISOFile *the_file, u32 trackNumber, u32 Stre
 {
 	GF_TrackBox *trak;
 	GF_MPEGAudioSampleEntryBox *entry;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (!trak || !StreamDescriptionIndex) return GF_BAD_PARAM;
 
 	entry = (GF_MPEGAudioSampleEntryBox *)gf_list_get(trak->Media->information->sampleTable->SampleDescription->child_boxes, StreamDescriptionIndex-1);
@@ -492,7 +492,7 @@ GF_Err gf_isom_opus_config_get(GF_ISOFile *the_file, u32 trackNumber, u32 Stream
 	u32 type;
 	GF_TrackBox *trak;
 	GF_MPEGAudioSampleEntryBox *entry;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (dsi) *dsi = NULL;
 	if (dsi_size) *dsi_size = 0;
 	if (!trak || !StreamDescriptionIndex) return GF_BAD_PARAM;
@@ -796,7 +796,7 @@ GF_Err gf_isom_get_dims_description(GF_ISOFile *movie, u32 trackNumber, u32 desc
 {
 	GF_DIMSSampleEntryBox *dims;
 	GF_TrackBox *trak;
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 	if (!trak || !descriptionIndex || !desc) return GF_BAD_PARAM;
 
 	dims = (GF_DIMSSampleEntryBox *)gf_list_get(trak->Media->information->sampleTable->SampleDescription->child_boxes, descriptionIndex-1);
@@ -1080,7 +1080,7 @@ GF_Err gf_isom_xml_subtitle_get_description(GF_ISOFile *the_file, u32 trackNumbe
 	if (xmlnamespace) *xmlnamespace = NULL;
 	if (xml_schema_loc) *xml_schema_loc = NULL;
 	if (mimes) *mimes = NULL;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (!trak || !StreamDescriptionIndex) return GF_BAD_PARAM;
 
 	entry = (GF_MetaDataSampleEntryBox *)gf_list_get(trak->Media->information->sampleTable->SampleDescription->child_boxes, StreamDescriptionIndex-1);
@@ -1108,7 +1108,7 @@ const char *gf_isom_subtitle_get_mime(GF_ISOFile *the_file, u32 trackNumber, u32
 	GF_TrackBox *trak;
 	GF_TextConfigBox *mime;
 	GF_MetaDataSampleEntryBox *entry;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (!trak || !StreamDescriptionIndex) return NULL;
 
 	entry = (GF_MetaDataSampleEntryBox *)gf_list_get(trak->Media->information->sampleTable->SampleDescription->child_boxes, StreamDescriptionIndex-1);
@@ -1221,7 +1221,7 @@ GF_Err gf_isom_stxt_get_description(GF_ISOFile *the_file, u32 trackNumber, u32 S
 	if (mime) *mime = NULL;
 	if (config) *config = NULL;
 	if (encoding) *encoding = NULL;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(the_file, trackNumber);
 	if (!trak || !StreamDescriptionIndex) return GF_BAD_PARAM;
 
 	entry = (GF_MetaDataSampleEntryBox *)gf_list_get(trak->Media->information->sampleTable->SampleDescription->child_boxes, StreamDescriptionIndex-1);
@@ -1717,7 +1717,7 @@ GF_Err gf_isom_get_tmcd_config(GF_ISOFile *movie, u32 trackNumber, u32 descripti
 {
 	GF_TimeCodeSampleEntryBox *tmcd;
 	GF_TrackBox *trak;
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 	if (!trak || !descriptionIndex) return GF_BAD_PARAM;
 
 	tmcd = (GF_TimeCodeSampleEntryBox *)gf_list_get(trak->Media->information->sampleTable->SampleDescription->child_boxes, descriptionIndex-1);
@@ -1737,7 +1737,7 @@ GF_Err gf_isom_get_pcm_config(GF_ISOFile *movie, u32 trackNumber, u32 descriptio
 	GF_AudioSampleEntryBox *aent;
 	GF_PCMConfigBox *pcmC;
 	GF_TrackBox *trak;
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_from_file_no_tables(movie, trackNumber);
 	if (!trak || !descriptionIndex) return GF_BAD_PARAM;
 
 	aent = (GF_AudioSampleEntryBox *)gf_list_get(trak->Media->information->sampleTable->SampleDescription->child_boxes, descriptionIndex-1);
@@ -27,6 +27,107 @@
 
 #ifndef GPAC_DISABLE_ISOM
 
+void stbl_lookup_index_del(GF_StblLookupIndex *index)
+{
+	if (!index) return;
+	if (index->points) gf_free(index->points);
+	gf_free(index);
+}
+
+//allocates an index for the given table, with one point every step entries
+static GF_StblLookupIndex *stbl_lookup_index_new(u32 nb_entries, u32 max_points, u32 *step)
+{
+	GF_StblLookupIndex *index;
+	if (!max_points || (nb_entries < GF_ISOM_STBL_INDEX_MIN_ENTRIES)) return NULL;
+
+	GF_SAFEALLOC(index, GF_StblLookupIndex);
+	if (!index) return NULL;
+	*step = (nb_entries + max_points - 1) / max_points;
+	index->points = gf_malloc(sizeof(GF_StblIndexPoint) * (nb_entries / *step + 1));
+	if (!index->points) {
+		gf_free(index);
+		return NULL;
+	}
+	index->nb_entries = nb_entries;
+	return index;
+}
+
+static void stbl_lookup_index_add(GF_StblLookupIndex *index, u32 entry_idx, u32 first_sample, u64 dts)
+{
+	GF_StblIndexPoint *pt = &index->points[index->nb_points];
+	pt->entry_idx = entry_idx;
+	pt->first_sample = first_sample;
+	pt->dts = dts;
+	index->nb_points++;
+}
+
+//get the last index point starting at or before the given sample
+static GF_StblIndexPoint *stbl_lookup_index_sample(GF_StblLookupIndex *index, u32 sampleNumber)
+{
+	u32 lo = 0, hi = index->nb_points;
+	while (lo < hi) {
+		u32 mid = (lo + hi) / 2;
+		if (index->points[mid].first_sample <= sampleNumber) lo = mid+1;
+		else hi = mid;
+	}
+	return lo ? &index->points[lo-1] : NULL;
+}
+
+//get the last index point strictly before the given DTS, so that samples with same DTS are never skipped
+static GF_StblIndexPoint *stbl_lookup_index_dts(GF_StblLookupIndex *index, u64 DTS)
+{
+	u32 lo = 0, hi = index->nb_points;
+	while (lo < hi) {
+		u32 mid = (lo + hi) / 2;
+		if (index->points[mid].dts < DTS) lo = mid+1;
+		else hi = mid;
+	}
+	return lo ? &index->points[lo-1] : NULL;
+}
+
+//drop index if table was shrunk since the index was built (appended entries do not invalidate the index)
+#define STBL_CHECK_INDEX(_box) \
+	if ((_box)->r_index && ((_box)->r_index->nb_entries > (_box)->nb_entries)) { \
+		stbl_lookup_index_del((_box)->r_index); \
+		(_box)->r_index = NULL; \
+	}
+
+static void stts_build_index(GF_TimeToSampleBox *stts)
+{
+	u32 i, step;
+	u64 first_sample = 1, dts = 0;
+	GF_StblLookupIndex *index = stbl_lookup_index_new(stts->nb_entries, stts->r_index_max, &step);
+	if (!index) return;
+
+	for (i=0; i<stts->nb_entries; i++) {
+		//broken table, only index the valid part
+		if (first_sample > 0xFFFFFFFFUL) break;
+		if (!(i % step))
+			stbl_lookup_index_add(index, i, (u32) first_sample, dts);
+		first_sample += stts->entries[i].sampleCount;
+		dts += (u64) stts->entries[i].sampleCount * stts->entries[i].sampleDelta;
+	}
+	stts->r_index = index;
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[iso file] Built stts lookup index with %d points for %d entries\n", index->nb_points, stts->nb_entries));
+}
+
+static void ctts_build_index(GF_CompositionOffsetBox *ctts)
+{
+	u32 i, step;
+	u64 first_sample = 1;
+	GF_StblLookupIndex *index = stbl_lookup_index_new(ctts->nb_entries, ctts->r_index_max, &step);
+	if (!index) return;
+
+	for (i=0; i<ctts->nb_entries; i++) {
+		if (first_sample > 0xFFFFFFFFUL) break;
+		if (!(i % step))
+			stbl_lookup_index_add(index, i, (u32) first_sample, 0);
+		first_sample += ctts->entries[i].sampleCount;
+	}
+	ctts->r_index = index;
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[iso file] Built ctts lookup index with %d points for %d entries\n", index->nb_points, ctts->nb_entries));
+}
+
 //Get the sample number
 GF_Err stbl_findEntryForTime(GF_SampleTableBox *stbl, u64 DTS, u8 useCTS, u32 *sampleNumber, u32 *prevSampleNumber)
 {
@@ -44,6 +145,8 @@ GF_Err stbl_findEntryForTime(GF_SampleTableBox *stbl, u64 DTS, u8 useCTS, u32 *s
 	if (!stbl->CompositionOffset) useCTS = 0;
 #endif
 
+	STBL_CHECK_INDEX(stbl->TimeToSample)
+
 	//our cache
 	if (stbl->TimeToSample->r_FirstSampleInEntry &&
 	        (DTS >= stbl->TimeToSample->r_CurrentDTS) ) {
@@ -57,6 +160,18 @@ GF_Err stbl_findEntryForTime(GF_SampleTableBox *stbl, u64 DTS, u8 useCTS, u32 *s
 		curDTS = stbl->TimeToSample->r_CurrentDTS = 0;
 		curSampNum = stbl->TimeToSample->r_FirstSampleInEntry = 1;
 		stbl->TimeToSample->r_currentEntryIndex = 0;
+		//cache miss on seek, build lookup index
+		if (DTS && !stbl->TimeToSample->r_index && stbl->TimeToSample->r_index_max)
+			stts_build_index(stbl->TimeToSample);
+	}
+	//jump to closest index point if after our cache
+	if (stbl->TimeToSample->r_index) {
+		GF_StblIndexPoint *pt = stbl_lookup_index_dts(stbl->TimeToSample->r_index, DTS);
+		if (pt && (pt->first_sample > curSampNum)) {
+			i = stbl->TimeToSample->r_currentEntryIndex = pt->entry_idx;
+			curDTS = stbl->TimeToSample->r_CurrentDTS = pt->dts;
+			curSampNum = stbl->TimeToSample->r_FirstSampleInEntry = pt->first_sample;
+		}
 	}
 
 #if 0
@@ -136,6 +251,8 @@ GF_Err stbl_GetSampleSize(GF_SampleSizeBox *stsz, u32 SampleNumber, u32 *Size)
 
 	if (stsz->sampleSize && (stsz->type != GF_ISOM_BOX_TYPE_STZ2)) {
 		(*Size) = stsz->sampleSize;
+	} else if (stsz->w_deltas && (SampleNumber > stsz->sampleCount - stsz->w_deltas->nb_entries)) {
+		(*Size) = (u32) stbl_DeltaStoreGet(stsz->w_deltas, SampleNumber - 1 - (stsz->sampleCount - stsz->w_deltas->nb_entries));
 	} else if (stsz->sizes) {
 		(*Size) = stsz->sizes[SampleNumber - 1];
 	} else {
@@ -144,6 +261,80 @@ GF_Err stbl_GetSampleSize(GF_SampleSizeBox *stsz, u32 SampleNumber, u32 *Size)
 	return GF_OK;
 }
 
+u64 stbl_DeltaStoreGet(GF_StblDeltaStore *ds, u32 idx)
+{
+	u32 i, pos;
+	u64 val;
+	if (!ds || (idx >= ds->nb_entries)) return 0;
+
+	if (ds->rd_next && (idx + 1 == ds->rd_next))
+		return ds->rd_value;
+
+	//continue from last decoded value if in the same block, otherwise start from the block absolute value
+	if (ds->rd_next && (idx >= ds->rd_next) && (idx / GF_ISOM_STBL_DELTA_BLOCK == (ds->rd_next - 1) / GF_ISOM_STBL_DELTA_BLOCK)) {
+		i = ds->rd_next;
+		pos = ds->rd_pos;
+		val = ds->rd_value;
+	} else {
+		i = idx - idx % GF_ISOM_STBL_DELTA_BLOCK;
+		pos = ds->blocks[idx / GF_ISOM_STBL_DELTA_BLOCK];
+		val = 0;
+	}
+	while (1) {
+		u64 v = 0;
+		u32 shift = 0;
+		while (pos < ds->size) {
+			u8 c = ds->data[pos++];
+			v |= ((u64) (c & 0x7F)) << shift;
+			if (!(c & 0x80)) break;
+			shift += 7;
+		}
+		//zigzag decoding
+		val += (v >> 1) ^ (0 - (v & 1));
+		if (i == idx) break;
+		i++;
+	}
+	ds->rd_next = idx + 1;
+	ds->rd_pos = pos;
+	ds->rd_value = val;
+	return val;
+}
+
+void stbl_DeltaStoreDel(GF_StblDeltaStore *ds)
+{
+	if (!ds) return;
+	if (ds->data) gf_free(ds->data);
+	if (ds->blocks) gf_free(ds->blocks);
+	gf_free(ds);
+}
+
+GF_Err stbl_GetChunkOffset(GF_Box *stco, u32 chunkNumber, u64 *offset)
+{
+	u32 nb_entries;
+	GF_StblDeltaStore *ds;
+	(*offset) = 0;
+	if (!stco) return GF_ISOM_INVALID_FILE;
+	if (stco->type == GF_ISOM_BOX_TYPE_STCO) {
+		nb_entries = ((GF_ChunkOffsetBox *)stco)->nb_entries;
+		ds = ((GF_ChunkOffsetBox *)stco)->w_deltas;
+	} else {
+		nb_entries = ((GF_ChunkLargeOffsetBox *)stco)->nb_entries;
+		ds = ((GF_ChunkLargeOffsetBox *)stco)->w_deltas;
+	}
+	if (!chunkNumber || (chunkNumber > nb_entries)) return GF_ISOM_INVALID_FILE;
+
+	if (ds && (chunkNumber > nb_entries - ds->nb_entries)) {
+		(*offset) = stbl_DeltaStoreGet(ds, chunkNumber - 1 - (nb_entries - ds->nb_entries));
+	} else if (stco->type == GF_ISOM_BOX_TYPE_STCO) {
+		if (!((GF_ChunkOffsetBox *)stco)->offsets) return GF_ISOM_INVALID_FILE;
+		(*offset) = (u64) ((GF_ChunkOffsetBox *)stco)->offsets[chunkNumber - 1];
+	} else {
+		if (!((GF_ChunkLargeOffsetBox *)stco)->offsets) return GF_ISOM_INVALID_FILE;
+		(*offset) = ((GF_ChunkLargeOffsetBox *)stco)->offsets[chunkNumber - 1];
+	}
+	return GF_OK;
+}
+
 
 
 //Get the CTS offset of a given sample
@@ -155,12 +346,25 @@ GF_Err stbl_GetSampleCTS(GF_CompositionOffsetBox *ctts, u32 SampleNumber, s32 *C
 	//test on SampleNumber is done before
 	if (!ctts || !SampleNumber) return GF_BAD_PARAM;
 
+	STBL_CHECK_INDEX(ctts)
+
 	if (ctts->r_FirstSampleInEntry && (ctts->r_FirstSampleInEntry < SampleNumber) ) {
 		i = ctts->r_currentEntryIndex;
 	} else {
 		ctts->r_FirstSampleInEntry = 1;
 		ctts->r_currentEntryIndex = 0;
 		i = 0;
+		//cache miss on seek, build lookup index
+		if ((SampleNumber>1) && !ctts->r_index && ctts->r_index_max)
+			ctts_build_index(ctts);
+	}
+	//jump to closest index point if after our cache
+	if (ctts->r_index) {
+		GF_StblIndexPoint *pt = stbl_lookup_index_sample(ctts->r_index, SampleNumber);
+		if (pt && (pt->first_sample > ctts->r_FirstSampleInEntry)) {
+			i = ctts->r_currentEntryIndex = pt->entry_idx;
+			ctts->r_FirstSampleInEntry = pt->first_sample;
+		}
 	}
 	for (; i< ctts->nb_entries; i++) {
 		if (SampleNumber < ctts->r_FirstSampleInEntry + ctts->entries[i].sampleCount) break;
@@ -189,6 +393,7 @@ GF_Err stbl_GetSampleDTS_and_Duration(GF_TimeToSampleBox *stts, u32 SampleNumber
 	if (!stts || !SampleNumber) return GF_BAD_PARAM;
 
 	ent = NULL;
+	STBL_CHECK_INDEX(stts)
 	//use our cache
 	count = stts->nb_entries;
 	if (stts->r_FirstSampleInEntry
@@ -201,6 +406,18 @@ GF_Err stbl_GetSampleDTS_and_Duration(GF_TimeToSampleBox *stts, u32 SampleNumber
 		i = stts->r_currentEntryIndex = 0;
 		stts->r_FirstSampleInEntry = 1;
 		stts->r_CurrentDTS = 0;
+		//cache miss on seek, build lookup index
+		if ((SampleNumber>1) && !stts->r_index && stts->r_index_max)
+			stts_build_index(stts);
+	}
+	//jump to closest index point if after our cache
+	if (stts->r_index) {
+		GF_StblIndexPoint *pt = stbl_lookup_index_sample(stts->r_index, SampleNumber);
+		if (pt && (pt->first_sample > stts->r_FirstSampleInEntry)) {
+			i = stts->r_currentEntryIndex = pt->entry_idx;
+			stts->r_FirstSampleInEntry = pt->first_sample;
+			stts->r_CurrentDTS = pt->dts;
+		}
 	}
 
 	for (; i < count; i++) {
@@ -364,15 +581,12 @@ GF_Err stbl_SearchSAPs(GF_SampleTableBox *stbl, u32 SampleNumber, GF_ISOSAPType
 }
 
 //get the number of "ghost chunk" (implicit chunks described by an entry)
-void GetGhostNum(GF_StscEntry *ent, u32 EntryIndex, u32 count, GF_SampleTableBox *stbl)
+static u32 stbl_get_ghost_num(GF_StscEntry *ent, u32 EntryIndex, u32 count, GF_SampleTableBox *stbl)
 {
 	GF_StscEntry *nextEnt;
 	u32 ghostNum = 1;
 
-	if (!ent) {
-		stbl->SampleToChunk->ghostNumber = 0;
-		return;
-	}
+	if (!ent) return 0;
 
 	if (!ent->nextChunk) {
 		if (EntryIndex+1 == count) {
@@ -392,7 +606,50 @@ void GetGhostNum(GF_StscEntry *ent, u32 EntryIndex, u32 count, GF_SampleTableBox
 	} else {
 		ghostNum = (ent->nextChunk > ent->firstChunk) ? (ent->nextChunk - ent->firstChunk) : 1;
 	}
-	stbl->SampleToChunk->ghostNumber = ghostNum;
+	return ghostNum;
+}
+
+void GetGhostNum(GF_StscEntry *ent, u32 EntryIndex, u32 count, GF_SampleTableBox *stbl)
+{
+	stbl->SampleToChunk->ghostNumber = stbl_get_ghost_num(ent, EntryIndex, count, stbl);
+}
+
+static void stsc_build_index(GF_SampleTableBox *stbl)
+{
+	u32 i, step;
+	u64 first_sample = 1;
+	GF_SampleToChunkBox *stsc = stbl->SampleToChunk;
+	GF_StblLookupIndex *index = stbl_lookup_index_new(stsc->nb_entries, stsc->r_index_max, &step);
+	if (!index) return;
+
+	for (i=0; i<stsc->nb_entries; i++) {
+		GF_StscEntry *ent = &stsc->entries[i];
+		if (first_sample > 0xFFFFFFFFUL) break;
+		if (!(i % step))
+			stbl_lookup_index_add(index, i, (u32) first_sample, 0);
+		first_sample += (u64) stbl_get_ghost_num(ent, i, stsc->nb_entries, stbl) * ent->samplesPerChunk;
+	}
+	stsc->r_index = index;
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[iso file] Built stsc lookup index with %d points for %d entries\n", index->nb_points, stsc->nb_entries));
+}
+
+void stbl_set_lookup_index(GF_SampleTableBox *stbl, u32 max_points)
+{
+	if (stbl->TimeToSample) {
+		stbl_lookup_index_del(stbl->TimeToSample->r_index);
+		stbl->TimeToSample->r_index = NULL;
+		stbl->TimeToSample->r_index_max = max_points;
+	}
+	if (stbl->CompositionOffset) {
+		stbl_lookup_index_del(stbl->CompositionOffset->r_index);
+		stbl->CompositionOffset->r_index = NULL;
+		stbl->CompositionOffset->r_index_max = max_points;
+	}
+	if (stbl->SampleToChunk) {
+		stbl_lookup_index_del(stbl->SampleToChunk->r_index);
+		stbl->SampleToChunk->r_index = NULL;
+		stbl->SampleToChunk->r_index_max = max_points;
+	}
 }
 
 //Get the offset, descIndex and chunkNumber of a sample...
@@ -400,8 +657,6 @@ GF_Err stbl_GetSampleInfos(GF_SampleTableBox *stbl, u32 sampleNumber, u64 *offse
 {
 	GF_Err e;
 	u32 i, k, offsetInChunk, size, chunk_num;
-	GF_ChunkOffsetBox *stco;
-	GF_ChunkLargeOffsetBox *co64;
 	GF_StscEntry *ent;
 
 	(*offset) = 0;
@@ -409,6 +664,7 @@ GF_Err stbl_GetSampleInfos(GF_SampleTableBox *stbl, u32 sampleNumber, u64 *offse
 	if (out_ent) (*out_ent) = NULL;
 	if (!stbl || !sampleNumber) return GF_BAD_PARAM;
 	if (!stbl->ChunkOffset || !stbl->SampleToChunk || !stbl->SampleSize) return GF_ISOM_INVALID_FILE;
+	STBL_CHECK_INDEX(stbl->SampleToChunk)
 
 	if (stbl->SampleSize && stbl->SampleToChunk->nb_entries == stbl->SampleSize->sampleCount) {
 		ent = &stbl->SampleToChunk->entries[sampleNumber-1];
@@ -416,20 +672,7 @@ GF_Err stbl_GetSampleInfos(GF_SampleTableBox *stbl, u32 sampleNumber, u64 *offse
 		(*descIndex) = ent->sampleDescriptionIndex;
 		(*chunkNumber) = sampleNumber;
 		if (out_ent) *out_ent = ent;
-		if ( stbl->ChunkOffset->type == GF_ISOM_BOX_TYPE_STCO) {
-			stco = (GF_ChunkOffsetBox *)stbl->ChunkOffset;
-			if (!stco->offsets) return GF_ISOM_INVALID_FILE;
-			if (stco->nb_entries < sampleNumber) return GF_ISOM_INVALID_FILE;
-
-			(*offset) = (u64) stco->offsets[sampleNumber - 1];
-		} else {
-			co64 = (GF_ChunkLargeOffsetBox *)stbl->ChunkOffset;
-			if (!co64->offsets) return GF_ISOM_INVALID_FILE;
-			if (co64->nb_entries < sampleNumber) return GF_ISOM_INVALID_FILE;
-
-			(*offset) = co64->offsets[sampleNumber - 1];
-		}
-		return GF_OK;
+		return stbl_GetChunkOffset(stbl->ChunkOffset, sampleNumber, offset);
 	}
 
 	//check our cache: if desired sample is at or above current cache entry, start from here
@@ -451,6 +694,21 @@ GF_Err stbl_GetSampleInfos(GF_SampleTableBox *stbl, u32 sampleNumber, u64 *offse
 		ent = &stbl->SampleToChunk->entries[0];
 		GetGhostNum(ent, 0, stbl->SampleToChunk->nb_entries, stbl);
 		k = stbl->SampleToChunk->currentChunk;
+		//cache miss on seek, build lookup index
+		if ((sampleNumber>1) && !stbl->SampleToChunk->r_index && stbl->SampleToChunk->r_index_max)
+			stsc_build_index(stbl);
+	}
+	//jump to closest index point if after our cache
+	if (stbl->SampleToChunk->r_index) {
+		GF_StblIndexPoint *pt = stbl_lookup_index_sample(stbl->SampleToChunk->r_index, sampleNumber);
+		if (pt && (pt->first_sample > stbl->SampleToChunk->firstSampleInCurrentChunk)) {
+			i = stbl->SampleToChunk->currentIndex = pt->entry_idx;
+			stbl->SampleToChunk->currentChunk = 1;
+			stbl->SampleToChunk->firstSampleInCurrentChunk = pt->first_sample;
+			ent = &stbl->SampleToChunk->entries[i];
+			GetGhostNum(ent, i, stbl->SampleToChunk->nb_entries, stbl);
+			k = 1;
+		}
 	}
 
 	//first get the chunk
@@ -530,15 +788,9 @@ sample_found:
 	}
 	//OK, that's the size of our offset in the chunk
 	//now get the chunk
-	if ( stbl->ChunkOffset->type == GF_ISOM_BOX_TYPE_STCO) {
-		stco = (GF_ChunkOffsetBox *)stbl->ChunkOffset;
-		if (stco->nb_entries < (*chunkNumber) ) return GF_ISOM_INVALID_FILE;
-		(*offset) = (u64) stco->offsets[(*chunkNumber) - 1] + (u64) offsetInChunk;
-	} else {
-		co64 = (GF_ChunkLargeOffsetBox *)stbl->ChunkOffset;
-		if (co64->nb_entries < (*chunkNumber) ) return GF_ISOM_INVALID_FILE;
-		(*offset) = co64->offsets[(*chunkNumber) - 1] + (u64) offsetInChunk;
-	}
+	e = stbl_GetChunkOffset(stbl->ChunkOffset, *chunkNumber, offset);
+	if (e) return e;
+	(*offset) += (u64) offsetInChunk;
 	return GF_OK;
 }
 
@@ -402,6 +402,112 @@ GF_Err stbl_unpackCTS(GF_SampleTableBox *stbl)
 	return GF_OK;
 }
 
+GF_Err stbl_DeltaStoreAppend(GF_StblDeltaStore **_ds, u64 value)
+{
+	s64 delta;
+	u64 v;
+	GF_StblDeltaStore *ds = *_ds;
+	if (!ds) {
+		GF_SAFEALLOC(ds, GF_StblDeltaStore);
+		if (!ds) return GF_OUT_OF_MEM;
+		*_ds = ds;
+	}
+	//first value of a block is coded as delta to 0
+	if (!(ds->nb_entries % GF_ISOM_STBL_DELTA_BLOCK)) {
+		if (ds->nb_blocks == ds->alloc_blocks) {
+			ALLOC_INC(ds->alloc_blocks);
+			ds->blocks = (u32*)gf_realloc(ds->blocks, sizeof(u32) * ds->alloc_blocks);
+			if (!ds->blocks) return GF_OUT_OF_MEM;
+		}
+		ds->blocks[ds->nb_blocks] = ds->size;
+		ds->nb_blocks++;
+		ds->last_value = 0;
+	}
+	//a 64 bit varint takes at most 10 bytes
+	if (ds->size + 10 > ds->alloc) {
+		ALLOC_INC(ds->alloc);
+		ds->data = (u8*)gf_realloc(ds->data, sizeof(u8) * ds->alloc);
+		if (!ds->data) return GF_OUT_OF_MEM;
+	}
+	//zigzag coding of the delta, so that small negative deltas take as few bytes as positive ones
+	delta = (s64) (value - ds->last_value);
+	v = ((u64) delta << 1) ^ (u64) (delta >> 63);
+	while (v >= 0x80) {
+		ds->data[ds->size++] = (u8) (v | 0x80);
+		v >>= 7;
+	}
+	ds->data[ds->size++] = (u8) v;
+	ds->last_value = value;
+	ds->nb_entries++;
+	return GF_OK;
+}
+
+GF_Err stbl_ExpandSizes(GF_SampleSizeBox *stsz)
+{
+	u32 i, nb_plain;
+	GF_StblDeltaStore *ds = stsz ? stsz->w_deltas : NULL;
+	if (!ds) return GF_OK;
+
+	nb_plain = stsz->sampleCount - ds->nb_entries;
+	if (!stsz->alloc_size) stsz->alloc_size = nb_plain;
+	if (stsz->alloc_size < stsz->sampleCount) {
+		//keep amortized growth in case appends and edits alternate
+		ALLOC_INC(stsz->alloc_size);
+		if (stsz->alloc_size < stsz->sampleCount) stsz->alloc_size = stsz->sampleCount;
+		stsz->sizes = (u32*)gf_realloc(stsz->sizes, sizeof(u32) * stsz->alloc_size);
+		if (!stsz->sizes) return GF_OUT_OF_MEM;
+	}
+	for (i=0; i<ds->nb_entries; i++) {
+		stsz->sizes[nb_plain + i] = (u32) stbl_DeltaStoreGet(ds, i);
+	}
+	stbl_DeltaStoreDel(ds);
+	stsz->w_deltas = NULL;
+	return GF_OK;
+}
+
+GF_Err stbl_ExpandChunkOffsets(GF_Box *a)
+{
+	u32 i, nb_plain;
+	GF_StblDeltaStore *ds;
+	if (!a) return GF_OK;
+
+	if (a->type == GF_ISOM_BOX_TYPE_STCO) {
+		GF_ChunkOffsetBox *stco = (GF_ChunkOffsetBox *)a;
+		ds = stco->w_deltas;
+		if (!ds) return GF_OK;
+		nb_plain = stco->nb_entries - ds->nb_entries;
+		if (!stco->alloc_size) stco->alloc_size = nb_plain;
+		if (stco->alloc_size < stco->nb_entries) {
+			ALLOC_INC(stco->alloc_size);
+			if (stco->alloc_size < stco->nb_entries) stco->alloc_size = stco->nb_entries;
+			stco->offsets = (u32*)gf_realloc(stco->offsets, sizeof(u32) * stco->alloc_size);
+			if (!stco->offsets) return GF_OUT_OF_MEM;
+		}
+		for (i=0; i<ds->nb_entries; i++) {
+			stco->offsets[nb_plain + i] = (u32) stbl_DeltaStoreGet(ds, i);
+		}
+		stco->w_deltas = NULL;
+	} else {
+		GF_ChunkLargeOffsetBox *co64 = (GF_ChunkLargeOffsetBox *)a;
+		ds = co64->w_deltas;
+		if (!ds) return GF_OK;
+		nb_plain = co64->nb_entries - ds->nb_entries;
+		if (!co64->alloc_size) co64->alloc_size = nb_plain;
+		if (co64->alloc_size < co64->nb_entries) {
+			ALLOC_INC(co64->alloc_size);
+			if (co64->alloc_size < co64->nb_entries) co64->alloc_size = co64->nb_entries;
+			co64->offsets = (u64*)gf_realloc(co64->offsets, sizeof(u64) * co64->alloc_size);
+			if (!co64->offsets) return GF_OUT_OF_MEM;
+		}
+		for (i=0; i<ds->nb_entries; i++) {
+			co64->offsets[nb_plain + i] = stbl_DeltaStoreGet(ds, i);
+		}
+		co64->w_deltas = NULL;
+	}
+	stbl_DeltaStoreDel(ds);
+	return GF_OK;
+}
+
 //add size
 GF_Err stbl_AddSize(GF_SampleSizeBox *stsz, u32 sampleNumber, u32 size, u32 nb_pack)
 {
@@ -457,17 +563,13 @@ GF_Err stbl_AddSize(GF_SampleSizeBox *stsz, u32 sampleNumber, u32 size, u32 nb_p
 	}
 
 
-	/*append*/
+	/*append: sizes are stored as deltas until the table is edited*/
 	if (stsz->sampleCount + 1 == sampleNumber) {
-		if (!stsz->alloc_size) stsz->alloc_size = stsz->sampleCount;
-		if (stsz->sampleCount == stsz->alloc_size) {
-			ALLOC_INC(stsz->alloc_size);
-			stsz->sizes = gf_realloc(stsz->sizes, sizeof(u32)*(stsz->alloc_size) );
-			if (!stsz->sizes) return GF_OUT_OF_MEM;
-			memset(&stsz->sizes[stsz->sampleCount], 0, sizeof(u32)*(stsz->alloc_size - stsz->sampleCount) );
-		}
-		stsz->sizes[stsz->sampleCount] = size;
+		GF_Err e = stbl_DeltaStoreAppend(&stsz->w_deltas, size);
+		if (e) return e;
 	} else {
+		GF_Err e = stbl_ExpandSizes(stsz);
+		if (e) return e;
 		newSizes = (u32*)gf_malloc(sizeof(u32)*(1 + stsz->sampleCount) );
 		if (!newSizes) return GF_OUT_OF_MEM;
 		k = 0;
@@ -709,7 +811,7 @@ GF_Err stbl_AddShadow(GF_ShadowSyncBox *stsh, u32 sampleNumber, u32 shadowNumber
 	}
 }
 
-//used in edit/write, where sampleNumber == chunkNumber
+//used in edit/write, where sampleNumber == chunkNumber unless chunks are appended in packed mode
 GF_Err stbl_AddChunkOffset(GF_MediaBox *mdia, u32 sampleNumber, u32 StreamDescIndex, u64 offset, u32 nb_pack)
 {
 	GF_SampleTableBox *stbl;
@@ -735,6 +837,28 @@ GF_Err stbl_AddChunkOffset(GF_MediaBox *mdia, u32 sampleNumber, u32 StreamDescIn
 		memset(&stsc->entries[stsc->nb_entries], 0, sizeof(GF_StscEntry)*(stsc->alloc_size-stsc->nb_entries) );
 	}
 	if (sampleNumber == stsc->w_lastSampleNumber + 1) {
+		u8 is_edited = (Media_IsSelfContained(mdia, StreamDescIndex)) ? 1 : 0;
+		ent = stsc->nb_entries ? &stsc->entries[stsc->nb_entries-1] : NULL;
+		//appending a chunk with the same layout as the last one: extend the chunk run of the last entry
+		//rather than adding one entry per chunk, this keeps stsc small when recording long sequences
+		if (ent && !mdia->mediaTrack->chunk_cache && (ent->samplesPerChunk == nb_pack) && (ent->sampleDescriptionIndex == StreamDescIndex)
+			&& (ent->isEdited == is_edited)
+			//last entry must end with the last chunk: single chunk entry (nextChunk set to firstChunk) or previously extended run
+			&& (((ent->nextChunk == ent->firstChunk) && (ent->firstChunk == stsc->w_lastChunkNumber)) || (ent->nextChunk == stsc->w_lastChunkNumber + 1))
+		) {
+			stsc->w_lastChunkNumber ++;
+			ent->nextChunk = stsc->w_lastChunkNumber + 1;
+			new_chunk_idx = stsc->w_lastChunkNumber;
+			stsc->w_lastSampleNumber = sampleNumber + nb_pack-1;
+
+			stsc->currentIndex = stsc->nb_entries-1;
+			stsc->firstSampleInCurrentChunk = sampleNumber;
+			stsc->currentChunk = new_chunk_idx - ent->firstChunk + 1;
+			stsc->ghostNumber = stsc->currentChunk;
+			//tables are no longer one chunk per sample, any further edit will have to unpack them
+			mdia->mediaTrack->is_unpacked = GF_FALSE;
+			goto add_offset;
+		}
 		ent = &stsc->entries[stsc->nb_entries];
 		stsc->w_lastChunkNumber ++;
 		ent->firstChunk = stsc->w_lastChunkNumber;
@@ -806,8 +930,8 @@ GF_Err stbl_AddChunkOffset(GF_MediaBox *mdia, u32 sampleNumber, u32 StreamDescIn
 
 		stbl->SampleToChunk->currentIndex = stsc->nb_entries-1;
 		stbl->SampleToChunk->firstSampleInCurrentChunk = sampleNumber;
-		//write - edit mode: sample number = chunk number
-		stbl->SampleToChunk->currentChunk = stsc->w_lastChunkNumber;
+		//new entry, first chunk in entry
+		stbl->SampleToChunk->currentChunk = 1;
 		stbl->SampleToChunk->ghostNumber = 1;
 	} else {
 		/*offset remaining entries*/
@@ -818,12 +942,15 @@ GF_Err stbl_AddChunkOffset(GF_MediaBox *mdia, u32 sampleNumber, u32 StreamDescIn
 		}
 	}
 
+add_offset:
 	//add the offset to the chunk...
 	//and we change our offset
 	if (stbl->ChunkOffset->type == GF_ISOM_BOX_TYPE_STCO) {
 		stco = (GF_ChunkOffsetBox *)stbl->ChunkOffset;
 		//if the new offset is a large one, we have to rewrite our table entry by entry (32->64 bit conv)...
 		if (offset > 0xFFFFFFFF) {
+			GF_Err e = stbl_ExpandChunkOffsets(stbl->ChunkOffset);
+			if (e) return e;
 			co64 = (GF_ChunkLargeOffsetBox *) gf_isom_box_new_parent(&stbl->child_boxes, GF_ISOM_BOX_TYPE_CO64);
 			if (!co64) return GF_OUT_OF_MEM;
 			co64->nb_entries = stco->nb_entries + 1;
@@ -844,17 +971,13 @@ GF_Err stbl_AddChunkOffset(GF_MediaBox *mdia, u32 sampleNumber, u32 StreamDescIn
 		} else {
 			//no, we can use this one.
 			if (new_chunk_idx > stco->nb_entries) {
-				if (!stco->alloc_size) stco->alloc_size = stco->nb_entries;
-				if (stco->nb_entries == stco->alloc_size) {
-					ALLOC_INC(stco->alloc_size);
-					stco->offsets = (u32*)gf_realloc(stco->offsets, sizeof(u32) * stco->alloc_size);
-					if (!stco->offsets) return GF_OUT_OF_MEM;
-					memset(&stco->offsets[stco->nb_entries], 0, sizeof(u32) * (stco->alloc_size-stco->nb_entries) );
-				}
-				stco->offsets[stco->nb_entries] = (u32) offset;
+				GF_Err e = stbl_DeltaStoreAppend(&stco->w_deltas, offset);
+				if (e) return e;
 				stco->nb_entries += 1;
 			} else {
 				//nope. we're inserting
+				GF_Err e = stbl_ExpandChunkOffsets(stbl->ChunkOffset);
+				if (e) return e;
 				newOff = (u32*)gf_malloc(sizeof(u32) * (stco->nb_entries + 1));
 				if (!newOff) return GF_OUT_OF_MEM;
 				k=0;
@@ -874,18 +997,14 @@ GF_Err stbl_AddChunkOffset(GF_MediaBox *mdia, u32 sampleNumber, u32 StreamDescIn
 	} else {
 		//use large offset...
 		co64 = (GF_ChunkLargeOffsetBox *)stbl->ChunkOffset;
-		if (sampleNumber > co64->nb_entries) {
-			if (!co64->alloc_size) co64->alloc_size = co64->nb_entries;
-			if (co64->nb_entries == co64->alloc_size) {
-				ALLOC_INC(co64->alloc_size);
-				co64->offsets = (u64*)gf_realloc(co64->offsets, sizeof(u64) * co64->alloc_size);
-				if (!co64->offsets) return GF_OUT_OF_MEM;
-				memset(&co64->offsets[co64->nb_entries], 0, sizeof(u64) * (co64->alloc_size - co64->nb_entries) );
-			}
-			co64->offsets[co64->nb_entries] = offset;
+		if (new_chunk_idx > co64->nb_entries) {
+			GF_Err e = stbl_DeltaStoreAppend(&co64->w_deltas, offset);
+			if (e) return e;
 			co64->nb_entries += 1;
 		} else {
 			//nope. we're inserting
+			GF_Err e = stbl_ExpandChunkOffsets(stbl->ChunkOffset);
+			if (e) return e;
 			newLarge = (u64*)gf_malloc(sizeof(u64) * (co64->nb_entries + 1));
 			if (!newLarge) return GF_OUT_OF_MEM;
 			k=0;
@@ -911,12 +1030,15 @@ GF_Err stbl_AddChunkOffset(GF_MediaBox *mdia, u32 sampleNumber, u32 StreamDescIn
 
 GF_Err stbl_SetChunkOffset(GF_MediaBox *mdia, u32 sampleNumber, u64 offset)
 {
+	GF_Err e;
 	GF_StscEntry *ent;
 	u32 i;
 	GF_ChunkLargeOffsetBox *co64;
 	GF_SampleTableBox *stbl = mdia->information->sampleTable;
 
 	if (!sampleNumber || !stbl) return GF_BAD_PARAM;
+	e = stbl_ExpandChunkOffsets(stbl->ChunkOffset);
+	if (e) return e;
 
 	ent = &stbl->SampleToChunk->entries[sampleNumber - 1];
 
@@ -973,7 +1095,10 @@ GF_Err stbl_SetSampleCTS(GF_SampleTableBox *stbl, u32 sampleNumber, s32 offset)
 GF_Err stbl_SetSampleSize(GF_SampleSizeBox *stsz, u32 SampleNumber, u32 size)
 {
 	u32 i;
+	GF_Err e;
 	if (!SampleNumber || (stsz->sampleCount < SampleNumber)) return GF_BAD_PARAM;
+	e = stbl_ExpandSizes(stsz);
+	if (e) return e;
 
 	if (stsz->sampleSize) {
 		if (stsz->sampleSize == size) return GF_OK;
@@ -1221,9 +1346,12 @@ GF_Err stbl_RemoveCTS(GF_SampleTableBox *stbl, u32 sampleNumber, u32 nb_samples)
 
 GF_Err stbl_RemoveSize(GF_SampleTableBox *stbl, u32 sampleNumber, u32 nb_samples)
 {
+	GF_Err e;
 	GF_SampleSizeBox *stsz = stbl->SampleSize;
 
 	if ((nb_samples>1) && (sampleNumber>1)) return GF_BAD_PARAM;
+	e = stbl_ExpandSizes(stsz);
+	if (e) return e;
 	//last sample
 	if (stsz->sampleCount == 1) {
 		if (stsz->sizes) gf_free(stsz->sizes);
@@ -1251,10 +1379,13 @@ GF_Err stbl_RemoveSize(GF_SampleTableBox *stbl, u32 sampleNumber, u32 nb_samples
 GF_Err stbl_RemoveChunk(GF_SampleTableBox *stbl, u32 sampleNumber, u32 nb_samples)
 {
 	u32 i;
+	GF_Err e;
 	GF_SampleToChunkBox *stsc = stbl->SampleToChunk;
 
 	if ((nb_samples>1) && (sampleNumber>1))
 		return GF_BAD_PARAM;
+	e = stbl_ExpandChunkOffsets(stbl->ChunkOffset);
+	if (e) return e;
 	
 	//raw audio or constant sample size and dur
 	if (stsc->nb_entries < stbl->SampleSize->sampleCount) {
@@ -1568,7 +1699,10 @@ GF_Err stbl_RemoveSampleGroup(GF_SampleTableBox *stbl, u32 SampleNumber)
 GF_Err stbl_SampleSizeAppend(GF_SampleSizeBox *stsz, u32 data_size)
 {
 	u32 i;
+	GF_Err e;
 	if (!stsz || !stsz->sampleCount) return GF_BAD_PARAM;
+	e = stbl_ExpandSizes(stsz);
+	if (e) return e;
 
 	//we must realloc our table
 	if (stsz->sampleSize) {
@@ -1631,7 +1765,10 @@ GF_Err stbl_AppendTime(GF_SampleTableBox *stbl, u32 duration, u32 nb_pack)
 GF_Err stbl_AppendSize(GF_SampleTableBox *stbl, u32 size, u32 nb_pack)
 {
 	u32 i;
+	GF_Err e;
 	CHECK_PACK(GF_ISOM_INVALID_FILE)
+	e = stbl_ExpandSizes(stbl->SampleSize);
+	if (e) return e;
 
 	if (!stbl->SampleSize->sampleCount) {
 		stbl->SampleSize->sampleSize = size;
@@ -1677,7 +1814,9 @@ GF_Err stbl_AppendChunk(GF_SampleTableBox *stbl, u64 offset)
 	GF_ChunkOffsetBox *stco;
 	GF_ChunkLargeOffsetBox *co64;
 	u32 i;
-	
+	GF_Err e = stbl_ExpandChunkOffsets(stbl->ChunkOffset);
+	if (e) return e;
+
 	//we may have to convert the table...
 	if (stbl->ChunkOffset->type==GF_ISOM_BOX_TYPE_STCO) {
 		stco = (GF_ChunkOffsetBox *)stbl->ChunkOffset;
@@ -1975,11 +2114,13 @@ GF_Err stbl_UnpackOffsets(GF_SampleTableBox *stbl)
 	//OK write our two tables...
 	ent = NULL;
 	for (i = 0; i < stbl->SampleSize->sampleCount; i++) {
+		GF_StscEntry *src_ent;
 		//get the data info for the sample
-		e = stbl_GetSampleInfos(stbl, i+1, &dataOffset, &chunkNumber, &sampleDescIndex, NULL);
+		e = stbl_GetSampleInfos(stbl, i+1, &dataOffset, &chunkNumber, &sampleDescIndex, &src_ent);
 		if (e) goto err_exit;
 		ent = &stsc_tmp->entries[i];
-		ent->isEdited = 0;
+		//keep track of samples added in edit mode, tables may have been packed while appending
+		ent->isEdited = src_ent ? src_ent->isEdited : 0;
 		ent->sampleDescriptionIndex = sampleDescIndex;
 		//here's the trick: each sample is in ONE chunk
 		ent->firstChunk = i+1;
@@ -2178,6 +2319,7 @@ GF_Err gf_isom_refresh_size_info(GF_ISOFile *file, u32 trackNumber)
 
 	stsz = trak->Media->information->sampleTable->SampleSize;
 	if (stsz->sampleSize || !stsz->sampleCount) return GF_OK;
+	if (stbl_ExpandSizes(stsz) != GF_OK) return GF_OUT_OF_MEM;
 
 	size = stsz->sizes[0];
 	for (i=1; i<stsz->sampleCount; i++) {
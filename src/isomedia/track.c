@@ -35,16 +35,24 @@ GF_TrackBox *GetTrackbyID(GF_MovieBox *moov, GF_ISOTrackID TrackID)
 	if (!moov) return NULL;
 	i=0;
 	while ((trak = (GF_TrackBox *)gf_list_enum(moov->trackList, &i))) {
-		if (trak->Header->trackID == TrackID) return trak;
+		if (trak->Header->trackID == TrackID) {
+			GF_Err e = gf_isom_load_track_tables(trak);
+			if (e && moov->mov) moov->mov->LastError = e;
+			return trak;
+		}
 	}
 	return NULL;
 }
 
 GF_TrackBox *gf_isom_get_track(GF_MovieBox *moov, u32 trackNumber)
 {
+	GF_Err e;
 	GF_TrackBox *trak;
 	if (!moov || !trackNumber || (trackNumber > gf_list_count(moov->trackList))) return NULL;
 	trak = (GF_TrackBox*)gf_list_get(moov->trackList, trackNumber - 1);
+	//load sample tables on first access
+	e = gf_isom_load_track_tables(trak);
+	if (e && moov->mov) moov->mov->LastError = e;
 	return trak;
 
 }
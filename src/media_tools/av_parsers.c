@@ -4894,44 +4894,104 @@ u32 gf_media_nalu_next_start_code_bs(GF_BitStream *bs)
 	return gf_media_nalu_locate_start_code_bs(bs, 0);
 }
 
-GF_EXPORT
-u32 gf_media_nalu_next_start_code(const u8 *data, u32 data_len, u32 *sc_size)
+#if defined(GPAC_64_BITS) && defined(__SSE2__)
+#include <emmintrin.h>
+#define GPAC_NALU_SCAN_SSE2
+#endif
+
+enum
 {
-	u32 avail = data_len;
-	const u8 *cur = data;
+	//00 00 01
+	NALU_SCAN_START_CODE=0,
+	//00 00 0x with x<4: emulation prevention byte insertion point
+	NALU_SCAN_EPB_ADD,
+	//00 00 03 0x with x<4: emulation prevention byte
+	NALU_SCAN_EPB_REMOVE,
+};
 
-	while (cur) {
-		u32 v, bpos;
-		u8 *next_zero = memchr(cur, 0, avail);
-		if (!next_zero) return data_len;
+#define NALU_SCAN_MATCH(_d, _type) (!(_d)[0] && !(_d)[1] \
+	&& ((_type==NALU_SCAN_START_CODE) ? ((_d)[2]==1) : (_type==NALU_SCAN_EPB_ADD) ? ((_d)[2]<4) : (((_d)[2]==3) && ((_d)[3]<4))) )
 
-		v = 0xffffff00;
-		bpos = (u32)(next_zero - data) + 1;
-		while (1) {
-			u8 cval;
-			if (bpos == (u32)data_len)
-				return data_len;
-
-			cval = data[bpos];
-			v = ((v << 8) & 0xFFFFFF00) | ((u32)cval);
-			bpos++;
-			if (v == 0x00000001) {
-				*sc_size = 4;
-				return bpos - 4;
-			}
-			else if ((v & 0x00FFFFFF) == 0x00000001) {
-				*sc_size = 3;
-				return bpos - 3;
-			}
-			if (cval)
-				break;
+/*locates the first byte pattern of the given type, returns its position or len if not found
+zero-free regions, the vast majority of slice data, are skipped 16 (SSE2) or 8 bytes at a time*/
+static GFINLINE u32 nalu_scan(const u8 *data, u32 len, u32 type)
+{
+	u32 i = 0;
+	u32 pattern_len = (type==NALU_SCAN_EPB_REMOVE) ? 4 : 3;
+	if (len < pattern_len) return len;
+#ifdef GPAC_NALU_SCAN_SSE2
+	while (i + 15 + pattern_len <= len) {
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i three = _mm_set1_epi8(3);
+		__m128i c, m = _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (data + i)), zero),
+									 _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (data + i + 1)), zero));
+		u32 mask;
+		if (!_mm_movemask_epi8(m)) {
+			i += 16;
+			continue;
 		}
-		if (bpos >= data_len)
-			break;
-		cur = data + bpos;
-		avail = data_len - bpos;
+		c = _mm_loadu_si128((const __m128i *) (data + i + 2));
+		if (type==NALU_SCAN_START_CODE) {
+			m = _mm_and_si128(m, _mm_cmpeq_epi8(c, _mm_set1_epi8(1)));
+		} else if (type==NALU_SCAN_EPB_ADD) {
+			m = _mm_and_si128(m, _mm_cmpeq_epi8(_mm_max_epu8(c, three), three));
+		} else {
+			__m128i d = _mm_loadu_si128((const __m128i *) (data + i + 3));
+			m = _mm_and_si128(m, _mm_cmpeq_epi8(c, three));
+			m = _mm_and_si128(m, _mm_cmpeq_epi8(_mm_max_epu8(d, three), three));
+		}
+		mask = (u32) _mm_movemask_epi8(m);
+		if (mask) return i + (u32) __builtin_ctz(mask);
+		i += 16;
+	}
+#else
+	//word at a time: skip 8 bytes if none of them is 0
+	while (i + 7 + pattern_len <= len) {
+		u64 v;
+		memcpy(&v, data + i, 8);
+		if ((v - 0x0101010101010101ULL) & ~v & 0x8080808080808080ULL) {
+			u32 j;
+			for (j=i; j<i+8; j++) {
+				if (NALU_SCAN_MATCH(data+j, type)) return j;
+			}
+		}
+		i += 8;
+	}
+#endif
+	for (; i + pattern_len <= len; i++) {
+		if (NALU_SCAN_MATCH(data+i, type)) return i;
+	}
+	return len;
+}
+
+/*returns the number of bytes that can be skipped by the emulation prevention state machines when no zero is pending:
+everything up to the zero run starting the next pattern*/
+static GFINLINE u32 nalu_scan_skip(const u8 *data, u32 len, u32 type)
+{
+	u32 pos = nalu_scan(data, len, type);
+	if (pos == len) return len;
+	while (pos && !data[pos-1])
+		pos--;
+	return pos;
+}
+
+//number of bytes processed bytewise after a short skip (dense patterns), or after a long one (isolated pattern)
+#define NALU_SCAN_DENSE_RUN		64
+#define NALU_SCAN_SPARSE_RUN	4
+
+GF_EXPORT
+u32 gf_media_nalu_next_start_code(const u8 *data, u32 data_len, u32 *sc_size)
+{
+	u32 pos = nalu_scan(data, data_len, NALU_SCAN_START_CODE);
+	if (pos == data_len) return data_len;
+
+	//4-byte start code if preceded by a zero
+	if (pos && !data[pos-1]) {
+		*sc_size = 4;
+		return pos - 1;
 	}
-	return data_len;
+	*sc_size = 3;
+	return pos;
 }
 
 Bool gf_media_avc_slice_is_intra(AVCState *avc)
@@ -4997,71 +5057,97 @@ static void avc_parse_hrd_parameters(GF_BitStream *bs, AVC_HRD *hrd)
 }
 
 /*returns the nal_size without emulation prevention bytes*/
+GF_EXPORT
 u32 gf_media_nalu_emulation_bytes_add_count(u8 *buffer, u32 nal_size)
 {
 	u32 i = 0, emulation_bytes_count = 0;
 	u8 num_zero = 0;
 
 	while (i < nal_size) {
-		/*ISO 14496-10: "Within the NAL unit, any four-byte sequence that starts with 0x000003
-		other than the following sequences shall not occur at any byte-aligned position:
-		\96 0x00000300
-		\96 0x00000301
-		\96 0x00000302
-		\96 0x00000303"
-		*/
-		if (num_zero == 2 && (u8)buffer[i] < 0x04) {
-			/*emulation code found*/
-			num_zero = 0;
-			emulation_bytes_count++;
-			if (!buffer[i])
-				num_zero = 1;
-		}
-		else {
-			if (!buffer[i])
-				num_zero++;
-			else
+		u32 end = NALU_SCAN_DENSE_RUN;
+		//no pending zero, jump to next insertion point
+		if (!num_zero) {
+			u32 skip = nalu_scan_skip(buffer + i, nal_size - i, NALU_SCAN_EPB_ADD);
+			i += skip;
+			if (i >= nal_size) break;
+			if (skip >= 16) end = NALU_SCAN_SPARSE_RUN;
+		}
+		end = MIN(i + end, nal_size);
+		for (; i < end; i++) {
+			/*ISO 14496-10: "Within the NAL unit, any four-byte sequence that starts with 0x000003
+			other than the following sequences shall not occur at any byte-aligned position:
+			\96 0x00000300
+			\96 0x00000301
+			\96 0x00000302
+			\96 0x00000303"
+			*/
+			if (num_zero == 2 && (u8)buffer[i] < 0x04) {
+				/*emulation code found*/
 				num_zero = 0;
+				emulation_bytes_count++;
+				if (!buffer[i])
+					num_zero = 1;
+			}
+			else {
+				if (!buffer[i])
+					num_zero++;
+				else
+					num_zero = 0;
+			}
 		}
-		i++;
 	}
 	return emulation_bytes_count;
 }
 
+GF_EXPORT
 u32 gf_media_nalu_add_emulation_bytes(const u8 *buffer_src, u8 *buffer_dst, u32 nal_size)
 {
 	u32 i = 0, emulation_bytes_count = 0;
 	u8 num_zero = 0;
 
 	while (i < nal_size) {
-		/*ISO 14496-10: "Within the NAL unit, any four-byte sequence that starts with 0x000003
-		other than the following sequences shall not occur at any byte-aligned position:
-		0x00000300
-		0x00000301
-		0x00000302
-		0x00000303"
-		*/
-		if (num_zero == 2 && (u8)buffer_src[i] < 0x04) {
-			/*add emulation code*/
-			num_zero = 0;
-			buffer_dst[i + emulation_bytes_count] = 0x03;
-			emulation_bytes_count++;
-			if (!buffer_src[i])
-				num_zero = 1;
-		}
-		else {
-			if (!buffer_src[i])
-				num_zero++;
-			else
+		u32 end = NALU_SCAN_DENSE_RUN;
+		//no pending zero, copy up to next insertion point
+		if (!num_zero) {
+			u32 skip = nalu_scan_skip(buffer_src + i, nal_size - i, NALU_SCAN_EPB_ADD);
+			if (skip) {
+				memcpy(buffer_dst + i + emulation_bytes_count, buffer_src + i, skip);
+				i += skip;
+				if (i >= nal_size) break;
+			}
+			if (skip >= 16) end = NALU_SCAN_SPARSE_RUN;
+		}
+		end = MIN(i + end, nal_size);
+		for (; i < end; i++) {
+			/*ISO 14496-10: "Within the NAL unit, any four-byte sequence that starts with 0x000003
+			other than the following sequences shall not occur at any byte-aligned position:
+			0x00000300
+			0x00000301
+			0x00000302
+			0x00000303"
+			*/
+			if (num_zero == 2 && (u8)buffer_src[i] < 0x04) {
+				/*add emulation code*/
 				num_zero = 0;
+				buffer_dst[i + emulation_bytes_count] = 0x03;
+				emulation_bytes_count++;
+				if (!buffer_src[i])
+					num_zero = 1;
+			}
+			else {
+				if (!buffer_src[i])
+					num_zero++;
+				else
+					num_zero = 0;
+			}
+			buffer_dst[i + emulation_bytes_count] = buffer_src[i];
 		}
-		buffer_dst[i + emulation_bytes_count] = buffer_src[i];
-		i++;
 	}
 	return nal_size + emulation_bytes_count;
 }
 
 /*returns the nal_size without emulation prevention bytes*/
+GF_EXPORT
 u32 gf_media_nalu_emulation_bytes_remove_count(const u8 *buffer, u32 nal_size)
 {
 	u32 i = 0, emulation_bytes_count = 0;
@@ -5070,30 +5156,41 @@ u32 gf_media_nalu_emulation_bytes_remove_count(const u8 *buffer, u32 nal_size)
 
 	while (i < nal_size)
 	{
-		/*ISO 14496-10: "Within the NAL unit, any four-byte sequence that starts with 0x000003
-		  other than the following sequences shall not occur at any byte-aligned position:
-		  \96 0x00000300
-		  \96 0x00000301
-		  \96 0x00000302
-		  \96 0x00000303"
-		*/
-		if (num_zero == 2
-			&& buffer[i] == 0x03
-			&& i + 1 < nal_size /*next byte is readable*/
-			&& (u8)buffer[i + 1] < 0x04)
-		{
-			/*emulation code found*/
-			num_zero = 0;
-			emulation_bytes_count++;
-			i++;
-		}
+		u32 end = NALU_SCAN_DENSE_RUN;
+		//no pending zero, jump to next emulation prevention byte
+		if (!num_zero) {
+			u32 skip = nalu_scan_skip(buffer + i, nal_size - i, NALU_SCAN_EPB_REMOVE);
+			i += skip;
+			if (i >= nal_size) break;
+			if (skip >= 16) end = NALU_SCAN_SPARSE_RUN;
+		}
+		end = MIN(i + end, nal_size);
+		while (i < end) {
+			/*ISO 14496-10: "Within the NAL unit, any four-byte sequence that starts with 0x000003
+			  other than the following sequences shall not occur at any byte-aligned position:
+			  \96 0x00000300
+			  \96 0x00000301
+			  \96 0x00000302
+			  \96 0x00000303"
+			*/
+			if (num_zero == 2
+				&& buffer[i] == 0x03
+				&& i + 1 < nal_size /*next byte is readable*/
+				&& (u8)buffer[i + 1] < 0x04)
+			{
+				/*emulation code found*/
+				num_zero = 0;
+				emulation_bytes_count++;
+				i++;
+			}
 
-		if (!buffer[i])
-			num_zero++;
-		else
-			num_zero = 0;
+			if (!buffer[i])
+				num_zero++;
+			else
+				num_zero = 0;
 
-		i++;
+			i++;
+		}
 	}
 
 	return emulation_bytes_count;
@@ -5108,32 +5205,47 @@ u32 gf_media_nalu_remove_emulation_bytes(const u8 *buffer_src, u8 *buffer_dst, u
 
 	while (i < nal_size)
 	{
-		/*ISO 14496-10: "Within the NAL unit, any four-byte sequence that starts with 0x000003
-		  other than the following sequences shall not occur at any byte-aligned position:
-		  0x00000300
-		  0x00000301
-		  0x00000302
-		  0x00000303"
-		*/
-		if (num_zero == 2
-			&& buffer_src[i] == 0x03
-			&& i + 1 < nal_size /*next byte is readable*/
-			&& (u8)buffer_src[i + 1] < 0x04)
-		{
-			/*emulation code found*/
-			num_zero = 0;
-			emulation_bytes_count++;
-			i++;
-		}
+		u32 end = NALU_SCAN_DENSE_RUN;
+		//no pending zero, copy up to next emulation prevention byte - may be called inplace
+		if (!num_zero) {
+			u32 skip = nalu_scan_skip(buffer_src + i, nal_size - i, NALU_SCAN_EPB_REMOVE);
+			if (skip) {
+				if (emulation_bytes_count || (buffer_dst != buffer_src))
+					memmove(buffer_dst + i - emulation_bytes_count, buffer_src + i, skip);
+				i += skip;
+				if (i >= nal_size) break;
+			}
+			if (skip >= 16) end = NALU_SCAN_SPARSE_RUN;
+		}
+		end = MIN(i + end, nal_size);
+		while (i < end) {
+			/*ISO 14496-10: "Within the NAL unit, any four-byte sequence that starts with 0x000003
+			  other than the following sequences shall not occur at any byte-aligned position:
+			  0x00000300
+			  0x00000301
+			  0x00000302
+			  0x00000303"
+			*/
+			if (num_zero == 2
+				&& buffer_src[i] == 0x03
+				&& i + 1 < nal_size /*next byte is readable*/
+				&& (u8)buffer_src[i + 1] < 0x04)
+			{
+				/*emulation code found*/
+				num_zero = 0;
+				emulation_bytes_count++;
+				i++;
+			}
 
-		buffer_dst[i - emulation_bytes_count] = buffer_src[i];
+			buffer_dst[i - emulation_bytes_count] = buffer_src[i];
 
-		if (!buffer_src[i])
-			num_zero++;
-		else
-			num_zero = 0;
+			if (!buffer_src[i])
+				num_zero++;
+			else
+				num_zero = 0;
 
-		i++;
+			i++;
+		}
 	}
 
 	return nal_size - emulation_bytes_count;
@@ -2296,19 +2296,22 @@ static GF_Err gf_dash_update_manifest(GF_DashClient *dash)
 
 		/* It means we have to reparse the file ... */
 		/* parse the MPD */
-		mpd_parser = gf_xml_dom_new();
-		e = gf_xml_dom_parse(mpd_parser, local_url, NULL, NULL);
-		if (e != GF_OK) {
-			gf_xml_dom_del(mpd_parser);
-			GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[DASH] Error - cannot update playlist: error in XML parsing %s\n", gf_error_to_string(e)));
-			return GF_NON_COMPLIANT_BITSTREAM;
-		}
 		new_mpd = gf_mpd_new();
-		if (dash->is_smooth)
+		if (dash->is_smooth) {
+			mpd_parser = gf_xml_dom_new();
+			e = gf_xml_dom_parse(mpd_parser, local_url, NULL, NULL);
+			if (e != GF_OK) {
+				gf_xml_dom_del(mpd_parser);
+				gf_mpd_del(new_mpd);
+				GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[DASH] Error - cannot update playlist: error in XML parsing %s\n", gf_error_to_string(e)));
+				return GF_NON_COMPLIANT_BITSTREAM;
+			}
 			e = gf_mpd_init_smooth_from_dom(gf_xml_dom_get_root(mpd_parser), new_mpd, purl);
-		else
-			e = gf_mpd_init_from_dom(gf_xml_dom_get_root(mpd_parser), new_mpd, purl);
-		gf_xml_dom_del(mpd_parser);
+			gf_xml_dom_del(mpd_parser);
+		} else {
+			//SAX load, avoids building the full document tree (large SegmentTimelines) at each live update
+			e = gf_mpd_init_from_file(local_url, new_mpd, purl);
+		}
 		if (e) {
 			GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[DASH] Error - cannot update playlist: error in MPD creation %s\n", gf_error_to_string(e)));
 			gf_mpd_del(new_mpd);
@@ -7950,26 +7953,28 @@ GF_Err gf_dash_open(GF_DashClient *dash, const char *manifest_url)
 		GF_LOG(GF_LOG_DEBUG, GF_LOG_DASH, ("[DASH] parsing %s manifest %s\n", dash->is_smooth ? "SmoothStreaming" : "DASH-MPD", local_url));
 
 		/* parse the MPD */
-		mpd_parser = gf_xml_dom_new();
-		e = gf_xml_dom_parse(mpd_parser, local_url, NULL, NULL);
-
-		if (sep_cgi) sep_cgi[0] = '?';
-		if (sep_frag) sep_frag[0] = '#';
+		if (dash->is_smooth) {
+			mpd_parser = gf_xml_dom_new();
+			e = gf_xml_dom_parse(mpd_parser, local_url, NULL, NULL);
 
-		if (e != GF_OK) {
-			GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[DASH] Error - cannot connect service: MPD parsing problem %s\n", gf_xml_dom_get_error(mpd_parser) ));
-			gf_xml_dom_del(mpd_parser);
-			dash->dash_io->del(dash->dash_io, dash->mpd_dnload);
-			dash->mpd_dnload = NULL;
-			return GF_URL_ERROR;
-		}
+			if (sep_cgi) sep_cgi[0] = '?';
+			if (sep_frag) sep_frag[0] = '#';
 
-		if (dash->is_smooth) {
+			if (e != GF_OK) {
+				GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[DASH] Error - cannot connect service: MPD parsing problem %s\n", gf_xml_dom_get_error(mpd_parser) ));
+				gf_xml_dom_del(mpd_parser);
+				dash->dash_io->del(dash->dash_io, dash->mpd_dnload);
+				dash->mpd_dnload = NULL;
+				return GF_URL_ERROR;
+			}
 			e = gf_mpd_init_smooth_from_dom(gf_xml_dom_get_root(mpd_parser), dash->mpd, manifest_url);
+			gf_xml_dom_del(mpd_parser);
 		} else {
-			e = gf_mpd_init_from_dom(gf_xml_dom_get_root(mpd_parser), dash->mpd, manifest_url);
+			e = gf_mpd_init_from_file(local_url, dash->mpd, manifest_url);
+
+			if (sep_cgi) sep_cgi[0] = '?';
+			if (sep_frag) sep_frag[0] = '#';
 		}
-		gf_xml_dom_del(mpd_parser);
 
 		if (!e && dash->split_adaptation_set)
 			gf_mpd_split_adaptation_sets(dash->mpd);
@@ -1001,7 +1001,7 @@ void id3_write_size(GF_BitStream *bs, u32 len)
 	gf_bs_write_int(bs, size, 7);
 }
 
-static void id3_tag_create(u8 **input, u32 *len)
+static void id3_tag_create(u8 **input, u32 *len, Bool free_input)
 {
 	GF_BitStream *bs = gf_bs_new(NULL, 0, GF_BITSTREAM_WRITE);
 	gf_bs_write_u8(bs, 'I');
@@ -1018,11 +1018,23 @@ static void id3_tag_create(u8 **input, u32 *len)
 	gf_bs_write_u8(bs, 0);
 	gf_bs_write_u8(bs, 0);
 	gf_bs_write_data(bs, *input, *len);
-	gf_free(*input);
+	if (free_input) gf_free(*input);
 	gf_bs_get_content(bs, input, len);
 	gf_bs_del(bs);
 }
 
+/*PES has been sent, discard internal buffer and release payload dispatched without copy*/
+static void gf_m2ts_stream_discard_data(GF_M2TS_Mux_Stream *stream)
+{
+	if (stream->discard_data) gf_free(stream->curr_pck.data);
+	if (stream->ref_data) {
+		stream->ifce->input_ctrl(stream->ifce, GF_ESI_INPUT_DATA_RELEASE, stream->ref_data);
+		stream->ref_data = NULL;
+	}
+	stream->curr_pck.data = NULL;
+	stream->curr_pck.data_len = 0;
+}
+
 static Bool gf_m2ts_adjust_next_stream_time_for_pcr(GF_M2TS_Mux *muxer, GF_M2TS_Mux_Stream *stream)
 {
 	u32 pck_diff;
@@ -1139,7 +1151,12 @@ static u32 gf_m2ts_stream_process_pes(GF_M2TS_Mux *muxer, GF_M2TS_Mux_Stream *st
 		/*discard first packet*/
 		stream->pck_first = curr_pck->next;
 		gf_free(curr_pck);
-		stream->discard_data = GF_TRUE;
+		if (stream->curr_pck.flags & GF_ESI_DATA_NO_COPY) {
+			stream->discard_data = GF_FALSE;
+			stream->ref_data = stream->curr_pck.data;
+		} else {
+			stream->discard_data = GF_TRUE;
+		}
 
 		if (stream->mx) gf_mx_v(stream->mx);
 	}
@@ -1212,10 +1229,8 @@ static u32 gf_m2ts_stream_process_pes(GF_M2TS_Mux *muxer, GF_M2TS_Mux_Stream *st
 			GF_LOG(GF_LOG_INFO, GF_LOG_CONTAINER, ("[MPEG-2 TS Muxer] PID %d: Initializing PCR for program number %d: PCR %d - mux time %d:%09d\n", stream->pid, stream->program->number, stream->program->pcr_init_time, muxer->time.sec, muxer->time.nanosec));
 		} else {
 			/*PES has been sent, discard internal buffer*/
-			if (stream->discard_data) gf_free(stream->curr_pck.data);
+			gf_m2ts_stream_discard_data(stream);
 			if (stream->curr_pck.mpeg2_af_descriptors) gf_free(stream->curr_pck.mpeg2_af_descriptors);
-			stream->curr_pck.data = NULL;
-			stream->curr_pck.data_len = 0;
 			stream->curr_pck.mpeg2_af_descriptors = NULL;
 			stream->curr_pck.mpeg2_af_descriptors_size = 0;
 			stream->pck_offset = 0;
@@ -1244,9 +1259,7 @@ static u32 gf_m2ts_stream_process_pes(GF_M2TS_Mux *muxer, GF_M2TS_Mux_Stream *st
 
 		/*packet data is now copied in sections, discard it if not pull*/
 		if (!(stream->ifce->caps & GF_ESI_AU_PULL_CAP)) {
-			gf_free(stream->curr_pck.data);
-			stream->curr_pck.data = NULL;
-			stream->curr_pck.data_len = 0;
+			gf_m2ts_stream_discard_data(stream);
 			gf_free(stream->curr_pck.mpeg2_af_descriptors);
 			stream->curr_pck.mpeg2_af_descriptors = NULL;
 			stream->curr_pck.mpeg2_af_descriptors_size = 0;
@@ -1278,7 +1291,7 @@ static u32 gf_m2ts_stream_process_pes(GF_M2TS_Mux *muxer, GF_M2TS_Mux_Stream *st
 		gf_sl_packetize(stream->ifce->sl_config, &stream->sl_header, src_data, src_data_len, &stream->curr_pck.data, &stream->curr_pck.data_len);
 
 		/*discard src data*/
-		if (!(stream->ifce->caps & GF_ESI_AU_PULL_CAP)) {
+		if (stream->discard_data) {
 			gf_free(src_data);
 		}
 		GF_LOG(GF_LOG_INFO, GF_LOG_CONTAINER, ("[MPEG-2 TS Muxer] PID %d: Encapsulating MPEG-4 SL Data (%p - %p) on PES - SL Header size %d\n", stream->pid, src_data, stream->curr_pck.data, stream->curr_pck.data_len - src_data_len));
@@ -1339,7 +1352,7 @@ static u32 gf_m2ts_stream_process_pes(GF_M2TS_Mux *muxer, GF_M2TS_Mux_Stream *st
 		stream->reframe_overhead = stream->curr_pck.data_len;
 		gf_bs_write_data(bs, stream->curr_pck.data, stream->curr_pck.data_len);
 		gf_bs_align(bs);
-		gf_free(stream->curr_pck.data);
+		if (stream->discard_data) gf_free(stream->curr_pck.data);
 		gf_bs_get_content(bs, &stream->curr_pck.data, &stream->curr_pck.data_len);
 		gf_bs_del(bs);
 		stream->reframe_overhead = stream->curr_pck.data_len - stream->reframe_overhead;
@@ -1404,17 +1417,17 @@ static u32 gf_m2ts_stream_process_pes(GF_M2TS_Mux *muxer, GF_M2TS_Mux_Stream *st
 
 			gf_bs_write_data(bs, stream->curr_pck.data, stream->curr_pck.data_len);
 			gf_bs_align(bs);
-			gf_free(stream->curr_pck.data);
+			if (stream->discard_data) gf_free(stream->curr_pck.data);
 			gf_bs_get_content(bs, &stream->curr_pck.data, &stream->curr_pck.data_len);
 			gf_bs_del(bs);
+			/*since we reallocated the packet data buffer, force a discard in pull mode*/
+			stream->discard_data = GF_TRUE;
 		}
-		/*since we reallocated the packet data buffer, force a discard in pull mode*/
-		stream->discard_data = GF_TRUE;
 		break;
 	case GF_M2TS_METADATA_PES:
 	case GF_M2TS_METADATA_ID3_HLS:
 	{
-		id3_tag_create(&stream->curr_pck.data, &stream->curr_pck.data_len);
+		id3_tag_create(&stream->curr_pck.data, &stream->curr_pck.data_len, stream->discard_data);
 		stream->discard_data = GF_TRUE;
 	}
 		break;
@@ -2050,9 +2063,7 @@ void gf_m2ts_mux_pes_get_next_packet(GF_M2TS_Mux_Stream *stream, char *packet)
 		}
 
 		/*PES has been sent, discard internal buffer*/
-		if (stream->discard_data) gf_free(stream->curr_pck.data);
-		stream->curr_pck.data = NULL;
-		stream->curr_pck.data_len = 0;
+		gf_m2ts_stream_discard_data(stream);
 		if (stream->curr_pck.mpeg2_af_descriptors) gf_free(stream->curr_pck.mpeg2_af_descriptors);
 		stream->curr_pck.mpeg2_af_descriptors = NULL;
 		stream->curr_pck.mpeg2_af_descriptors_size = 0;
@@ -2104,9 +2115,7 @@ void gf_m2ts_mux_pes_get_next_packet(GF_M2TS_Mux_Stream *stream, char *packet)
 				if (stream->pck_offset == stream->curr_pck.data_len) {
 					assert(!remain || (remain>=stream->min_bytes_copy_from_next));
 					/*PES has been sent, discard internal buffer*/
-					if (stream->discard_data) gf_free(stream->curr_pck.data);
-					stream->curr_pck.data = NULL;
-					stream->curr_pck.data_len = 0;
+					gf_m2ts_stream_discard_data(stream);
 					if (stream->curr_pck.mpeg2_af_descriptors) gf_free(stream->curr_pck.mpeg2_af_descriptors);
 					stream->curr_pck.mpeg2_af_descriptors = NULL;
 					stream->curr_pck.mpeg2_af_descriptors_size = 0;
@@ -2180,12 +2189,22 @@ GF_Err gf_m2ts_output_ctrl(GF_ESInterface *_self, u32 ctrl_type, void *param)
 
 		stream->force_new = (esi_pck->flags & GF_ESI_DATA_AU_END) ? GF_TRUE : GF_FALSE;
 
-		stream->pck_reassembler->data = (char*)gf_realloc(stream->pck_reassembler->data , sizeof(char)*(stream->pck_reassembler->data_len+esi_pck->data_len) );
-		if (esi_pck->data_len)
-			memcpy(stream->pck_reassembler->data + stream->pck_reassembler->data_len, esi_pck->data, esi_pck->data_len);
-		stream->pck_reassembler->data_len += esi_pck->data_len;
+		//complete AU dispatched without copy, use its payload as is
+		if ((esi_pck->flags & GF_ESI_DATA_NO_COPY) && stream->force_new && !stream->pck_reassembler->data) {
+			stream->pck_reassembler->data = esi_pck->data;
+			stream->pck_reassembler->data_len = esi_pck->data_len;
+			stream->pck_reassembler->flags |= esi_pck->flags;
+		} else {
+			stream->pck_reassembler->data = (char*)gf_realloc(stream->pck_reassembler->data , sizeof(char)*(stream->pck_reassembler->data_len+esi_pck->data_len) );
+			if (esi_pck->data_len)
+				memcpy(stream->pck_reassembler->data + stream->pck_reassembler->data_len, esi_pck->data, esi_pck->data_len);
+			stream->pck_reassembler->data_len += esi_pck->data_len;
 
-		stream->pck_reassembler->flags |= esi_pck->flags;
+			stream->pck_reassembler->flags |= esi_pck->flags & ~GF_ESI_DATA_NO_COPY;
+			//payload copied, release it
+			if (esi_pck->flags & GF_ESI_DATA_NO_COPY)
+				stream->ifce->input_ctrl(stream->ifce, GF_ESI_INPUT_DATA_RELEASE, esi_pck->data);
+		}
 		if (esi_pck->sap_type) stream->pck_reassembler->sap_type = esi_pck->sap_type;
 		if (stream->force_new) {
 			if (stream->mx) gf_mx_p(stream->mx);
@@ -2729,13 +2748,16 @@ void gf_m2ts_mux_stream_del(GF_M2TS_Mux_Stream *st)
 		gf_free(st->tables);
 		st->tables = tab;
 	}
+	//payloads dispatched without copy are owned by the stream interface
 	while (st->pck_first) {
 		GF_M2TS_Packet *curr_pck = st->pck_first;
 		st->pck_first = curr_pck->next;
-		gf_free(curr_pck->data);
+		if (!(curr_pck->flags & GF_ESI_DATA_NO_COPY))
+			gf_free(curr_pck->data);
+		if (curr_pck->mpeg2_af_descriptors) gf_free(curr_pck->mpeg2_af_descriptors);
 		gf_free(curr_pck);
 	}
-	if (st->curr_pck.data) gf_free(st->curr_pck.data);
+	if (st->curr_pck.data && st->discard_data) gf_free(st->curr_pck.data);
 	if (st->curr_pck.mpeg2_af_descriptors) gf_free(st->curr_pck.mpeg2_af_descriptors);
 	if (st->mx) gf_mx_del(st->mx);
 	if (st->loop_descriptors) {
@@ -76,13 +76,18 @@ static char *gf_mpd_parse_string(char *attr)
 }
 
 
+static Bool gf_mpd_valid_ns(GF_MPD *mpd, const char *ns)
+{
+	if (!mpd->xml_namespace && !ns) return 1;
+	if (mpd->xml_namespace && ns && !strcmp(mpd->xml_namespace, ns)) return 1;
+	if (ns && !strcmp(ns, "gpac")) return 1;
+	return 0;
+}
+
 static Bool gf_mpd_valid_child(GF_MPD *mpd, GF_XMLNode *child)
 {
 	if (child->type != GF_XML_NODE_TYPE) return 0;
-	if (!mpd->xml_namespace && !child->ns) return 1;
-	if (mpd->xml_namespace && child->ns && !strcmp(mpd->xml_namespace, child->ns)) return 1;
-	if (child->ns && !strcmp(child->ns, "gpac")) return 1;
-	return 0;
+	return gf_mpd_valid_ns(mpd, child->ns);
 }
 
 static char *gf_mpd_parse_text_content(GF_XMLNode *child)
@@ -364,6 +369,25 @@ static void gf_mpd_parse_segment_base_generic(GF_MPD *mpd, GF_MPD_SegmentBase *s
 	}
 }
 
+static void gf_mpd_parse_segment_timeline_attr(GF_MPD_SegmentTimelineEntry *seg_tl_ent, const char *name, const char *value)
+{
+	if (!strcmp(name, "t"))
+		seg_tl_ent->start_time = gf_mpd_parse_long_int(value);
+	else if (!strcmp(name, "d"))
+		seg_tl_ent->duration = gf_mpd_parse_int(value);
+	else if (!strcmp(name, "r")) {
+		seg_tl_ent->repeat_count = gf_mpd_parse_int(value);
+		if (seg_tl_ent->repeat_count == (u32)-1)
+			seg_tl_ent->repeat_count--;
+	}
+}
+
+typedef struct
+{
+	GF_XMLNode *node;
+	GF_MPD_SegmentTimeline *timeline;
+} GF_MPDPendingTimeline;
+
 static GF_MPD_SegmentTimeline *gf_mpd_parse_segment_timeline(GF_MPD *mpd, GF_XMLNode *root)
 {
 	u32 i, j;
@@ -371,6 +395,18 @@ static GF_MPD_SegmentTimeline *gf_mpd_parse_segment_timeline(GF_MPD *mpd, GF_XML
 	GF_XMLAttribute *att;
 	GF_XMLNode *child;
 	GF_MPD_SegmentTimeline *seg;
+	GF_MPDPendingTimeline *pending;
+
+	//timeline already decoded by the SAX loader
+	i = 0;
+	while ((pending = gf_list_enum(mpd->sax_timelines, &i))) {
+		if (pending->node != root) continue;
+		seg = pending->timeline;
+		gf_list_rem(mpd->sax_timelines, i-1);
+		gf_free(pending);
+		return seg;
+	}
+
 	GF_SAFEALLOC(seg, GF_MPD_SegmentTimeline);
 	if (!seg) return NULL;
 	seg->entries = gf_list_new();
@@ -387,15 +423,7 @@ static GF_MPD_SegmentTimeline *gf_mpd_parse_segment_timeline(GF_MPD *mpd, GF_XML
 
 			j = 0;
 			while ( (att = gf_list_enum(child->attributes, &j)) ) {
-				if (!strcmp(att->name, "t"))
-					seg_tl_ent->start_time = gf_mpd_parse_long_int(att->value);
-				else if (!strcmp(att->name, "d"))
-					seg_tl_ent->duration = gf_mpd_parse_int(att->value);
-				else if (!strcmp(att->name, "r")) {
-					seg_tl_ent->repeat_count = gf_mpd_parse_int(att->value);
-					if (seg_tl_ent->repeat_count == (u32)-1)
-						seg_tl_ent->repeat_count--;
-				}
+				gf_mpd_parse_segment_timeline_attr(seg_tl_ent, att->name, att->value);
 			}
 			if (seg_tl_ent->start_time)
 				curr_start_time = seg_tl_ent->start_time;
@@ -1131,6 +1159,160 @@ void gf_mpd_segment_base_free(void *_item)
 	gf_free(ptr);
 }
 
+/*serialization cache for the repeated parts of live manifests (SegmentTimeline entries, HLS media playlist segments)
+Each slot holds the serialized text of one item and the values it was produced from. Items are matched in order
+from the slot of the first item, so that items trimmed at the start or appended at the end only cost their own
+formatting, while unchanged items are copied from the cache*/
+typedef struct
+{
+	const void *key;
+	u64 v1, v2, v3;
+	u32 offset;
+} GF_MPDCacheSlot;
+
+typedef struct
+{
+	char *text;
+	u32 text_size, text_alloc;
+	GF_MPDCacheSlot *slots;
+	u32 nb_slots, nb_alloc;
+	//first slot of the current pass, next slot to match
+	u32 first, next;
+	Bool reuse;
+	s32 indent;
+} GF_MPDSerializeCache;
+
+static void gf_mpd_cache_del(void *_cache)
+{
+	GF_MPDSerializeCache *cache = (GF_MPDSerializeCache *)_cache;
+	if (!cache) return;
+	if (cache->text) gf_free(cache->text);
+	if (cache->slots) gf_free(cache->slots);
+	gf_free(cache);
+}
+
+static GF_MPDSerializeCache *gf_mpd_cache_begin(void **p_cache, const void *first_key, s32 indent)
+{
+	u32 i;
+	GF_MPDSerializeCache *cache = *p_cache;
+	if (!cache) {
+		GF_SAFEALLOC(cache, GF_MPDSerializeCache);
+		if (!cache) return NULL;
+		cache->indent = indent;
+		*p_cache = cache;
+	}
+	if (cache->indent != indent) {
+		cache->nb_slots = cache->text_size = 0;
+		cache->indent = indent;
+	}
+	for (i=0; i<cache->nb_slots; i++) {
+		if (cache->slots[i].key == first_key) break;
+	}
+	cache->first = cache->next = i;
+	cache->reuse = GF_TRUE;
+	return cache;
+}
+
+static void gf_mpd_cache_truncate(GF_MPDSerializeCache *cache)
+{
+	if (cache->next < cache->nb_slots) {
+		cache->text_size = cache->slots[cache->next].offset;
+		cache->nb_slots = cache->next;
+	}
+	cache->reuse = GF_FALSE;
+}
+
+/*returns GF_TRUE if the cached text for this item can be reused, otherwise a new slot is started and the item
+text must be produced using gf_mpd_cache_printf*/
+static Bool gf_mpd_cache_match(GF_MPDSerializeCache *cache, const void *key, u64 v1, u64 v2, u64 v3)
+{
+	GF_MPDCacheSlot *slot;
+	if (cache->reuse && (cache->next < cache->nb_slots)) {
+		slot = &cache->slots[cache->next];
+		if ((slot->key==key) && (slot->v1==v1) && (slot->v2==v2) && (slot->v3==v3)) {
+			cache->next++;
+			return GF_TRUE;
+		}
+	}
+	if (cache->reuse) gf_mpd_cache_truncate(cache);
+
+	if (cache->nb_slots == cache->nb_alloc) {
+		cache->nb_alloc = cache->nb_alloc ? 2*cache->nb_alloc : 32;
+		cache->slots = gf_realloc(cache->slots, sizeof(GF_MPDCacheSlot) * cache->nb_alloc);
+	}
+	slot = &cache->slots[cache->nb_slots];
+	slot->key = key;
+	slot->v1 = v1;
+	slot->v2 = v2;
+	slot->v3 = v3;
+	slot->offset = cache->text_size;
+	cache->nb_slots++;
+	cache->next = cache->nb_slots;
+	return GF_FALSE;
+}
+
+static void gf_mpd_cache_printf(GF_MPDSerializeCache *cache, const char *format, ...)
+{
+	va_list args;
+	s32 len;
+	u32 remain = cache->text_alloc - cache->text_size;
+
+	va_start(args, format);
+	len = vsnprintf(cache->text + cache->text_size, remain, format, args);
+	va_end(args);
+	if (len<0) return;
+	if ((u32) len >= remain) {
+		while (cache->text_alloc <= cache->text_size + (u32) len)
+			cache->text_alloc = cache->text_alloc ? 2*cache->text_alloc : 4096;
+		cache->text = gf_realloc(cache->text, cache->text_alloc);
+		va_start(args, format);
+		vsnprintf(cache->text + cache->text_size, cache->text_alloc - cache->text_size, format, args);
+		va_end(args);
+	}
+	cache->text_size += len;
+}
+
+static void gf_mpd_cache_indent(GF_MPDSerializeCache *cache, s32 indent)
+{
+	if (indent<0) return;
+	gf_mpd_cache_printf(cache, "%*s", indent, "");
+}
+
+/*writes the text of all items of the current pass and drops the slots of items no longer present*/
+static void gf_mpd_cache_end(GF_MPDSerializeCache *cache, FILE *out)
+{
+	u32 start;
+	if (cache->reuse) gf_mpd_cache_truncate(cache);
+
+	if (cache->first < cache->nb_slots) {
+		start = cache->slots[cache->first].offset;
+		gf_fwrite(cache->text + start, cache->text_size - start, out);
+	} else {
+		cache->nb_slots = cache->text_size = 0;
+	}
+	if (!cache->first) return;
+
+	cache->nb_slots -= cache->first;
+	memmove(cache->slots, cache->slots + cache->first, sizeof(GF_MPDCacheSlot) * cache->nb_slots);
+	cache->first = cache->next = 0;
+	//compact text once the dropped part exceeds the remaining one
+	if (cache->nb_slots && (2*cache->slots[0].offset > cache->text_size)) {
+		u32 i, shift = cache->slots[0].offset;
+		cache->text_size -= shift;
+		memmove(cache->text, cache->text + shift, cache->text_size);
+		for (i=0; i<cache->nb_slots; i++)
+			cache->slots[i].offset -= shift;
+	}
+}
+
+/*writes the text of all items of the previous pass, when the caller knows the items did not change since then*/
+static Bool gf_mpd_cache_reuse(GF_MPDSerializeCache *cache, u32 nb_items, s32 indent, FILE *out)
+{
+	if (!cache || (cache->indent != indent) || !nb_items || (cache->nb_slots != nb_items)) return GF_FALSE;
+	gf_fwrite(cache->text + cache->slots[0].offset, cache->text_size - cache->slots[0].offset, out);
+	return GF_TRUE;
+}
+
 void gf_mpd_segment_entry_free(void *_item)
 {
 	gf_free(_item);
@@ -1139,6 +1321,7 @@ void gf_mpd_segment_timeline_free(void *_item)
 {
 	GF_MPD_SegmentTimeline *ptr = (GF_MPD_SegmentTimeline *)_item;
 	gf_mpd_del_list(ptr->entries, gf_mpd_segment_entry_free, 0);
+	if (ptr->serialize_cache) gf_mpd_cache_del(ptr->serialize_cache);
 	gf_free(ptr);
 }
 
@@ -1284,6 +1467,7 @@ void gf_mpd_representation_free(void *_item)
 	}
 	if (ptr->m3u8_var_name) gf_free(ptr->m3u8_var_name);
 	if (ptr->m3u8_var_file) gf_fclose(ptr->m3u8_var_file);
+	if (ptr->m3u8_var_cache) gf_mpd_cache_del(ptr->m3u8_var_cache);
 
 	gf_free(ptr);
 }
@@ -1352,6 +1536,38 @@ void gf_mpd_del(GF_MPD *mpd)
 	gf_free(mpd);
 }
 
+static GF_Err gf_mpd_parse_root_child(GF_MPD *mpd, GF_XMLNode *root, GF_XMLNode *child, u32 *child_pos, u32 child_idx)
+{
+	GF_Err e;
+	u32 i = *child_pos;
+
+	if (!strcmp(child->name, "ProgramInformation")) {
+		e = gf_mpd_parse_program_info(mpd, child);
+		if (e) return e;
+	} else if (!strcmp(child->name, "Location")) {
+		char *str = gf_mpd_parse_text_content(child);
+		if (str) gf_list_add(mpd->locations, str);
+	} else if (!strcmp(child->name, "PrePeriod") || !strcmp(child->name, "Period")) {
+		e = gf_mpd_parse_period(mpd, child);
+		if (e) return e;
+	} else if (!strcmp(child->name, "Metrics")) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[MPD] Metrics not implemented yet\n"));
+	} else if (!strcmp(child->name, "BaseURL")) {
+		e = gf_mpd_parse_base_url(mpd->base_URLs, child);
+		if (e) return e;
+	} else if (!strcmp(child->name, "UTCTiming")) {
+		gf_mpd_parse_descriptor(mpd->utc_timings, child);
+	} else if (!strcmp(child->name, "EssentialProperty")) {
+		gf_mpd_parse_descriptor(mpd->essential_properties, child);
+	}
+	else if (!strcmp(child->name, "SupplementalProperty")) {
+		gf_mpd_parse_descriptor(mpd->supplemental_properties, child);
+	} else {
+		MPD_STORE_EXTENSION_NODE(mpd)
+	}
+	*child_pos = i;
+	return GF_OK;
+}
 
 GF_EXPORT
 GF_Err gf_mpd_complete_from_dom(GF_XMLNode *root, GF_MPD *mpd, const char *default_base_url)
@@ -1438,30 +1654,8 @@ GF_Err gf_mpd_complete_from_dom(GF_XMLNode *root, GF_MPD *mpd, const char *defau
 		if (! gf_mpd_valid_child(mpd, child))
 			continue;
 
-		if (!strcmp(child->name, "ProgramInformation")) {
-			e = gf_mpd_parse_program_info(mpd, child);
-			if (e) return e;
-		} else if (!strcmp(child->name, "Location")) {
-			char *str = gf_mpd_parse_text_content(child);
-			if (str) gf_list_add(mpd->locations, str);
-		} else if (!strcmp(child->name, "PrePeriod") || !strcmp(child->name, "Period")) {
-			e = gf_mpd_parse_period(mpd, child);
-			if (e) return e;
-		} else if (!strcmp(child->name, "Metrics")) {
-			GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[MPD] Metrics not implemented yet\n"));
-		} else if (!strcmp(child->name, "BaseURL")) {
-			e = gf_mpd_parse_base_url(mpd->base_URLs, child);
-			if (e) return e;
-		} else if (!strcmp(child->name, "UTCTiming")) {
-			gf_mpd_parse_descriptor(mpd->utc_timings, child);
-		} else if (!strcmp(child->name, "EssentialProperty")) {
-			gf_mpd_parse_descriptor(mpd->essential_properties, child);
-		}
-		else if (!strcmp(child->name, "SupplementalProperty")) {
-			gf_mpd_parse_descriptor(mpd->supplemental_properties, child);
-		} else {
-			MPD_STORE_EXTENSION_NODE(mpd)
-		}
+		e = gf_mpd_parse_root_child(mpd, root, child, &i, child_idx);
+		if (e) return e;
 		child_idx++;
 	}
 
@@ -1496,6 +1690,275 @@ GF_Err gf_mpd_init_from_dom(GF_XMLNode *root, GF_MPD *mpd, const char *default_b
 	return gf_mpd_complete_from_dom(root, mpd, default_base_url);
 }
 
+/*SAX loader state: the MPD element is kept as a DOM node without children, each of its children is converted and
+destroyed as soon as it is closed, and S entries of SegmentTimeline are decoded without creating XML nodes*/
+typedef struct
+{
+	GF_MPD *mpd;
+	const char *base_url;
+	GF_SAXParser *sax;
+	//stack of open XML nodes, root first
+	GF_List *stack;
+	GF_XMLNode *root;
+	//set if root is an MPD element, otherwise the document is loaded as a DOM and parsed at the end
+	Bool streaming;
+	//index of next root child, used for extension nodes ordering
+	u32 child_idx;
+	//SegmentTimeline being decoded
+	GF_XMLNode *timeline_node;
+	GF_MPD_SegmentTimeline *timeline;
+	u64 timeline_time;
+	//depth of ignored nodes (S elements and their content)
+	u32 skip_depth;
+	GF_Err e;
+} GF_MPDSAXLoader;
+
+static void gf_mpd_sax_reset_timelines(GF_MPD *mpd)
+{
+	while (gf_list_count(mpd->sax_timelines)) {
+		GF_MPDPendingTimeline *pending = gf_list_pop_back(mpd->sax_timelines);
+		gf_mpd_segment_timeline_free(pending->timeline);
+		gf_free(pending);
+	}
+}
+
+static void gf_mpd_sax_abort(GF_MPDSAXLoader *ctx, GF_Err e)
+{
+	ctx->e = e;
+	gf_xml_sax_suspend(ctx->sax, GF_TRUE);
+}
+
+static Bool gf_mpd_sax_timeline_start(GF_MPDSAXLoader *ctx, GF_XMLNode *parent, const char *name, const char *ns)
+{
+	GF_MPDPendingTimeline *pending;
+	if (!ctx->streaming || !parent || strcmp(name, "SegmentTimeline") || !gf_mpd_valid_ns(ctx->mpd, ns))
+		return GF_FALSE;
+	if (strcmp(parent->name, "SegmentTemplate") && strcmp(parent->name, "SegmentList"))
+		return GF_FALSE;
+	if (!gf_mpd_valid_ns(ctx->mpd, parent->ns))
+		return GF_FALSE;
+
+	GF_SAFEALLOC(pending, GF_MPDPendingTimeline);
+	if (!pending) return GF_FALSE;
+	GF_SAFEALLOC(pending->timeline, GF_MPD_SegmentTimeline);
+	if (!pending->timeline) {
+		gf_free(pending);
+		return GF_FALSE;
+	}
+	pending->timeline->entries = gf_list_new();
+	gf_list_add(ctx->mpd->sax_timelines, pending);
+	ctx->timeline = pending->timeline;
+	ctx->timeline_time = 0;
+	return GF_TRUE;
+}
+
+static void gf_mpd_sax_timeline_entry(GF_MPDSAXLoader *ctx, const char *name, const char *ns, const GF_XMLAttribute *attributes, u32 nb_attributes)
+{
+	u32 i;
+	GF_MPD_SegmentTimelineEntry *seg_tl_ent;
+
+	if (strcmp(name, "S") || !gf_mpd_valid_ns(ctx->mpd, ns)) return;
+
+	GF_SAFEALLOC(seg_tl_ent, GF_MPD_SegmentTimelineEntry);
+	if (!seg_tl_ent) {
+		gf_mpd_sax_abort(ctx, GF_OUT_OF_MEM);
+		return;
+	}
+	seg_tl_ent->start_time = ctx->timeline_time;
+	gf_list_add(ctx->timeline->entries, seg_tl_ent);
+
+	for (i=0; i<nb_attributes; i++) {
+		gf_mpd_parse_segment_timeline_attr(seg_tl_ent, attributes[i].name, attributes[i].value);
+	}
+	if (seg_tl_ent->start_time)
+		ctx->timeline_time = seg_tl_ent->start_time;
+
+	ctx->timeline_time += (u64) (seg_tl_ent->duration * (seg_tl_ent->repeat_count+1));
+}
+
+static void gf_mpd_sax_node_start(void *cbk, const char *name, const char *ns, const GF_XMLAttribute *attributes, u32 nb_attributes)
+{
+	u32 i;
+	GF_XMLNode *node, *parent;
+	GF_MPDSAXLoader *ctx = (GF_MPDSAXLoader *)cbk;
+
+	if (ctx->e) return;
+	if (ctx->skip_depth) {
+		ctx->skip_depth++;
+		return;
+	}
+	parent = gf_list_last(ctx->stack);
+	if (!parent && ctx->root) {
+		//only one root node
+		gf_xml_sax_suspend(ctx->sax, GF_TRUE);
+		return;
+	}
+	if (ctx->timeline && (parent == ctx->timeline_node)) {
+		ctx->skip_depth = 1;
+		gf_mpd_sax_timeline_entry(ctx, name, ns, attributes, nb_attributes);
+		return;
+	}
+
+	GF_SAFEALLOC(node, GF_XMLNode);
+	if (!node) {
+		gf_mpd_sax_abort(ctx, GF_OUT_OF_MEM);
+		return;
+	}
+	node->attributes = gf_list_new();
+	node->content = gf_list_new();
+	node->name = gf_strdup(name);
+	if (ns) node->ns = gf_strdup(ns);
+	gf_list_add(ctx->stack, node);
+
+	for (i=0; i<nb_attributes; i++) {
+		GF_XMLAttribute *att;
+		GF_SAFEALLOC(att, GF_XMLAttribute);
+		if (!att) {
+			gf_mpd_sax_abort(ctx, GF_OUT_OF_MEM);
+			return;
+		}
+		att->name = gf_strdup(attributes[i].name);
+		att->value = gf_strdup(attributes[i].value);
+		gf_list_add(node->attributes, att);
+	}
+
+	if (!parent) {
+		ctx->root = node;
+		if (strcmp(name, "MPD")) return;
+		//parse MPD attributes now, children will be parsed as they are closed
+		ctx->streaming = GF_TRUE;
+		ctx->e = gf_mpd_init_from_dom(node, ctx->mpd, ctx->base_url);
+		if (ctx->e) gf_mpd_sax_abort(ctx, ctx->e);
+		return;
+	}
+	if (gf_mpd_sax_timeline_start(ctx, parent, name, ns)) {
+		GF_MPDPendingTimeline *pending = gf_list_last(ctx->mpd->sax_timelines);
+		pending->node = node;
+		ctx->timeline_node = node;
+	}
+}
+
+static void gf_mpd_sax_root_child(GF_MPDSAXLoader *ctx, GF_XMLNode *child)
+{
+	GF_Err e = GF_OK;
+	GF_XMLNode *root = ctx->root;
+	u32 pos = gf_list_count(root->content);
+
+	if (gf_mpd_valid_child(ctx->mpd, child)) {
+		e = gf_mpd_parse_root_child(ctx->mpd, root, child, &pos, ctx->child_idx);
+		ctx->child_idx++;
+	}
+	//not stored as an extension node
+	if (gf_list_del_item(root->content, child)>=0)
+		gf_xml_dom_node_del(child);
+
+	gf_mpd_sax_reset_timelines(ctx->mpd);
+	if (e) gf_mpd_sax_abort(ctx, e);
+}
+
+static void gf_mpd_sax_node_end(void *cbk, const char *name, const char *ns)
+{
+	GF_XMLNode *node, *parent;
+	GF_MPDSAXLoader *ctx = (GF_MPDSAXLoader *)cbk;
+
+	if (ctx->e) return;
+	if (ctx->skip_depth) {
+		ctx->skip_depth--;
+		return;
+	}
+	node = gf_list_pop_back(ctx->stack);
+	if (!node || strcmp(node->name, name) || (!ns && node->ns) || (ns && !node->ns) || (ns && strcmp(node->ns, ns))) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[MPD] Invalid node stack: closing node is %s but %s was expected\n", name, node ? node->name : "unknown"));
+		if (node != ctx->root) gf_xml_dom_node_del(node);
+		gf_mpd_sax_abort(ctx, GF_NON_COMPLIANT_BITSTREAM);
+		return;
+	}
+	if (node == ctx->timeline_node) {
+		ctx->timeline_node = NULL;
+		ctx->timeline = NULL;
+	}
+	parent = gf_list_last(ctx->stack);
+	if (!parent) {
+		if (!ctx->streaming) {
+			ctx->e = gf_mpd_init_from_dom(node, ctx->mpd, ctx->base_url);
+			gf_mpd_sax_reset_timelines(ctx->mpd);
+		}
+		return;
+	}
+	gf_list_add(parent->content, node);
+	if (ctx->streaming && (parent == ctx->root))
+		gf_mpd_sax_root_child(ctx, node);
+}
+
+static void gf_mpd_sax_text_content(void *cbk, const char *content, Bool is_cdata)
+{
+	GF_XMLNode *node, *parent;
+	GF_MPDSAXLoader *ctx = (GF_MPDSAXLoader *)cbk;
+
+	if (ctx->e || ctx->skip_depth) return;
+	parent = gf_list_last(ctx->stack);
+	if (!parent) return;
+	if (ctx->streaming && ((parent == ctx->root) || (parent == ctx->timeline_node)))
+		return;
+
+	GF_SAFEALLOC(node, GF_XMLNode);
+	if (!node) {
+		gf_mpd_sax_abort(ctx, GF_OUT_OF_MEM);
+		return;
+	}
+	node->type = is_cdata ? GF_XML_CDATA_TYPE : GF_XML_TEXT_TYPE;
+	node->name = gf_strdup(content);
+	gf_list_add(parent->content, node);
+}
+
+GF_EXPORT
+GF_Err gf_mpd_init_from_file(const char *file, GF_MPD *mpd, const char *default_base_url)
+{
+	GF_Err e;
+	GF_MPDSAXLoader ctx;
+	if (!file || !mpd) return GF_BAD_PARAM;
+
+	memset(&ctx, 0, sizeof(GF_MPDSAXLoader));
+	ctx.mpd = mpd;
+	ctx.base_url = default_base_url;
+	ctx.stack = gf_list_new();
+	ctx.sax = gf_xml_sax_new(gf_mpd_sax_node_start, gf_mpd_sax_node_end, gf_mpd_sax_text_content, &ctx);
+	if (!ctx.stack || !ctx.sax) {
+		gf_list_del(ctx.stack);
+		if (ctx.sax) gf_xml_sax_del(ctx.sax);
+		return GF_OUT_OF_MEM;
+	}
+	mpd->sax_timelines = gf_list_new();
+
+	e = gf_xml_sax_parse_file(ctx.sax, file, NULL);
+	if (e<0) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[MPD] Failed to parse %s: %s\n", file, gf_xml_sax_get_error(ctx.sax) ));
+	} else if (ctx.e) {
+		e = ctx.e;
+	} else if (!ctx.root || gf_list_count(ctx.stack)) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[MPD] Incomplete document %s\n", file));
+		e = GF_NON_COMPLIANT_BITSTREAM;
+	} else {
+		e = GF_OK;
+	}
+
+	//root is always first in stack if not closed
+	while (gf_list_count(ctx.stack)) {
+		GF_XMLNode *node = gf_list_pop_back(ctx.stack);
+		if (node != ctx.root) gf_xml_dom_node_del(node);
+	}
+	gf_list_del(ctx.stack);
+	gf_xml_dom_node_del(ctx.root);
+	gf_xml_sax_del(ctx.sax);
+
+	gf_mpd_sax_reset_timelines(mpd);
+	gf_list_del(mpd->sax_timelines);
+	mpd->sax_timelines = NULL;
+	//namespace was pointing to the root node
+	mpd->xml_namespace = NULL;
+	return e;
+}
+
 static GF_Err gf_m3u8_fill_mpd_struct(MasterPlaylist *pl, const char *m3u8_file, const char *src_base_url, const char *mpd_file, char *title, Double update_interval,
                                       char *mimeTypeForM3U8Segments, Bool do_import, Bool use_mpd_templates, Bool use_segment_timeline, Bool is_end, u32 max_dur, GF_MPD *mpd, Bool parse_sub_playlist)
 {
@@ -2645,29 +3108,57 @@ static void gf_mpd_print_segment_base(FILE *out, GF_MPD_SegmentBase *s, s32 inde
 
 static void gf_mpd_print_segment_timeline(FILE *out, GF_MPD_SegmentTimeline *tl, s32 indent)
 {
-	u32 i;
+	u32 i, count;
 	u64 start_time=0;
 	GF_MPD_SegmentTimelineEntry *se;
+	GF_MPDSerializeCache *cache;
 
 	gf_mpd_nl(out, indent);
 	gf_fprintf(out, "<SegmentTimeline>");
 	gf_mpd_lf(out, indent);
 
-	i = 0;
-	while ( (se = gf_list_enum(tl->entries, &i))) {
+	count = gf_list_count(tl->entries);
+	//first entry is modified when purging the timeline, always print it
+	se = gf_list_get(tl->entries, 0);
+	if (se) {
 		gf_mpd_nl(out, indent+1);
-		gf_fprintf(out, "<S");
+		gf_fprintf(out, "<S t=\""LLD"\"", se->start_time);
+		start_time = se->start_time + (se->repeat_count+1) * se->duration;
+		if (se->duration) gf_fprintf(out, " d=\"%d\"", se->duration);
+		if (se->repeat_count) gf_fprintf(out, " r=\"%d\"", se->repeat_count);
+		gf_fprintf(out, "/>");
+		gf_mpd_lf(out, indent);
+	}
+
+	//other entries only change when appending or trimming the timeline, use serialization cache
+	//if the owner tracks changes and nothing changed, the cached entries are written without checking them
+	if (tl->track_changes && !tl->modified && (count>1) && gf_mpd_cache_reuse(tl->serialize_cache, count-1, indent, out))
+		count = 0;
+	tl->modified = GF_FALSE;
+
+	cache = (count>1) ? gf_mpd_cache_begin(&tl->serialize_cache, gf_list_get(tl->entries, 1), indent) : NULL;
+	for (i=1; cache && (i<count); i++) {
+		se = gf_list_get(tl->entries, i);
+		if (gf_mpd_cache_match(cache, se, se->start_time, ((u64) se->repeat_count)<<32 | se->duration, start_time)) {
+			if (!start_time || (se->start_time != start_time))
+				start_time = se->start_time;
+			start_time += (se->repeat_count+1) * se->duration;
+			continue;
+		}
+		gf_mpd_cache_indent(cache, indent+1);
+		gf_mpd_cache_printf(cache, "<S");
 		if (!start_time || (se->start_time != start_time)) {
-			gf_fprintf(out, " t=\""LLD"\"", se->start_time);
+			gf_mpd_cache_printf(cache, " t=\""LLD"\"", se->start_time);
 			start_time = se->start_time;
 		}
 		start_time += (se->repeat_count+1) * se->duration;
 
-		if (se->duration) gf_fprintf(out, " d=\"%d\"", se->duration);
-		if (se->repeat_count) gf_fprintf(out, " r=\"%d\"", se->repeat_count);
-		gf_fprintf(out, "/>");
-		gf_mpd_lf(out, indent);
+		if (se->duration) gf_mpd_cache_printf(cache, " d=\"%d\"", se->duration);
+		if (se->repeat_count) gf_mpd_cache_printf(cache, " r=\"%d\"", se->repeat_count);
+		gf_mpd_cache_printf(cache, (indent>=0) ? "/>\n" : "/>");
 	}
+	if (cache) gf_mpd_cache_end(cache, out);
+
 	gf_mpd_nl(out, indent);
 	gf_fprintf(out, "</SegmentTimeline>");
 	gf_mpd_lf(out, indent);
@@ -3481,8 +3972,9 @@ static GF_Err gf_mpd_write_m3u8_playlist(const GF_MPD *mpd, const GF_MPD_Period
 		if (!out) return GF_IO_ERR;
 		close_file = GF_TRUE;
 	} else {
-		out = gf_file_temp(NULL);
 		if (rep->m3u8_var_file) gf_fclose(rep->m3u8_var_file);
+		out = gf_file_mem_new();
+		if (!out) return GF_OUT_OF_MEM;
 		rep->m3u8_var_file = out;
 	}
 
@@ -3517,6 +4009,27 @@ static GF_Err gf_mpd_write_m3u8_playlist(const GF_MPD *mpd, const GF_MPD_Period
 			gf_fprintf(out,"#EXT-X-MAP:URI=\"%s\"\n", rep->hls_single_file_name);
 		}
 
+		//plain segment entries only change when appending or trimming the playlist, use serialization cache
+		if (!rep->crypto_type && !as->use_hls_ll && count) {
+			GF_MPDSerializeCache *cache = gf_mpd_cache_begin(&rep->m3u8_var_cache, gf_list_get(rep->state_seg_list, 0), 0);
+			for (i=0; cache && (i<count); i++) {
+				Double dur;
+				u32 len;
+				sctx = gf_list_get(rep->state_seg_list, i);
+				len = (u32) strlen(sctx->filename);
+				if (gf_mpd_cache_match(cache, sctx, sctx->dur, ((u64) len)<<32 | gf_crc_32((u8 *) sctx->filename, len), rep->timescale))
+					continue;
+
+				dur = (Double) sctx->dur;
+				dur /= rep->timescale;
+				gf_mpd_cache_printf(cache, "#EXTINF:%g,\n%s\n", dur, sctx->filename);
+			}
+			if (cache) {
+				gf_mpd_cache_end(cache, out);
+				count = 0;
+			}
+		}
+
 		for (i=0; i<count; i++) {
 			Double dur;
 			sctx = gf_list_get(rep->state_seg_list, i);
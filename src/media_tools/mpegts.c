@@ -332,6 +332,13 @@ static void gf_m2ts_metadata_descriptor_del(GF_M2TS_MetadataDescriptor *metad)
 
 static void gf_m2ts_es_del(GF_M2TS_ES *es, GF_M2TS_Demuxer *ts)
 {
+	if ((es->flags & GF_M2TS_ES_IS_PES) && ((GF_M2TS_PES *)es)->batch) {
+		GF_M2TS_PES *pes = (GF_M2TS_PES *)es;
+		if (pes->batch_count) gf_m2ts_process_deferred_pes(ts, pes);
+		if (ts->deferred) gf_list_del_item(ts->deferred, pes);
+		gf_free(pes->batch);
+		pes->batch = NULL;
+	}
 	gf_list_del_item(es->program->streams, es);
 
 	if (ts->on_event)
@@ -1996,10 +2003,9 @@ static void gf_m2ts_store_temi(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes)
 	pes->temi_pending = 1;
 }
 
-void gf_m2ts_flush_pes(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes, Bool force_flush)
+static void gf_m2ts_do_flush_pes(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes, Bool force_flush)
 {
 	GF_M2TS_PESHeader pesh;
-	if (!ts) return;
 
 	/*we need at least a full, valid start code and PES header !!*/
 	if ((pes->pck_data_len >= 4) && !pes->pck_data[0] && !pes->pck_data[1] && (pes->pck_data[2] == 0x1)) {
@@ -2034,7 +2040,7 @@ void gf_m2ts_flush_pes(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes, Bool force_flush)
 				pck.DTS = pesh.DTS;
 				pck.stream = pes;
 				if (pes->rap) pck.flags |= GF_M2TS_PES_PCK_RAP;
-				pes->pes_end_packet_number = ts->pck_number;
+				pes->pes_end_packet_number = pes->pck_number;
 				if (ts->on_event) ts->on_event(ts, GF_M2TS_EVT_PES_TIMING, &pck);
 			}
 			GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[MPEG-2 TS] PID %d Got PES header DTS %d PTS %d\n", pes->pid, pesh.DTS, pesh.PTS));
@@ -2152,11 +2158,141 @@ void gf_m2ts_flush_pes(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes, Bool force_flush)
 	pes->rap = 0;
 }
 
+void gf_m2ts_flush_pes(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes, Bool force_flush)
+{
+	if (!ts) return;
+	if (pes->batch_count) gf_m2ts_process_deferred_pes(ts, pes);
+	pes->pck_number = ts->pck_number;
+	gf_m2ts_do_flush_pes(ts, pes, force_flush);
+}
+
+/*TS packet pending for PES reassembly in deferred mode*/
+typedef struct __m2ts_pes_batch_item
+{
+	u32 pck_number;
+	u8 payload_start;
+	u8 rap;
+	/*discontinuity found, trash PES being reassembled*/
+	u8 reset;
+	u8 data_size;
+	/*program PCR state at payload start*/
+	u64 before_last_pcr_value, last_pcr_value;
+	u32 before_last_pcr_value_pck_number, last_pcr_value_pck_number;
+	u8 data[184];
+} GF_M2TS_PESBatchItem;
+
+static GFINLINE Bool gf_m2ts_pes_is_deferred(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes)
+{
+	if (!ts->deferred_pes) return GF_FALSE;
+	/*SL packets may trigger new PID declarations in the user callback, keep them in the demux thread*/
+	if (pes->flags & GF_M2TS_ES_IS_SL) return GF_FALSE;
+	if (pes->stream_type == GF_M2TS_SYSTEMS_MPEG4_PES) return GF_FALSE;
+	return GF_TRUE;
+}
+
+static GF_M2TS_PESBatchItem *gf_m2ts_pes_batch_item_new(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes)
+{
+	if (!pes->batch_count) {
+		if (!ts->deferred) ts->deferred = gf_list_new();
+		if (gf_list_find(ts->deferred, pes)<0)
+			gf_list_add(ts->deferred, pes);
+	}
+	if (pes->batch_count == pes->batch_alloc) {
+		pes->batch_alloc = pes->batch_alloc ? 2*pes->batch_alloc : 16;
+		pes->batch = gf_realloc(pes->batch, sizeof(GF_M2TS_PESBatchItem) * pes->batch_alloc);
+	}
+	pes->batch_count++;
+	return &pes->batch[pes->batch_count-1];
+}
+
+static void gf_m2ts_reassemble_pes(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes, GF_M2TS_PESBatchItem *item, unsigned char *data, u32 data_size)
+{
+	Bool flush_pes = 0;
+
+	pes->pck_number = item->pck_number;
+	if (item->reset) {
+		pes->pck_data_len = 0;
+		pes->pes_len = 0;
+		return;
+	}
+	/*framing may have been reset while processing a previous packet*/
+	if (!pes->reframe) return;
+
+	if (item->payload_start) {
+		flush_pes = 1;
+		pes->pes_start_packet_number = item->pck_number;
+		pes->before_last_pcr_value = item->before_last_pcr_value;
+		pes->before_last_pcr_value_pck_number = item->before_last_pcr_value_pck_number;
+		pes->last_pcr_value = item->last_pcr_value;
+		pes->last_pcr_value_pck_number = item->last_pcr_value_pck_number;
+	} else if (pes->pes_len && (pes->pck_data_len + data_size == pes->pes_len + 6)) {
+		/* 6 = startcode+stream_id+length*/
+		/*reassemble pes*/
+		if (pes->pck_data_len + data_size > pes->pck_alloc_len) {
+			pes->pck_alloc_len = pes->pck_data_len + data_size;
+			pes->pck_data = (u8*)gf_realloc(pes->pck_data, pes->pck_alloc_len);
+		}
+		memcpy(pes->pck_data+pes->pck_data_len, data, data_size);
+		pes->pck_data_len += data_size;
+		/*force discard*/
+		data_size = 0;
+		flush_pes = 1;
+	}
+
+	/*PES first fragment: flush previous packet*/
+	if (flush_pes && pes->pck_data_len) {
+		gf_m2ts_do_flush_pes(ts, pes, GF_TRUE);
+		if (!data_size) return;
+	}
+	/*we need to wait for first packet of PES*/
+	if (!pes->pck_data_len && !item->payload_start) {
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[MPEG-2 TS] PID %d: Waiting for PES header, trashing data\n", pes->pid));
+		return;
+	}
+	/*reassemble*/
+	if (pes->pck_data_len + data_size > pes->pck_alloc_len ) {
+		pes->pck_alloc_len = pes->pck_data_len + data_size;
+		pes->pck_data = (u8*)gf_realloc(pes->pck_data, pes->pck_alloc_len);
+	}
+	memcpy(pes->pck_data + pes->pck_data_len, data, data_size);
+	pes->pck_data_len += data_size;
+
+	if (item->rap) pes->rap = 1;
+	if (item->payload_start && !pes->pes_len && (pes->pck_data_len>=6)) {
+		pes->pes_len = (pes->pck_data[4]<<8) | pes->pck_data[5];
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[MPEG-2 TS] PID %d: Got PES packet len %d\n", pes->pid, pes->pes_len));
+
+		if (pes->pes_len + 6 == pes->pck_data_len) {
+			gf_m2ts_do_flush_pes(ts, pes, GF_TRUE);
+		}
+	}
+}
+
+GF_EXPORT
+GF_M2TS_PES *gf_m2ts_pop_deferred_pes(GF_M2TS_Demuxer *ts)
+{
+	if (!ts || !ts->deferred) return NULL;
+	return gf_list_pop_front(ts->deferred);
+}
+
+GF_EXPORT
+void gf_m2ts_process_deferred_pes(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes)
+{
+	u32 i, count;
+	if (!ts || !pes) return;
+	count = pes->batch_count;
+	pes->batch_count = 0;
+	for (i=0; i<count; i++) {
+		GF_M2TS_PESBatchItem *item = &pes->batch[i];
+		gf_m2ts_reassemble_pes(ts, pes, item, item->data, item->data_size);
+	}
+}
+
 static void gf_m2ts_process_pes(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes, GF_M2TS_Header *hdr, unsigned char *data, u32 data_size, GF_M2TS_AdaptationField *paf)
 {
 	u8 expect_cc;
 	Bool disc=0;
-	Bool flush_pes = 0;
+	GF_M2TS_PESBatchItem item, *pitem;
 
 	/*duplicated packet, NOT A DISCONTINUITY, we should discard the packet - however we may encounter this configuration in DASH at segment boundaries.
 	If payload start is set, ignore duplication*/
@@ -2186,9 +2322,16 @@ static void gf_m2ts_process_pes(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes, GF_M2TS_H
 				if (pes->pck_data_len) {
 					GF_LOG(GF_LOG_ERROR, GF_LOG_CONTAINER, ("[MPEG-2 TS] PES %d: Packet discontinuity (%d expected - got %d) - trashing PES packet\n", pes->pid, expect_cc, hdr->continuity_counter));
 				}
+				pes->cc = -1;
+				if (gf_m2ts_pes_is_deferred(ts, pes)) {
+					pitem = gf_m2ts_pes_batch_item_new(ts, pes);
+					memset(pitem, 0, offsetof(GF_M2TS_PESBatchItem, data));
+					pitem->pck_number = ts->pck_number;
+					pitem->reset = 1;
+					return;
+				}
 				pes->pck_data_len = 0;
 				pes->pes_len = 0;
-				pes->cc = -1;
 				return;
 			}
 		}
@@ -2196,54 +2339,23 @@ static void gf_m2ts_process_pes(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes, GF_M2TS_H
 
 	if (!pes->reframe) return;
 
+	pitem = gf_m2ts_pes_is_deferred(ts, pes) ? gf_m2ts_pes_batch_item_new(ts, pes) : &item;
+	pitem->pck_number = ts->pck_number;
+	pitem->payload_start = hdr->payload_start;
+	pitem->rap = (paf && paf->random_access_indicator) ? 1 : 0;
+	pitem->reset = 0;
 	if (hdr->payload_start) {
-		flush_pes = 1;
-		pes->pes_start_packet_number = ts->pck_number;
-		pes->before_last_pcr_value = pes->program->before_last_pcr_value;
-		pes->before_last_pcr_value_pck_number = pes->program->before_last_pcr_value_pck_number;
-		pes->last_pcr_value = pes->program->last_pcr_value;
-		pes->last_pcr_value_pck_number = pes->program->last_pcr_value_pck_number;
-	} else if (pes->pes_len && (pes->pck_data_len + data_size == pes->pes_len + 6)) {
-		/* 6 = startcode+stream_id+length*/
-		/*reassemble pes*/
-		if (pes->pck_data_len + data_size > pes->pck_alloc_len) {
-			pes->pck_alloc_len = pes->pck_data_len + data_size;
-			pes->pck_data = (u8*)gf_realloc(pes->pck_data, pes->pck_alloc_len);
-		}
-		memcpy(pes->pck_data+pes->pck_data_len, data, data_size);
-		pes->pck_data_len += data_size;
-		/*force discard*/
-		data_size = 0;
-		flush_pes = 1;
-	}
-
-	/*PES first fragment: flush previous packet*/
-	if (flush_pes && pes->pck_data_len) {
-		gf_m2ts_flush_pes(ts, pes, GF_TRUE);
-		if (!data_size) return;
-	}
-	/*we need to wait for first packet of PES*/
-	if (!pes->pck_data_len && !hdr->payload_start) {
-		GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[MPEG-2 TS] PID %d: Waiting for PES header, trashing data\n", hdr->pid));
+		pitem->before_last_pcr_value = pes->program->before_last_pcr_value;
+		pitem->before_last_pcr_value_pck_number = pes->program->before_last_pcr_value_pck_number;
+		pitem->last_pcr_value = pes->program->last_pcr_value;
+		pitem->last_pcr_value_pck_number = pes->program->last_pcr_value_pck_number;
+	}
+	if (pitem != &item) {
+		pitem->data_size = data_size;
+		memcpy(pitem->data, data, data_size);
 		return;
 	}
-	/*reassemble*/
-	if (pes->pck_data_len + data_size > pes->pck_alloc_len ) {
-		pes->pck_alloc_len = pes->pck_data_len + data_size;
-		pes->pck_data = (u8*)gf_realloc(pes->pck_data, pes->pck_alloc_len);
-	}
-	memcpy(pes->pck_data + pes->pck_data_len, data, data_size);
-	pes->pck_data_len += data_size;
-
-	if (paf && paf->random_access_indicator) pes->rap = 1;
-	if (hdr->payload_start && !pes->pes_len && (pes->pck_data_len>=6)) {
-		pes->pes_len = (pes->pck_data[4]<<8) | pes->pck_data[5];
-		GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[MPEG-2 TS] PID %d: Got PES packet len %d\n", pes->pid, pes->pes_len));
-
-		if (pes->pes_len + 6 == pes->pck_data_len) {
-			gf_m2ts_flush_pes(ts, pes, GF_TRUE);
-		}
-	}
+	gf_m2ts_reassemble_pes(ts, pes, &item, data, data_size);
 }
 
 void gf_m2ts_flush_all(GF_M2TS_Demuxer *ts, Bool no_force_flush)
@@ -2392,6 +2504,7 @@ static void gf_m2ts_get_adaptation_field(GF_M2TS_Demuxer *ts, GF_M2TS_Adaptation
 					if (ts->ess[pid] && (ts->ess[pid]->flags & GF_M2TS_ES_IS_PES)) {
 						GF_M2TS_PES *pes = (GF_M2TS_PES *) ts->ess[pid];
 
+						if (pes->batch_count) gf_m2ts_process_deferred_pes(ts, pes);
 						if (pes->temi_tc_desc_len)
 							gf_m2ts_store_temi(ts, pes);
 
@@ -2822,6 +2935,7 @@ void gf_m2ts_reset_parsers_for_program(GF_M2TS_Demuxer *ts, GF_M2TS_Program *pro
 		} else {
 			GF_M2TS_PES *pes = (GF_M2TS_PES *)es;
 			if (pes->pid==pes->program->pmt_pid) continue;
+			if (pes->batch_count) gf_m2ts_process_deferred_pes(ts, pes);
 			pes->cc = -1;
 			pes->pck_data_len = 0;
 			if (pes->prev_data) gf_free(pes->prev_data);
@@ -2920,6 +3034,9 @@ GF_Err gf_m2ts_set_pes_framing(GF_M2TS_PES *pes, GF_M2TSPesFraming mode)
 
 	if (pes->pid==pes->program->pmt_pid) return GF_BAD_PARAM;
 
+	//pending packets were received with the previous framing mode
+	if (pes->batch_count) gf_m2ts_process_deferred_pes(pes->program->ts, pes);
+
 	//if component reuse, disable previous pes
 	if ((mode > GF_M2TS_PES_FRAMING_SKIP) && (pes->program->ts->ess[pes->pid] != (GF_M2TS_ES *) pes)) {
 		GF_M2TS_PES *o_pes = (GF_M2TS_PES *) pes->program->ts->ess[pes->pid];
@@ -3072,6 +3189,7 @@ void gf_m2ts_demux_del(GF_M2TS_Demuxer *ts)
 		gf_free(p);
 	}
 	gf_list_del(ts->programs);
+	if (ts->deferred) gf_list_del(ts->deferred);
 
 	if (ts->TDT_time) gf_free(ts->TDT_time);
 	gf_m2ts_reset_sdt(ts);
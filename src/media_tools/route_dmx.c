@@ -33,6 +33,8 @@
 #include <gpac/thread.h>
 
 #define GF_ROUTE_SOCK_SIZE	0x80000
+//max number of datagrams fetched per system call
+#define GF_ROUTE_BATCH_SIZE	32
 
 typedef struct
 {
@@ -138,6 +140,7 @@ struct __gf_routedmx {
 	GF_Socket *atsc_sock;
 	u8 *buffer;
 	u32 buffer_size;
+	GF_SockBatch *batch;
 	u8 *unz_buffer;
 	u32 unz_buffer_size;
 
@@ -227,6 +230,7 @@ GF_EXPORT
 void gf_route_dmx_del(GF_ROUTEDmx *routedmx)
 {
 	if (routedmx->buffer) gf_free(routedmx->buffer);
+	if (routedmx->batch) gf_sk_batch_del(routedmx->batch);
 	if (routedmx->unz_buffer) gf_free(routedmx->unz_buffer);
 	if (routedmx->atsc_sock) gf_sk_del(routedmx->atsc_sock);
     if (routedmx->dom) gf_xml_dom_del(routedmx->dom);
@@ -297,6 +301,13 @@ static GF_ROUTEDmx *gf_route_dmx_new_internal(const char *ifce, u32 sock_buffer_
 		gf_route_dmx_del(routedmx);
 		return NULL;
 	}
+	//LCT packets are received in batches, independently of the signaling buffer above which may be reallocated while processing a packet
+	routedmx->batch = gf_sk_batch_new(GF_ROUTE_BATCH_SIZE, routedmx->buffer_size);
+	if (!routedmx->batch) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_ROUTE, ("[ROUTE] Failed to allocate socket buffer\n"));
+		gf_route_dmx_del(routedmx);
+		return NULL;
+	}
 	routedmx->unz_buffer = gf_malloc(routedmx->unz_buffer_size);
 	if (!routedmx->unz_buffer) {
 		GF_LOG(GF_LOG_ERROR, GF_LOG_ROUTE, ("[ROUTE] Failed to allocate socket buffer\n"));
@@ -1468,10 +1479,10 @@ static GF_Err gf_route_dmx_process_service_signaling(GF_ROUTEDmx *routedmx, GF_R
 }
 
 
-static GF_Err gf_route_dmx_process_service(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, GF_ROUTESession *route_sess)
+static GF_Err gf_route_dmx_process_service_packet(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, u8 *data, u32 nb_read)
 {
 	GF_Err e;
-	u32 nb_read, v, C, psi, S, O, H, /*Res, A,*/ B, hdr_len, cp, cc, tsi, toi, pos;
+	u32 v, C, psi, S, O, H, /*Res, A,*/ B, hdr_len, cp, cc, tsi, toi, pos;
 	u32 /*a_G=0, a_U=0,*/ a_S=0, a_M=0/*, a_A=0, a_H=0, a_D=0*/;
 	u64 tol_size=0;
 	Bool in_order = GF_TRUE;
@@ -1479,21 +1490,7 @@ static GF_Err gf_route_dmx_process_service(GF_ROUTEDmx *routedmx, GF_ROUTEServic
 	GF_ROUTELCTChannel *rlct=NULL;
 	GF_LCTObject *gather_object=NULL;
 
-	if (route_sess) {
-		e = gf_sk_receive_no_select(route_sess->sock, routedmx->buffer, routedmx->buffer_size, &nb_read);
-	} else {
-		e = gf_sk_receive_no_select(s->sock, routedmx->buffer, routedmx->buffer_size, &nb_read);
-	}
-
-	if (e != GF_OK) return e;
-	assert(nb_read);
-
-	routedmx->nb_packets++;
-	routedmx->total_bytes_recv += nb_read;
-	routedmx->last_pck_time = gf_sys_clock_high_res();
-	if (!routedmx->first_pck_time) routedmx->first_pck_time = routedmx->last_pck_time;
-
-	e = gf_bs_reassign_buffer(routedmx->bs, routedmx->buffer, nb_read);
+	e = gf_bs_reassign_buffer(routedmx->bs, data, nb_read);
 	if (e != GF_OK) return e;
 
 	//parse LCT header
@@ -1660,7 +1657,7 @@ static GF_Err gf_route_dmx_process_service(GF_ROUTEDmx *routedmx, GF_ROUTEServic
 
 	GF_LOG(GF_LOG_DEBUG, GF_LOG_ROUTE, ("[ROUTE] Service %d : LCT packet TSI %u TOI %u size %d startOffset %u TOL "LLU"\n", s->service_id, tsi, toi, nb_read-pos, start_offset, tol_size));
 
-	e = gf_route_service_gather_object(routedmx, s, tsi, toi, start_offset, routedmx->buffer + pos, nb_read-pos, (u32) tol_size, B, in_order, rlct, &gather_object);
+	e = gf_route_service_gather_object(routedmx, s, tsi, toi, start_offset, data + pos, nb_read-pos, (u32) tol_size, B, in_order, rlct, &gather_object);
 
 	if (e==GF_EOS) {
 		if (!tsi) {
@@ -1681,6 +1678,32 @@ static GF_Err gf_route_dmx_process_service(GF_ROUTEDmx *routedmx, GF_ROUTEServic
 	return GF_OK;
 }
 
+static GF_Err gf_route_dmx_process_service(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, GF_ROUTESession *route_sess)
+{
+	GF_Err e, last_e = GF_OK;
+	u32 i, nb_pck, nb_ok = 0;
+
+	e = gf_sk_receive_batch(route_sess ? route_sess->sock : s->sock, routedmx->batch, &nb_pck);
+	if (e != GF_OK) return e;
+
+	routedmx->last_pck_time = gf_sys_clock_high_res();
+	if (!routedmx->first_pck_time) routedmx->first_pck_time = routedmx->last_pck_time;
+
+	for (i=0; i<nb_pck; i++) {
+		u32 nb_read;
+		u8 *data = gf_sk_batch_get(routedmx->batch, i, &nb_read);
+		if (!data || !nb_read) continue;
+
+		routedmx->nb_packets++;
+		routedmx->total_bytes_recv += nb_read;
+		//process all packets in the batch even if one fails
+		e = gf_route_dmx_process_service_packet(routedmx, s, data, nb_read);
+		if (e) last_e = e;
+		else nb_ok++;
+	}
+	return nb_ok ? GF_OK : last_e;
+}
+
 static GF_Err gf_route_dmx_process_lls(GF_ROUTEDmx *routedmx)
 {
 	u32 read;
@@ -170,6 +170,10 @@ struct __DownloadedCacheEntryStruct
     GF_Blob cache_blob;
     GF_Blob *external_blob;
     Bool persistent;
+	/*last access time of the entry, in UTC ms*/
+	u64 last_access;
+	/*content set through gf_cache_set_content, entry is referenced outside of the cache*/
+	Bool pushed;
 };
 
 Bool gf_cache_entry_persistent(const DownloadedCacheEntry entry)
@@ -453,6 +457,7 @@ DownloadedCacheEntry gf_cache_create_entry ( GF_DownloadManager * dm, const char
 	entry->dm = dm;
 	entry->range_start = start_range;
 	entry->range_end = end_range;
+	entry->last_access = gf_net_get_utc();
 
 #ifdef ENABLE_WRITE_MX
 	{
@@ -929,6 +934,29 @@ void gf_cache_set_end_range(DownloadedCacheEntry entry, u64 range_end)
 	}
 }
 
+void gf_cache_entry_touch(const DownloadedCacheEntry entry)
+{
+	if (entry) entry->last_access = gf_net_get_utc();
+}
+
+u64 gf_cache_entry_get_last_access(const DownloadedCacheEntry entry)
+{
+	return entry ? entry->last_access : 0;
+}
+
+Bool gf_cache_entry_is_memory(const DownloadedCacheEntry entry)
+{
+	return entry ? entry->memory_stored : GF_FALSE;
+}
+
+u32 gf_cache_entry_get_storage_size(const DownloadedCacheEntry entry)
+{
+	if (!entry) return 0;
+	//external blobs are not owned by the cache
+	if (entry->memory_stored) return entry->external_blob ? 0 : entry->mem_allocated;
+	return entry->file_exists ? MAX(entry->contentLength, entry->written_in_cache) : 0;
+}
+
 Bool gf_cache_is_in_progress(const DownloadedCacheEntry entry)
 {
 	if (!entry) return GF_FALSE;
@@ -938,6 +966,14 @@ Bool gf_cache_is_in_progress(const DownloadedCacheEntry entry)
 	return GF_FALSE;
 }
 
+Bool gf_cache_entry_can_evict(const DownloadedCacheEntry entry)
+{
+	if (!entry || entry->persistent || entry->pushed) return GF_FALSE;
+	if (gf_list_count(entry->sessions) || entry->write_session) return GF_FALSE;
+	if (gf_cache_is_in_progress(entry)) return GF_FALSE;
+	return GF_TRUE;
+}
+
 Bool gf_cache_set_mime(const DownloadedCacheEntry entry, const char *mime)
 {
 	if (!entry || !entry->memory_stored) return GF_FALSE;
@@ -1018,6 +1054,7 @@ Bool gf_cache_is_deleted(const DownloadedCacheEntry entry)
 Bool gf_cache_set_content(const DownloadedCacheEntry entry, GF_Blob *blob, Bool copy, GF_Mutex *mx)
 {
 	if (!entry || !entry->memory_stored) return GF_FALSE;
+	entry->pushed = GF_TRUE;
 
     if (!blob) {
         entry->flags = DELETED;
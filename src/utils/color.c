@@ -28,6 +28,19 @@
 #include <gpac/constants.h>
 #include <gpac/color.h>
 
+//intrinsic code segfaults on 32 bit, need to check why
+#if defined(GPAC_64_BITS)
+# if defined(WIN32) && !defined(__GNUC__)
+#  include <intrin.h>
+#  define GPAC_HAS_SSE2
+# else
+#  ifdef __SSE2__
+#   include <emmintrin.h>
+#   define GPAC_HAS_SSE2
+#  endif
+# endif
+#endif
+
 #ifndef GPAC_DISABLE_PLAYER
 
 static GF_Err color_write_nv12_10_to_yuv(GF_VideoSurface *vs_dst, GF_VideoSurface *vs_src, GF_Window *_src_wnd, Bool swap_up);
@@ -80,6 +93,370 @@ static void yuv2rgb_init(void)
 	}
 }
 
+#ifdef GPAC_HAS_SSE2
+
+/*SSE2 versions of the YUV -> RGBA line loaders
+
+all computations are done on 32 bit integers with the same fixed-point coefficients as the tables above, and
+saturation to [0,255] is done by signed/unsigned packing, so output is bit-exact with the C code.
+Each helper processes a multiple of 16 pixels and returns the number of pixels processed, the remaining
+pixels being handled by the C code*/
+
+#define SSE2_COEF_PAIR(_lo, _hi)	_mm_set1_epi32( (s32) ( ( ((u32) (u16) (_hi)) << 16) | (u16) (_lo) ) )
+
+/*converts 8 pixels given as 16 bit Y, U and V samples (chroma already upsampled) to RGBA*/
+static GFINLINE void yuv_to_rgba_8px_sse2(u8 *dst, __m128i y, __m128i u, __m128i v)
+{
+	__m128i yu_l, yu_h, yv_l, yv_h, v_l, v_h, r, g, b, rg, ba;
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i c_r = SSE2_COEF_PAIR(FIX_OUT(1.164), FIX_OUT(1.596));
+	const __m128i c_g = SSE2_COEF_PAIR(FIX_OUT(1.164), -FIX_OUT(0.391));
+	const __m128i c_b = SSE2_COEF_PAIR(FIX_OUT(1.164), FIX_OUT(2.018));
+	const __m128i c_gv = SSE2_COEF_PAIR(FIX_OUT(0.813), 0);
+
+	y = _mm_sub_epi16(y, _mm_set1_epi16(16));
+	u = _mm_sub_epi16(u, _mm_set1_epi16(128));
+	v = _mm_sub_epi16(v, _mm_set1_epi16(128));
+
+	yu_l = _mm_unpacklo_epi16(y, u);
+	yu_h = _mm_unpackhi_epi16(y, u);
+	yv_l = _mm_unpacklo_epi16(y, v);
+	yv_h = _mm_unpackhi_epi16(y, v);
+	v_l = _mm_unpacklo_epi16(v, zero);
+	v_h = _mm_unpackhi_epi16(v, zero);
+
+	//R = RGB_Y[y] + R_V[v]
+	r = _mm_packs_epi32(
+	        _mm_srai_epi32(_mm_madd_epi16(yv_l, c_r), SCALEBITS_OUT),
+	        _mm_srai_epi32(_mm_madd_epi16(yv_h, c_r), SCALEBITS_OUT)
+	    );
+	//G = RGB_Y[y] - G_U[u] - G_V[v]
+	g = _mm_packs_epi32(
+	        _mm_srai_epi32(_mm_sub_epi32(_mm_madd_epi16(yu_l, c_g), _mm_madd_epi16(v_l, c_gv)), SCALEBITS_OUT),
+	        _mm_srai_epi32(_mm_sub_epi32(_mm_madd_epi16(yu_h, c_g), _mm_madd_epi16(v_h, c_gv)), SCALEBITS_OUT)
+	    );
+	//B = RGB_Y[y] + B_U[u]
+	b = _mm_packs_epi32(
+	        _mm_srai_epi32(_mm_madd_epi16(yu_l, c_b), SCALEBITS_OUT),
+	        _mm_srai_epi32(_mm_madd_epi16(yu_h, c_b), SCALEBITS_OUT)
+	    );
+
+	//clip and interleave as RGBA
+	r = _mm_packus_epi16(r, r);
+	g = _mm_packus_epi16(g, g);
+	b = _mm_packus_epi16(b, b);
+	rg = _mm_unpacklo_epi8(r, g);
+	ba = _mm_unpacklo_epi8(b, _mm_set1_epi8((char) 0xFF));
+	_mm_storeu_si128((__m128i *) dst, _mm_unpacklo_epi16(rg, ba));
+	_mm_storeu_si128((__m128i *) (dst+16), _mm_unpackhi_epi16(rg, ba));
+}
+
+/*8 bit planar line, chroma is either horizontally subsampled by 2 (420, 422) or not (444)*/
+static u32 yuv_load_line_sse2(u8 *dst, const u8 *y_src, const u8 *u_src, const u8 *v_src, u32 nb_px, Bool full_chroma)
+{
+	u32 i;
+	const __m128i zero = _mm_setzero_si128();
+
+	nb_px &= ~15;
+	for (i=0; i<nb_px; i+=16) {
+		__m128i y, u, v;
+		y = _mm_loadu_si128((const __m128i *) (y_src+i));
+		if (full_chroma) {
+			u = _mm_loadu_si128((const __m128i *) (u_src+i));
+			v = _mm_loadu_si128((const __m128i *) (v_src+i));
+		} else {
+			u = _mm_loadl_epi64((const __m128i *) (u_src+i/2));
+			v = _mm_loadl_epi64((const __m128i *) (v_src+i/2));
+			u = _mm_unpacklo_epi8(u, u);
+			v = _mm_unpacklo_epi8(v, v);
+		}
+		yuv_to_rgba_8px_sse2(dst + 4*i, _mm_unpacklo_epi8(y, zero), _mm_unpacklo_epi8(u, zero), _mm_unpacklo_epi8(v, zero));
+		yuv_to_rgba_8px_sse2(dst + 4*i + 32, _mm_unpackhi_epi8(y, zero), _mm_unpackhi_epi8(u, zero), _mm_unpackhi_epi8(v, zero));
+	}
+	return nb_px;
+}
+
+/*10 bit planar line, same as above with samples on 16 bits, downshifted to 8 bits*/
+static u32 yuv_10_load_line_sse2(u8 *dst, const u16 *y_src, const u16 *u_src, const u16 *v_src, u32 nb_px, Bool full_chroma)
+{
+	u32 i;
+
+	nb_px &= ~15;
+	for (i=0; i<nb_px; i+=16) {
+		__m128i y_l, y_h, u_l, u_h, v_l, v_h;
+		y_l = _mm_srli_epi16(_mm_loadu_si128((const __m128i *) (y_src+i)), 2);
+		y_h = _mm_srli_epi16(_mm_loadu_si128((const __m128i *) (y_src+i+8)), 2);
+		if (full_chroma) {
+			u_l = _mm_srli_epi16(_mm_loadu_si128((const __m128i *) (u_src+i)), 2);
+			u_h = _mm_srli_epi16(_mm_loadu_si128((const __m128i *) (u_src+i+8)), 2);
+			v_l = _mm_srli_epi16(_mm_loadu_si128((const __m128i *) (v_src+i)), 2);
+			v_h = _mm_srli_epi16(_mm_loadu_si128((const __m128i *) (v_src+i+8)), 2);
+		} else {
+			__m128i u = _mm_srli_epi16(_mm_loadu_si128((const __m128i *) (u_src+i/2)), 2);
+			__m128i v = _mm_srli_epi16(_mm_loadu_si128((const __m128i *) (v_src+i/2)), 2);
+			u_l = _mm_unpacklo_epi16(u, u);
+			u_h = _mm_unpackhi_epi16(u, u);
+			v_l = _mm_unpacklo_epi16(v, v);
+			v_h = _mm_unpackhi_epi16(v, v);
+		}
+		yuv_to_rgba_8px_sse2(dst + 4*i, y_l, u_l, v_l);
+		yuv_to_rgba_8px_sse2(dst + 4*i + 32, y_h, u_h, v_h);
+	}
+	return nb_px;
+}
+
+/*semi-planar line, u_src and v_src point to the first and second byte of the interleaved chroma plane (NV12) or the opposite (NV21)*/
+static u32 yuv_nv12_load_line_sse2(u8 *dst, const u8 *y_src, const u8 *u_src, const u8 *v_src, u32 nb_px)
+{
+	u32 i;
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i mask = _mm_set1_epi16(0x00FF);
+	const u8 *uv_src = (u_src < v_src) ? u_src : v_src;
+
+	nb_px &= ~15;
+	for (i=0; i<nb_px; i+=16) {
+		__m128i y, uv, c0, c1, u, v;
+		y = _mm_loadu_si128((const __m128i *) (y_src+i));
+		uv = _mm_loadu_si128((const __m128i *) (uv_src+i));
+		c0 = _mm_and_si128(uv, mask);
+		c1 = _mm_srli_epi16(uv, 8);
+		u = (u_src < v_src) ? c0 : c1;
+		v = (u_src < v_src) ? c1 : c0;
+		yuv_to_rgba_8px_sse2(dst + 4*i, _mm_unpacklo_epi8(y, zero), _mm_unpacklo_epi16(u, u), _mm_unpacklo_epi16(v, v));
+		yuv_to_rgba_8px_sse2(dst + 4*i + 32, _mm_unpackhi_epi8(y, zero), _mm_unpackhi_epi16(u, u), _mm_unpackhi_epi16(v, v));
+	}
+	return nb_px;
+}
+
+/*packed 422 line (YUYV and variants), y_src, u_src and v_src point to the first Y, U and V bytes of the first 4-byte macropixel*/
+static u32 yuv_packed_load_line_sse2(u8 *dst, const u8 *y_src, const u8 *u_src, const u8 *v_src, u32 nb_px)
+{
+	u32 i;
+	__m128i sh_y0, sh_y1, sh_u, sh_v;
+	const __m128i mask = _mm_set1_epi32(0xFF);
+	const u8 *src = MIN(y_src, MIN(u_src, v_src));
+
+	sh_y0 = _mm_cvtsi32_si128( (s32) (8 * (y_src - src)) );
+	sh_y1 = _mm_cvtsi32_si128( (s32) (8 * (y_src + 2 - src)) );
+	sh_u = _mm_cvtsi32_si128( (s32) (8 * (u_src - src)) );
+	sh_v = _mm_cvtsi32_si128( (s32) (8 * (v_src - src)) );
+
+	nb_px &= ~15;
+	for (i=0; i<nb_px; i+=16) {
+		__m128i m0, m1, y0, y1, u, v;
+		m0 = _mm_loadu_si128((const __m128i *) (src + 2*i));
+		m1 = _mm_loadu_si128((const __m128i *) (src + 2*i + 16));
+
+		y0 = _mm_packs_epi32(_mm_and_si128(_mm_srl_epi32(m0, sh_y0), mask), _mm_and_si128(_mm_srl_epi32(m1, sh_y0), mask));
+		y1 = _mm_packs_epi32(_mm_and_si128(_mm_srl_epi32(m0, sh_y1), mask), _mm_and_si128(_mm_srl_epi32(m1, sh_y1), mask));
+		u = _mm_packs_epi32(_mm_and_si128(_mm_srl_epi32(m0, sh_u), mask), _mm_and_si128(_mm_srl_epi32(m1, sh_u), mask));
+		v = _mm_packs_epi32(_mm_and_si128(_mm_srl_epi32(m0, sh_v), mask), _mm_and_si128(_mm_srl_epi32(m1, sh_v), mask));
+
+		yuv_to_rgba_8px_sse2(dst + 4*i, _mm_unpacklo_epi16(y0, y1), _mm_unpacklo_epi16(u, u), _mm_unpacklo_epi16(v, v));
+		yuv_to_rgba_8px_sse2(dst + 4*i + 32, _mm_unpackhi_epi16(y0, y1), _mm_unpackhi_epi16(u, u), _mm_unpackhi_epi16(v, v));
+	}
+	return nb_px;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GPAC_COLOR_HAS_AVX2
+#endif
+
+#ifdef GPAC_COLOR_HAS_AVX2
+#include <immintrin.h>
+
+/*SSE4.1 version of the 8 bit planar line loader, zero-extending samples at load time*/
+__attribute__((target("sse4.1")))
+static u32 yuv_load_line_sse41(u8 *dst, const u8 *y_src, const u8 *u_src, const u8 *v_src, u32 nb_px, Bool full_chroma)
+{
+	u32 i;
+
+	nb_px &= ~15;
+	for (i=0; i<nb_px; i+=16) {
+		__m128i y_l, y_h, u_l, u_h, v_l, v_h;
+		y_l = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *) (y_src+i)));
+		y_h = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *) (y_src+i+8)));
+		if (full_chroma) {
+			u_l = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *) (u_src+i)));
+			u_h = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *) (u_src+i+8)));
+			v_l = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *) (v_src+i)));
+			v_h = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *) (v_src+i+8)));
+		} else {
+			__m128i u = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *) (u_src+i/2)));
+			__m128i v = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *) (v_src+i/2)));
+			u_l = _mm_unpacklo_epi16(u, u);
+			u_h = _mm_unpackhi_epi16(u, u);
+			v_l = _mm_unpacklo_epi16(v, v);
+			v_h = _mm_unpackhi_epi16(v, v);
+		}
+		yuv_to_rgba_8px_sse2(dst + 4*i, y_l, u_l, v_l);
+		yuv_to_rgba_8px_sse2(dst + 4*i + 32, y_h, u_h, v_h);
+	}
+	return nb_px;
+}
+
+#define AVX2_COEF_PAIR(_lo, _hi)	_mm256_set1_epi32( (s32) ( ( ((u32) (u16) (_hi)) << 16) | (u16) (_lo) ) )
+
+/*AVX2 version of yuv_to_rgba_8px_sse2 for 16 pixels. Unpack and pack operations work within 128 bit lanes,
+so pixels 0-7 are in the low lane and 8-15 in the high lane until the final store*/
+__attribute__((target("avx2")))
+static GFINLINE void yuv_to_rgba_16px_avx2(u8 *dst, __m256i y, __m256i u, __m256i v)
+{
+	__m256i yu_l, yu_h, yv_l, yv_h, v_l, v_h, r, g, b, rg, ba, lo, hi;
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i c_r = AVX2_COEF_PAIR(FIX_OUT(1.164), FIX_OUT(1.596));
+	const __m256i c_g = AVX2_COEF_PAIR(FIX_OUT(1.164), -FIX_OUT(0.391));
+	const __m256i c_b = AVX2_COEF_PAIR(FIX_OUT(1.164), FIX_OUT(2.018));
+	const __m256i c_gv = AVX2_COEF_PAIR(FIX_OUT(0.813), 0);
+
+	y = _mm256_sub_epi16(y, _mm256_set1_epi16(16));
+	u = _mm256_sub_epi16(u, _mm256_set1_epi16(128));
+	v = _mm256_sub_epi16(v, _mm256_set1_epi16(128));
+
+	yu_l = _mm256_unpacklo_epi16(y, u);
+	yu_h = _mm256_unpackhi_epi16(y, u);
+	yv_l = _mm256_unpacklo_epi16(y, v);
+	yv_h = _mm256_unpackhi_epi16(y, v);
+	v_l = _mm256_unpacklo_epi16(v, zero);
+	v_h = _mm256_unpackhi_epi16(v, zero);
+
+	r = _mm256_packs_epi32(
+	        _mm256_srai_epi32(_mm256_madd_epi16(yv_l, c_r), SCALEBITS_OUT),
+	        _mm256_srai_epi32(_mm256_madd_epi16(yv_h, c_r), SCALEBITS_OUT)
+	    );
+	g = _mm256_packs_epi32(
+	        _mm256_srai_epi32(_mm256_sub_epi32(_mm256_madd_epi16(yu_l, c_g), _mm256_madd_epi16(v_l, c_gv)), SCALEBITS_OUT),
+	        _mm256_srai_epi32(_mm256_sub_epi32(_mm256_madd_epi16(yu_h, c_g), _mm256_madd_epi16(v_h, c_gv)), SCALEBITS_OUT)
+	    );
+	b = _mm256_packs_epi32(
+	        _mm256_srai_epi32(_mm256_madd_epi16(yu_l, c_b), SCALEBITS_OUT),
+	        _mm256_srai_epi32(_mm256_madd_epi16(yu_h, c_b), SCALEBITS_OUT)
+	    );
+
+	r = _mm256_packus_epi16(r, r);
+	g = _mm256_packus_epi16(g, g);
+	b = _mm256_packus_epi16(b, b);
+	rg = _mm256_unpacklo_epi8(r, g);
+	ba = _mm256_unpacklo_epi8(b, _mm256_set1_epi8((char) 0xFF));
+	//lo holds pixels 0-3 and 8-11, hi holds pixels 4-7 and 12-15
+	lo = _mm256_unpacklo_epi16(rg, ba);
+	hi = _mm256_unpackhi_epi16(rg, ba);
+	_mm256_storeu_si256((__m256i *) dst, _mm256_permute2x128_si256(lo, hi, 0x20));
+	_mm256_storeu_si256((__m256i *) (dst+32), _mm256_permute2x128_si256(lo, hi, 0x31));
+}
+
+/*AVX2 version of the 8 bit planar line loader, 32 pixels per iteration*/
+__attribute__((target("avx2")))
+static u32 yuv_load_line_avx2(u8 *dst, const u8 *y_src, const u8 *u_src, const u8 *v_src, u32 nb_px, Bool full_chroma)
+{
+	u32 i, j;
+
+	nb_px &= ~31;
+	for (i=0; i<nb_px; i+=32) {
+		for (j=i; j<i+32; j+=16) {
+			__m256i y, u, v;
+			y = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) (y_src+j)));
+			if (full_chroma) {
+				u = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) (u_src+j)));
+				v = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) (v_src+j)));
+			} else {
+				__m128i u8 = _mm_loadl_epi64((const __m128i *) (u_src+j/2));
+				__m128i v8 = _mm_loadl_epi64((const __m128i *) (v_src+j/2));
+				u = _mm256_cvtepu8_epi16(_mm_unpacklo_epi8(u8, u8));
+				v = _mm256_cvtepu8_epi16(_mm_unpacklo_epi8(v8, v8));
+			}
+			yuv_to_rgba_16px_avx2(dst + 4*j, y, u, v);
+		}
+	}
+	return nb_px;
+}
+
+/*AVX2 version of the semi-planar line loader, 32 pixels per iteration*/
+__attribute__((target("avx2")))
+static u32 yuv_nv12_load_line_avx2(u8 *dst, const u8 *y_src, const u8 *u_src, const u8 *v_src, u32 nb_px)
+{
+	u32 i, j;
+	const __m256i mask = _mm256_set1_epi32(0x0000FFFF);
+	const u8 *uv_src = (u_src < v_src) ? u_src : v_src;
+
+	nb_px &= ~31;
+	for (i=0; i<nb_px; i+=32) {
+		for (j=i; j<i+32; j+=16) {
+			__m256i y, uv, c0, c1;
+			y = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) (y_src+j)));
+			//one chroma pair per 32 bit word, duplicate first and second sample on both halves of the word
+			uv = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) (uv_src+j)));
+			c0 = _mm256_or_si256(_mm256_and_si256(uv, mask), _mm256_slli_epi32(uv, 16));
+			c1 = _mm256_or_si256(_mm256_andnot_si256(mask, uv), _mm256_srli_epi32(uv, 16));
+			if (u_src < v_src)
+				yuv_to_rgba_16px_avx2(dst + 4*j, y, c0, c1);
+			else
+				yuv_to_rgba_16px_avx2(dst + 4*j, y, c1, c0);
+		}
+	}
+	return nb_px;
+}
+#endif //GPAC_COLOR_HAS_AVX2
+
+/*SIMD level of the YUV line loaders, 0 meaning C code only*/
+enum
+{
+	YUV_SIMD_NONE = 0,
+	YUV_SIMD_SSE2,
+	YUV_SIMD_SSE41,
+	YUV_SIMD_AVX2,
+};
+static u32 yuv_simd_level = YUV_SIMD_NONE;
+static u32 (*yuv_load_line_simd)(u8 *dst, const u8 *y_src, const u8 *u_src, const u8 *v_src, u32 nb_px, Bool full_chroma) = yuv_load_line_sse2;
+static u32 (*yuv_nv12_load_line_simd)(u8 *dst, const u8 *y_src, const u8 *u_src, const u8 *v_src, u32 nb_px) = yuv_nv12_load_line_sse2;
+
+/*selects the line loaders from the CPU features, capped by the core simd option
+called once at system init (and again once command line options are parsed), never while conversions may run
+SSE4.1 and AVX2 only cover 8-bit planar (and NV12/NV21 for AVX2) sources, other YUV sources use SSE2 loaders*/
+void gf_color_simd_init()
+{
+	static s32 cpu_level = -1;
+	u32 level;
+	const char *opt;
+
+	if (cpu_level<0) {
+		level = YUV_SIMD_SSE2;
+#ifdef GPAC_COLOR_HAS_AVX2
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("sse4.1")) level = YUV_SIMD_SSE41;
+		if (__builtin_cpu_supports("avx2")) level = YUV_SIMD_AVX2;
+#endif
+		cpu_level = level;
+	}
+	level = (u32) cpu_level;
+	opt = gf_opts_get_key("core", "simd");
+	if (opt) {
+		if (!strcmp(opt, "none")) level = YUV_SIMD_NONE;
+		else if (!strcmp(opt, "sse2")) level = MIN(level, YUV_SIMD_SSE2);
+		else if (!strcmp(opt, "sse41")) level = MIN(level, YUV_SIMD_SSE41);
+	}
+
+	yuv_load_line_simd = yuv_load_line_sse2;
+	yuv_nv12_load_line_simd = yuv_nv12_load_line_sse2;
+#ifdef GPAC_COLOR_HAS_AVX2
+	if (level == YUV_SIMD_SSE41) {
+		yuv_load_line_simd = yuv_load_line_sse41;
+	} else if (level == YUV_SIMD_AVX2) {
+		yuv_load_line_simd = yuv_load_line_avx2;
+		yuv_nv12_load_line_simd = yuv_nv12_load_line_avx2;
+	}
+#endif
+	yuv_simd_level = level;
+}
+
+#else
+
+void gf_color_simd_init()
+{
+}
+
+#endif //GPAC_HAS_SSE2
+
 static void yuv_load_lines_planar(unsigned char *dst, s32 dststride, unsigned char *y_src, unsigned char *u_src, unsigned char * v_src, s32 y_stride, s32 uv_stride, s32 width, Bool dst_yuv)
 {
 	u32 hw, x;
@@ -113,7 +490,19 @@ static void yuv_load_lines_planar(unsigned char *dst, s32 dststride, unsigned ch
 		}
 		return;
 	}
-	for (x = 0; x < hw; x++) {
+	x = 0;
+#ifdef GPAC_HAS_SSE2
+	if (yuv_simd_level) {
+		x = yuv_load_line_simd(dst, y_src, u_src, v_src, 2*hw, GF_FALSE);
+		yuv_load_line_simd(dst2, y_src2, u_src, v_src, x, GF_FALSE);
+		dst += 4*x;
+		dst2 += 4*x;
+		y_src += x;
+		y_src2 += x;
+		x /= 2;
+	}
+#endif
+	for (; x < hw; x++) {
 		s32 u, v;
 		s32 b_u, g_uv, r_v, rgb_y;
 
@@ -197,7 +586,23 @@ static void yuv422_load_lines_planar(unsigned char *dst, s32 dststride, unsigned
 		return;
 	}
 
-	for (x = 0; x < hw; x++) {
+	x = 0;
+#ifdef GPAC_HAS_SSE2
+	if (yuv_simd_level) {
+		x = yuv_load_line_simd(dst, y_src, u_src, v_src, 2*hw, GF_FALSE);
+		yuv_load_line_simd(dst2, y_src2, u_src2, v_src2, x, GF_FALSE);
+		dst += 4*x;
+		dst2 += 4*x;
+		y_src += x;
+		y_src2 += x;
+		x /= 2;
+		u_src += x;
+		v_src += x;
+		u_src2 += x;
+		v_src2 += x;
+	}
+#endif
+	for (; x < hw; x++) {
 		s32 b_u, g_uv, r_v, rgb_y;
 
 		b_u = B_U[*u_src];
@@ -296,7 +701,23 @@ static void yuv444_load_lines_planar(unsigned char *dst, s32 dststride, unsigned
 		return;
 	}
 
-	for (x = 0; x < hw; x++) {
+	x = 0;
+#ifdef GPAC_HAS_SSE2
+	if (yuv_simd_level) {
+		x = yuv_load_line_simd(dst, y_src, u_src, v_src, 2*hw, GF_TRUE);
+		yuv_load_line_simd(dst2, y_src2, u_src2, v_src2, x, GF_TRUE);
+		dst += 4*x;
+		dst2 += 4*x;
+		y_src += x;
+		y_src2 += x;
+		u_src += x;
+		v_src += x;
+		u_src2 += x;
+		v_src2 += x;
+		x /= 2;
+	}
+#endif
+	for (; x < hw; x++) {
 		s32 b_u, g_uv, r_v, rgb_y;
 
 
@@ -393,7 +814,19 @@ static void yuv_10_load_lines_planar(unsigned char *dst, s32 dststride, unsigned
 		}
 		return;
 	}
-	for (x = 0; x < hw; x++) {
+	x = 0;
+#ifdef GPAC_HAS_SSE2
+	if (yuv_simd_level) {
+		x = yuv_10_load_line_sse2(dst, y_src, u_src, v_src, 2*hw, GF_FALSE);
+		yuv_10_load_line_sse2(dst2, y_src2, u_src, v_src, x, GF_FALSE);
+		dst += 4*x;
+		dst2 += 4*x;
+		y_src += x;
+		y_src2 += x;
+		x /= 2;
+	}
+#endif
+	for (; x < hw; x++) {
 		s32 u, v;
 		s32 b_u, g_uv, r_v, rgb_y;
 
@@ -480,7 +913,23 @@ static void yuv422_10_load_lines_planar(unsigned char *dst, s32 dststride, unsig
 		}
 		return;
 	}
-	for (x = 0; x < hw; x++) {
+	x = 0;
+#ifdef GPAC_HAS_SSE2
+	if (yuv_simd_level) {
+		x = yuv_10_load_line_sse2(dst, y_src, u_src, v_src, 2*hw, GF_FALSE);
+		yuv_10_load_line_sse2(dst2, y_src2, u_src2, v_src2, x, GF_FALSE);
+		dst += 4*x;
+		dst2 += 4*x;
+		y_src += x;
+		y_src2 += x;
+		x /= 2;
+		u_src += x;
+		v_src += x;
+		u_src2 += x;
+		v_src2 += x;
+	}
+#endif
+	for (; x < hw; x++) {
 		s32 b_u, g_uv, r_v, rgb_y;
 
 		b_u = B_U[*u_src >> 2];
@@ -580,7 +1029,23 @@ static void yuv444_10_load_lines_planar(unsigned char *dst, s32 dststride, unsig
 		}
 		return;
 	}
-	for (x = 0; x < hw; x++) {
+	x = 0;
+#ifdef GPAC_HAS_SSE2
+	if (yuv_simd_level) {
+		x = yuv_10_load_line_sse2(dst, y_src, u_src, v_src, 2*hw, GF_TRUE);
+		yuv_10_load_line_sse2(dst2, y_src2, u_src2, v_src2, x, GF_TRUE);
+		dst += 4*x;
+		dst2 += 4*x;
+		y_src += x;
+		y_src2 += x;
+		u_src += x;
+		v_src += x;
+		u_src2 += x;
+		v_src2 += x;
+		x /= 2;
+	}
+#endif
+	for (; x < hw; x++) {
 		s32 b_u, g_uv, r_v, rgb_y;
 
 
@@ -664,6 +1129,16 @@ static void yuv_load_lines_packed(unsigned char *dst, s32 dststride, unsigned ch
 		}
 		return;
 	}
+#ifdef GPAC_HAS_SSE2
+	if (yuv_simd_level) {
+		u32 nb_px = yuv_packed_load_line_sse2(dst, y_src, u_src, v_src, 2*hw);
+		dst += 4*nb_px;
+		y_src += 2*nb_px;
+		u_src += 2*nb_px;
+		v_src += 2*nb_px;
+		hw -= nb_px/2;
+	}
+#endif
 	while (hw) {
 		s32 b_u, g_uv, r_v, rgb_y;
 		hw--;
@@ -1613,9 +2088,10 @@ static void load_line_yv12_10(char *src_bits, u32 x_offset, u32 y_offset, u32 y_
 		pV = (u8 *)src_bits + 5*y_pitch*height/4;
 	}
 
-	pY += x_offset + y_offset*y_pitch;
-	pU += x_offset/2 + y_offset*y_pitch/4;
-	pV += x_offset/2 + y_offset*y_pitch/4;
+	//16 bits per sample
+	pY += 2*x_offset + y_offset*y_pitch;
+	pU += x_offset + y_offset*y_pitch/4;
+	pV += x_offset + y_offset*y_pitch/4;
 	yuv_10_load_lines_planar((unsigned char*)dst_bits, 4*width, pY, pU, pV, y_pitch, y_pitch/2, width, dst_yuv);
 }
 static void load_line_yuv422_10(char *src_bits, u32 x_offset, u32 y_offset, u32 y_pitch, u32 width, u32 height, u8 *dst_bits, u8 *pU, u8 *pV, Bool dst_yuv)
@@ -1676,7 +2152,7 @@ static void load_line_yuva(char *src_bits, u32 x_offset, u32 y_offset, u32 y_pit
 static void load_line_yuyv(u8 *src_bits, u32 x_offset, u32 y_offset, u32 y_pitch, u32 width, u32 height, u8 *dst_bits, Bool dst_yuv)
 {
 	u8 *pY, *pU, *pV;
-	pY = (u8 *)src_bits + x_offset + y_offset*y_pitch;
+	pY = (u8 *)src_bits + 2*x_offset + y_offset*y_pitch;
 	pU = (u8 *)pY + 1;
 	pV = (u8 *)pY + 3;
 	yuv_load_lines_packed((unsigned char*)dst_bits, 4*width, pY, pU, pV, width, dst_yuv);
@@ -1684,7 +2160,7 @@ static void load_line_yuyv(u8 *src_bits, u32 x_offset, u32 y_offset, u32 y_pitch
 static void load_line_uyvy(u8 *src_bits, u32 x_offset, u32 y_offset, u32 y_pitch, u32 width, u32 height, u8 *dst_bits, Bool dst_yuv)
 {
 	u8 *pY, *pU, *pV;
-	pU = (u8 *)src_bits + x_offset + y_offset*y_pitch;
+	pU = (u8 *)src_bits + 2*x_offset + y_offset*y_pitch;
 	pY = (u8 *)pU + 1;
 	pV = (u8 *)pU + 2;
 	yuv_load_lines_packed((unsigned char*)dst_bits, 4*width, pY, pU, pV, width, dst_yuv);
@@ -1692,7 +2168,7 @@ static void load_line_uyvy(u8 *src_bits, u32 x_offset, u32 y_offset, u32 y_pitch
 static void load_line_yvyu(u8 *src_bits, u32 x_offset, u32 y_offset, u32 y_pitch, u32 width, u32 height, u8 *dst_bits, Bool dst_yuv)
 {
 	u8 *pY, *pU, *pV;
-	pY = (u8 *)src_bits + x_offset + y_offset*y_pitch;
+	pY = (u8 *)src_bits + 2*x_offset + y_offset*y_pitch;
 	pV = (u8 *)pY + 1;
 	pU = (u8 *)pY + 3;
 	yuv_load_lines_packed((unsigned char*)dst_bits, 4*width, pY, pU, pV, width, dst_yuv);
@@ -1700,7 +2176,7 @@ static void load_line_yvyu(u8 *src_bits, u32 x_offset, u32 y_offset, u32 y_pitch
 static void load_line_vyuy(u8 *src_bits, u32 x_offset, u32 y_offset, u32 y_pitch, u32 width, u32 height, u8 *dst_bits, Bool dst_yuv)
 {
 	u8 *pY, *pU, *pV;
-	pV = (u8 *)src_bits + x_offset + y_offset*y_pitch;
+	pV = (u8 *)src_bits + 2*x_offset + y_offset*y_pitch;
 	pY = (u8 *)pV + 1;
 	pU = (u8 *)pV + 2;
 	yuv_load_lines_packed((unsigned char*)dst_bits, 4*width, pY, pU, pV, width, dst_yuv);
@@ -1740,7 +2216,19 @@ static void gf_yuv_load_lines_nv12_nv21(unsigned char *dst, s32 dststride, unsig
 		}
 		return;
 	}
-	for (x = 0; x < hw; x++) {
+	x = 0;
+#ifdef GPAC_HAS_SSE2
+	if (yuv_simd_level) {
+		x = yuv_nv12_load_line_simd(dst, y_src, u_src, v_src, 2*hw);
+		yuv_nv12_load_line_simd(dst2, y_src2, u_src, v_src, x);
+		dst += 4*x;
+		dst2 += 4*x;
+		y_src += x;
+		y_src2 += x;
+		x /= 2;
+	}
+#endif
+	for (; x < hw; x++) {
 		s32 u, v;
 		s32 b_u, g_uv, r_v, rgb_y;
 
@@ -2055,7 +2543,6 @@ GF_Err gf_stretch_bits(GF_VideoSurface *dst, GF_VideoSurface *src, GF_Window *ds
 		GF_LOG(GF_LOG_WARNING, GF_LOG_CORE, ("Source pixel format %s not supported by gf_stretch_bits\n", gf_pixel_fmt_name(src->pixel_format) ));
 		return GF_NOT_SUPPORTED;
 	}
-
 	/*only RGB output supported*/
 	switch (dst->pixel_format) {
 	case GF_PIXEL_RGB_555:
@@ -2539,19 +3026,6 @@ void gf_cmx_apply_fixed(GF_ColorMatrix *_this, Fixed *a, Fixed *r, Fixed *g, Fix
 #ifndef GPAC_DISABLE_PLAYER
 
 
-//intrinsic code segfaults on 32 bit, need to check why
-#if defined(GPAC_64_BITS)
-# if defined(WIN32) && !defined(__GNUC__)
-#  include <intrin.h>
-#  define GPAC_HAS_SSE2
-# else
-#  ifdef __SSE2__
-#   include <emmintrin.h>
-#   define GPAC_HAS_SSE2
-#  endif
-# endif
-#endif
-
 #ifdef GPAC_HAS_SSE2
 
 static GF_Err color_write_yv12_10_to_yuv_intrin(GF_VideoSurface *vs_dst, unsigned char *pY, unsigned char *pU, unsigned char*pV, u32 src_stride, u32 src_width, u32 src_height, const GF_Window *_src_wnd, Bool swap_uv)
@@ -108,6 +108,9 @@ static void gf_dm_data_received(GF_DownloadSession *sess, u8 *payload, u32 paylo
 static GF_Err gf_dm_read_data(GF_DownloadSession *sess, char *data, u32 data_size, u32 *out_read);
 
 static void gf_dm_connect(GF_DownloadSession *sess);
+static void gf_dm_pool_remove(GF_DownloadSession *sess);
+static void gf_dm_pool_del(GF_DownloadManager *dm);
+static void gf_dm_pool_release_socket(GF_DownloadSession *sess, GF_Socket *sock);
 GF_Err gf_dm_sess_send(GF_DownloadSession *sess, u8 *data, u32 size);
 
 /*internal flags*/
@@ -161,9 +164,16 @@ struct __gf_download_session
 	u32 reserved;
 
 	struct __gf_download_manager *dm;
-	GF_Thread *th;
 	GF_Mutex *mx;
 	GF_SessTask *ftask;
+	//set when the session is scheduled by the download manager I/O pool, pool_busy is set while a pool thread processes it
+	//and pool_parked while it waits for I/O on its socket
+	Bool in_pool, pool_busy, pool_parked;
+	u32 pool_park_time;
+	//socket select mode to wait for while a non-blocking connection or TLS handshake is pending, 0 otherwise
+	u32 io_wait;
+	//start time of the pending non-blocking connection or TLS handshake
+	u64 io_wait_start;
 
 	Bool in_callback, destroy;
 	u32 proxy_enabled;
@@ -290,7 +300,11 @@ struct __gf_download_manager
 	GF_List *sessions;
 	Bool disable_cache, simulate_no_connection, allow_offline_cache, clean_cache;
 	u32 limit_data_rate, read_buf_size;
-	u64 max_cache_size;
+	u64 max_cache_size, max_mem_cache_size;
+	//estimated disk cache usage, refreshed from the cache directory when evicting
+	u64 cache_disk_size;
+	u32 cache_hits, cache_misses, cache_evictions;
+	u64 cache_evicted_bytes;
 	Bool allow_broken_certificate;
 
 	GF_List *skip_proxy_servers;
@@ -310,6 +324,9 @@ struct __gf_download_manager
 
 	Bool (*local_cache_url_provider_cbk)(void *udta, char *url, Bool cache_destroy);
 	void *lc_udta;
+
+	//shared I/O thread pool for threaded sessions, created upon first threaded session
+	struct __dm_io_pool *io_pool;
 };
 
 #ifdef GPAC_HAS_SSL
@@ -362,6 +379,7 @@ void h2_detach_session(GF_H2_Session *h2_sess, GF_DownloadSession *sess)
 	if (!gf_list_count(h2_sess->sessions)) {
 		if (sess->sock) {
 			GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[Downloader] closing socket\n"));
+			gf_dm_pool_release_socket(sess, sess->sock);
 			gf_sk_del(sess->sock);
 			sess->sock = NULL;
 		}
@@ -1492,6 +1510,7 @@ static void gf_dm_configure_cache(GF_DownloadSession *sess)
 		GF_LOG(GF_LOG_INFO, GF_LOG_HTTP, ("[CACHE] Cache setup to %p %s\n", sess, gf_cache_get_cache_filename(sess->cache_entry)));
 
 		if (sess->cache_entry) {
+			gf_cache_entry_touch(sess->cache_entry);
 			if (sess->flags & GF_NETIO_SESSION_KEEP_FIRST_CACHE) {
 				sess->flags &= ~GF_NETIO_SESSION_KEEP_FIRST_CACHE;
 				gf_cache_entry_set_persistent(sess->cache_entry);
@@ -1504,6 +1523,7 @@ static void gf_dm_configure_cache(GF_DownloadSession *sess)
 		if ( (sess->allow_direct_reuse || sess->dm->allow_offline_cache) && !gf_cache_check_if_cache_file_is_corrupted(sess->cache_entry)
 		) {
 			sess->from_cache_only = GF_TRUE;
+			safe_int_inc(&sess->dm->cache_hits);
 			sess->connect_time = 0;
 			sess->status = GF_NETIO_CONNECTED;
 			GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTP] using existing cache entry\n"));
@@ -1792,6 +1812,7 @@ static void gf_dm_disconnect(GF_DownloadSession *sess, HTTPCloseType close_type)
 			if (sess->sock) {
 				GF_Socket * sx = sess->sock;
 				sess->sock = NULL;
+				gf_dm_pool_release_socket(sess, sx);
 				gf_sk_del(sx);
 			}
 		}
@@ -1815,22 +1836,17 @@ void gf_dm_sess_del(GF_DownloadSession *sess)
 
 	GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[Downloader] Destroy session URL %s\n", sess->orig_url));
 	/*self-destruction, let the download manager destroy us*/
-	if ((sess->th || sess->ftask) && sess->in_callback) {
+	if ((sess->in_pool || sess->ftask) && sess->in_callback) {
 		sess->destroy = GF_TRUE;
 		return;
 	}
+	/*if scheduled by the I/O pool, wait for the pool to release it*/
+	if (sess->in_pool)
+		gf_dm_pool_remove(sess);
+
 	gf_dm_disconnect(sess, HTTP_CLOSE);
 	gf_dm_sess_clear_headers(sess);
 
-	/*if threaded wait for thread exit*/
-	if (sess->th) {
-		while (!(sess->flags & GF_DOWNLOAD_SESSION_THREAD_DEAD))
-			gf_sleep(1);
-		gf_th_stop(sess->th);
-		gf_th_del(sess->th);
-		sess->th = NULL;
-	}
-
 	if (sess->dm) {
 		gf_mx_p(sess->dm->cache_mx);
 		gf_list_del_item(sess->dm->sessions, sess);
@@ -1875,6 +1891,7 @@ void gf_dm_sess_del(GF_DownloadSession *sess)
 #endif
 	if (sess->sock) {
 		GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[Downloader] closing socket\n"));
+		gf_dm_pool_release_socket(sess, sess->sock);
 		gf_sk_del(sess->sock);
 	}
 	gf_list_del(sess->headers);
@@ -2289,6 +2306,7 @@ GF_Err gf_dm_sess_setup_from_url(GF_DownloadSession *sess, const char *url, Bool
 #endif
 
 		if (sess->sock) {
+			gf_dm_pool_release_socket(sess, sess->sock);
 			gf_sk_del(sess->sock);
 			sess->sock = NULL;
 		}
@@ -2355,7 +2373,8 @@ Bool gf_dm_session_do_task(GF_DownloadSession *sess)
 		if (sess->status >= GF_NETIO_DISCONNECTED) {
 			do_run = GF_FALSE;
 		} else {
-			if (sess->status < GF_NETIO_CONNECTED) {
+			//connection or TLS handshake in progress
+			if ((sess->status < GF_NETIO_CONNECTED) || sess->io_wait_start) {
 				gf_dm_connect(sess);
 			} else {
 				sess->do_requests(sess);
@@ -2393,22 +2412,347 @@ Bool gf_dm_session_task(GF_FilterSession *fsess, void *callback, u32 *reschedule
 	return GF_FALSE;
 }
 
-static u32 gf_dm_session_thread(void *par)
+/*shared I/O pool for threaded sessions: a fixed number of threads steps runnable sessions in round-robin fashion.
+A session making no progress while waiting for network I/O is parked: its socket, registered in the pool socket group
+for its whole lifetime, is monitored until ready. A single thread at a time waits on the socket group, other idle threads
+wait on the pool semaphore. New work wakes both*/
+typedef struct __dm_io_pool
 {
-	GF_DownloadSession *sess = (GF_DownloadSession *)par;
-	if (!sess) return 0;
+	GF_DownloadManager *dm;
+	GF_Thread **threads;
+	u32 nb_threads;
+	//protects the session list and the pool state of sessions
+	GF_Mutex *mx;
+	GF_Semaphore *sema;
+	GF_List *sessions;
+	u32 next_sess, nb_parked;
+	//max number of concurrent HTTP/1.1 transfers per host, 0 means no limit
+	u32 max_host_conns;
+	//set when a thread is waiting on the socket group, wait_gen is incremented at the end of each wait
+	Bool has_waiter;
+	u32 wait_gen;
+	//max wait time in ms, shorter if the socket group cannot be woken up
+	u32 wait_ms;
+	GF_SockGroup *sg;
+	Bool exit;
+} GF_DMIOPool;
+
+//max time a session stays parked without being processed, so that its timeouts are checked
+#define DM_POOL_PARK_MS	1000
+
+static Bool gf_dm_pool_sess_active(GF_DownloadSession *sess)
+{
+#ifdef GPAC_HAS_HTTP2
+	//h2 streams are multiplexed on a single connection and do not count in host connections
+	if (sess->h2_sess) return GF_FALSE;
+#endif
+	//pending connections count as active
+	if ((sess->status < GF_NETIO_CONNECTED) && !sess->io_wait_start) return GF_FALSE;
+	if (sess->status >= GF_NETIO_DATA_TRANSFERED) return GF_FALSE;
+	return GF_TRUE;
+}
+
+//pool mutex shall be held
+static Bool gf_dm_pool_can_start(GF_DMIOPool *pool, GF_DownloadSession *sess)
+{
+	u32 i, count, nb_active=0;
+	if (!pool->max_host_conns) return GF_TRUE;
+	if ((sess->status != GF_NETIO_SETUP) || sess->io_wait_start) return GF_TRUE;
+	if (!sess->server_name) return GF_TRUE;
+
+	count = gf_list_count(pool->sessions);
+	for (i=0; i<count; i++) {
+		GF_DownloadSession *a_sess = gf_list_get(pool->sessions, i);
+		if (a_sess == sess) continue;
+		if (a_sess->port != sess->port) continue;
+		if (!a_sess->server_name || strcmp(a_sess->server_name, sess->server_name)) continue;
+		if (!gf_dm_pool_sess_active(a_sess)) continue;
+		nb_active++;
+		if (nb_active >= pool->max_host_conns) return GF_FALSE;
+	}
+	return GF_TRUE;
+}
+
+//pool mutex shall be held
+static GF_DownloadSession *gf_dm_pool_pick(GF_DMIOPool *pool)
+{
+	u32 i, count = gf_list_count(pool->sessions);
+	for (i=0; i<count; i++) {
+		GF_DownloadSession *sess;
+		u32 idx = (pool->next_sess + i) % count;
+		sess = gf_list_get(pool->sessions, idx);
+		if (sess->pool_busy || sess->pool_parked) continue;
+		if (!gf_dm_pool_can_start(pool, sess)) continue;
+		pool->next_sess = idx+1;
+		sess->pool_busy = GF_TRUE;
+		return sess;
+	}
+	return NULL;
+}
+
+//wakes up idle pool threads, including the one waiting on the socket group
+static void gf_dm_pool_signal(GF_DMIOPool *pool, u32 nb_sess)
+{
+	gf_sema_notify(pool->sema, nb_sess);
+	if (pool->has_waiter)
+		gf_sk_group_notify(pool->sg);
+}
+
+//checks if a session made no progress because it waits for I/O on its socket
+static Bool gf_dm_pool_can_park(GF_DownloadSession *sess, GF_SockSelectMode *mode)
+{
+	if (!sess->sock || sess->destroy) return GF_FALSE;
+	//pending connection or TLS handshake
+	if (sess->io_wait) {
+		*mode = sess->io_wait;
+		return GF_TRUE;
+	}
+	if ((sess->status != GF_NETIO_WAIT_FOR_REPLY) && (sess->status != GF_NETIO_DATA_EXCHANGE)) return GF_FALSE;
+	//TLS layer may have pending data not visible on the socket
+#ifdef GPAC_HAS_SSL
+	if (sess->ssl && SSL_pending(sess->ssl)) return GF_FALSE;
+#endif
+	*mode = GF_SK_SELECT_READ;
+	return GF_TRUE;
+}
+
+//pool mutex shall be held
+static void gf_dm_pool_park(GF_DMIOPool *pool, GF_DownloadSession *sess, GF_SockSelectMode mode)
+{
+	sess->pool_parked = GF_TRUE;
+	sess->pool_park_time = gf_sys_clock();
+	pool->nb_parked++;
+	//no-op if already registered, the socket stays in the group until destroyed
+	gf_sk_group_register(pool->sg, sess->sock);
+	gf_sk_group_sock_set_mode(pool->sg, sess->sock, GF_FALSE, mode);
+}
+
+//pool mutex shall be held
+static void gf_dm_pool_unpark(GF_DMIOPool *pool, GF_DownloadSession *sess)
+{
+	u32 i, count;
+	sess->pool_parked = GF_FALSE;
+	pool->nb_parked--;
+	//HTTP/2 sessions share their socket, keep monitoring it if another session is parked on it
+	count = gf_list_count(pool->sessions);
+	for (i=0; i<count; i++) {
+		GF_DownloadSession *a_sess = gf_list_get(pool->sessions, i);
+		if ((a_sess != sess) && a_sess->pool_parked && (a_sess->sock == sess->sock))
+			return;
+	}
+	gf_sk_group_sock_set_mode(pool->sg, sess->sock, GF_TRUE, GF_SK_SELECT_BOTH);
+}
+
+//waits for I/O on the sockets of parked sessions or for new work - called with pool mutex held and has_waiter set, returns with pool mutex released
+static void gf_dm_pool_wait(GF_DMIOPool *pool, u32 wait_ms)
+{
+	GF_Err e;
+	u32 i, count, now, nb_ready=0;
 
-	GF_LOG(GF_LOG_DEBUG, GF_LOG_CORE, ("[Downloader] Entering thread ID %d\n", gf_th_id() ));
+	gf_mx_v(pool->mx);
+	e = gf_sk_group_select(pool->sg, 1000*wait_ms, GF_SK_SELECT_READ);
+	if (e && (e!=GF_IP_NETWORK_EMPTY)) gf_sleep(1);
+
+	gf_mx_p(pool->mx);
+	now = gf_sys_clock();
+	count = gf_list_count(pool->sessions);
+	for (i=0; i<count; i++) {
+		GF_DownloadSession *sess = gf_list_get(pool->sessions, i);
+		if (!sess->pool_parked) continue;
+		//sessions parked for too long are processed anyway to check their timeouts
+		if (!gf_sk_group_sock_is_set(pool->sg, sess->sock, GF_SK_SELECT_BOTH) && (now - sess->pool_park_time < DM_POOL_PARK_MS))
+			continue;
+		gf_dm_pool_unpark(pool, sess);
+		nb_ready++;
+	}
+	pool->has_waiter = GF_FALSE;
+	pool->wait_gen++;
+	gf_mx_v(pool->mx);
+	//the waiting thread processes one of them
+	if (nb_ready>1)
+		gf_sema_notify(pool->sema, nb_ready-1);
+}
+
+static u32 gf_dm_pool_thread(void *par)
+{
+	u32 nb_idle = 0;
+	GF_DMIOPool *pool = (GF_DMIOPool *)par;
+
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[Downloader] Entering I/O pool thread ID %d\n", gf_th_id() ));
+	while (!pool->exit) {
+		GF_NetIOStatus status;
+		GF_SockSelectMode mode;
+		u32 bytes_done, count;
+		Bool ret, do_destroy=GF_FALSE;
+		GF_DownloadSession *sess;
+
+		gf_mx_p(pool->mx);
+		count = gf_list_count(pool->sessions) - pool->nb_parked;
+		sess = (nb_idle < count) ? gf_dm_pool_pick(pool) : NULL;
+		if (!sess) {
+			u32 wait_ms = pool->wait_ms;
+			//runnable sessions not making progress (eg held back by host limits), only wait a bit
+			if (nb_idle) wait_ms = 1;
+			nb_idle = 0;
+			if (pool->nb_parked && !pool->has_waiter) {
+				pool->has_waiter = GF_TRUE;
+				gf_dm_pool_wait(pool, wait_ms);
+			} else {
+				gf_mx_v(pool->mx);
+				gf_sema_wait_for(pool->sema, wait_ms);
+			}
+			continue;
+		}
+		gf_mx_v(pool->mx);
+		//never block on a single socket, sessions waiting for I/O are parked in the socket group
+		if (sess->sock) gf_sk_set_usec_wait(sess->sock, 0);
+
+		status = sess->status;
+		bytes_done = sess->bytes_done;
+		sess->io_wait = 0;
+		ret = gf_dm_session_do_task(sess);
+
+		gf_mx_p(pool->mx);
+		sess->pool_busy = GF_FALSE;
+		if (!ret) {
+			//once released, the session may be destroyed by the user at any time, only destroy it if requested from a callback
+			do_destroy = sess->destroy;
+			gf_list_del_item(pool->sessions, sess);
+			sess->in_pool = GF_FALSE;
+			sess->flags |= GF_DOWNLOAD_SESSION_THREAD_DEAD;
+		} else if ((status != sess->status) || (bytes_done != sess->bytes_done)) {
+			nb_idle = 0;
+		} else if (gf_dm_pool_can_park(sess, &mode)) {
+			gf_dm_pool_park(pool, sess, mode);
+		} else {
+			nb_idle++;
+		}
+		gf_mx_v(pool->mx);
+
+		if (!ret) {
+			//a slot may be available for a pending session on the same host
+			gf_dm_pool_signal(pool, 1);
+			if (do_destroy)
+				gf_dm_sess_del(sess);
+		}
+	}
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[Downloader] Exiting I/O pool thread ID %d\n", gf_th_id() ));
+	return 0;
+}
+
+static GF_Err gf_dm_pool_add(GF_DownloadSession *sess)
+{
+	GF_DMIOPool *pool;
+	GF_DownloadManager *dm = sess->dm;
+
+	gf_mx_p(dm->cache_mx);
+	pool = dm->io_pool;
+	if (!pool) {
+		u32 i;
+		GF_SAFEALLOC(pool, GF_DMIOPool);
+		if (!pool) {
+			gf_mx_v(dm->cache_mx);
+			return GF_OUT_OF_MEM;
+		}
+		pool->dm = dm;
+		pool->mx = gf_mx_new("DMIOPool");
+		pool->sema = gf_sema_new(GF_INT_MAX, 0);
+		pool->sessions = gf_list_new();
+		pool->sg = gf_sk_group_new();
+		pool->max_host_conns = gf_opts_get_int("core", "dm-host-conns");
+		pool->nb_threads = gf_opts_get_int("core", "dm-pool-threads");
+		if (!pool->nb_threads) pool->nb_threads = 1;
+		pool->threads = gf_malloc(sizeof(GF_Thread *) * pool->nb_threads);
+		if (!pool->mx || !pool->sema || !pool->sessions || !pool->sg || !pool->threads) {
+			dm->io_pool = pool;
+			pool->nb_threads = 0;
+			gf_dm_pool_del(dm);
+			gf_mx_v(dm->cache_mx);
+			return GF_OUT_OF_MEM;
+		}
+		//without wake-up support, new work is only seen at the end of a wait
+		pool->wait_ms = (gf_sk_group_notify(pool->sg)==GF_OK) ? DM_POOL_PARK_MS : 10;
+		for (i=0; i<pool->nb_threads; i++) {
+			pool->threads[i] = gf_th_new("DMIOPool");
+			gf_th_run(pool->threads[i], gf_dm_pool_thread, pool);
+		}
+		dm->io_pool = pool;
+		GF_LOG(GF_LOG_INFO, GF_LOG_HTTP, ("[Downloader] Started I/O pool with %d threads\n", pool->nb_threads));
+	}
+	gf_mx_v(dm->cache_mx);
+
+	gf_mx_p(pool->mx);
+	if (sess->in_pool) {
+		gf_mx_v(pool->mx);
+		GF_LOG(GF_LOG_WARNING, GF_LOG_HTTP, ("[HTTP] Session already started - ignoring start\n"));
+		return GF_OK;
+	}
+	sess->in_pool = GF_TRUE;
+	sess->pool_busy = GF_FALSE;
+	sess->pool_parked = GF_FALSE;
 	sess->flags &= ~GF_DOWNLOAD_SESSION_THREAD_DEAD;
-	while (!sess->destroy) {
-		Bool ret = gf_dm_session_do_task(sess);
-		if (!ret) break;
-		gf_sleep(0);
+	gf_list_add(pool->sessions, sess);
+	gf_dm_pool_signal(pool, 1);
+	gf_mx_v(pool->mx);
+	return GF_OK;
+}
+
+static void gf_dm_pool_remove(GF_DownloadSession *sess)
+{
+	u32 wait_gen;
+	GF_DMIOPool *pool = sess->dm ? sess->dm->io_pool : NULL;
+	if (!pool) return;
+	while (1) {
+		gf_mx_p(pool->mx);
+		if (!sess->pool_busy) break;
+		gf_mx_v(pool->mx);
+		gf_sleep(1);
 	}
+	gf_list_del_item(pool->sessions, sess);
+	sess->in_pool = GF_FALSE;
 	sess->flags |= GF_DOWNLOAD_SESSION_THREAD_DEAD;
-	if (sess->destroy)
-		gf_dm_sess_del(sess);
-	return 1;
+	if (!sess->pool_parked) {
+		gf_mx_v(pool->mx);
+		return;
+	}
+	gf_dm_pool_unpark(pool, sess);
+	//the socket may have been signaled in the current wait, make sure the wait is over before the socket can be destroyed
+	wait_gen = pool->wait_gen;
+	while (pool->has_waiter && (wait_gen == pool->wait_gen)) {
+		gf_sk_group_notify(pool->sg);
+		gf_mx_v(pool->mx);
+		gf_sleep(1);
+		gf_mx_p(pool->mx);
+	}
+	gf_mx_v(pool->mx);
+}
+
+static void gf_dm_pool_release_socket(GF_DownloadSession *sess, GF_Socket *sock)
+{
+	GF_DMIOPool *pool = sess->dm ? sess->dm->io_pool : NULL;
+	if (pool && sock)
+		gf_sk_group_unregister(pool->sg, sock);
+}
+
+static void gf_dm_pool_del(GF_DownloadManager *dm)
+{
+	u32 i;
+	GF_DMIOPool *pool = dm->io_pool;
+	if (!pool) return;
+	pool->exit = GF_TRUE;
+	if (pool->sema) gf_sema_notify(pool->sema, pool->nb_threads);
+	if (pool->sg) gf_sk_group_notify(pool->sg);
+	for (i=0; i<pool->nb_threads; i++) {
+		gf_th_stop(pool->threads[i]);
+		gf_th_del(pool->threads[i]);
+	}
+	if (pool->threads) gf_free(pool->threads);
+	if (pool->sessions) gf_list_del(pool->sessions);
+	if (pool->sg) gf_sk_group_del(pool->sg);
+	if (pool->sema) gf_sema_del(pool->sema);
+	if (pool->mx) gf_mx_del(pool->mx);
+	gf_free(pool);
+	dm->io_pool = NULL;
 }
 
 static GF_DownloadSession *gf_dm_sess_new_internal(GF_DownloadManager * dm, const char *url, u32 dl_flags,
@@ -2748,7 +3092,7 @@ static void gf_dm_connect(GF_DownloadSession *sess)
 {
 	GF_Err e;
 	u16 proxy_port = 0;
-	const char *proxy;
+	const char *proxy = NULL;
 
 #ifdef GPAC_HAS_HTTP2
 
@@ -2810,14 +3154,25 @@ static void gf_dm_connect(GF_DownloadSession *sess)
 #endif
 
 
+	//TLS handshake in progress
+	if (sess->io_wait_start && (sess->status == GF_NETIO_CONNECTED))
+		goto ssl_connect;
+
 	if (!sess->sock) {
 		sess->num_retry = 40;
 		sess->sock = gf_sk_new(GF_SOCK_TYPE_TCP);
+		//do not block pool threads while connecting
+		if (sess->in_pool) {
+			gf_sk_set_block_mode(sess->sock, GF_TRUE);
+			sess->io_wait_start = 0;
+		}
 	}
 
 	/*connect*/
 	sess->status = GF_NETIO_SETUP;
-	gf_dm_sess_notify_state(sess, sess->status, GF_OK);
+	//only notify once for a pending non-blocking connection
+	if (!sess->io_wait_start)
+		gf_dm_sess_notify_state(sess, sess->status, GF_OK);
 
 	/*PROXY setup*/
 	if (sess->proxy_enabled!=2) {
@@ -2853,7 +3208,9 @@ static void gf_dm_connect(GF_DownloadSession *sess)
 		proxy = sess->server_name;
 		proxy_port = sess->port;
 	}
-	GF_LOG(GF_LOG_INFO, GF_LOG_HTTP, ("[HTTP] Connecting to %s:%d\n", proxy, proxy_port));
+	if (!sess->io_wait_start) {
+		GF_LOG(GF_LOG_INFO, GF_LOG_HTTP, ("[HTTP] Connecting to %s:%d\n", proxy, proxy_port));
+	}
 
 	if (sess->status == GF_NETIO_SETUP) {
 		u64 now;
@@ -2865,8 +3222,23 @@ static void gf_dm_connect(GF_DownloadSession *sess)
 		}
 
 		now = gf_sys_clock_high_res();
+		if (sess->in_pool) {
+			if (!sess->io_wait_start) sess->io_wait_start = now;
+			now = sess->io_wait_start;
+		}
 		e = gf_sk_connect(sess->sock, (char *) proxy, proxy_port, NULL);
 
+		/*non-blocking connection in progress*/
+		if ((e == GF_IP_SOCK_WOULD_BLOCK) && sess->in_pool) {
+			if (gf_sys_clock_high_res() - now < 1000 * (u64) sess->request_timeout) {
+				sess->io_wait = GF_SK_SELECT_WRITE;
+				return;
+			}
+			GF_LOG(GF_LOG_ERROR, GF_LOG_HTTP, ("[HTTP] Timeout connecting to %s:%d\n", proxy, proxy_port));
+			e = GF_IP_CONNECTION_FAILURE;
+		}
+		sess->io_wait_start = 0;
+
 		/*retry*/
 		if ((e == GF_IP_SOCK_WOULD_BLOCK) && sess->num_retry) {
 			sess->status = GF_NETIO_SETUP;
@@ -2898,8 +3270,9 @@ static void gf_dm_connect(GF_DownloadSession *sess)
 //		gf_sk_set_buffer_size(sess->sock, GF_FALSE, GF_DOWNLOAD_BUFFER_SIZE);
 	}
 
+ssl_connect:
 #ifdef GPAC_HAS_SSL
-	if (!sess->ssl && (sess->flags & GF_DOWNLOAD_SESSION_USE_SSL)) {
+	if ((!sess->ssl || sess->io_wait_start) && (sess->flags & GF_DOWNLOAD_SESSION_USE_SSL)) {
 		u64 now = gf_sys_clock_high_res();
 		if (sess->dm && !sess->dm->ssl_ctx)
 			ssl_init(sess->dm, 0);
@@ -2909,14 +3282,27 @@ static void gf_dm_connect(GF_DownloadSession *sess)
 			X509 *cert;
 			Bool success;
 
-			sess->ssl = SSL_new(sess->dm->ssl_ctx);
-			SSL_set_fd(sess->ssl, gf_sk_get_handle(sess->sock));
-			SSL_ctrl(sess->ssl, SSL_CTRL_SET_TLSEXT_HOSTNAME, TLSEXT_NAMETYPE_host_name, (void*) proxy);
+			if (!sess->ssl) {
+				sess->ssl = SSL_new(sess->dm->ssl_ctx);
+				SSL_set_fd(sess->ssl, gf_sk_get_handle(sess->sock));
+				SSL_ctrl(sess->ssl, SSL_CTRL_SET_TLSEXT_HOSTNAME, TLSEXT_NAMETYPE_host_name, (void*) proxy);
+
+				SSL_set_connect_state(sess->ssl);
+				if (sess->in_pool) sess->io_wait_start = now;
+			}
+			if (sess->io_wait_start) now = sess->io_wait_start;
 
-			SSL_set_connect_state(sess->ssl);
 			ret = SSL_connect(sess->ssl);
 			if (ret<=0) {
 				ret = SSL_get_error(sess->ssl, ret);
+				/*non-blocking handshake in progress*/
+				if (sess->io_wait_start && ((ret==SSL_ERROR_WANT_READ) || (ret==SSL_ERROR_WANT_WRITE))
+					&& (gf_sys_clock_high_res() - now < 1000 * (u64) sess->request_timeout)
+				) {
+					sess->io_wait = (ret==SSL_ERROR_WANT_READ) ? GF_SK_SELECT_READ : GF_SK_SELECT_WRITE;
+					return;
+				}
+				sess->io_wait_start = 0;
 				if (ret==SSL_ERROR_SSL) {
 					char msg[1024];
 					SSL_load_error_strings();
@@ -2928,6 +3314,7 @@ static void gf_dm_connect(GF_DownloadSession *sess)
 					sess->last_error = GF_REMOTE_SERVICE_ERROR;
 				}
 			} else {
+				sess->io_wait_start = 0;
 				GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[SSL] connected\n"));
 
 
@@ -3037,6 +3424,10 @@ static void gf_dm_connect(GF_DownloadSession *sess)
 	}
 #endif
 
+	//connection and handshake done, back to blocking mode for request and response processing
+	if (sess->in_pool && sess->sock)
+		gf_sk_set_block_mode(sess->sock, GF_FALSE);
+
 	/*this should be done when building HTTP GET request in case we have range directives*/
 	gf_dm_configure_cache(sess);
 
@@ -3191,14 +3582,7 @@ GF_Err gf_dm_sess_process(GF_DownloadSession *sess)
 			gf_fs_post_user_task(sess->dm->filter_session, gf_dm_session_task, sess->ftask, "download");
 			return GF_OK;
 		}
-		if (sess->th) {
-			GF_LOG(GF_LOG_WARNING, GF_LOG_HTTP, ("[HTTP] Session already started - ignoring start\n"));
-			return GF_OK;
-		}
-		sess->th = gf_th_new( gf_file_basename(sess->orig_url) );
-		if (!sess->th) return GF_OUT_OF_MEM;
-		gf_th_run(sess->th, gf_dm_session_thread, sess);
-		return GF_OK;
+		return gf_dm_pool_add(sess);
 	}
 
 	if (sess->put_state==2) {
@@ -3322,20 +3706,261 @@ static void gf_cache_cleanup_cache(GF_DownloadManager * dm) {
 }
 #endif
 
+//cache is trimmed down to 80% of its max size when exceeded
+#define GF_CACHE_LOW_WATER(_size)	((_size) / 10 * 8)
+//cache file names are gpac_cache_ followed by the 40 hex chars of the URL hash, data file and property file share this key
+#define GF_CACHE_KEY_LEN	51
+
+typedef struct
+{
+	char *path;
+	const char *name;
+	u64 size, mtime;
+} GF_CacheFile;
+
 typedef struct
 {
-	Bool check_size;
-	u64 out_size;
-} cache_probe;
+	u32 first, nb_files;
+	u64 size, last_access;
+	DownloadedCacheEntry entry;
+	Bool in_use;
+} GF_CacheFileGroup;
 
+typedef struct
+{
+	GF_CacheFile *files;
+	u32 nb_files, nb_alloc;
+	u64 total;
+} GF_CacheScan;
+
+static Bool gf_dm_cache_scan_file(void *cbck, char *item_name, char *item_path, GF_FileEnumInfo *file_info)
+{
+	GF_CacheFile *f;
+	GF_CacheScan *scan = (GF_CacheScan *)cbck;
+	if (strncmp(item_name, "gpac_cache_", 11)) return GF_FALSE;
+
+	if (scan->nb_files == scan->nb_alloc) {
+		scan->nb_alloc = scan->nb_alloc ? 2*scan->nb_alloc : 256;
+		scan->files = gf_realloc(scan->files, sizeof(GF_CacheFile) * scan->nb_alloc);
+		if (!scan->files) {
+			scan->nb_files = scan->nb_alloc = 0;
+			return GF_TRUE;
+		}
+	}
+	f = &scan->files[scan->nb_files];
+	f->path = gf_strdup(item_path);
+	f->name = f->path + strlen(item_path) - strlen(item_name);
+	f->size = file_info->size;
+	f->mtime = file_info->last_modified;
+	scan->nb_files++;
+	scan->total += file_info->size;
+	return GF_FALSE;
+}
+
+static int gf_dm_cache_file_cmp(const void *a, const void *b)
+{
+	return strcmp(((GF_CacheFile *)a)->name, ((GF_CacheFile *)b)->name);
+}
+
+static int gf_dm_cache_group_access_cmp(const void *a, const void *b)
+{
+	u64 ta = ((GF_CacheFileGroup *)a)->last_access;
+	u64 tb = ((GF_CacheFileGroup *)b)->last_access;
+	if (ta<tb) return -1;
+	if (ta>tb) return 1;
+	return 0;
+}
+
+static int gf_dm_cache_entry_access_cmp(const void *a, const void *b)
+{
+	u64 ta = gf_cache_entry_get_last_access(*(DownloadedCacheEntry *)a);
+	u64 tb = gf_cache_entry_get_last_access(*(DownloadedCacheEntry *)b);
+	if (ta<tb) return -1;
+	if (ta>tb) return 1;
+	return 0;
+}
+
+static void gf_dm_cache_remove_entry(GF_DownloadManager *dm, DownloadedCacheEntry entry, u64 size)
+{
+	gf_list_del_item(dm->cache_entries, entry);
+	gf_cache_entry_set_delete_files_when_deleted(entry);
+	gf_cache_delete_entry(entry);
+	dm->cache_evictions++;
+	dm->cache_evicted_bytes += size;
+}
+
+/*evicts least recently used files from the disk cache until below the low water mark. Files of entries known to the
+download manager use the entry access time, other files (from previous runs) use their modification time*/
+static void gf_dm_cache_evict_disk(GF_DownloadManager *dm)
+{
+	u32 i, j, nb_groups, count;
+	u64 low_water, total;
+	GF_CacheFileGroup *groups = NULL;
+	GF_CacheScan scan;
+
+	memset(&scan, 0, sizeof(GF_CacheScan));
+	gf_mx_p(dm->cache_mx);
+	gf_enum_directory(dm->cache_directory, GF_FALSE, gf_dm_cache_scan_file, &scan, NULL);
+	dm->cache_disk_size = total = scan.total;
+	if (total < dm->max_cache_size) goto exit;
+
+	low_water = GF_CACHE_LOW_WATER(dm->max_cache_size);
+	GF_LOG(GF_LOG_INFO, GF_LOG_CACHE, ("[Cache] Cache size "LLU" exceeds max allowed "LLU", evicting least recently used files\n", total, dm->max_cache_size));
+
+	//group data and property files of the same entry
+	qsort(scan.files, scan.nb_files, sizeof(GF_CacheFile), gf_dm_cache_file_cmp);
+	groups = gf_malloc(sizeof(GF_CacheFileGroup) * scan.nb_files);
+	if (!groups) goto exit;
+	nb_groups = 0;
+	for (i=0; i<scan.nb_files; i++) {
+		GF_CacheFile *f = &scan.files[i];
+		GF_CacheFileGroup *g = nb_groups ? &groups[nb_groups-1] : NULL;
+		if (!g || (strlen(f->name) < GF_CACHE_KEY_LEN) || strncmp(scan.files[g->first].name, f->name, GF_CACHE_KEY_LEN)) {
+			g = &groups[nb_groups];
+			nb_groups++;
+			memset(g, 0, sizeof(GF_CacheFileGroup));
+			g->first = i;
+		}
+		g->nb_files++;
+		g->size += f->size;
+		g->last_access = MAX(g->last_access, f->mtime * 1000);
+	}
+
+	//use access time of known entries, and protect the ones in use
+	count = gf_list_count(dm->cache_entries);
+	for (i=0; i<count; i++) {
+		const char *name;
+		s32 lo, hi;
+		DownloadedCacheEntry entry = gf_list_get(dm->cache_entries, i);
+		if (gf_cache_entry_is_memory(entry)) continue;
+		name = gf_file_basename(gf_cache_get_cache_filename(entry));
+		if (!name || (strlen(name) < GF_CACHE_KEY_LEN)) continue;
+		lo = 0;
+		hi = nb_groups-1;
+		while (lo<=hi) {
+			s32 mid = (lo+hi)/2;
+			GF_CacheFileGroup *g = &groups[mid];
+			s32 res = strncmp(name, scan.files[g->first].name, GF_CACHE_KEY_LEN);
+			if (!res) {
+				g->entry = entry;
+				g->last_access = gf_cache_entry_get_last_access(entry);
+				g->in_use = gf_cache_entry_can_evict(entry) ? GF_FALSE : GF_TRUE;
+				break;
+			}
+			if (res<0) hi = mid-1;
+			else lo = mid+1;
+		}
+	}
+
+	qsort(groups, nb_groups, sizeof(GF_CacheFileGroup), gf_dm_cache_group_access_cmp);
+	for (i=0; (i<nb_groups) && (total > low_water); i++) {
+		GF_CacheFileGroup *g = &groups[i];
+		if (g->in_use) continue;
+		if (g->entry) {
+			gf_dm_cache_remove_entry(dm, g->entry, 0);
+		} else {
+			dm->cache_evictions++;
+		}
+		for (j=0; j<g->nb_files; j++) {
+			GF_CacheFile *f = &scan.files[g->first + j];
+			if (gf_file_exists(f->path) && (gf_file_delete(f->path) != GF_OK)) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_CACHE, ("[Cache] Failed to delete cache file %s\n", f->path));
+			}
+		}
+		dm->cache_evicted_bytes += g->size;
+		total -= g->size;
+	}
+	dm->cache_disk_size = total;
+	if (total > low_water) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_CACHE, ("[Cache] Cache size "LLU" still above "LLU" after eviction, all remaining files in use\n", total, low_water));
+	}
+
+exit:
+	gf_mx_v(dm->cache_mx);
+	for (i=0; i<scan.nb_files; i++)
+		gf_free(scan.files[i].path);
+	if (scan.files) gf_free(scan.files);
+	if (groups) gf_free(groups);
+}
+
+/*evicts least recently used memory entries until below the low water mark of the memory cache budget*/
+static void gf_dm_cache_evict_memory(GF_DownloadManager *dm)
+{
+	u32 i, count, nb_cands=0;
+	u64 total=0, low_water;
+	DownloadedCacheEntry *cands;
+
+	gf_mx_p(dm->cache_mx);
+	count = gf_list_count(dm->cache_entries);
+	for (i=0; i<count; i++) {
+		DownloadedCacheEntry entry = gf_list_get(dm->cache_entries, i);
+		if (gf_cache_entry_is_memory(entry))
+			total += gf_cache_entry_get_storage_size(entry);
+	}
+	if (total <= dm->max_mem_cache_size) {
+		gf_mx_v(dm->cache_mx);
+		return;
+	}
+	cands = gf_malloc(sizeof(DownloadedCacheEntry) * count);
+	if (!cands) {
+		gf_mx_v(dm->cache_mx);
+		return;
+	}
+	for (i=0; i<count; i++) {
+		DownloadedCacheEntry entry = gf_list_get(dm->cache_entries, i);
+		if (!gf_cache_entry_is_memory(entry) || !gf_cache_entry_can_evict(entry)) continue;
+		if (!gf_cache_entry_get_storage_size(entry)) continue;
+		cands[nb_cands++] = entry;
+	}
+	qsort(cands, nb_cands, sizeof(DownloadedCacheEntry), gf_dm_cache_entry_access_cmp);
+
+	low_water = GF_CACHE_LOW_WATER(dm->max_mem_cache_size);
+	for (i=0; (i<nb_cands) && (total > low_water); i++) {
+		u32 size = gf_cache_entry_get_storage_size(cands[i]);
+		gf_dm_cache_remove_entry(dm, cands[i], size);
+		total -= size;
+	}
+	gf_free(cands);
+	gf_mx_v(dm->cache_mx);
+}
+
+/*called once an entry is fully written in cache*/
+static void gf_dm_cache_entry_done(GF_DownloadSession *sess)
+{
+	GF_DownloadManager *dm = sess->dm;
+	if (!dm || !sess->cache_entry) return;
+
+	if (gf_cache_entry_is_memory(sess->cache_entry)) {
+		if (dm->max_mem_cache_size)
+			gf_dm_cache_evict_memory(dm);
+	} else if (dm->max_cache_size && !dm->clean_cache) {
+		gf_mx_p(dm->cache_mx);
+		dm->cache_disk_size += gf_cache_entry_get_storage_size(sess->cache_entry);
+		if (dm->cache_disk_size >= dm->max_cache_size)
+			gf_dm_cache_evict_disk(dm);
+		gf_mx_v(dm->cache_mx);
+	}
+}
 
 static void gf_dm_clean_cache(GF_DownloadManager *dm)
 {
-	u64 out_size = gf_cache_get_size(dm->cache_directory);
-	if (out_size >= dm->max_cache_size) {
-		GF_LOG(dm->max_cache_size ? GF_LOG_WARNING : GF_LOG_INFO, GF_LOG_HTTP, ("[Cache] Cache size %d exceeds max allowed %d, deleting entire cache\n", out_size, dm->max_cache_size));
+	if (!dm->max_cache_size) {
+		GF_LOG(GF_LOG_INFO, GF_LOG_HTTP, ("[Cache] Deleting entire cache\n"));
 		gf_cache_delete_all_cached_files(dm->cache_directory);
+		dm->cache_disk_size = 0;
+		return;
 	}
+	gf_dm_cache_evict_disk(dm);
+}
+
+GF_EXPORT
+void gf_dm_get_cache_stats(GF_DownloadManager *dm, u32 *nb_hits, u32 *nb_misses, u32 *nb_evictions, u64 *evicted_bytes)
+{
+	if (!dm) return;
+	if (nb_hits) *nb_hits = dm->cache_hits;
+	if (nb_misses) *nb_misses = dm->cache_misses;
+	if (nb_evictions) *nb_evictions = dm->cache_evictions;
+	if (evicted_bytes) *evicted_bytes = dm->cache_evicted_bytes;
 }
 
 GF_EXPORT
@@ -3426,6 +4051,7 @@ retry_cache:
 			gf_dm_clean_cache(dm);
 		}
 	}
+	dm->max_mem_cache_size = gf_opts_get_int("core", "cache-mem-size");
 	dm->allow_broken_certificate = gf_opts_get_bool("core", "broken-cert");
 
 	gf_mx_v( dm->cache_mx );
@@ -3477,6 +4103,7 @@ void gf_dm_del(GF_DownloadManager *dm)
 	}
 	gf_list_del(dm->sessions);
 	dm->sessions = NULL;
+	gf_dm_pool_del(dm);
 	assert( dm->skip_proxy_servers );
 	while (gf_list_count(dm->skip_proxy_servers)) {
 		char *serv = (char*)gf_list_get(dm->skip_proxy_servers, 0);
@@ -3508,6 +4135,8 @@ void gf_dm_del(GF_DownloadManager *dm)
 		dm->cache_entries = NULL;
 	}
 
+	GF_LOG(GF_LOG_INFO, GF_LOG_CACHE, ("[Cache] %d hits %d misses %d evictions ("LLU" bytes)\n", dm->cache_hits, dm->cache_misses, dm->cache_evictions, dm->cache_evicted_bytes));
+
 	gf_list_del( dm->partial_downloads );
 	dm->partial_downloads = NULL;
 	/* TODO: Not ready for now, we should find a locking strategy between several GPAC instances...
@@ -3796,6 +4425,7 @@ static void gf_dm_data_received(GF_DownloadSession *sess, u8 *payload, u32 paylo
 			gf_cache_close_write_cache(sess->cache_entry, sess, GF_TRUE);
 			GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP,
 			       ("[CACHE] url %s saved as %s\n", gf_cache_get_url(sess->cache_entry), gf_cache_get_cache_filename(sess->cache_entry)));
+			gf_dm_cache_entry_done(sess);
 		}
 
 		gf_dm_disconnect(sess, HTTP_NO_CLOSE);
@@ -3921,7 +4551,7 @@ GF_Err gf_dm_sess_fetch_data(GF_DownloadSession *sess, char *buffer, u32 buffer_
 		}
 		return GF_BAD_PARAM;
 	}
-	if (sess->th)
+	if (sess->in_pool)
 		return GF_BAD_PARAM;
 	if (sess->status == GF_NETIO_DISCONNECTED) {
 		if (!sess->init_data_size)
@@ -5362,6 +5992,7 @@ static GF_Err wait_for_header_and_parse(GF_DownloadSession *sess, char * sHTTP)
 	{
 		sess->status = GF_NETIO_PARSE_REPLY;
 		assert(sess->cache_entry);
+		if (sess->dm) safe_int_inc(&sess->dm->cache_hits);
 		sess->total_size = gf_cache_get_cache_filesize(sess->cache_entry);
 
 		gf_dm_sess_notify_state(sess, GF_NETIO_PARSE_REPLY, GF_OK);
@@ -5592,6 +6223,7 @@ static GF_Err wait_for_header_and_parse(GF_DownloadSession *sess, char * sHTTP)
 	} else {
 		sess->total_size = ContentLength;
 		if (sess->use_cache_file && sess->http_read_type == GET ) {
+			if (sess->dm) safe_int_inc(&sess->dm->cache_misses);
 			e = gf_cache_open_write_cache(sess->cache_entry, sess);
 			if (e) {
 				GF_LOG(GF_LOG_ERROR, GF_LOG_HTTP, ( "[CACHE] Failed to open cache, error=%d\n", e));
@@ -6022,7 +6654,7 @@ const char * gf_cache_get_cache_filename_range( const GF_DownloadSession * sess,
 GF_Err gf_dm_sess_reassign(GF_DownloadSession *sess, u32 flags, gf_dm_user_io user_io, void *cbk)
 {
 	/*shall only be called for non-threaded sessions!! */
-	if (sess->th)
+	if (sess->in_pool)
 		return GF_BAD_PARAM;
 
 	if (flags == 0xFFFFFFFF) {
@@ -6221,6 +6853,7 @@ const DownloadedCacheEntry gf_dm_add_cache_entry(GF_DownloadManager *dm, const c
 
 	gf_cache_set_content(the_entry, blob, clone_memory ? GF_TRUE : GF_FALSE, dm->cache_mx);
 	gf_cache_set_downtime(the_entry, download_time_ms);
+	gf_cache_entry_touch(the_entry);
 	gf_mx_v(dm->cache_mx );
 	return the_entry;
 }
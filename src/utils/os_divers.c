@@ -201,6 +201,22 @@ void gf_sleep(u32 ms)
 
 }
 
+GF_EXPORT
+void gf_usleep(u32 us)
+{
+#ifdef WIN32
+	//no sub-millisecond sleep on windows, round to the closest millisecond
+	Sleep((us+500)/1000);
+#else
+	struct timespec ts, rem;
+	ts.tv_sec = us / 1000000;
+	ts.tv_nsec = (long) (us % 1000000) * 1000;
+	while (nanosleep(&ts, &rem) && (errno == EINTR)) {
+		ts = rem;
+	}
+#endif
+}
+
 #ifndef gettimeofday
 #ifdef _WIN32_WCE
 
@@ -892,6 +908,10 @@ Bool gf_sys_has_filter_global_meta_args()
 	return gpac_has_global_filter_meta_args;
 }
 
+#ifndef GPAC_DISABLE_PLAYER
+void gf_color_simd_init();
+#endif
+
 static u32 gpac_quiet = 0;
 char gf_prog_lf = '\r';
 
@@ -1003,6 +1023,10 @@ GF_Err gf_sys_set_args(s32 argc, const char **argv)
 		}
 		//now that we have parsed all options, load restrict
 		gf_cfg_load_restrict();
+#ifndef GPAC_DISABLE_PLAYER
+		//reselect color conversion SIMD code in case -simd was set
+		gf_color_simd_init();
+#endif
 
 	}
 	//for OSX we allow overwrite of argc/argv due to different behavior between console-mode apps and GUI
@@ -1373,6 +1397,9 @@ GF_Err gf_sys_init(GF_MemTrackerType mem_tracker_type, const char *profile)
 		
 		gf_init_global_config(profile);
 
+#ifndef GPAC_DISABLE_PLAYER
+		gf_color_simd_init();
+#endif
 
 	}
 	sys_init += 1;
@@ -1299,6 +1299,150 @@ static GF_FileIO *gf_fileio_from_blob(const char *file_name)
 	gfio_blob->size = blob_size;
 	return gf_fileio_new((char *) file_name, gfio_blob, gfio_blob_open, gfio_blob_seek, gfio_blob_read, NULL, gfio_blob_tell, gfio_blob_eof, NULL);
 }
+
+typedef struct
+{
+	u8 *data;
+	u32 size, alloc, pos;
+} GF_FileIOMem;
+
+static GF_FileIO *gfio_mem_open(GF_FileIO *fileio_ref, const char *url, const char *mode, GF_Err *out_error)
+{
+	GF_FileIOMem *mem = gf_fileio_get_udta(fileio_ref);
+	*out_error = GF_OK;
+	if (!url) {
+		if (mode && (!strcmp(mode, "ref") || !strcmp(mode, "unref")))
+			return NULL;
+		if (mem->data) gf_free(mem->data);
+		gf_free(mem);
+		gf_fileio_del(fileio_ref);
+		return NULL;
+	}
+	*out_error = GF_NOT_SUPPORTED;
+	return NULL;
+}
+
+static Bool gfio_mem_realloc(GF_FileIOMem *mem, u32 size)
+{
+	u8 *data;
+	u32 alloc;
+	if (size <= mem->alloc) return GF_TRUE;
+	alloc = mem->alloc ? mem->alloc : 4096;
+	while (alloc < size) {
+		if (alloc >= 0x80000000) return GF_FALSE;
+		alloc *= 2;
+	}
+	data = gf_realloc(mem->data, alloc);
+	if (!data) return GF_FALSE;
+	mem->data = data;
+	mem->alloc = alloc;
+	return GF_TRUE;
+}
+
+static GF_Err gfio_mem_seek(GF_FileIO *fileio, u64 offset, s32 whence)
+{
+	GF_FileIOMem *mem = gf_fileio_get_udta(fileio);
+	s64 pos = (s64) offset;
+	if (whence==SEEK_END) pos += mem->size;
+	else if (whence==SEEK_CUR) pos += mem->pos;
+	if ((pos<0) || (pos > mem->size)) return GF_BAD_PARAM;
+	mem->pos = (u32) pos;
+	return GF_OK;
+}
+static u32 gfio_mem_read(GF_FileIO *fileio, u8 *buffer, u32 bytes)
+{
+	GF_FileIOMem *mem = gf_fileio_get_udta(fileio);
+	if (bytes > mem->size - mem->pos)
+		bytes = mem->size - mem->pos;
+	if (bytes) {
+		memcpy(buffer, mem->data + mem->pos, bytes);
+		mem->pos += bytes;
+	}
+	return bytes;
+}
+static u32 gfio_mem_write(GF_FileIO *fileio, u8 *buffer, u32 bytes)
+{
+	GF_FileIOMem *mem = gf_fileio_get_udta(fileio);
+	//flush
+	if (!buffer || !bytes) return 0;
+	if ((u64) mem->pos + bytes > 0xFFFFFFFFUL) return 0;
+	if (!gfio_mem_realloc(mem, mem->pos + bytes)) return 0;
+	memcpy(mem->data + mem->pos, buffer, bytes);
+	mem->pos += bytes;
+	if (mem->pos > mem->size) mem->size = mem->pos;
+	return bytes;
+}
+static int gfio_mem_printf(GF_FileIO *fileio, const char *format, va_list args)
+{
+	va_list args_copy;
+	int len;
+	GF_FileIOMem *mem = gf_fileio_get_udta(fileio);
+
+	//try formatting in place first, most calls fit in the remaining space
+	va_copy(args_copy, args);
+	len = vsnprintf((char *) mem->data + mem->pos, mem->alloc - mem->pos, format, args_copy);
+	va_end(args_copy);
+	if (len<0) return len;
+	if ((u32) len >= mem->alloc - mem->pos) {
+		if (!gfio_mem_realloc(mem, mem->pos + len + 1)) return -1;
+		vsnprintf((char *) mem->data + mem->pos, mem->alloc - mem->pos, format, args);
+	}
+	mem->pos += len;
+	if (mem->pos > mem->size) mem->size = mem->pos;
+	return len;
+}
+static s64 gfio_mem_tell(GF_FileIO *fileio)
+{
+	GF_FileIOMem *mem = gf_fileio_get_udta(fileio);
+	return (s64) mem->pos;
+}
+static Bool gfio_mem_eof(GF_FileIO *fileio)
+{
+	GF_FileIOMem *mem = gf_fileio_get_udta(fileio);
+	return (mem->pos==mem->size) ? GF_TRUE : GF_FALSE;
+}
+
+GF_EXPORT
+FILE *gf_file_mem_new(void)
+{
+	GF_FileIO *gfio;
+	GF_FileIOMem *mem;
+	GF_SAFEALLOC(mem, GF_FileIOMem);
+	if (!mem) return NULL;
+	gfio = gf_fileio_new(NULL, mem, gfio_mem_open, gfio_mem_seek, gfio_mem_read, gfio_mem_write, gfio_mem_tell, gfio_mem_eof, gfio_mem_printf);
+	if (!gfio) {
+		gf_free(mem);
+		return NULL;
+	}
+	return (FILE *) gfio;
+}
+
+static GF_FileIOMem *gf_file_mem_get(FILE *fp)
+{
+	GF_FileIO *gfio = (GF_FileIO *) fp;
+	if (!gf_fileio_check(fp) || (gfio->open != gfio_mem_open)) return NULL;
+	return gf_fileio_get_udta(gfio);
+}
+
+GF_EXPORT
+const u8 *gf_file_mem_get_data(FILE *fp, u32 *size)
+{
+	GF_FileIOMem *mem = gf_file_mem_get(fp);
+	if (!mem) {
+		if (size) *size = 0;
+		return NULL;
+	}
+	if (size) *size = mem->size;
+	return mem->data;
+}
+
+GF_EXPORT
+void gf_file_mem_reset(FILE *fp)
+{
+	GF_FileIOMem *mem = gf_file_mem_get(fp);
+	if (mem) mem->size = mem->pos = 0;
+}
+
 GF_EXPORT
 FILE *gf_fopen_ex(const char *file_name, const char *parent_name, const char *mode)
 {
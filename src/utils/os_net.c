@@ -94,6 +94,10 @@ static int wsa_init = 0;
 
 #else
 /*non-win32*/
+/*recvmmsg/sendmmsg*/
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
 #include <unistd.h>
 #include <fcntl.h>
 #include <netdb.h>
@@ -165,6 +169,19 @@ static u32 ipv6_check_state = 0;
 #include <sys/un.h>
 #endif
 
+/*use epoll for socket groups, avoiding FD_SETSIZE limitation and fd_set rebuild at each select*/
+#if defined(GPAC_CONFIG_LINUX) || defined(GPAC_CONFIG_ANDROID)
+#define GPAC_HAS_EPOLL
+#include <sys/epoll.h>
+/*zero-copy file send*/
+#define GPAC_HAS_SENDFILE
+#include <sys/sendfile.h>
+/*multiple datagrams per system call*/
+#define GPAC_HAS_MMSG
+#include <signal.h>
+#include <pthread.h>
+#endif
+
 GF_EXPORT
 const char *gf_errno_str(int errnoval)
 {
@@ -183,6 +200,10 @@ enum
 	/*socket is bound to a specific dest (server) or source (client) */
 	GF_SOCK_HAS_PEER = 1<<14,
 	GF_SOCK_IS_UN = 1<<15,
+	/*kernel drop counter requested for batched reception*/
+	GF_SOCK_RXQ_OVFL = 1<<16,
+	/*non-blocking TCP connection in progress*/
+	GF_SOCK_IS_CONNECTING = 1<<17,
 };
 
 struct __tag_socket
@@ -198,6 +219,23 @@ struct __tag_socket
 	u32 dest_addr_len;
 
 	u32 usec_wait;
+
+#ifdef GPAC_HAS_EPOLL
+	/*socket group and select call ID for which the socket was last signaled, and associated GF_SK_SELECT_* flags*/
+	struct __tag_sock_group *sel_group;
+	u32 sel_id;
+	u32 sel_flags;
+	/*socket handle registered in the epoll set of the group the socket belongs to, NULL_SOCKET if none*/
+	SOCKET epoll_socket;
+#endif
+	/*socket group monitoring state: paused, and select mode plus one overriding the group select mode (0 if none)*/
+	u8 sel_paused;
+	u8 sel_mode_plus_one;
+
+	/*batched datagram I/O stats*/
+	u64 batch_calls, batch_dgrams, batch_slots, batch_drops;
+	/*last kernel drop counter value*/
+	u32 rxq_ovfl;
 };
 
 
@@ -470,6 +508,9 @@ GF_EXPORT
 void gf_sk_del(GF_Socket *sock)
 {
 	assert( sock );
+	if (sock->batch_calls) {
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_NETWORK, ("[socket] batched I/O: "LLU" calls "LLU" datagrams - fill ratio %.02f %% - "LLU" drops\n", sock->batch_calls, sock->batch_dgrams, sock->batch_slots ? ((Double) sock->batch_dgrams*100)/sock->batch_slots : 0, sock->batch_drops));
+	}
 	gf_sk_free(sock);
 #ifdef WIN32
 	wsa_init --;
@@ -511,6 +552,55 @@ struct hostent *gf_gethostbyname(const char *PeerName)
 #endif
 
 
+static Bool gf_sk_connect_in_progress(u32 err)
+{
+#ifdef WIN32
+	if (err==WSAEWOULDBLOCK) return GF_TRUE;
+#else
+	if ((err==EINPROGRESS) || (err==EAGAIN)) return GF_TRUE;
+#endif
+	return GF_FALSE;
+}
+
+//checks completion of a non-blocking connection
+static GF_Err gf_sk_connect_check(GF_Socket *sock)
+{
+	s32 ready, err=0;
+#ifdef WIN32
+	int err_len = sizeof(s32);
+#else
+	socklen_t err_len = sizeof(s32);
+#endif
+	struct timeval timeout;
+	fd_set wgroup, egroup;
+
+	FD_ZERO(&wgroup);
+	FD_ZERO(&egroup);
+	FD_SET(sock->socket, &wgroup);
+	FD_SET(sock->socket, &egroup);
+	timeout.tv_sec = 0;
+	timeout.tv_usec = 0;
+	ready = select((int) sock->socket+1, NULL, &wgroup, &egroup, &timeout);
+	if (!ready) return GF_IP_SOCK_WOULD_BLOCK;
+
+	if ((ready == SOCKET_ERROR) || getsockopt(sock->socket, SOL_SOCKET, SO_ERROR, (char *) &err, &err_len))
+		err = LASTSOCKERROR;
+
+	sock->flags &= ~GF_SOCK_IS_CONNECTING;
+	if (err) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_NETWORK, ("[socket] Failed to connect: %s\n", gf_errno_str(err) ));
+		closesocket(sock->socket);
+		sock->socket = NULL_SOCKET;
+		return GF_IP_CONNECTION_FAILURE;
+	}
+#ifdef SO_NOSIGPIPE
+	err = 1;
+	setsockopt(sock->socket, SOL_SOCKET, SO_NOSIGPIPE, &err, sizeof(err));
+#endif
+	GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[socket] Connection established\n"));
+	return GF_OK;
+}
+
 //connects a socket to a remote peer on a given port
 GF_EXPORT
 GF_Err gf_sk_connect(GF_Socket *sock, const char *PeerName, u16 PortNumber, const char *local_ip)
@@ -523,6 +613,10 @@ GF_Err gf_sk_connect(GF_Socket *sock, const char *PeerName, u16 PortNumber, cons
 	struct hostent *Host = NULL;
 #endif
 
+	//non-blocking connection pending
+	if (sock->flags & GF_SOCK_IS_CONNECTING)
+		return gf_sk_connect_check(sock);
+
 	if (sock->flags & GF_SOCK_IS_UN) {
 #ifdef GPAC_HAS_SOCK_UN
 		struct sockaddr_un server_add;
@@ -590,6 +684,15 @@ GF_Err gf_sk_connect(GF_Socket *sock, const char *PeerName, u16 PortNumber, cons
 		if (sock->flags & GF_SOCK_IS_TCP) {
 			GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[Sock_IPV6] Connecting to %s:%d\n", PeerName, PortNumber));
 			ret = connect(sock->socket, aip->ai_addr, (int) aip->ai_addrlen);
+			if ((ret == SOCKET_ERROR) && (sock->flags & GF_SOCK_NON_BLOCKING) && gf_sk_connect_in_progress(LASTSOCKERROR)) {
+				GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[Sock_IPV6] Connection to %s:%d in progress\n", PeerName, PortNumber));
+				sock->flags |= GF_SOCK_IS_CONNECTING;
+				memcpy(&sock->dest_addr, aip->ai_addr, aip->ai_addrlen);
+				sock->dest_addr_len = (u32) aip->ai_addrlen;
+				freeaddrinfo(res);
+				if (lip) freeaddrinfo(lip);
+				return GF_IP_SOCK_WOULD_BLOCK;
+			}
 			if (ret == SOCKET_ERROR) {
 				closesocket(sock->socket);
 				sock->socket = NULL_SOCKET;
@@ -652,6 +755,11 @@ GF_Err gf_sk_connect(GF_Socket *sock, const char *PeerName, u16 PortNumber, cons
 	ret = connect(sock->socket, (struct sockaddr *) &sock->dest_addr, sizeof(struct sockaddr));
 	if (ret == SOCKET_ERROR) {
 		u32 res = LASTSOCKERROR;
+		if ((sock->flags & GF_SOCK_NON_BLOCKING) && (sock->flags & GF_SOCK_IS_TCP) && gf_sk_connect_in_progress(res)) {
+			GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[Sock_IPV4] Connection to %s:%d in progress\n", PeerName, PortNumber));
+			sock->flags |= GF_SOCK_IS_CONNECTING;
+			return GF_IP_SOCK_WOULD_BLOCK;
+		}
 		GF_LOG(GF_LOG_ERROR, GF_LOG_NETWORK, ("[Sock_IPV4] Couldn't connect socket: %s\n", gf_errno_str(res) ));
 		switch (res) {
 		case EAGAIN:
@@ -986,6 +1094,69 @@ GF_Err gf_sk_send(GF_Socket *sock, const u8 *buffer, u32 length)
 	return GF_OK;
 }
 
+GF_EXPORT
+GF_Err gf_sk_send_file(GF_Socket *sock, FILE *file, u64 offset, u32 length, u32 *written)
+{
+#ifdef GPAC_HAS_SENDFILE
+	int fd, err;
+	ssize_t res;
+	off_t off = (off_t) offset;
+	sigset_t pipe_mask, old_mask;
+#endif
+
+	if (written) *written = 0;
+	if (!sock || !sock->socket || !file)
+		return GF_BAD_PARAM;
+
+#ifdef GPAC_HAS_SENDFILE
+	if (!(sock->flags & GF_SOCK_IS_TCP) || (sock->flags & GF_SOCK_HAS_PEER))
+		return GF_NOT_SUPPORTED;
+	//memory or custom IO file
+	if (gf_fileio_check(file))
+		return GF_NOT_SUPPORTED;
+	fd = fileno(file);
+	if (fd<0)
+		return GF_NOT_SUPPORTED;
+
+	//sendfile has no MSG_NOSIGNAL equivalent, block SIGPIPE for this thread during the call
+	sigemptyset(&pipe_mask);
+	sigaddset(&pipe_mask, SIGPIPE);
+	pthread_sigmask(SIG_BLOCK, &pipe_mask, &old_mask);
+	res = sendfile(sock->socket, fd, &off, length);
+	err = errno;
+	if ((res<0) && (err==EPIPE)) {
+		//consume the pending signal before unblocking
+		struct timespec no_wait = {0, 0};
+		sigtimedwait(&pipe_mask, NULL, &no_wait);
+	}
+	pthread_sigmask(SIG_SETMASK, &old_mask, NULL);
+
+	if (res<0) {
+		switch (err) {
+		case EAGAIN:
+			return GF_IP_SOCK_WOULD_BLOCK;
+		case ENOTCONN:
+		case ECONNRESET:
+		case EPIPE:
+			GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[socket] sendfile failure: %s\n", gf_errno_str(err)));
+			return GF_IP_CONNECTION_CLOSED;
+		//file or socket type not supported by sendfile
+		case EINVAL:
+		case ENOSYS:
+		case EOVERFLOW:
+			return GF_NOT_SUPPORTED;
+		default:
+			GF_LOG(GF_LOG_ERROR, GF_LOG_NETWORK, ("[socket] sendfile failure: %s\n", gf_errno_str(err)));
+			return GF_IP_NETWORK_FAILURE;
+		}
+	}
+	if (written) *written = (u32) res;
+	return GF_OK;
+#else
+	return GF_NOT_SUPPORTED;
+#endif
+}
+
 GF_Err gf_sk_select(GF_Socket *sock, u32 mode)
 {
 #ifndef __SYMBIAN32__
@@ -1277,43 +1448,299 @@ GF_Err gf_sk_setup_multicast(GF_Socket *sock, const char *multi_IPAdd, u16 Multi
 }
 
 #include <gpac/list.h>
+#include <gpac/thread.h>
 struct __tag_sock_group
 {
 	GF_List *sockets;
 	fd_set rgroup, wgroup;
+	//protects the socket list, sockets may be registered, unregistered or paused while another thread waits on the group
+	GF_Mutex *mx;
+#ifndef WIN32
+	//wake-up pipe, the read end is monitored together with the sockets
+	int notify_fd[2];
+#endif
+
+#ifdef GPAC_HAS_EPOLL
+	//epoll instance, or -1 if not available (fallback to select)
+	int epoll_fd;
+	//select mode for which sockets are currently registered in epoll
+	GF_SockSelectMode epoll_mode;
+	//ID of the last select call
+	u32 sel_id;
+	struct epoll_event *events;
+	u32 nb_alloc_events;
+	//sockets registered before being created, added to epoll at next select
+	GF_List *epoll_pending;
+#endif
 };
 
+//get select mode of a socket in a group
+#define SK_GROUP_MODE(_sk, _mode) ((_sk)->sel_mode_plus_one ? (GF_SockSelectMode) ((_sk)->sel_mode_plus_one-1) : (_mode))
+
+#ifndef WIN32
+static void gf_sk_group_notify_reset(GF_SockGroup *sg)
+{
+	u8 buf[64];
+	while (read(sg->notify_fd[0], buf, 64) > 0) {}
+}
+#endif
+
+#ifdef GPAC_HAS_EPOLL
+static GFINLINE u32 gf_sk_group_epoll_flags(GF_SockSelectMode mode)
+{
+	if (mode==GF_SK_SELECT_READ) return EPOLLIN;
+	if (mode==GF_SK_SELECT_WRITE) return EPOLLOUT;
+	return EPOLLIN | EPOLLOUT;
+}
+
+static void gf_sk_group_epoll_ctl(GF_SockGroup *sg, GF_Socket *sk, int op)
+{
+	struct epoll_event ev;
+	//socket closed (failed connection), no longer in the epoll set
+	if (!sk->socket) return;
+	//closing a descriptor removes it from the epoll set, never remove a stale handle whose value may have been reused
+	if ((op==EPOLL_CTL_DEL) && (sk->epoll_socket != sk->socket)) {
+		sk->epoll_socket = NULL_SOCKET;
+		return;
+	}
+	memset(&ev, 0, sizeof(struct epoll_event));
+	//level-triggered: users of socket groups do not always drain the socket after a select
+	//paused sockets stay in the epoll set without any event
+	if (!sk->sel_paused)
+		ev.events = gf_sk_group_epoll_flags(SK_GROUP_MODE(sk, sg->epoll_mode));
+	ev.data.ptr = sk;
+	if (epoll_ctl(sg->epoll_fd, op, sk->socket, &ev) == 0) {
+		sk->epoll_socket = (op==EPOLL_CTL_DEL) ? NULL_SOCKET : sk->socket;
+	} else {
+		//socket may have been closed before unregister, in which case it is no longer in the epoll set
+		if (op==EPOLL_CTL_DEL) {
+			sk->epoll_socket = NULL_SOCKET;
+			if (errno==EBADF) return;
+		}
+		//socket handle recreated since registration (failed connection retried), add the new one
+		if ((op==EPOLL_CTL_MOD) && (errno==ENOENT) && (epoll_ctl(sg->epoll_fd, EPOLL_CTL_ADD, sk->socket, &ev) == 0)) {
+			sk->epoll_socket = sk->socket;
+			return;
+		}
+		//already in the set
+		if ((op==EPOLL_CTL_ADD) && (errno==EEXIST) && (epoll_ctl(sg->epoll_fd, EPOLL_CTL_MOD, sk->socket, &ev) == 0)) {
+			sk->epoll_socket = sk->socket;
+			return;
+		}
+		GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] cannot %s socket %d in epoll: %s\n", (op==EPOLL_CTL_ADD) ? "add" : ((op==EPOLL_CTL_DEL) ? "remove" : "modify"), sk->socket, gf_errno_str(errno) ));
+	}
+}
+
+static GF_Err gf_sk_group_select_epoll(GF_SockGroup *sg, u32 usec_wait, GF_SockSelectMode mode)
+{
+	s32 i, ready;
+	u32 count, nb_set;
+
+	gf_mx_p(sg->mx);
+	count = gf_list_count(sg->sockets);
+	//register sockets created since their registration to the group
+	for (i=0; i<(s32) gf_list_count(sg->epoll_pending); i++) {
+		GF_Socket *sk = gf_list_get(sg->epoll_pending, i);
+		if (!sk->socket) continue;
+		gf_list_rem(sg->epoll_pending, i);
+		i--;
+		gf_sk_group_epoll_ctl(sg, sk, EPOLL_CTL_ADD);
+	}
+
+	//socket handles closed (and possibly recreated) by gf_sk_connect since registration are no longer in the epoll set
+	for (i=0; i<(s32) count; i++) {
+		GF_Socket *sk = gf_list_get(sg->sockets, i);
+		if (sk->epoll_socket == sk->socket) continue;
+		if (gf_list_find(sg->epoll_pending, sk)>=0) continue;
+		sk->epoll_socket = NULL_SOCKET;
+		if (sk->socket) gf_sk_group_epoll_ctl(sg, sk, EPOLL_CTL_ADD);
+		else gf_list_add(sg->epoll_pending, sk);
+	}
+
+	//mode changed, update all registered sockets not using their own mode
+	if (mode != sg->epoll_mode) {
+		u32 j;
+		sg->epoll_mode = mode;
+		for (j=0; j<count; j++) {
+			GF_Socket *sk = gf_list_get(sg->sockets, j);
+			if (sk->sel_paused || sk->sel_mode_plus_one) continue;
+			if (gf_list_find(sg->epoll_pending, sk)>=0) continue;
+			gf_sk_group_epoll_ctl(sg, sk, EPOLL_CTL_MOD);
+		}
+	}
+	//one more event for the wake-up pipe
+	count++;
+	if (sg->nb_alloc_events < count) {
+		sg->nb_alloc_events = count;
+		sg->events = gf_realloc(sg->events, sizeof(struct epoll_event) * sg->nb_alloc_events);
+		if (!sg->events) {
+			sg->nb_alloc_events = 0;
+			gf_mx_v(sg->mx);
+			return GF_OUT_OF_MEM;
+		}
+	}
+	//new select call, invalidates previous socket states
+	sg->sel_id++;
+	gf_mx_v(sg->mx);
+
+	//epoll timeout is in ms, round up so that sub-ms waits do not turn into a busy poll
+	ready = epoll_wait(sg->epoll_fd, sg->events, (int) count, (int) (((u64) usec_wait + 999) / 1000) );
+
+	if (ready < 0) {
+		switch (errno) {
+		case EINTR:
+			/* Interrupted system call, not really important... */
+			GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] network is lost\n"));
+			return GF_IP_NETWORK_EMPTY;
+		default:
+			GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] cannot poll: %s\n", gf_errno_str(errno) ));
+			return GF_IP_NETWORK_FAILURE;
+		}
+	}
+	nb_set = 0;
+	gf_mx_p(sg->mx);
+	for (i=0; i<ready; i++) {
+		GF_Socket *sk = sg->events[i].data.ptr;
+		u32 evts = sg->events[i].events;
+		//wake-up pipe
+		if (!sk) {
+			gf_sk_group_notify_reset(sg);
+			continue;
+		}
+		sk->sel_group = sg;
+		sk->sel_id = sg->sel_id;
+		sk->sel_flags = 0;
+		//as with select, errors and hang-ups are reported as ready so that the next read/write reports them
+		if (evts & (EPOLLIN | EPOLLERR | EPOLLHUP)) sk->sel_flags |= 1<<GF_SK_SELECT_READ;
+		if (evts & (EPOLLOUT | EPOLLERR | EPOLLHUP)) sk->sel_flags |= 1<<GF_SK_SELECT_WRITE;
+		nb_set++;
+	}
+	gf_mx_v(sg->mx);
+	if (!nb_set) {
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_NETWORK, ("[socket] nothing to be read - ready %d\n", ready));
+		return GF_IP_NETWORK_EMPTY;
+	}
+	return GF_OK;
+}
+#endif
+
 GF_SockGroup *gf_sk_group_new()
 {
 	GF_SockGroup *tmp;
 	GF_SAFEALLOC(tmp, GF_SockGroup);
 	if (!tmp) return NULL;
 	tmp->sockets = gf_list_new();
+	tmp->mx = gf_mx_new("SockGroup");
 	FD_ZERO(&tmp->rgroup);
 	FD_ZERO(&tmp->wgroup);
+#ifndef WIN32
+	if (pipe(tmp->notify_fd) == 0) {
+		fcntl(tmp->notify_fd[0], F_SETFL, fcntl(tmp->notify_fd[0], F_GETFL, 0) | O_NONBLOCK);
+		fcntl(tmp->notify_fd[1], F_SETFL, fcntl(tmp->notify_fd[1], F_GETFL, 0) | O_NONBLOCK);
+	} else {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] cannot create socket group wake-up pipe: %s\n", gf_errno_str(errno) ));
+		tmp->notify_fd[0] = tmp->notify_fd[1] = -1;
+	}
+#endif
+#ifdef GPAC_HAS_EPOLL
+	tmp->epoll_mode = GF_SK_SELECT_READ;
+	tmp->epoll_pending = gf_list_new();
+	tmp->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	if (tmp->epoll_fd < 0) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] cannot create epoll instance (%s), using select\n", gf_errno_str(errno) ));
+	} else if (tmp->notify_fd[0] >= 0) {
+		struct epoll_event ev;
+		memset(&ev, 0, sizeof(struct epoll_event));
+		ev.events = EPOLLIN;
+		ev.data.ptr = NULL;
+		epoll_ctl(tmp->epoll_fd, EPOLL_CTL_ADD, tmp->notify_fd[0], &ev);
+	}
+#endif
 	return tmp;
 }
 
 void gf_sk_group_del(GF_SockGroup *sg)
 {
+#ifdef GPAC_HAS_EPOLL
+	if (sg->epoll_fd >= 0) close(sg->epoll_fd);
+	if (sg->events) gf_free(sg->events);
+	gf_list_del(sg->epoll_pending);
+#endif
+#ifndef WIN32
+	if (sg->notify_fd[0] >= 0) close(sg->notify_fd[0]);
+	if (sg->notify_fd[1] >= 0) close(sg->notify_fd[1]);
+#endif
 	gf_list_del(sg->sockets);
+	gf_mx_del(sg->mx);
 	gf_free(sg);
 }
 
 void gf_sk_group_register(GF_SockGroup *sg, GF_Socket *sk)
 {
 	if (sg && sk) {
-		if (gf_list_find(sg->sockets, sk)<0)
+		gf_mx_p(sg->mx);
+		if (gf_list_find(sg->sockets, sk)<0) {
 			gf_list_add(sg->sockets, sk);
+#ifdef GPAC_HAS_EPOLL
+			if (sg->epoll_fd >= 0) {
+				if (!sk->socket) gf_list_add(sg->epoll_pending, sk);
+				else gf_sk_group_epoll_ctl(sg, sk, EPOLL_CTL_ADD);
+			}
+#endif
+		}
+		gf_mx_v(sg->mx);
 	}
 }
 void gf_sk_group_unregister(GF_SockGroup *sg, GF_Socket *sk)
 {
 	if (sg && sk) {
+		gf_mx_p(sg->mx);
+#ifdef GPAC_HAS_EPOLL
+		if ((sg->epoll_fd >= 0) && (gf_list_find(sg->sockets, sk)>=0)) {
+			if (gf_list_del_item(sg->epoll_pending, sk)<0)
+				gf_sk_group_epoll_ctl(sg, sk, EPOLL_CTL_DEL);
+			if (sk->sel_group == sg) sk->sel_group = NULL;
+		}
+#endif
 		gf_list_del_item(sg->sockets, sk);
+		gf_mx_v(sg->mx);
 	}
 }
 
+GF_Err gf_sk_group_notify(GF_SockGroup *sg)
+{
+#ifndef WIN32
+	u8 val = 1;
+	if (!sg || (sg->notify_fd[1] < 0)) return GF_BAD_PARAM;
+	//pipe full, a notification is already pending
+	if ((write(sg->notify_fd[1], &val, 1) < 0) && (errno != EAGAIN))
+		return GF_IO_ERR;
+	return GF_OK;
+#else
+	return GF_NOT_SUPPORTED;
+#endif
+}
+
+void gf_sk_group_sock_set_mode(GF_SockGroup *sg, GF_Socket *sk, Bool paused, GF_SockSelectMode mode)
+{
+	if (!sg || !sk) return;
+	gf_mx_p(sg->mx);
+	sk->sel_paused = paused ? 1 : 0;
+	if (!paused) sk->sel_mode_plus_one = 1 + mode;
+#ifdef GPAC_HAS_EPOLL
+	if (sg->epoll_fd >= 0) {
+		if ((gf_list_find(sg->epoll_pending, sk)<0) && (gf_list_find(sg->sockets, sk)>=0))
+			gf_sk_group_epoll_ctl(sg, sk, EPOLL_CTL_MOD);
+		gf_mx_v(sg->mx);
+		return;
+	}
+#endif
+	gf_mx_v(sg->mx);
+	//select sets are built before waiting, restart a pending wait to monitor the resumed socket
+	if (!paused)
+		gf_sk_group_notify(sg);
+}
+
 GF_Err gf_sk_group_select(GF_SockGroup *sg, u32 usec_wait, GF_SockSelectMode mode)
 {
 	s32 ready;
@@ -1326,30 +1753,41 @@ GF_Err gf_sk_group_select(GF_SockGroup *sg, u32 usec_wait, GF_SockSelectMode mod
 	if (!gf_list_count(sg->sockets))
 		return GF_IP_NETWORK_EMPTY;
 
+#ifdef GPAC_HAS_EPOLL
+	if (sg->epoll_fd >= 0)
+		return gf_sk_group_select_epoll(sg, usec_wait, mode);
+#endif
+
 	FD_ZERO(&sg->rgroup);
 	FD_ZERO(&sg->wgroup);
 
-	switch (mode) {
-	case GF_SK_SELECT_BOTH:
-		rgroup = &sg->rgroup;
-		wgroup = &sg->wgroup;
-		break;
-	case GF_SK_SELECT_READ:
-		rgroup = &sg->rgroup;
-		break;
-	case GF_SK_SELECT_WRITE:
-		wgroup = &sg->wgroup;
-		break;
-	}
+	gf_mx_p(sg->mx);
 	while ((sock = gf_list_enum(sg->sockets, &i))) {
-		if (rgroup)
+		GF_SockSelectMode sk_mode;
+		if (sock->sel_paused) continue;
+		sk_mode = SK_GROUP_MODE(sock, mode);
+		if (sk_mode != GF_SK_SELECT_WRITE) {
+			rgroup = &sg->rgroup;
 			FD_SET(sock->socket, rgroup);
-
-		if (wgroup)
+		}
+		if (sk_mode != GF_SK_SELECT_READ) {
+			wgroup = &sg->wgroup;
 			FD_SET(sock->socket, wgroup);
+		}
 
 		if (max_fd < (u32) sock->socket) max_fd = (u32) sock->socket;
 	}
+	gf_mx_v(sg->mx);
+#ifndef WIN32
+	if (sg->notify_fd[0] >= 0) {
+		rgroup = &sg->rgroup;
+		FD_SET(sg->notify_fd[0], rgroup);
+		if (max_fd < (u32) sg->notify_fd[0]) max_fd = (u32) sg->notify_fd[0];
+	}
+#endif
+	if (!rgroup && !wgroup)
+		return GF_IP_NETWORK_EMPTY;
+
 	if (usec_wait>=1000000) {
 		timeout.tv_sec = usec_wait/1000000;
 		timeout.tv_usec = (u32) (usec_wait - (timeout.tv_sec*1000000));
@@ -1375,6 +1813,12 @@ GF_Err gf_sk_group_select(GF_SockGroup *sg, u32 usec_wait, GF_SockSelectMode mod
 			return GF_IP_NETWORK_FAILURE;
 		}
 	}
+#ifndef WIN32
+	if ((ready>0) && (sg->notify_fd[0] >= 0) && FD_ISSET(sg->notify_fd[0], &sg->rgroup)) {
+		gf_sk_group_notify_reset(sg);
+		ready--;
+	}
+#endif
 	if (!ready) {
 		GF_LOG(GF_LOG_DEBUG, GF_LOG_NETWORK, ("[socket] nothing to be read - ready %d\n", ready));
 		return GF_IP_NETWORK_EMPTY;
@@ -1384,6 +1828,17 @@ GF_Err gf_sk_group_select(GF_SockGroup *sg, u32 usec_wait, GF_SockSelectMode mod
 
 Bool gf_sk_group_sock_is_set(GF_SockGroup *sg, GF_Socket *sk, GF_SockSelectMode mode)
 {
+#ifdef GPAC_HAS_EPOLL
+	if (sg && sk && (sg->epoll_fd >= 0)) {
+		if ((sk->sel_group != sg) || (sk->sel_id != sg->sel_id))
+			return GF_FALSE;
+		if ((mode!=GF_SK_SELECT_WRITE) && (sk->sel_flags & (1<<GF_SK_SELECT_READ)))
+			return GF_TRUE;
+		if ((mode!=GF_SK_SELECT_READ) && (sk->sel_flags & (1<<GF_SK_SELECT_WRITE)))
+			return GF_TRUE;
+		return GF_FALSE;
+	}
+#endif
 	if (sg && sk) {
 		if ((mode!=GF_SK_SELECT_WRITE) && FD_ISSET(sk->socket, &sg->rgroup))
 			return GF_TRUE;
@@ -1488,6 +1943,325 @@ GF_Err gf_sk_receive_no_select(GF_Socket *sock, u8 *buffer, u32 length, u32 *Byt
 	return gf_sk_receive_internal(sock, buffer, length, BytesRead, GF_FALSE);
 }
 
+struct __tag_sock_batch
+{
+	u32 nb_slots, slot_size;
+	u8 *data;
+	u32 *sizes;
+	/*first datagram and number of datagrams available (reception) or queued (emission)*/
+	u32 first, nb_items;
+#ifdef GPAC_HAS_MMSG
+	struct mmsghdr *msgs;
+	struct iovec *iovs;
+	/*control data per slot for kernel drop counter*/
+	u8 *ctrl;
+	u32 ctrl_size;
+#endif
+};
+
+GF_EXPORT
+GF_SockBatch *gf_sk_batch_new(u32 nb_slots, u32 slot_size)
+{
+	GF_SockBatch *batch;
+	if (!nb_slots || !slot_size) return NULL;
+	GF_SAFEALLOC(batch, GF_SockBatch);
+	if (!batch) return NULL;
+	batch->nb_slots = nb_slots;
+	batch->slot_size = slot_size;
+	batch->data = gf_malloc(sizeof(u8) * nb_slots * slot_size);
+	batch->sizes = gf_malloc(sizeof(u32) * nb_slots);
+#ifdef GPAC_HAS_MMSG
+	batch->ctrl_size = CMSG_SPACE(sizeof(u32));
+	batch->msgs = gf_malloc(sizeof(struct mmsghdr) * nb_slots);
+	batch->iovs = gf_malloc(sizeof(struct iovec) * nb_slots);
+	batch->ctrl = gf_malloc(sizeof(u8) * nb_slots * batch->ctrl_size);
+	if (!batch->msgs || !batch->iovs || !batch->ctrl) {
+		gf_sk_batch_del(batch);
+		return NULL;
+	}
+#endif
+	if (!batch->data || !batch->sizes) {
+		gf_sk_batch_del(batch);
+		return NULL;
+	}
+	return batch;
+}
+
+GF_EXPORT
+void gf_sk_batch_del(GF_SockBatch *batch)
+{
+	if (!batch) return;
+	if (batch->data) gf_free(batch->data);
+	if (batch->sizes) gf_free(batch->sizes);
+#ifdef GPAC_HAS_MMSG
+	if (batch->msgs) gf_free(batch->msgs);
+	if (batch->iovs) gf_free(batch->iovs);
+	if (batch->ctrl) gf_free(batch->ctrl);
+#endif
+	gf_free(batch);
+}
+
+GF_EXPORT
+u8 *gf_sk_batch_get(GF_SockBatch *batch, u32 idx, u32 *size)
+{
+	if (!batch || (idx >= batch->nb_items)) return NULL;
+	idx += batch->first;
+	if (size) *size = batch->sizes[idx];
+	return batch->data + idx * batch->slot_size;
+}
+
+GF_EXPORT
+u8 *gf_sk_batch_reserve(GF_SockBatch *batch, u32 *max_size)
+{
+	u32 idx;
+	if (!batch) return NULL;
+	//all sent, restart from first slot
+	if (!batch->nb_items) batch->first = 0;
+	idx = batch->first + batch->nb_items;
+	if (idx >= batch->nb_slots) return NULL;
+	if (max_size) *max_size = batch->slot_size;
+	return batch->data + idx * batch->slot_size;
+}
+
+GF_EXPORT
+GF_Err gf_sk_batch_commit(GF_SockBatch *batch, u32 size)
+{
+	u32 idx;
+	if (!batch) return GF_BAD_PARAM;
+	if (!batch->nb_items) batch->first = 0;
+	idx = batch->first + batch->nb_items;
+	if ((idx >= batch->nb_slots) || (size > batch->slot_size)) return GF_BAD_PARAM;
+	batch->sizes[idx] = size;
+	batch->nb_items++;
+	return GF_OK;
+}
+
+GF_EXPORT
+GF_Err gf_sk_batch_add(GF_SockBatch *batch, const u8 *data, u32 size)
+{
+	u32 max_size;
+	u8 *slot = gf_sk_batch_reserve(batch, &max_size);
+	if (!slot || (size > max_size)) return GF_BUFFER_TOO_SMALL;
+	memcpy(slot, data, size);
+	return gf_sk_batch_commit(batch, size);
+}
+
+GF_EXPORT
+u32 gf_sk_batch_pending(GF_SockBatch *batch)
+{
+	return batch ? batch->nb_items : 0;
+}
+
+GF_EXPORT
+void gf_sk_batch_reset(GF_SockBatch *batch)
+{
+	if (batch) batch->first = batch->nb_items = 0;
+}
+
+GF_EXPORT
+GF_Err gf_sk_receive_batch(GF_Socket *sock, GF_SockBatch *batch, u32 *nb_datagrams)
+{
+	u32 i;
+	GF_Err e = GF_OK;
+	if (nb_datagrams) *nb_datagrams = 0;
+	if (!sock || !sock->socket || !batch) return GF_BAD_PARAM;
+	batch->first = batch->nb_items = 0;
+
+#ifdef GPAC_HAS_MMSG
+	if (!(sock->flags & GF_SOCK_IS_TCP)) {
+		s32 res;
+		if (!(sock->flags & GF_SOCK_RXQ_OVFL)) {
+			int on = 1;
+			setsockopt(sock->socket, SOL_SOCKET, SO_RXQ_OVFL, &on, sizeof(on));
+			sock->flags |= GF_SOCK_RXQ_OVFL;
+		}
+		for (i=0; i<batch->nb_slots; i++) {
+			struct msghdr *hdr = &batch->msgs[i].msg_hdr;
+			batch->iovs[i].iov_base = batch->data + i * batch->slot_size;
+			batch->iovs[i].iov_len = batch->slot_size;
+			memset(hdr, 0, sizeof(struct msghdr));
+			hdr->msg_iov = &batch->iovs[i];
+			hdr->msg_iovlen = 1;
+			hdr->msg_control = batch->ctrl + i * batch->ctrl_size;
+			hdr->msg_controllen = batch->ctrl_size;
+			//same behavior as recvfrom: store address of last sender
+			if (sock->flags & GF_SOCK_HAS_PEER) {
+				hdr->msg_name = &sock->dest_addr;
+				hdr->msg_namelen = sizeof(sock->dest_addr);
+			}
+		}
+		res = recvmmsg(sock->socket, batch->msgs, batch->nb_slots, MSG_WAITFORONE, NULL);
+		if (res == SOCKET_ERROR) {
+			switch (LASTSOCKERROR) {
+			case EAGAIN:
+				return GF_IP_SOCK_WOULD_BLOCK;
+			case EINTR:
+				return GF_IP_NETWORK_EMPTY;
+			case ENOTCONN:
+			case ECONNRESET:
+			case ECONNABORTED:
+				GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] error reading: %s\n", gf_errno_str(LASTSOCKERROR)));
+				return GF_IP_CONNECTION_CLOSED;
+			default:
+				GF_LOG(GF_LOG_ERROR, GF_LOG_NETWORK, ("[socket] error reading: %s\n", gf_errno_str(LASTSOCKERROR) ));
+				return GF_IP_NETWORK_FAILURE;
+			}
+		}
+		if (!res) return GF_IP_NETWORK_EMPTY;
+
+		for (i=0; i<(u32) res; i++) {
+			struct cmsghdr *cmsg;
+			struct msghdr *hdr = &batch->msgs[i].msg_hdr;
+			batch->sizes[i] = batch->msgs[i].msg_len;
+			if (hdr->msg_flags & MSG_TRUNC) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] datagram larger than %d bytes, truncated\n", batch->slot_size));
+				sock->batch_drops++;
+			}
+			for (cmsg = CMSG_FIRSTHDR(hdr); cmsg; cmsg = CMSG_NXTHDR(hdr, cmsg)) {
+				u32 ovfl;
+				if ((cmsg->cmsg_level != SOL_SOCKET) || (cmsg->cmsg_type != SO_RXQ_OVFL)) continue;
+				memcpy(&ovfl, CMSG_DATA(cmsg), sizeof(u32));
+				//kernel counter is cumulative
+				if (ovfl != sock->rxq_ovfl) {
+					GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] %u datagrams dropped by kernel, consider increasing socket buffer size\n", ovfl - sock->rxq_ovfl));
+					sock->batch_drops += ovfl - sock->rxq_ovfl;
+					sock->rxq_ovfl = ovfl;
+				}
+			}
+		}
+		if (sock->flags & GF_SOCK_HAS_PEER)
+			sock->dest_addr_len = batch->msgs[res-1].msg_hdr.msg_namelen;
+
+		batch->nb_items = res;
+		sock->batch_calls++;
+		sock->batch_dgrams += res;
+		sock->batch_slots += batch->nb_slots;
+		if (nb_datagrams) *nb_datagrams = res;
+		return GF_OK;
+	}
+#endif
+
+	for (i=0; i<batch->nb_slots; i++) {
+		u32 read = 0;
+		//first read behaves as gf_sk_receive_no_select, next ones only fetch datagrams already queued
+		//so that a blocking socket does not wait for the batch to be full
+		if (i) {
+#ifndef __SYMBIAN32__
+			struct timeval timeout;
+			fd_set Group;
+			timeout.tv_sec = 0;
+			timeout.tv_usec = 0;
+			FD_ZERO(&Group);
+			FD_SET(sock->socket, &Group);
+			if (select((int) sock->socket+1, &Group, NULL, NULL, &timeout) <= 0)
+				break;
+			if (!FD_ISSET(sock->socket, &Group))
+				break;
+#else
+			break;
+#endif
+		}
+		e = gf_sk_receive_internal(sock, batch->data + i * batch->slot_size, batch->slot_size, &read, GF_FALSE);
+		if (e) break;
+		batch->sizes[i] = read;
+		batch->nb_items++;
+	}
+	if (!batch->nb_items) return e;
+	sock->batch_calls++;
+	sock->batch_dgrams += batch->nb_items;
+	sock->batch_slots += batch->nb_slots;
+	if (nb_datagrams) *nb_datagrams = batch->nb_items;
+	return GF_OK;
+}
+
+GF_EXPORT
+GF_Err gf_sk_send_batch(GF_Socket *sock, GF_SockBatch *batch)
+{
+	u32 nb_sent = 0;
+	GF_Err e = GF_OK;
+	if (!sock || !sock->socket || !batch) return GF_BAD_PARAM;
+	if (!batch->nb_items) return GF_OK;
+
+#ifdef GPAC_HAS_MMSG
+	if (!(sock->flags & GF_SOCK_IS_TCP)) {
+		u32 i;
+		int sflags = 0;
+#ifdef MSG_NOSIGNAL
+		sflags = MSG_NOSIGNAL;
+#endif
+		for (i=0; i<batch->nb_items; i++) {
+			u32 idx = batch->first + i;
+			struct msghdr *hdr = &batch->msgs[i].msg_hdr;
+			batch->iovs[i].iov_base = batch->data + idx * batch->slot_size;
+			batch->iovs[i].iov_len = batch->sizes[idx];
+			memset(hdr, 0, sizeof(struct msghdr));
+			hdr->msg_iov = &batch->iovs[i];
+			hdr->msg_iovlen = 1;
+			if (sock->flags & GF_SOCK_HAS_PEER) {
+				hdr->msg_name = &sock->dest_addr;
+				hdr->msg_namelen = sock->dest_addr_len;
+			}
+		}
+		i = 0;
+		while (batch->nb_items) {
+			s32 res = sendmmsg(sock->socket, batch->msgs + i, batch->nb_items, sflags);
+			if (res == SOCKET_ERROR) {
+				switch (LASTSOCKERROR) {
+				case EAGAIN:
+					e = GF_IP_SOCK_WOULD_BLOCK;
+					break;
+				case ENOBUFS:
+					e = GF_BUFFER_TOO_SMALL;
+					break;
+				case EINTR:
+					continue;
+				default:
+					GF_LOG(GF_LOG_ERROR, GF_LOG_NETWORK, ("[socket] send failure: %s - discarding %d datagrams\n", gf_errno_str(LASTSOCKERROR), batch->nb_items));
+					sock->batch_drops += batch->nb_items;
+					batch->first = batch->nb_items = 0;
+					e = GF_IP_NETWORK_FAILURE;
+					break;
+				}
+				break;
+			}
+			i += res;
+			nb_sent += res;
+			batch->first += res;
+			batch->nb_items -= res;
+		}
+	} else
+#endif
+	{
+		while (batch->nb_items) {
+			u32 idx = batch->first;
+			e = gf_sk_send(sock, batch->data + idx * batch->slot_size, batch->sizes[idx]);
+			if ((e==GF_IP_SOCK_WOULD_BLOCK) || (e==GF_BUFFER_TOO_SMALL))
+				break;
+			if (e) sock->batch_drops++;
+			else nb_sent++;
+			batch->first++;
+			batch->nb_items--;
+		}
+	}
+	if (!batch->nb_items) batch->first = 0;
+
+	if (nb_sent) {
+		sock->batch_calls++;
+		sock->batch_dgrams += nb_sent;
+		sock->batch_slots += batch->nb_slots;
+	}
+	return e;
+}
+
+GF_EXPORT
+void gf_sk_get_batch_stats(GF_Socket *sock, u64 *nb_calls, u64 *nb_datagrams, u64 *nb_slots, u64 *nb_drops)
+{
+	if (nb_calls) *nb_calls = sock ? sock->batch_calls : 0;
+	if (nb_datagrams) *nb_datagrams = sock ? sock->batch_dgrams : 0;
+	if (nb_slots) *nb_slots = sock ? sock->batch_slots : 0;
+	if (nb_drops) *nb_drops = sock ? sock->batch_drops : 0;
+}
+
 GF_EXPORT
 GF_Err gf_sk_listen(GF_Socket *sock, u32 MaxConnection)
 {
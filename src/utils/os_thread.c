@@ -25,6 +25,11 @@
 
 #ifndef GPAC_DISABLE_CORE_TOOLS
 
+/*sched_setaffinity*/
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #ifdef GPAC_CONFIG_ANDROID
 #include <jni.h>
 #endif
@@ -43,6 +48,9 @@ typedef HANDLE TH_HANDLE;
 #include <pthread.h>
 #include <semaphore.h>
 #include <errno.h>
+#if defined(__linux__)
+#include <dirent.h>
+#endif
 typedef pthread_t TH_HANDLE ;
 
 #endif
@@ -424,6 +432,109 @@ u32 gf_th_status(GF_Thread *t)
 }
 
 
+GF_EXPORT
+GF_Err gf_th_set_cpu_affinity(const u32 *cpus, u32 nb_cpus)
+{
+#if defined(WIN32) && !defined(_WIN32_WCE)
+	u32 i;
+	DWORD_PTR mask = 0;
+	if (!cpus) return GF_BAD_PARAM;
+	for (i=0; i<nb_cpus; i++) {
+		if (cpus[i] < 8*sizeof(DWORD_PTR))
+			mask |= ((DWORD_PTR) 1) << cpus[i];
+	}
+	if (!mask) return GF_BAD_PARAM;
+	if (!SetThreadAffinityMask(GetCurrentThread(), mask))
+		return GF_IO_ERR;
+	return GF_OK;
+#elif defined(__linux__)
+	u32 i;
+	cpu_set_t set;
+	if (!cpus) return GF_BAD_PARAM;
+	CPU_ZERO(&set);
+	for (i=0; i<nb_cpus; i++) {
+		if (cpus[i] < CPU_SETSIZE)
+			CPU_SET(cpus[i], &set);
+	}
+	if (!CPU_COUNT(&set)) return GF_BAD_PARAM;
+	//0 is the calling thread
+	if (sched_setaffinity(0, sizeof(cpu_set_t), &set) != 0)
+		return GF_IO_ERR;
+	return GF_OK;
+#else
+	return GF_NOT_SUPPORTED;
+#endif
+}
+
+GF_EXPORT
+GF_Err gf_th_get_cpu_affinity(u32 *cpus, u32 max_cpus, u32 *nb_cpus)
+{
+#if defined(WIN32) && !defined(_WIN32_WCE)
+	u32 i, count=0;
+	DWORD_PTR mask, proc_mask, sys_mask;
+	if (!nb_cpus) return GF_BAD_PARAM;
+	//no getter for thread mask, set it to the process mask to get the previous one and restore it
+	if (!GetProcessAffinityMask(GetCurrentProcess(), &proc_mask, &sys_mask))
+		return GF_IO_ERR;
+	mask = SetThreadAffinityMask(GetCurrentThread(), proc_mask);
+	if (!mask) return GF_IO_ERR;
+	SetThreadAffinityMask(GetCurrentThread(), mask);
+	for (i=0; i<8*sizeof(DWORD_PTR); i++) {
+		if (! (mask & (((DWORD_PTR) 1) << i))) continue;
+		if (cpus && (count<max_cpus)) cpus[count] = i;
+		count++;
+	}
+	*nb_cpus = count;
+	return GF_OK;
+#elif defined(__linux__)
+	u32 i, count=0;
+	cpu_set_t set;
+	if (!nb_cpus) return GF_BAD_PARAM;
+	CPU_ZERO(&set);
+	if (sched_getaffinity(0, sizeof(cpu_set_t), &set) != 0)
+		return GF_IO_ERR;
+	for (i=0; i<CPU_SETSIZE; i++) {
+		if (!CPU_ISSET(i, &set)) continue;
+		if (cpus && (count<max_cpus)) cpus[count] = i;
+		count++;
+	}
+	*nb_cpus = count;
+	return GF_OK;
+#else
+	return GF_NOT_SUPPORTED;
+#endif
+}
+
+GF_EXPORT
+s32 gf_th_get_cpu_node(u32 cpu)
+{
+#if defined(WIN32) && !defined(_WIN32_WCE)
+	UCHAR node;
+	if ((cpu<256) && GetNumaProcessorNode((UCHAR) cpu, &node))
+		return (s32) node;
+	return -1;
+#elif defined(__linux__)
+	s32 node = -1;
+	char szPath[100];
+	DIR *dir;
+	struct dirent *ent;
+	//a nodeN entry is present in the CPU sysfs directory
+	snprintf(szPath, 100, "/sys/devices/system/cpu/cpu%u", cpu);
+	dir = opendir(szPath);
+	if (!dir) return -1;
+	while ((ent = readdir(dir)) != NULL) {
+		if (!strncmp(ent->d_name, "node", 4) && (ent->d_name[4]>='0') && (ent->d_name[4]<='9')) {
+			node = atoi(ent->d_name+4);
+			break;
+		}
+	}
+	closedir(dir);
+	return node;
+#else
+	return -1;
+#endif
+}
+
 GF_EXPORT
 u32 gf_th_id()
 {